@@ -26,9 +26,9 @@ namespace Piccolo
     PiccoloEditor::~PiccoloEditor() {}
 
     /// <summary>
-    /// ʼ༭
+    /// 初始化编辑器
     /// </summary>
-    /// <param name="engine_runtime">ָ</param>
+    /// <param name="engine_runtime">引擎指针</param>
     void PiccoloEditor::initialize(PiccoloEngine* engine_runtime)
     {
         assert(engine_runtime);
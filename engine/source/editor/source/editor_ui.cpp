@@ -337,6 +337,10 @@ namespace Piccolo
                 {
                     g_runtime_global_context.m_world_manager->saveCurrentLevel();
                 }
+                if (ImGui::MenuItem("Cook Current Level"))
+                {
+                    g_runtime_global_context.m_world_manager->cookCurrentLevel();
+                }
                 if (ImGui::BeginMenu("Debug"))
                 {
                     if (ImGui::BeginMenu("Animation"))
@@ -452,12 +456,8 @@ namespace Piccolo
 
     void EditorUI::createLeafNodeUI(Reflection::ReflectionInstance& instance)
     {
-        Reflection::FieldAccessor* fields;
-        int                        fields_count = instance.m_meta.getFieldsList(fields);
-
-        for (size_t index = 0; index < fields_count; index++)
+        for (const Reflection::FieldAccessor& field : instance.m_meta.getFields())
         {
-            auto field = fields[index];
             if (field.isArrayType())
             {
                 Reflection::ArrayAccessor array_accessor;
@@ -523,7 +523,6 @@ namespace Piccolo
                                                                      field.get(instance.m_instance));
             }
         }
-        delete[] fields;
     }
 
     void EditorUI::showEditorDetailWindow(bool* p_open)
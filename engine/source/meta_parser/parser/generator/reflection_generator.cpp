@@ -5,6 +5,7 @@
 #include "language_types/class.h"
 #include "template_manager/template_manager.h"
 
+#include <functional>
 #include <map>
 #include <set>
 
@@ -21,6 +22,7 @@ namespace Generator
         GeneratorInterface::prepareStatus(path);
         TemplateManager::getInstance()->loadTemplates(m_root_path, "commonReflectionFile");
         TemplateManager::getInstance()->loadTemplates(m_root_path, "allReflectionFile");
+        TemplateManager::getInstance()->loadTemplates(m_root_path, "componentTypeIndexFile");
         return;
     }
 
@@ -53,6 +55,12 @@ namespace Generator
             class_names.insert_or_assign(class_temp->getClassName(), false);
             class_names[class_temp->getClassName()] = true;
 
+            std::vector<std::string>& base_names = m_class_base_names[class_temp->getClassName()];
+            for (auto base_class : class_temp->m_base_classes)
+            {
+                base_names.emplace_back(base_class->name);
+            }
+
             std::vector<std::string>                                   field_names;
             std::map<std::string, std::pair<std::string, std::string>> vector_map;
 
@@ -135,6 +143,45 @@ namespace Generator
         std::string render_string =
             TemplateManager::getInstance()->renderByTemplate("allReflectionFile", mustache_data);
         Utils::saveFile(render_string, m_out_path + "/all_reflection.h");
+
+        genComponentTypeIndexFile();
+    }
+
+    void ReflectionGenerator::genComponentTypeIndexFile()
+    {
+        // every class that derives from Component, directly or not, gets a dense index in name order
+        std::function<bool(const std::string&)> is_component = [&](const std::string& class_name) {
+            auto iter = m_class_base_names.find(class_name);
+            if (iter == m_class_base_names.end())
+                return false;
+            for (auto& base_name : iter->second)
+            {
+                if (base_name == "Component" || is_component(base_name))
+                    return true;
+            }
+            return false;
+        };
+
+        Mustache::data component_defines = Mustache::data::type::list;
+        size_t         component_count   = 0;
+        for (auto& class_item : m_class_base_names)
+        {
+            if (!is_component(class_item.first))
+                continue;
+
+            Mustache::data component_define;
+            component_define.set("class_name", class_item.first);
+            component_define.set("component_type_index", std::to_string(component_count));
+            component_defines.push_back(component_define);
+            ++component_count;
+        }
+
+        Mustache::data mustache_data;
+        mustache_data.set("component_defines", component_defines);
+        mustache_data.set("component_type_count", std::to_string(component_count));
+        std::string render_string =
+            TemplateManager::getInstance()->renderByTemplate("componentTypeIndexFile", mustache_data);
+        Utils::saveFile(render_string, m_out_path + "/component_type_index.h");
     }
 
     ReflectionGenerator::~ReflectionGenerator() {}
@@ -1,5 +1,8 @@
 #pragma once
 #include "generator/generator.h"
+
+#include <map>
+#include <vector>
 namespace Generator
 {
     class ReflectionGenerator : public GeneratorInterface
@@ -15,8 +18,12 @@ namespace Generator
         virtual void        prepareStatus(std::string path) override;
         virtual std::string processFileName(std::string path) override;
 
+        void genComponentTypeIndexFile();
+
     private:
         std::vector<std::string> m_head_file_list;
         std::vector<std::string> m_sourcefile_list;
+        // direct base classes of every reflected class, used to find all classes derived from Component
+        std::map<std::string, std::vector<std::string>> m_class_base_names;
     };
 } // namespace Generator
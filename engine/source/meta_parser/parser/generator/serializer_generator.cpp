@@ -43,6 +43,8 @@ namespace Generator
             Mustache::data class_def;
             genClassRenderData(class_temp, class_def);
 
+            m_schema_signature += class_temp->getClassName() + "{";
+
             // deal base class
             for (int index = 0; index < class_temp->m_base_classes.size(); ++index)
             {
@@ -56,11 +58,13 @@ namespace Generator
                             "headfile_name", Utils::makeRelativePath(m_root_path, include_file_base).string()));
                     }
                 }
+                m_schema_signature += ":" + class_temp->m_base_classes[index]->name;
             }
             for (auto field : class_temp->m_fields)
             {
                 if (!field->shouldCompile())
                     continue;
+                m_schema_signature += field->m_type + " " + field->m_name + ";";
                 // deal vector
                 if (field->m_type.find("std::vector") == 0)
                 {
@@ -77,6 +81,7 @@ namespace Generator
                 }
                 // deal normal
             }
+            m_schema_signature += "}";
             class_defines.push_back(class_def);
             m_class_defines.push_back(class_def);
         }
@@ -97,6 +102,7 @@ namespace Generator
         Mustache::data mustache_data;
         mustache_data.set("class_defines", m_class_defines);
         mustache_data.set("include_headfiles", m_include_headfiles);
+        mustache_data.set("serializer_schema_hash", std::to_string(calculateSchemaHash(m_schema_signature)));
 
         std::string render_string = TemplateManager::getInstance()->renderByTemplate("allSerializer.h", mustache_data);
         Utils::saveFile(render_string, m_out_path + "/all_serializer.h");
@@ -104,5 +110,17 @@ namespace Generator
         Utils::saveFile(render_string, m_out_path + "/all_serializer.ipp");
     }
 
+    uint32_t SerializerGenerator::calculateSchemaHash(const std::string& signature)
+    {
+        // FNV-1a, stable across compilers unlike std::hash
+        uint32_t hash = 2166136261u;
+        for (unsigned char c : signature)
+        {
+            hash ^= c;
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
     SerializerGenerator::~SerializerGenerator() {}
 } // namespace Generator
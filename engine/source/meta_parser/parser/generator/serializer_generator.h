@@ -1,5 +1,8 @@
 #pragma once
 #include "generator/generator.h"
+
+#include <cstdint>
+
 namespace Generator
 {
     class SerializerGenerator : public GeneratorInterface
@@ -19,8 +22,12 @@ namespace Generator
 
         virtual std::string processFileName(std::string path) override;
 
+        static uint32_t calculateSchemaHash(const std::string& signature);
+
     private:
         Mustache::data m_class_defines {Mustache::data::type::list};
         Mustache::data m_include_headfiles {Mustache::data::type::list};
+        // every serialized class layout in generation order, hashed into k_serializer_schema_hash
+        std::string m_schema_signature;
     };
 } // namespace Generator
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PICCOLO_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Piccolo
+{
+    /// four floats processed together, used by the structure of arrays kernels where every lane is a different
+    /// element (bone, box, ...). SSE2 is part of every x86-64 target, other targets use the scalar fallback
+    ///
+    /// comparisons return masks whose lanes have all bits set or cleared, select() picks lanes by such a mask
+    class SimdFloat4
+    {
+    public:
+        static constexpr uint32_t k_lane_count = 4;
+
+#ifdef PICCOLO_SIMD_SSE2
+        SimdFloat4() = default;
+        explicit SimdFloat4(__m128 value) : m_value {value} {}
+
+        static SimdFloat4 splat(float value) { return SimdFloat4 {_mm_set1_ps(value)}; }
+        static SimdFloat4 set(float lane0, float lane1, float lane2, float lane3)
+        {
+            return SimdFloat4 {_mm_setr_ps(lane0, lane1, lane2, lane3)};
+        }
+        static SimdFloat4 load(const float* source) { return SimdFloat4 {_mm_loadu_ps(source)}; }
+        void              store(float* destination) const { _mm_storeu_ps(destination, m_value); }
+
+        SimdFloat4 operator+(const SimdFloat4& rhs) const { return SimdFloat4 {_mm_add_ps(m_value, rhs.m_value)}; }
+        SimdFloat4 operator-(const SimdFloat4& rhs) const { return SimdFloat4 {_mm_sub_ps(m_value, rhs.m_value)}; }
+        SimdFloat4 operator*(const SimdFloat4& rhs) const { return SimdFloat4 {_mm_mul_ps(m_value, rhs.m_value)}; }
+        SimdFloat4 operator/(const SimdFloat4& rhs) const { return SimdFloat4 {_mm_div_ps(m_value, rhs.m_value)}; }
+        SimdFloat4 operator-() const { return SimdFloat4 {_mm_xor_ps(m_value, _mm_set1_ps(-0.f))}; }
+
+        SimdFloat4 operator&(const SimdFloat4& rhs) const { return SimdFloat4 {_mm_and_ps(m_value, rhs.m_value)}; }
+        SimdFloat4 operator|(const SimdFloat4& rhs) const { return SimdFloat4 {_mm_or_ps(m_value, rhs.m_value)}; }
+
+        static SimdFloat4 sqrt(const SimdFloat4& value) { return SimdFloat4 {_mm_sqrt_ps(value.m_value)}; }
+        static SimdFloat4 abs(const SimdFloat4& value)
+        {
+            return SimdFloat4 {_mm_andnot_ps(_mm_set1_ps(-0.f), value.m_value)};
+        }
+
+        static SimdFloat4 lessThan(const SimdFloat4& lhs, const SimdFloat4& rhs)
+        {
+            return SimdFloat4 {_mm_cmplt_ps(lhs.m_value, rhs.m_value)};
+        }
+        static SimdFloat4 select(const SimdFloat4& mask, const SimdFloat4& if_true, const SimdFloat4& if_false)
+        {
+            return SimdFloat4 {
+                _mm_or_ps(_mm_and_ps(mask.m_value, if_true.m_value), _mm_andnot_ps(mask.m_value, if_false.m_value))};
+        }
+        /// bit n of the result is set when lane n of the mask is set
+        static uint32_t moveMask(const SimdFloat4& mask)
+        {
+            return static_cast<uint32_t>(_mm_movemask_ps(mask.m_value));
+        }
+
+    private:
+        __m128 m_value;
+#else
+        SimdFloat4() = default;
+
+        static SimdFloat4 splat(float value) { return set(value, value, value, value); }
+        static SimdFloat4 set(float lane0, float lane1, float lane2, float lane3)
+        {
+            SimdFloat4 result;
+            result.m_value[0] = lane0;
+            result.m_value[1] = lane1;
+            result.m_value[2] = lane2;
+            result.m_value[3] = lane3;
+            return result;
+        }
+        static SimdFloat4 load(const float* source)
+        {
+            SimdFloat4 result;
+            std::memcpy(result.m_value, source, sizeof(result.m_value));
+            return result;
+        }
+        void store(float* destination) const { std::memcpy(destination, m_value, sizeof(m_value)); }
+
+        SimdFloat4 operator+(const SimdFloat4& rhs) const { return apply(rhs, [](float a, float b) { return a + b; }); }
+        SimdFloat4 operator-(const SimdFloat4& rhs) const { return apply(rhs, [](float a, float b) { return a - b; }); }
+        SimdFloat4 operator*(const SimdFloat4& rhs) const { return apply(rhs, [](float a, float b) { return a * b; }); }
+        SimdFloat4 operator/(const SimdFloat4& rhs) const { return apply(rhs, [](float a, float b) { return a / b; }); }
+        SimdFloat4 operator-() const { return splat(0.f) - *this; }
+        SimdFloat4 operator&(const SimdFloat4& rhs) const
+        {
+            return apply(rhs, [](float a, float b) { return maskBits(floatBits(a) & floatBits(b)); });
+        }
+        SimdFloat4 operator|(const SimdFloat4& rhs) const
+        {
+            return apply(rhs, [](float a, float b) { return maskBits(floatBits(a) | floatBits(b)); });
+        }
+
+        static SimdFloat4 sqrt(const SimdFloat4& value)
+        {
+            return value.apply(value, [](float a, float) { return std::sqrt(a); });
+        }
+        static SimdFloat4 abs(const SimdFloat4& value)
+        {
+            return value.apply(value, [](float a, float) { return std::fabs(a); });
+        }
+
+        static SimdFloat4 lessThan(const SimdFloat4& lhs, const SimdFloat4& rhs)
+        {
+            return lhs.apply(rhs, [](float a, float b) { return a < b ? maskBits(~0u) : maskBits(0u); });
+        }
+        static SimdFloat4 select(const SimdFloat4& mask, const SimdFloat4& if_true, const SimdFloat4& if_false)
+        {
+            SimdFloat4 result;
+            for (uint32_t lane = 0; lane < k_lane_count; ++lane)
+            {
+                result.m_value[lane] = floatBits(mask.m_value[lane]) ? if_true.m_value[lane] : if_false.m_value[lane];
+            }
+            return result;
+        }
+        static uint32_t moveMask(const SimdFloat4& mask)
+        {
+            uint32_t result = 0;
+            for (uint32_t lane = 0; lane < k_lane_count; ++lane)
+            {
+                result |= (floatBits(mask.m_value[lane]) >> 31) << lane;
+            }
+            return result;
+        }
+
+    private:
+        static float maskBits(uint32_t bits)
+        {
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        static uint32_t floatBits(float value)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        template<typename Operation>
+        SimdFloat4 apply(const SimdFloat4& rhs, Operation operation) const
+        {
+            SimdFloat4 result;
+            for (uint32_t lane = 0; lane < k_lane_count; ++lane)
+            {
+                result.m_value[lane] = operation(m_value[lane], rhs.m_value[lane]);
+            }
+            return result;
+        }
+
+        float m_value[k_lane_count];
+#endif
+    };
+} // namespace Piccolo
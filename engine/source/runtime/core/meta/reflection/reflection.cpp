@@ -1,6 +1,11 @@
 #include "reflection.h"
+
+#include "runtime/core/meta/serializer/binary_serializer.h"
+
+#include <algorithm>
 #include <cstring>
-#include <map>
+#include <memory>
+#include <string_view>
 
 namespace Piccolo
 {
@@ -9,207 +14,280 @@ namespace Piccolo
         const char* k_unknown_type = "UnknownType";
         const char* k_unknown      = "Unknown";
 
-        static std::map<std::string, ClassFunctionTuple*>       m_class_map;
-        static std::multimap<std::string, FieldFunctionTuple*>  m_field_map;
-        static std::multimap<std::string, MethodFunctionTuple*> m_method_map;
-        static std::map<std::string, ArrayFunctionTuple*>       m_array_map;
+        /// everything registered for one type name, immutable once the registry is frozen
+        struct TypeDescriptor
+        {
+            std::string                 type_name;
+            std::vector<FieldAccessor>  fields;
+            std::vector<MethodAccessor> methods;
+            const ClassFunctionTuple*   class_functions {nullptr};
+            ArrayAccessor               array_accessor;
+            bool                        is_array {false};
+            // a type with fields or methods, the meta of a type without any is not valid
+            bool is_valid {false};
+        };
+
+        namespace
+        {
+            // the keys view the names owned by the descriptors, which never move
+            std::unordered_map<std::string_view, std::unique_ptr<TypeDescriptor>> g_type_descriptors;
+
+            const std::vector<FieldAccessor>  k_no_fields;
+            const std::vector<MethodAccessor> k_no_methods;
+
+            const TypeDescriptor* findTypeDescriptor(std::string_view type_name)
+            {
+                auto iter = g_type_descriptors.find(type_name);
+                return iter != g_type_descriptors.end() ? iter->second.get() : nullptr;
+            }
+
+            TypeDescriptor& findOrAddTypeDescriptor(std::string_view type_name)
+            {
+                auto iter = g_type_descriptors.find(type_name);
+                if (iter != g_type_descriptors.end())
+                {
+                    return *iter->second;
+                }
+
+                std::unique_ptr<TypeDescriptor> descriptor = std::make_unique<TypeDescriptor>();
+                descriptor->type_name                      = type_name;
+                TypeDescriptor& result                     = *descriptor;
+                g_type_descriptors.emplace(std::string_view(result.type_name), std::move(descriptor));
+                return result;
+            }
+        } // namespace
 
-        void TypeMetaRegisterinterface::registerToFieldMap(const char* name, FieldFunctionTuple* value)
+        void TypeMetaRegisterinterface::registerToFieldMap(const char* name, const FieldFunctionTuple* value)
         {
-            m_field_map.insert(std::make_pair(name, value));
+            findOrAddTypeDescriptor(name).fields.emplace_back(FieldAccessor(value));
         }
-        void TypeMetaRegisterinterface::registerToMethodMap(const char* name, MethodFunctionTuple* value)
+        void TypeMetaRegisterinterface::registerToMethodMap(const char* name, const MethodFunctionTuple* value)
         {
-            m_method_map.insert(std::make_pair(name, value));
+            findOrAddTypeDescriptor(name).methods.emplace_back(MethodAccessor(value));
         }
-        void TypeMetaRegisterinterface::registerToArrayMap(const char* name, ArrayFunctionTuple* value)
+        void TypeMetaRegisterinterface::registerToArrayMap(const char* name, const ArrayFunctionTuple* value)
         {
-            if (m_array_map.find(name) == m_array_map.end())
-            {
-                m_array_map.insert(std::make_pair(name, value));
-            }
-            else
+            // every file using an array type registers it again
+            TypeDescriptor& descriptor = findOrAddTypeDescriptor(name);
+            if (!descriptor.is_array)
             {
-                delete value;
+                descriptor.array_accessor = ArrayAccessor(value);
+                descriptor.is_array       = true;
             }
         }
 
-        void TypeMetaRegisterinterface::registerToClassMap(const char* name, ClassFunctionTuple* value)
+        void TypeMetaRegisterinterface::registerToClassMap(const char* name, const ClassFunctionTuple* value)
         {
-            if (m_class_map.find(name) == m_class_map.end())
+            TypeDescriptor& descriptor = findOrAddTypeDescriptor(name);
+            if (descriptor.class_functions == nullptr)
             {
-                m_class_map.insert(std::make_pair(name, value));
-            }
-            else
-            {
-                delete value;
+                descriptor.class_functions = value;
             }
         }
 
-        void TypeMetaRegisterinterface::unregisterAll()
+        void TypeMetaRegisterinterface::freeze()
         {
-            for (const auto& itr : m_field_map)
+            // intern the types fields refer to first, adding descriptors while resolving would invalidate iteration
+            std::vector<TypeDescriptor*> descriptors;
+            descriptors.reserve(g_type_descriptors.size());
+            for (auto& iter : g_type_descriptors)
             {
-                delete itr.second;
+                descriptors.push_back(iter.second.get());
             }
-            m_field_map.clear();
-            for (const auto& itr : m_class_map)
+            for (TypeDescriptor* descriptor : descriptors)
             {
-                delete itr.second;
+                for (const FieldAccessor& field : descriptor->fields)
+                {
+                    findOrAddTypeDescriptor(field.m_field_type_name);
+                }
+                if (descriptor->is_array)
+                {
+                    findOrAddTypeDescriptor(descriptor->array_accessor.m_element_type_name);
+                }
             }
-            m_class_map.clear();
-            for (const auto& itr : m_array_map)
+
+            for (auto& iter : g_type_descriptors)
             {
-                delete itr.second;
+                TypeDescriptor& descriptor = *iter.second;
+                descriptor.is_valid        = !descriptor.fields.empty() || !descriptor.methods.empty();
+                for (FieldAccessor& field : descriptor.fields)
+                {
+                    field.m_owner_type_descriptor = &descriptor;
+                    field.m_field_type_descriptor = findTypeDescriptor(field.m_field_type_name);
+                }
             }
-            m_array_map.clear();
         }
 
-        TypeMeta::TypeMeta(std::string type_name) : m_type_name(type_name)
-        {
-            m_is_valid = false;
-            m_fields.clear();
-            m_methods.clear();
+        void TypeMetaRegisterinterface::unregisterAll() { g_type_descriptors.clear(); }
 
-            auto fileds_iter = m_field_map.equal_range(type_name);
-            while (fileds_iter.first != fileds_iter.second)
+        TypeMeta::TypeMeta(const std::string& type_name) : m_descriptor(findTypeDescriptor(type_name))
+        {
+            if (m_descriptor == nullptr)
             {
-                FieldAccessor f_field(fileds_iter.first->second);
-                m_fields.emplace_back(f_field);
-                m_is_valid = true;
-
-                ++fileds_iter.first;
+                m_unregistered_type_name = type_name;
             }
+        }
 
-            auto methods_iter = m_method_map.equal_range(type_name);
-            while (methods_iter.first != methods_iter.second)
+        TypeMeta::TypeMeta(const TypeDescriptor* descriptor) : m_descriptor(descriptor)
+        {
+            if (m_descriptor == nullptr)
             {
-                MethodAccessor f_method(methods_iter.first->second);
-                m_methods.emplace_back(f_method);
-                m_is_valid = true;
-
-                ++methods_iter.first;
+                m_unregistered_type_name = k_unknown_type;
             }
         }
 
-        TypeMeta::TypeMeta() : m_type_name(k_unknown_type), m_is_valid(false) { m_fields.clear(); m_methods.clear(); }
+        TypeMeta::TypeMeta() : m_unregistered_type_name(k_unknown_type) {}
 
-        TypeMeta TypeMeta::newMetaFromName(std::string type_name)
+        TypeMeta TypeMeta::newMetaFromName(const std::string& type_name)
         {
             TypeMeta f_type(type_name);
             return f_type;
         }
 
-        bool TypeMeta::newArrayAccessorFromName(std::string array_type_name, ArrayAccessor& accessor)
+        bool TypeMeta::newArrayAccessorFromName(const std::string& array_type_name, ArrayAccessor& accessor)
         {
-            auto iter = m_array_map.find(array_type_name);
+            const TypeDescriptor* descriptor = findTypeDescriptor(array_type_name);
 
-            if (iter != m_array_map.end())
+            if (descriptor != nullptr && descriptor->is_array)
             {
-                ArrayAccessor new_accessor(iter->second);
-                accessor = new_accessor;
+                accessor = descriptor->array_accessor;
                 return true;
             }
 
             return false;
         }
 
-        ReflectionInstance TypeMeta::newFromNameAndJson(std::string type_name, const Json& json_context)
+        ReflectionInstance TypeMeta::newFromNameAndJson(const std::string& type_name, const Json& json_context)
         {
-            auto iter = m_class_map.find(type_name);
+            const TypeDescriptor* descriptor = findTypeDescriptor(type_name);
 
-            if (iter != m_class_map.end())
+            if (descriptor != nullptr && descriptor->class_functions != nullptr)
             {
-                return ReflectionInstance(TypeMeta(type_name), (std::get<1>(*iter->second)(json_context)));
+                return ReflectionInstance(TypeMeta(descriptor),
+                                          (std::get<1>(*descriptor->class_functions)(json_context)));
             }
             return ReflectionInstance();
         }
 
-        Json TypeMeta::writeByName(std::string type_name, void* instance)
+        Json TypeMeta::writeByName(const std::string& type_name, void* instance)
         {
-            auto iter = m_class_map.find(type_name);
+            const TypeDescriptor* descriptor = findTypeDescriptor(type_name);
 
-            if (iter != m_class_map.end())
+            if (descriptor != nullptr && descriptor->class_functions != nullptr)
             {
-                return std::get<2>(*iter->second)(instance);
+                return std::get<2>(*descriptor->class_functions)(instance);
             }
             return Json();
         }
 
-        std::string TypeMeta::getTypeName() { return m_type_name; }
+        bool TypeMeta::writeByName(const std::string& type_name, JsonWriter& writer, void* instance)
+        {
+            const TypeDescriptor* descriptor = findTypeDescriptor(type_name);
+
+            if (descriptor != nullptr && descriptor->class_functions != nullptr)
+            {
+                std::get<5>(*descriptor->class_functions)(writer, instance);
+                return true;
+            }
+            return false;
+        }
+
+        ReflectionInstance TypeMeta::newFromNameAndJsonReader(const std::string& type_name, JsonReader& reader)
+        {
+            const TypeDescriptor* descriptor = findTypeDescriptor(type_name);
+
+            if (descriptor != nullptr && descriptor->class_functions != nullptr)
+            {
+                return ReflectionInstance(TypeMeta(descriptor), (std::get<6>(*descriptor->class_functions)(reader)));
+            }
+            reader.skipValue();
+            return ReflectionInstance();
+        }
+
+        ReflectionInstance TypeMeta::newFromNameAndBinary(const std::string& type_name, BinaryReader& reader)
+        {
+            const TypeDescriptor* descriptor = findTypeDescriptor(type_name);
 
-        int TypeMeta::getFieldsList(FieldAccessor*& out_list)
+            if (descriptor != nullptr && descriptor->class_functions != nullptr)
+            {
+                return ReflectionInstance(TypeMeta(descriptor), (std::get<3>(*descriptor->class_functions)(reader)));
+            }
+            return ReflectionInstance();
+        }
+
+        bool TypeMeta::writeBinaryByName(const std::string& type_name, BinaryWriter& writer, void* instance)
         {
-            int count = m_fields.size();
-            out_list  = new FieldAccessor[count];
-            for (int i = 0; i < count; ++i)
+            const TypeDescriptor* descriptor = findTypeDescriptor(type_name);
+
+            if (descriptor != nullptr && descriptor->class_functions != nullptr)
             {
-                out_list[i] = m_fields[i];
+                std::get<4>(*descriptor->class_functions)(writer, instance);
+                return true;
             }
-            return count;
+            return false;
         }
 
-        int TypeMeta::getMethodsList(MethodAccessor*& out_list)
+        ReflectionInstance TypeMeta::cloneByName(const std::string& type_name, void* instance)
         {
-            int count = m_methods.size();
-            out_list  = new MethodAccessor[count];
-            for (int i = 0; i < count; ++i)
+            BinaryWriter writer;
+            if (!writeBinaryByName(type_name, writer, instance) || !writer.isValid())
             {
-                out_list[i] = m_methods[i];
+                return ReflectionInstance();
             }
-            return count;
+
+            BinaryReader reader(writer.getBuffer().data(), writer.getBuffer().size());
+            return newFromNameAndBinary(type_name, reader);
+        }
+
+        const std::string& TypeMeta::getTypeName() const
+        {
+            return m_descriptor != nullptr ? m_descriptor->type_name : m_unregistered_type_name;
+        }
+
+        const std::vector<FieldAccessor>& TypeMeta::getFields() const
+        {
+            return m_descriptor != nullptr ? m_descriptor->fields : k_no_fields;
         }
 
-        int TypeMeta::getBaseClassReflectionInstanceList(ReflectionInstance*& out_list, void* instance)
+        const std::vector<MethodAccessor>& TypeMeta::getMethods() const
         {
-            auto iter = m_class_map.find(m_type_name);
+            return m_descriptor != nullptr ? m_descriptor->methods : k_no_methods;
+        }
 
-            if (iter != m_class_map.end())
+        int TypeMeta::getBaseClassReflectionInstanceList(ReflectionInstance*& out_list, void* instance) const
+        {
+            if (m_descriptor != nullptr && m_descriptor->class_functions != nullptr)
             {
-                return (std::get<0>(*iter->second))(out_list, instance);
+                return (std::get<0>(*m_descriptor->class_functions))(out_list, instance);
             }
 
             return 0;
         }
 
-        FieldAccessor TypeMeta::getFieldByName(const char* name)
+        FieldAccessor TypeMeta::getFieldByName(const char* name) const
         {
-            const auto it = std::find_if(m_fields.begin(), m_fields.end(), [&](const auto& i) {
+            const std::vector<FieldAccessor>& fields = getFields();
+            const auto it = std::find_if(fields.begin(), fields.end(), [&](const auto& i) {
                 return std::strcmp(i.getFieldName(), name) == 0;
             });
-            if (it != m_fields.end())
+            if (it != fields.end())
                 return *it;
             return FieldAccessor(nullptr);
         }
 
-        MethodAccessor TypeMeta::getMethodByName(const char* name)
+        MethodAccessor TypeMeta::getMethodByName(const char* name) const
         {
-            const auto it = std::find_if(m_methods.begin(), m_methods.end(), [&](const auto& i) {
+            const std::vector<MethodAccessor>& methods = getMethods();
+            const auto it = std::find_if(methods.begin(), methods.end(), [&](const auto& i) {
                 return std::strcmp(i.getMethodName(), name) == 0;
             });
-            if (it != m_methods.end())
+            if (it != methods.end())
                 return *it;
             return MethodAccessor(nullptr);
         }
 
-        TypeMeta& TypeMeta::operator=(const TypeMeta& dest)
-        {
-            if (this == &dest)
-            {
-                return *this;
-            }
-            m_fields.clear();
-            m_fields = dest.m_fields;
-
-            
-            m_methods.clear();
-            m_methods = dest.m_methods;
-
-            m_type_name = dest.m_type_name;
-            m_is_valid  = dest.m_is_valid;
+        bool TypeMeta::isValid() const { return m_descriptor != nullptr && m_descriptor->is_valid; }
 
-            return *this;
-        }
         FieldAccessor::FieldAccessor()
         {
             m_field_type_name = k_unknown_type;
@@ -217,7 +295,7 @@ namespace Piccolo
             m_functions       = nullptr;
         }
 
-        FieldAccessor::FieldAccessor(FieldFunctionTuple* functions) : m_functions(functions)
+        FieldAccessor::FieldAccessor(const FieldFunctionTuple* functions) : m_functions(functions)
         {
             m_field_type_name = k_unknown_type;
             m_field_name      = k_unknown;
@@ -228,42 +306,44 @@ namespace Piccolo
 
             m_field_type_name = (std::get<4>(*m_functions))();
             m_field_name      = (std::get<3>(*m_functions))();
+            m_is_array        = (std::get<5>(*m_functions))();
         }
 
-        void* FieldAccessor::get(void* instance)
+        void* FieldAccessor::get(void* instance) const
         {
             // todo: should check validation
             return static_cast<void*>((std::get<1>(*m_functions))(instance));
         }
 
-        void FieldAccessor::set(void* instance, void* value)
+        void FieldAccessor::set(void* instance, void* value) const
         {
             // todo: should check validation
             (std::get<0>(*m_functions))(instance, value);
         }
 
-        TypeMeta FieldAccessor::getOwnerTypeMeta()
+        TypeMeta FieldAccessor::getOwnerTypeMeta() const
         {
+            if (m_owner_type_descriptor != nullptr)
+            {
+                return TypeMeta(m_owner_type_descriptor);
+            }
             // todo: should check validation
             TypeMeta f_type((std::get<2>(*m_functions))());
             return f_type;
         }
 
-        bool FieldAccessor::getTypeMeta(TypeMeta& field_type)
+        bool FieldAccessor::getTypeMeta(TypeMeta& field_type) const
         {
-            TypeMeta f_type(m_field_type_name);
-            field_type = f_type;
-            return f_type.m_is_valid;
+            // resolved by freeze(), only looked up by name for accessors made before that
+            field_type = m_field_type_descriptor != nullptr ? TypeMeta(m_field_type_descriptor) :
+                                                              TypeMeta(std::string(m_field_type_name));
+            return field_type.isValid();
         }
 
         const char* FieldAccessor::getFieldName() const { return m_field_name; }
-        const char* FieldAccessor::getFieldTypeName() { return m_field_type_name; }
+        const char* FieldAccessor::getFieldTypeName() const { return m_field_type_name; }
 
-        bool FieldAccessor::isArrayType()
-        {
-            // todo: should check validation
-            return (std::get<5>(*m_functions))();
-        }
+        bool FieldAccessor::isArrayType() const { return m_is_array; }
 
         FieldAccessor& FieldAccessor::operator=(const FieldAccessor& dest)
         {
@@ -271,9 +351,12 @@ namespace Piccolo
             {
                 return *this;
             }
-            m_functions       = dest.m_functions;
-            m_field_name      = dest.m_field_name;
-            m_field_type_name = dest.m_field_type_name;
+            m_functions             = dest.m_functions;
+            m_field_name            = dest.m_field_name;
+            m_field_type_name       = dest.m_field_type_name;
+            m_owner_type_descriptor = dest.m_owner_type_descriptor;
+            m_field_type_descriptor = dest.m_field_type_descriptor;
+            m_is_array              = dest.m_is_array;
             return *this;
         }
 
@@ -283,7 +366,7 @@ namespace Piccolo
             m_functions   = nullptr;
         }
 
-        MethodAccessor::MethodAccessor(MethodFunctionTuple* functions) : m_functions(functions)
+        MethodAccessor::MethodAccessor(const MethodFunctionTuple* functions) : m_functions(functions)
         {
             m_method_name      = k_unknown;
             if (m_functions == nullptr)
@@ -293,9 +376,7 @@ namespace Piccolo
 
             m_method_name      = (std::get<0>(*m_functions))();
         }
-        const char* MethodAccessor::getMethodName() const{
-            return (std::get<0>(*m_functions))();
-        }
+        const char* MethodAccessor::getMethodName() const { return m_method_name; }
         MethodAccessor& MethodAccessor::operator=(const MethodAccessor& dest)
         {
             if (this == &dest)
@@ -306,12 +387,12 @@ namespace Piccolo
             m_method_name      = dest.m_method_name;
             return *this;
         }
-        void MethodAccessor::invoke(void* instance) { (std::get<1>(*m_functions))(instance); }
+        void MethodAccessor::invoke(void* instance) const { (std::get<1>(*m_functions))(instance); }
         ArrayAccessor::ArrayAccessor() :
             m_func(nullptr), m_array_type_name("UnKnownType"), m_element_type_name("UnKnownType")
         {}
 
-        ArrayAccessor::ArrayAccessor(ArrayFunctionTuple* array_func) : m_func(array_func)
+        ArrayAccessor::ArrayAccessor(const ArrayFunctionTuple* array_func) : m_func(array_func)
         {
             m_array_type_name   = k_unknown_type;
             m_element_type_name = k_unknown_type;
@@ -323,9 +404,9 @@ namespace Piccolo
             m_array_type_name   = std::get<3>(*m_func)();
             m_element_type_name = std::get<4>(*m_func)();
         }
-        const char* ArrayAccessor::getArrayTypeName() { return m_array_type_name; }
-        const char* ArrayAccessor::getElementTypeName() { return m_element_type_name; }
-        void        ArrayAccessor::set(int index, void* instance, void* element_value)
+        const char* ArrayAccessor::getArrayTypeName() const { return m_array_type_name; }
+        const char* ArrayAccessor::getElementTypeName() const { return m_element_type_name; }
+        void        ArrayAccessor::set(int index, void* instance, void* element_value) const
         {
             // todo: should check validation
             size_t count = getSize(instance);
@@ -333,7 +414,7 @@ namespace Piccolo
             std::get<0> (*m_func)(index, instance, element_value);
         }
 
-        void* ArrayAccessor::get(int index, void* instance)
+        void* ArrayAccessor::get(int index, void* instance) const
         {
             // todo: should check validation
             size_t count = getSize(instance);
@@ -341,13 +422,13 @@ namespace Piccolo
             return std::get<1>(*m_func)(index, instance);
         }
 
-        int ArrayAccessor::getSize(void* instance)
+        int ArrayAccessor::getSize(void* instance) const
         {
             // todo: should check validation
             return std::get<2>(*m_func)(instance);
         }
 
-        ArrayAccessor& ArrayAccessor::operator=(ArrayAccessor& dest)
+        ArrayAccessor& ArrayAccessor::operator=(const ArrayAccessor& dest)
         {
             if (this == &dest)
             {
@@ -3,6 +3,7 @@
 
 #include <functional>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -24,7 +25,8 @@ namespace Piccolo
 
 #define REFLECTION_BODY(class_name) \
     friend class Reflection::TypeFieldReflectionOparator::Type##class_name##Operator; \
-    friend class Serializer;
+    friend class Serializer; \
+    friend class BinarySerializer;
     // public: virtual std::string getTypeName() override {return #class_name;}
 
 #define REFLECTION_TYPE(class_name) \
@@ -68,6 +70,11 @@ namespace Piccolo
     struct is_safely_castable<T, U, std::void_t<decltype(static_cast<U>(std::declval<T>()))>> : std::true_type
     {};
 
+    class BinaryReader;
+    class BinaryWriter;
+    class JsonReader;
+    class JsonWriter;
+
     namespace Reflection
     {
         class TypeMeta;
@@ -76,38 +83,60 @@ namespace Piccolo
         class ArrayAccessor;
         class ReflectionInstance;
     } // namespace Reflection
-    typedef std::function<void(void*, void*)>      SetFuncion;
-    typedef std::function<void*(void*)>            GetFuncion;
-    typedef std::function<const char*()>           GetNameFuncion;
-    typedef std::function<void(int, void*, void*)> SetArrayFunc;
-    typedef std::function<void*(int, void*)>       GetArrayFunc;
-    typedef std::function<int(void*)>              GetSizeFunc;
-    typedef std::function<bool()>                  GetBoolFunc;
-    typedef std::function<void(void*)>             InvokeFunction;
-
-    typedef std::function<void*(const Json&)>                           ConstructorWithJson;
-    typedef std::function<Json(void*)>                                  WriteJsonByName;
-    typedef std::function<int(Reflection::ReflectionInstance*&, void*)> GetBaseClassReflectionInstanceListFunc;
-
+    // plain function pointers, the generated accessors are static functions so nothing needs to be captured
+    typedef void (*SetFuncion)(void*, void*);
+    typedef void* (*GetFuncion)(void*);
+    typedef const char* (*GetNameFuncion)();
+    typedef void (*SetArrayFunc)(int, void*, void*);
+    typedef void* (*GetArrayFunc)(int, void*);
+    typedef int (*GetSizeFunc)(void*);
+    typedef bool (*GetBoolFunc)();
+    typedef void (*InvokeFunction)(void*);
+
+    typedef void* (*ConstructorWithJson)(const Json&);
+    typedef Json (*WriteJsonByName)(void*);
+    typedef void (*WriteJsonStreamByName)(JsonWriter&, void*);
+    typedef void* (*ConstructorWithJsonReader)(JsonReader&);
+    typedef void* (*ConstructorWithBinary)(BinaryReader&);
+    typedef void (*WriteBinaryByName)(BinaryWriter&, void*);
+    typedef int (*GetBaseClassReflectionInstanceListFunc)(Reflection::ReflectionInstance*&, void*);
+
+    // the generated code keeps these tables in static storage, the registry only points at them
     typedef std::tuple<SetFuncion, GetFuncion, GetNameFuncion, GetNameFuncion, GetNameFuncion, GetBoolFunc>
                                                        FieldFunctionTuple;
     typedef std::tuple<GetNameFuncion, InvokeFunction> MethodFunctionTuple;
-    typedef std::tuple<GetBaseClassReflectionInstanceListFunc, ConstructorWithJson, WriteJsonByName> ClassFunctionTuple;
+    typedef std::tuple<GetBaseClassReflectionInstanceListFunc,
+                       ConstructorWithJson,
+                       WriteJsonByName,
+                       ConstructorWithBinary,
+                       WriteBinaryByName,
+                       WriteJsonStreamByName,
+                       ConstructorWithJsonReader>
+        ClassFunctionTuple;
     typedef std::tuple<SetArrayFunc, GetArrayFunc, GetSizeFunc, GetNameFuncion, GetNameFuncion>      ArrayFunctionTuple;
 
     namespace Reflection
     {
+        struct TypeDescriptor;
+
+        /// fields, methods, classes and arrays are registered by the generated code, freeze() then turns them into
+        /// one immutable descriptor per type name. lookups after that only read, so they are safe from any thread
         class TypeMetaRegisterinterface
         {
         public:
-            static void registerToClassMap(const char* name, ClassFunctionTuple* value);
-            static void registerToFieldMap(const char* name, FieldFunctionTuple* value);
+            static void registerToClassMap(const char* name, const ClassFunctionTuple* value);
+            static void registerToFieldMap(const char* name, const FieldFunctionTuple* value);
 
-            static void registerToMethodMap(const char* name, MethodFunctionTuple* value);
-            static void registerToArrayMap(const char* name, ArrayFunctionTuple* value);
+            static void registerToMethodMap(const char* name, const MethodFunctionTuple* value);
+            static void registerToArrayMap(const char* name, const ArrayFunctionTuple* value);
+
+            // called once all types are registered, interns the type names every field refers to
+            static void freeze();
 
             static void unregisterAll();
         };
+
+        /// a handle to the descriptor of a type, copying it copies a pointer
         class TypeMeta
         {
             friend class FieldAccessor;
@@ -119,48 +148,54 @@ namespace Piccolo
 
             // static void Register();
 
-            static TypeMeta newMetaFromName(std::string type_name);
+            static TypeMeta newMetaFromName(const std::string& type_name);
 
-            static bool               newArrayAccessorFromName(std::string array_type_name, ArrayAccessor& accessor);
-            static ReflectionInstance newFromNameAndJson(std::string type_name, const Json& json_context);
-            static Json               writeByName(std::string type_name, void* instance);
+            static bool newArrayAccessorFromName(const std::string& array_type_name, ArrayAccessor& accessor);
+            static ReflectionInstance newFromNameAndJson(const std::string& type_name, const Json& json_context);
+            static Json               writeByName(const std::string& type_name, void* instance);
+            static bool writeByName(const std::string& type_name, JsonWriter& writer, void* instance);
+            // the value is skipped when the type is unknown, so the reader stays in step
+            static ReflectionInstance newFromNameAndJsonReader(const std::string& type_name, JsonReader& reader);
+            static ReflectionInstance newFromNameAndBinary(const std::string& type_name, BinaryReader& reader);
+            static bool writeBinaryByName(const std::string& type_name, BinaryWriter& writer, void* instance);
+            // deep copy of every reflected field, the runtime-only members of the copy are default constructed
+            static ReflectionInstance cloneByName(const std::string& type_name, void* instance);
 
-            std::string getTypeName();
+            const std::string& getTypeName() const;
 
-            int getFieldsList(FieldAccessor*& out_list);
-            int getMethodsList(MethodAccessor*& out_list);
+            // the registered fields and methods of the type, no copy is made
+            const std::vector<FieldAccessor>&  getFields() const;
+            const std::vector<MethodAccessor>& getMethods() const;
 
-            int getBaseClassReflectionInstanceList(ReflectionInstance*& out_list, void* instance);
+            int getBaseClassReflectionInstanceList(ReflectionInstance*& out_list, void* instance) const;
 
-            FieldAccessor getFieldByName(const char* name);
-            MethodAccessor getMethodByName(const char* name);
+            FieldAccessor  getFieldByName(const char* name) const;
+            MethodAccessor getMethodByName(const char* name) const;
 
-            bool isValid() { return m_is_valid; }
-
-            TypeMeta& operator=(const TypeMeta& dest);
+            bool isValid() const;
 
         private:
-            TypeMeta(std::string type_name);
+            TypeMeta(const std::string& type_name);
+            TypeMeta(const TypeDescriptor* descriptor);
 
         private:
-            std::vector<FieldAccessor, std::allocator<FieldAccessor>>   m_fields;
-            std::vector<MethodAccessor, std::allocator<MethodAccessor>> m_methods;
-            std::string                                                 m_type_name;
-
-            bool m_is_valid;
+            const TypeDescriptor* m_descriptor {nullptr};
+            // only set when no type of the name was registered
+            std::string m_unregistered_type_name;
         };
 
         class FieldAccessor
         {
             friend class TypeMeta;
+            friend class TypeMetaRegisterinterface;
 
         public:
             FieldAccessor();
 
-            void* get(void* instance);
-            void  set(void* instance, void* value);
+            void* get(void* instance) const;
+            void  set(void* instance, void* value) const;
 
-            TypeMeta getOwnerTypeMeta();
+            TypeMeta getOwnerTypeMeta() const;
 
             /**
              * param: TypeMeta out_type
@@ -170,40 +205,44 @@ namespace Piccolo
              *        true: it's a reflection type
              *        false: it's not a reflection type
              */
-            bool        getTypeMeta(TypeMeta& field_type);
+            bool        getTypeMeta(TypeMeta& field_type) const;
             const char* getFieldName() const;
-            const char* getFieldTypeName();
-            bool        isArrayType();
+            const char* getFieldTypeName() const;
+            bool        isArrayType() const;
 
             FieldAccessor& operator=(const FieldAccessor& dest);
 
         private:
-            FieldAccessor(FieldFunctionTuple* functions);
+            FieldAccessor(const FieldFunctionTuple* functions);
 
         private:
-            FieldFunctionTuple* m_functions;
-            const char*         m_field_name;
-            const char*         m_field_type_name;
+            const FieldFunctionTuple* m_functions;
+            const char*               m_field_name;
+            const char*               m_field_type_name;
+            const TypeDescriptor*     m_owner_type_descriptor {nullptr};
+            const TypeDescriptor*     m_field_type_descriptor {nullptr};
+            bool                      m_is_array {false};
         };
         class MethodAccessor
         {
             friend class TypeMeta;
+            friend class TypeMetaRegisterinterface;
 
         public:
             MethodAccessor();
 
-            void invoke(void* instance);
+            void invoke(void* instance) const;
 
             const char* getMethodName() const;
 
             MethodAccessor& operator=(const MethodAccessor& dest);
 
         private:
-            MethodAccessor(MethodFunctionTuple* functions);
+            MethodAccessor(const MethodFunctionTuple* functions);
 
         private:
-            MethodFunctionTuple* m_functions;
-            const char*          m_method_name;
+            const MethodFunctionTuple* m_functions;
+            const char*                m_method_name;
         };
         /**
          *  Function reflection is not implemented, so use this as an std::vector accessor
@@ -211,25 +250,26 @@ namespace Piccolo
         class ArrayAccessor
         {
             friend class TypeMeta;
+            friend class TypeMetaRegisterinterface;
 
         public:
             ArrayAccessor();
-            const char* getArrayTypeName();
-            const char* getElementTypeName();
-            void        set(int index, void* instance, void* element_value);
+            const char* getArrayTypeName() const;
+            const char* getElementTypeName() const;
+            void        set(int index, void* instance, void* element_value) const;
 
-            void* get(int index, void* instance);
-            int   getSize(void* instance);
+            void* get(int index, void* instance) const;
+            int   getSize(void* instance) const;
 
-            ArrayAccessor& operator=(ArrayAccessor& dest);
+            ArrayAccessor& operator=(const ArrayAccessor& dest);
 
         private:
-            ArrayAccessor(ArrayFunctionTuple* array_func);
+            ArrayAccessor(const ArrayFunctionTuple* array_func);
 
         private:
-            ArrayFunctionTuple* m_func;
-            const char*         m_array_type_name;
-            const char*         m_element_type_name;
+            const ArrayFunctionTuple* m_func;
+            const char*               m_array_type_name;
+            const char*               m_element_type_name;
         };
 
         class ReflectionInstance
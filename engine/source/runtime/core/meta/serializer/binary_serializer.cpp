@@ -0,0 +1,82 @@
+#include "binary_serializer.h"
+
+namespace Piccolo
+{
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const char& instance)
+    {
+        writer.writeScalar(instance);
+    }
+    template<>
+    char& BinarySerializer::read(BinaryReader& reader, char& instance)
+    {
+        return instance = reader.readScalar<char>();
+    }
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const int& instance)
+    {
+        writer.writeScalar(static_cast<int32_t>(instance));
+    }
+    template<>
+    int& BinarySerializer::read(BinaryReader& reader, int& instance)
+    {
+        return instance = static_cast<int>(reader.readScalar<int32_t>());
+    }
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const unsigned int& instance)
+    {
+        writer.writeScalar(static_cast<uint32_t>(instance));
+    }
+    template<>
+    unsigned int& BinarySerializer::read(BinaryReader& reader, unsigned int& instance)
+    {
+        return instance = static_cast<unsigned int>(reader.readScalar<uint32_t>());
+    }
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const float& instance)
+    {
+        writer.writeScalar(instance);
+    }
+    template<>
+    float& BinarySerializer::read(BinaryReader& reader, float& instance)
+    {
+        return instance = reader.readScalar<float>();
+    }
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const double& instance)
+    {
+        writer.writeScalar(instance);
+    }
+    template<>
+    double& BinarySerializer::read(BinaryReader& reader, double& instance)
+    {
+        return instance = reader.readScalar<double>();
+    }
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const bool& instance)
+    {
+        writer.writeScalar(instance);
+    }
+    template<>
+    bool& BinarySerializer::read(BinaryReader& reader, bool& instance)
+    {
+        return instance = reader.readScalar<bool>();
+    }
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const std::string& instance)
+    {
+        writer.writeString(instance);
+    }
+    template<>
+    std::string& BinarySerializer::read(BinaryReader& reader, std::string& instance)
+    {
+        reader.readString(instance);
+        return instance;
+    }
+} // namespace Piccolo
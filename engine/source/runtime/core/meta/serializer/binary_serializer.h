@@ -0,0 +1,360 @@
+#pragma once
+#include "runtime/core/meta/reflection/reflection.h"
+#include "runtime/core/meta/serializer/serializer.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Piccolo
+{
+    // cooked asset layout:
+    //   uint32 magic | uint32 format version | uint32 schema hash | payload
+    // every scalar is little-endian, strings and arrays are prefixed by a uint32 length. a pointer is its type
+    // name followed by the pointee, an empty type name is a null pointer with nothing after it
+    static constexpr uint32_t k_cooked_asset_magic   = 0x42414350; // "PCAB"
+    static constexpr uint32_t k_cooked_asset_version = 2;
+
+    class BinaryWriter
+    {
+    public:
+        template<typename T>
+        void writeScalar(T value)
+        {
+            static_assert(std::is_arithmetic<T>::value, "BinaryWriter::writeScalar<T> only accepts arithmetic types");
+            if constexpr (std::is_same<T, float>::value)
+            {
+                uint32_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                writeLittleEndian(bits);
+            }
+            else if constexpr (std::is_same<T, double>::value)
+            {
+                uint64_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                writeLittleEndian(bits);
+            }
+            else if constexpr (std::is_same<T, bool>::value)
+            {
+                m_buffer.push_back(value ? 1 : 0);
+            }
+            else
+            {
+                writeLittleEndian(static_cast<typename std::make_unsigned<T>::type>(value));
+            }
+        }
+
+        void writeSize(size_t size) { writeScalar(static_cast<uint32_t>(size)); }
+
+        void writeString(const std::string& value)
+        {
+            writeSize(value.size());
+            writeBytes(value.data(), value.size());
+        }
+
+        void writeBytes(const void* data, size_t size)
+        {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+        }
+
+        void fail() { m_is_valid = false; }
+
+        bool isValid() const { return m_is_valid; }
+
+        const std::vector<uint8_t>& getBuffer() const { return m_buffer; }
+
+    private:
+        template<typename T>
+        void writeLittleEndian(T value)
+        {
+            for (size_t i = 0; i < sizeof(T); ++i)
+            {
+                m_buffer.push_back(static_cast<uint8_t>(value >> (i * 8)));
+            }
+        }
+
+        std::vector<uint8_t> m_buffer;
+        bool                 m_is_valid {true};
+    };
+
+    class BinaryReader
+    {
+    public:
+        BinaryReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+        template<typename T>
+        T readScalar()
+        {
+            static_assert(std::is_arithmetic<T>::value, "BinaryReader::readScalar<T> only accepts arithmetic types");
+            if constexpr (std::is_same<T, float>::value)
+            {
+                uint32_t bits = readLittleEndian<uint32_t>();
+                float    value;
+                std::memcpy(&value, &bits, sizeof(value));
+                return value;
+            }
+            else if constexpr (std::is_same<T, double>::value)
+            {
+                uint64_t bits = readLittleEndian<uint64_t>();
+                double   value;
+                std::memcpy(&value, &bits, sizeof(value));
+                return value;
+            }
+            else if constexpr (std::is_same<T, bool>::value)
+            {
+                return readLittleEndian<uint8_t>() != 0;
+            }
+            else
+            {
+                return static_cast<T>(readLittleEndian<typename std::make_unsigned<T>::type>());
+            }
+        }
+
+        // a corrupted length can never be larger than the bytes left, reject it before anything is allocated
+        size_t readSize()
+        {
+            size_t size = readScalar<uint32_t>();
+            if (size > getRemainingSize())
+            {
+                fail();
+                return 0;
+            }
+            return size;
+        }
+
+        void readString(std::string& value)
+        {
+            size_t size = readSize();
+            value.assign(reinterpret_cast<const char*>(m_data + m_offset), size);
+            m_offset += size;
+        }
+
+        bool readBytes(void* out_data, size_t size)
+        {
+            if (size > getRemainingSize())
+            {
+                fail();
+                return false;
+            }
+            std::memcpy(out_data, m_data + m_offset, size);
+            m_offset += size;
+            return true;
+        }
+
+        void fail()
+        {
+            m_is_valid = false;
+            m_offset   = m_size;
+        }
+
+        bool isValid() const { return m_is_valid; }
+
+        size_t getRemainingSize() const { return m_size - m_offset; }
+
+        size_t getAllocationCount() const { return m_allocations.size(); }
+
+        /// remembers the pointer a read has allocated, so a failed read can give everything back. order is the
+        /// allocation count from before the pointee was read, the pointers inside it are tracked after it
+        template<typename T>
+        void trackAllocation(T*& instance, size_t order)
+        {
+            Allocation allocation {&instance, [](void* slot) {
+                                       T*& allocated = *static_cast<T**>(slot);
+                                       delete allocated;
+                                       allocated = nullptr;
+                                   }};
+            m_allocations.insert(m_allocations.begin() + order, allocation);
+        }
+
+        /// deletes every tracked allocation and nulls the pointer it was read into. the newest go first, so a
+        /// member pointer is already null when the object owning it is deleted
+        void releaseAllocations()
+        {
+            for (auto iter = m_allocations.rbegin(); iter != m_allocations.rend(); ++iter)
+            {
+                iter->release(iter->slot);
+            }
+            m_allocations.clear();
+        }
+
+    private:
+        struct Allocation
+        {
+            void* slot;
+            void (*release)(void* slot);
+        };
+
+        template<typename T>
+        T readLittleEndian()
+        {
+            if (sizeof(T) > getRemainingSize())
+            {
+                fail();
+                return 0;
+            }
+            T value = 0;
+            for (size_t i = 0; i < sizeof(T); ++i)
+            {
+                value |= static_cast<T>(static_cast<T>(m_data[m_offset + i]) << (i * 8));
+            }
+            m_offset += sizeof(T);
+            return value;
+        }
+
+        const uint8_t* m_data {nullptr};
+        size_t         m_size {0};
+        size_t         m_offset {0};
+        bool           m_is_valid {true};
+
+        std::vector<Allocation> m_allocations;
+    };
+
+    /// binary counterpart of Serializer, the class specializations are generated by the meta parser
+    /// into all_serializer.ipp next to the json ones and must visit fields in the same order on both sides
+    class BinarySerializer
+    {
+    public:
+        template<typename T>
+        static void writePointer(BinaryWriter& writer, T* instance)
+        {
+            if (instance == nullptr)
+            {
+                writer.writeString(std::string {});
+                return;
+            }
+            writer.writeString("*");
+            BinarySerializer::write(writer, *instance);
+        }
+
+        template<typename T>
+        static T*& readPointer(BinaryReader& reader, T*& instance)
+        {
+            assert(instance == nullptr);
+            std::string type_name;
+            reader.readString(type_name);
+            return readPointerContext(reader, type_name, instance);
+        }
+
+        template<typename T>
+        static void write(BinaryWriter& writer, const Reflection::ReflectionPtr<T>& instance)
+        {
+            T*          instance_ptr = static_cast<T*>(instance.operator->());
+            std::string type_name    = instance.getTypeName();
+            if (instance_ptr == nullptr)
+            {
+                writer.writeString(std::string {});
+                return;
+            }
+            writer.writeString(type_name);
+            if (!Reflection::TypeMeta::writeBinaryByName(type_name, writer, instance_ptr))
+            {
+                writer.fail();
+            }
+        }
+
+        template<typename T>
+        static T*& read(BinaryReader& reader, Reflection::ReflectionPtr<T>& instance)
+        {
+            std::string type_name;
+            reader.readString(type_name);
+            instance.setTypeName(type_name);
+            return readPointerContext(reader, type_name, instance.getPtrReference());
+        }
+
+        template<typename T>
+        static void write(BinaryWriter& writer, const T& instance)
+        {
+            if constexpr (std::is_pointer<T>::value)
+            {
+                writePointer(writer, (T)instance);
+            }
+            else
+            {
+                static_assert(always_false<T>, "BinarySerializer::write<T> has not been implemented yet!");
+            }
+        }
+
+        template<typename T>
+        static T& read(BinaryReader& reader, T& instance)
+        {
+            if constexpr (std::is_pointer<T>::value)
+            {
+                return readPointer(reader, instance);
+            }
+            else
+            {
+                static_assert(always_false<T>, "BinarySerializer::read<T> has not been implemented yet!");
+                return instance;
+            }
+        }
+
+    private:
+        template<typename T>
+        static T*& readPointerContext(BinaryReader& reader, const std::string& type_name, T*& instance)
+        {
+            if (type_name.empty())
+            {
+                return instance;
+            }
+
+            const size_t allocation_order = reader.getAllocationCount();
+            if ('*' == type_name[0])
+            {
+                instance = new T;
+                reader.trackAllocation(instance, allocation_order);
+                read(reader, *instance);
+            }
+            else
+            {
+                instance = static_cast<T*>(Reflection::TypeMeta::newFromNameAndBinary(type_name, reader).m_instance);
+                if (instance == nullptr)
+                {
+                    reader.fail();
+                    return instance;
+                }
+                reader.trackAllocation(instance, allocation_order);
+            }
+            return instance;
+        }
+    };
+
+    // implementation of base types
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const char& instance);
+    template<>
+    char& BinarySerializer::read(BinaryReader& reader, char& instance);
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const int& instance);
+    template<>
+    int& BinarySerializer::read(BinaryReader& reader, int& instance);
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const unsigned int& instance);
+    template<>
+    unsigned int& BinarySerializer::read(BinaryReader& reader, unsigned int& instance);
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const float& instance);
+    template<>
+    float& BinarySerializer::read(BinaryReader& reader, float& instance);
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const double& instance);
+    template<>
+    double& BinarySerializer::read(BinaryReader& reader, double& instance);
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const bool& instance);
+    template<>
+    bool& BinarySerializer::read(BinaryReader& reader, bool& instance);
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const std::string& instance);
+    template<>
+    std::string& BinarySerializer::read(BinaryReader& reader, std::string& instance);
+} // namespace Piccolo
@@ -0,0 +1,478 @@
+#include "json_reader.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace Piccolo
+{
+    namespace
+    {
+        bool isDigit(char ch) { return ch >= '0' && ch <= '9'; }
+
+        void appendUtf8(uint32_t code_point, std::string& out)
+        {
+            if (code_point < 0x80)
+            {
+                out += static_cast<char>(code_point);
+            }
+            else if (code_point < 0x800)
+            {
+                out += static_cast<char>(0xc0 | (code_point >> 6));
+                out += static_cast<char>(0x80 | (code_point & 0x3f));
+            }
+            else if (code_point < 0x10000)
+            {
+                out += static_cast<char>(0xe0 | (code_point >> 12));
+                out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3f));
+                out += static_cast<char>(0x80 | (code_point & 0x3f));
+            }
+            else
+            {
+                out += static_cast<char>(0xf0 | (code_point >> 18));
+                out += static_cast<char>(0x80 | ((code_point >> 12) & 0x3f));
+                out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3f));
+                out += static_cast<char>(0x80 | (code_point & 0x3f));
+            }
+        }
+    } // namespace
+
+    bool JsonReader::beginObject()
+    {
+        skipWhitespace();
+        if (!consume('{'))
+        {
+            skipValue();
+            return false;
+        }
+        m_is_first_value = true;
+        return true;
+    }
+
+    bool JsonReader::nextKey(std::string_view& key)
+    {
+        skipWhitespace();
+        if (!m_is_valid || consume('}'))
+        {
+            m_is_first_value = false;
+            return false;
+        }
+        if (!m_is_first_value)
+        {
+            if (!consume(','))
+            {
+                fail();
+                return false;
+            }
+            skipWhitespace();
+        }
+        m_is_first_value = false;
+
+        if (peek() != '"')
+        {
+            fail();
+            return false;
+        }
+
+        // most keys have no escapes and are viewed in place
+        const char* key_begin = m_data + m_offset + 1;
+        const char* key_end   = static_cast<const char*>(std::memchr(key_begin, '"', m_size - m_offset - 1));
+        if (key_end != nullptr && std::memchr(key_begin, '\\', key_end - key_begin) == nullptr)
+        {
+            key = std::string_view(key_begin, key_end - key_begin);
+            m_offset += (key_end - key_begin) + 2;
+        }
+        else
+        {
+            m_key_buffer.clear();
+            if (!parseString(m_key_buffer))
+            {
+                return false;
+            }
+            key = m_key_buffer;
+        }
+
+        skipWhitespace();
+        if (!consume(':'))
+        {
+            fail();
+            return false;
+        }
+        return true;
+    }
+
+    bool JsonReader::beginArray()
+    {
+        skipWhitespace();
+        if (!consume('['))
+        {
+            skipValue();
+            return false;
+        }
+        m_is_first_value = true;
+        return true;
+    }
+
+    bool JsonReader::nextElement()
+    {
+        skipWhitespace();
+        if (!m_is_valid || consume(']'))
+        {
+            m_is_first_value = false;
+            return false;
+        }
+        if (!m_is_first_value && !consume(','))
+        {
+            fail();
+            return false;
+        }
+        m_is_first_value = false;
+        return true;
+    }
+
+    bool JsonReader::readNull()
+    {
+        skipWhitespace();
+        return peek() == 'n' && consumeLiteral("null", 4);
+    }
+
+    bool JsonReader::readBool(bool& value)
+    {
+        skipWhitespace();
+        if (peek() == 't' && consumeLiteral("true", 4))
+        {
+            value = true;
+            return true;
+        }
+        if (peek() == 'f' && consumeLiteral("false", 5))
+        {
+            value = false;
+            return true;
+        }
+        skipValue();
+        return false;
+    }
+
+    bool JsonReader::readNumber(double& value)
+    {
+        skipWhitespace();
+        const size_t number_begin = m_offset;
+        if (!skipNumber())
+        {
+            skipValue();
+            return false;
+        }
+
+        // strtod needs a terminated copy, the text itself goes on after the number
+        char         number_text[64];
+        const size_t number_size = m_offset - number_begin;
+        if (number_size >= sizeof(number_text))
+        {
+            fail();
+            return false;
+        }
+        std::memcpy(number_text, m_data + number_begin, number_size);
+        number_text[number_size] = '\0';
+        value                    = std::strtod(number_text, nullptr);
+        return true;
+    }
+
+    bool JsonReader::readString(std::string& value)
+    {
+        skipWhitespace();
+        if (peek() != '"')
+        {
+            skipValue();
+            return false;
+        }
+        value.clear();
+        return parseString(value);
+    }
+
+    void JsonReader::skipValue()
+    {
+        skipWhitespace();
+        switch (peek())
+        {
+            case '{':
+            case '[': {
+                // the members are not checked one by one, only strings and the nesting are followed
+                uint32_t depth = 0;
+                while (m_offset < m_size)
+                {
+                    const char ch = m_data[m_offset];
+                    if (ch == '"')
+                    {
+                        m_key_buffer.clear();
+                        if (!parseString(m_key_buffer))
+                        {
+                            return;
+                        }
+                        continue;
+                    }
+
+                    ++m_offset;
+                    if (ch == '{' || ch == '[')
+                    {
+                        ++depth;
+                    }
+                    else if (ch == '}' || ch == ']')
+                    {
+                        if (--depth == 0)
+                        {
+                            return;
+                        }
+                    }
+                }
+                fail();
+                return;
+            }
+            case '"':
+                m_key_buffer.clear();
+                parseString(m_key_buffer);
+                return;
+            case 't':
+                consumeLiteral("true", 4);
+                return;
+            case 'f':
+                consumeLiteral("false", 5);
+                return;
+            case 'n':
+                consumeLiteral("null", 4);
+                return;
+            default:
+                if (!skipNumber())
+                {
+                    fail();
+                }
+                return;
+        }
+    }
+
+    std::string_view JsonReader::skipValueText()
+    {
+        skipWhitespace();
+        const size_t value_begin = m_offset;
+        skipValue();
+        if (!m_is_valid)
+        {
+            return std::string_view();
+        }
+        return std::string_view(m_data + value_begin, m_offset - value_begin);
+    }
+
+    void JsonReader::fail()
+    {
+        m_is_valid = false;
+        m_offset   = m_size;
+    }
+
+    bool JsonReader::isAtEnd()
+    {
+        skipWhitespace();
+        return m_offset == m_size;
+    }
+
+    void JsonReader::skipWhitespace()
+    {
+        while (m_offset < m_size)
+        {
+            const char ch = m_data[m_offset];
+            if (ch != ' ' && ch != '\t' && ch != '\n' && ch != '\r')
+            {
+                return;
+            }
+            ++m_offset;
+        }
+    }
+
+    char JsonReader::peek() { return m_offset < m_size ? m_data[m_offset] : '\0'; }
+
+    bool JsonReader::consume(char ch)
+    {
+        if (peek() == ch)
+        {
+            ++m_offset;
+            return true;
+        }
+        return false;
+    }
+
+    bool JsonReader::consumeLiteral(const char* literal, size_t size)
+    {
+        if (m_size - m_offset < size || std::memcmp(m_data + m_offset, literal, size) != 0)
+        {
+            fail();
+            return false;
+        }
+        m_offset += size;
+        return true;
+    }
+
+    bool JsonReader::parseString(std::string& value)
+    {
+        // skip the opening quote
+        ++m_offset;
+        while (m_offset < m_size)
+        {
+            // copy the run up to the next quote or escape at once
+            size_t run_end = m_offset;
+            while (run_end < m_size && m_data[run_end] != '"' && m_data[run_end] != '\\' &&
+                   static_cast<uint8_t>(m_data[run_end]) >= 0x20)
+            {
+                ++run_end;
+            }
+            value.append(m_data + m_offset, run_end - m_offset);
+            m_offset = run_end;
+            if (m_offset == m_size)
+            {
+                break;
+            }
+
+            const char ch = m_data[m_offset++];
+            if (ch == '"')
+            {
+                return true;
+            }
+            if (ch != '\\' || m_offset == m_size)
+            {
+                // control characters have to be escaped
+                break;
+            }
+
+            const char escaped = m_data[m_offset++];
+            switch (escaped)
+            {
+                case '"':
+                case '\\':
+                case '/':
+                    value += escaped;
+                    break;
+                case 'b':
+                    value += '\b';
+                    break;
+                case 'f':
+                    value += '\f';
+                    break;
+                case 'n':
+                    value += '\n';
+                    break;
+                case 'r':
+                    value += '\r';
+                    break;
+                case 't':
+                    value += '\t';
+                    break;
+                case 'u': {
+                    uint32_t code_point;
+                    if (!parseUnicodeEscape(code_point))
+                    {
+                        fail();
+                        return false;
+                    }
+                    // a high surrogate followed by a low one encodes a code point above the basic plane
+                    if (code_point >= 0xd800 && code_point <= 0xdbff && m_size - m_offset >= 2 &&
+                        m_data[m_offset] == '\\' && m_data[m_offset + 1] == 'u')
+                    {
+                        const size_t low_offset = m_offset;
+                        m_offset += 2;
+                        uint32_t low_surrogate;
+                        if (parseUnicodeEscape(low_surrogate) && low_surrogate >= 0xdc00 && low_surrogate <= 0xdfff)
+                        {
+                            code_point = 0x10000 + ((code_point - 0xd800) << 10) + (low_surrogate - 0xdc00);
+                        }
+                        else
+                        {
+                            m_offset = low_offset;
+                        }
+                    }
+                    appendUtf8(code_point, value);
+                    break;
+                }
+                default:
+                    fail();
+                    return false;
+            }
+        }
+
+        fail();
+        return false;
+    }
+
+    bool JsonReader::parseUnicodeEscape(uint32_t& code_point)
+    {
+        if (m_size - m_offset < 4)
+        {
+            return false;
+        }
+
+        code_point = 0;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            const char ch = m_data[m_offset + i];
+            code_point <<= 4;
+            if (isDigit(ch))
+            {
+                code_point |= ch - '0';
+            }
+            else if (ch >= 'a' && ch <= 'f')
+            {
+                code_point |= ch - 'a' + 10;
+            }
+            else if (ch >= 'A' && ch <= 'F')
+            {
+                code_point |= ch - 'A' + 10;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        m_offset += 4;
+        return true;
+    }
+
+    bool JsonReader::skipNumber()
+    {
+        const size_t number_begin = m_offset;
+        consume('-');
+        if (!isDigit(peek()))
+        {
+            m_offset = number_begin;
+            return false;
+        }
+        while (isDigit(peek()))
+        {
+            ++m_offset;
+        }
+        if (consume('.'))
+        {
+            if (!isDigit(peek()))
+            {
+                fail();
+                return false;
+            }
+            while (isDigit(peek()))
+            {
+                ++m_offset;
+            }
+        }
+        if (peek() == 'e' || peek() == 'E')
+        {
+            ++m_offset;
+            if (peek() == '+' || peek() == '-')
+            {
+                ++m_offset;
+            }
+            if (!isDigit(peek()))
+            {
+                fail();
+                return false;
+            }
+            while (isDigit(peek()))
+            {
+                ++m_offset;
+            }
+        }
+        return true;
+    }
+} // namespace Piccolo
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Piccolo
+{
+    /// pulls json values one token at a time from text in memory, the streaming counterpart of parsing a Json
+    /// tree and reading from it. keys without escapes are returned as views into the text, so reading a
+    /// document allocates nothing but the strings and arrays of the values it fills
+    ///
+    /// a value of an unexpected type is skipped and reported by returning false, a syntax error invalidates the
+    /// reader and makes every further call return false
+    class JsonReader
+    {
+    public:
+        JsonReader(const char* data, size_t size) : m_data(data), m_size(size) {}
+
+        /// enters the object, false if the next value is not one
+        bool beginObject();
+        /// moves to the next member of the current object, false at the end of it. the key stays valid until the
+        /// next call
+        bool nextKey(std::string_view& key);
+
+        /// enters the array, false if the next value is not one
+        bool beginArray();
+        /// moves to the next element of the current array, false at the end of it
+        bool nextElement();
+
+        /// consumes the next value if it is null
+        bool readNull();
+        bool readBool(bool& value);
+        bool readNumber(double& value);
+        bool readString(std::string& value);
+
+        void skipValue();
+        /// skips the next value and returns its text, which can be read again by a reader of its own
+        std::string_view skipValueText();
+
+        void fail();
+        bool isValid() const { return m_is_valid; }
+
+        /// true once the whole text was read, trailing whitespace aside
+        bool isAtEnd();
+
+    private:
+        void skipWhitespace();
+        char peek();
+        bool consume(char ch);
+        bool consumeLiteral(const char* literal, size_t size);
+        bool parseString(std::string& value);
+        bool parseUnicodeEscape(uint32_t& code_point);
+        bool skipNumber();
+
+        const char* m_data {nullptr};
+        size_t      m_size {0};
+        size_t      m_offset {0};
+        bool        m_is_valid {true};
+        // no comma is expected before the first member or element of an object or array
+        bool m_is_first_value {false};
+
+        std::string m_key_buffer;
+    };
+} // namespace Piccolo
@@ -0,0 +1,322 @@
+#include "json_writer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string_view>
+
+namespace Piccolo
+{
+    namespace
+    {
+        // the stream gets the text in chunks of about this size
+        constexpr size_t k_json_writer_buffer_size = 64 * 1024;
+    } // namespace
+
+    JsonWriter::JsonWriter(std::ostream& stream, bool is_pretty) : m_stream(stream), m_is_pretty(is_pretty)
+    {
+        m_buffer.reserve(k_json_writer_buffer_size + 256);
+    }
+
+    JsonWriter::~JsonWriter() { flush(); }
+
+    void JsonWriter::beginObject()
+    {
+        beginValue();
+        m_buffer += '{';
+        beginContainer(true);
+    }
+
+    void JsonWriter::endObject()
+    {
+        endMember();
+        if (!m_containers.empty() && !m_containers.back().m_is_sorted)
+        {
+            sortMembers(m_containers.back());
+        }
+        --m_depth;
+        if (!m_is_first_value)
+        {
+            writeNewLine();
+        }
+        m_buffer += '}';
+        m_is_first_value = false;
+        endContainer();
+    }
+
+    void JsonWriter::beginArray()
+    {
+        beginValue();
+        m_buffer += '[';
+        beginContainer(false);
+    }
+
+    void JsonWriter::endArray()
+    {
+        --m_depth;
+        if (!m_is_first_value)
+        {
+            writeNewLine();
+        }
+        m_buffer += ']';
+        m_is_first_value = false;
+        endContainer();
+    }
+
+    void JsonWriter::writeKey(const char* key)
+    {
+        endMember();
+        beginValue();
+
+        Member member;
+        member.m_begin = m_buffer.size();
+        writeEscapedString(key);
+        member.m_key_end = m_buffer.size();
+        member.m_end     = m_buffer.size();
+        m_buffer += ": ";
+        m_is_after_key = true;
+
+        if (!m_containers.empty())
+        {
+            Container& object = m_containers.back();
+            if (m_members.size() > object.m_first_member && !isKeyLess(m_members.back(), member))
+            {
+                object.m_is_sorted = false;
+            }
+            m_members.push_back(member);
+        }
+    }
+
+    void JsonWriter::writeNull()
+    {
+        beginValue();
+        m_buffer += "null";
+    }
+
+    void JsonWriter::writeBool(bool value)
+    {
+        beginValue();
+        m_buffer += value ? "true" : "false";
+    }
+
+    void JsonWriter::writeInt(int value)
+    {
+        beginValue();
+        char text[16];
+        std::snprintf(text, sizeof(text), "%d", value);
+        m_buffer += text;
+    }
+
+    void JsonWriter::writeFloat(float value)
+    {
+        // the tree stores floats as doubles, their digits are what the tree dump gives
+        writeDouble(static_cast<double>(value));
+    }
+
+    void JsonWriter::writeDouble(double value)
+    {
+        if (!std::isfinite(value))
+        {
+            writeNull();
+            return;
+        }
+        beginValue();
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.17g", value);
+        m_buffer += text;
+    }
+
+    void JsonWriter::writeString(const std::string& value)
+    {
+        beginValue();
+        writeEscapedString(value);
+    }
+
+    void JsonWriter::writeJson(const Json& value)
+    {
+        beginValue();
+        value.dump(m_buffer);
+    }
+
+    void JsonWriter::flush()
+    {
+        if (m_buffer.empty())
+        {
+            return;
+        }
+        if (m_is_valid)
+        {
+            m_stream.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+            m_is_valid = static_cast<bool>(m_stream);
+        }
+        m_buffer.clear();
+    }
+
+    void JsonWriter::beginValue()
+    {
+        // the members of an open object may still move
+        if (m_buffer.size() >= k_json_writer_buffer_size && m_open_object_count == 0)
+        {
+            flush();
+        }
+
+        if (m_is_after_key)
+        {
+            m_is_after_key = false;
+            return;
+        }
+        if (!m_is_first_value)
+        {
+            m_buffer += m_is_pretty ? "," : ", ";
+        }
+        if (m_depth > 0)
+        {
+            writeNewLine();
+        }
+        m_is_first_value = false;
+    }
+
+    void JsonWriter::beginContainer(bool is_object)
+    {
+        m_containers.push_back(Container {is_object, m_members.size(), true});
+        if (is_object)
+        {
+            ++m_open_object_count;
+        }
+        ++m_depth;
+        m_is_first_value = true;
+    }
+
+    void JsonWriter::endContainer()
+    {
+        if (m_containers.empty())
+        {
+            return;
+        }
+        if (m_containers.back().m_is_object)
+        {
+            --m_open_object_count;
+        }
+        m_members.resize(m_containers.back().m_first_member);
+        m_containers.pop_back();
+    }
+
+    void JsonWriter::endMember()
+    {
+        if (!m_containers.empty() && m_containers.back().m_is_object &&
+            m_members.size() > m_containers.back().m_first_member)
+        {
+            m_members.back().m_end = m_buffer.size();
+        }
+    }
+
+    void JsonWriter::sortMembers(const Container& object)
+    {
+        std::vector<Member> members(m_members.begin() + object.m_first_member, m_members.end());
+        std::stable_sort(members.begin(), members.end(), [this](const Member& lhs, const Member& rhs) {
+            return isKeyLess(lhs, rhs);
+        });
+
+        // the members are still on the lines of the open object, m_depth is its inner depth
+        std::string separator = m_is_pretty ? "," : ", ";
+        if (m_is_pretty)
+        {
+            separator += '\n';
+            separator.append(m_depth * 4, ' ');
+        }
+
+        const size_t text_begin = m_members[object.m_first_member].m_begin;
+        const size_t text_end   = m_members.back().m_end;
+        std::string  sorted_text;
+        sorted_text.reserve(text_end - text_begin);
+        for (size_t member_index = 0; member_index < members.size(); ++member_index)
+        {
+            // equal keys stay in write order, the last one wins
+            const Member& member = members[member_index];
+            if (member_index + 1 < members.size() && !isKeyLess(member, members[member_index + 1]))
+            {
+                continue;
+            }
+            if (!sorted_text.empty())
+            {
+                sorted_text += separator;
+            }
+            sorted_text.append(m_buffer, member.m_begin, member.m_end - member.m_begin);
+        }
+        m_buffer.replace(text_begin, text_end - text_begin, sorted_text);
+    }
+
+    bool JsonWriter::isKeyLess(const Member& lhs, const Member& rhs) const
+    {
+        // without the quotes, a key has to sort before the longer keys it is a prefix of
+        const std::string_view buffer(m_buffer);
+        return buffer.substr(lhs.m_begin + 1, lhs.m_key_end - lhs.m_begin - 2) <
+               buffer.substr(rhs.m_begin + 1, rhs.m_key_end - rhs.m_begin - 2);
+    }
+
+    void JsonWriter::writeNewLine()
+    {
+        if (!m_is_pretty)
+        {
+            return;
+        }
+        m_buffer += '\n';
+        m_buffer.append(m_depth * 4, ' ');
+    }
+
+    void JsonWriter::writeEscapedString(const std::string& value)
+    {
+        // same escaping as json11
+        m_buffer += '"';
+        for (size_t i = 0; i < value.length(); ++i)
+        {
+            const char ch = value[i];
+            if (ch == '\\')
+            {
+                m_buffer += "\\\\";
+            }
+            else if (ch == '"')
+            {
+                m_buffer += "\\\"";
+            }
+            else if (ch == '\b')
+            {
+                m_buffer += "\\b";
+            }
+            else if (ch == '\f')
+            {
+                m_buffer += "\\f";
+            }
+            else if (ch == '\n')
+            {
+                m_buffer += "\\n";
+            }
+            else if (ch == '\r')
+            {
+                m_buffer += "\\r";
+            }
+            else if (ch == '\t')
+            {
+                m_buffer += "\\t";
+            }
+            else if (static_cast<uint8_t>(ch) <= 0x1f)
+            {
+                char text[8];
+                std::snprintf(text, sizeof(text), "\\u%04x", ch);
+                m_buffer += text;
+            }
+            else if (static_cast<uint8_t>(ch) == 0xe2 && i + 2 < value.length() &&
+                     static_cast<uint8_t>(value[i + 1]) == 0x80 &&
+                     (static_cast<uint8_t>(value[i + 2]) == 0xa8 || static_cast<uint8_t>(value[i + 2]) == 0xa9))
+            {
+                m_buffer += static_cast<uint8_t>(value[i + 2]) == 0xa8 ? "\\u2028" : "\\u2029";
+                i += 2;
+            }
+            else
+            {
+                m_buffer += ch;
+            }
+        }
+        m_buffer += '"';
+    }
+} // namespace Piccolo
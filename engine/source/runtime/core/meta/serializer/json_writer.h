@@ -0,0 +1,88 @@
+#pragma once
+#include "runtime/core/meta/json.h"
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Piccolo
+{
+    /// writes json text token by token into a stream, the streaming counterpart of building a Json tree and
+    /// dumping it. the text is collected in a buffer that is handed to the stream whenever it fills up
+    ///
+    /// compact output is the text Json::dump gives for the same document, pretty output puts every member on its own
+    /// line. so both match the tree, the members of an object are sorted by key when the object ends and a later
+    /// member replaces an earlier one of the same key. the text of an open object stays in the buffer until it ends
+    class JsonWriter
+    {
+    public:
+        JsonWriter(std::ostream& stream, bool is_pretty);
+        ~JsonWriter();
+
+        JsonWriter(const JsonWriter&) = delete;
+        JsonWriter& operator=(const JsonWriter&) = delete;
+
+        void beginObject();
+        void endObject();
+        void beginArray();
+        void endArray();
+
+        /// the next value written is the value of this member
+        void writeKey(const char* key);
+
+        void writeNull();
+        void writeBool(bool value);
+        void writeInt(int value);
+        void writeFloat(float value);
+        void writeDouble(double value);
+        void writeString(const std::string& value);
+        /// a value that was already built as a tree
+        void writeJson(const Json& value);
+
+        /// hands the buffered text to the stream
+        void flush();
+
+        /// false once the stream failed
+        bool isValid() const { return m_is_valid; }
+
+    private:
+        struct Container
+        {
+            bool   m_is_object;
+            size_t m_first_member;
+            bool   m_is_sorted;
+        };
+
+        // a member of an open object, from the quote opening its key to the end of its value
+        struct Member
+        {
+            size_t m_begin;
+            size_t m_key_end;
+            size_t m_end;
+        };
+
+        void beginValue();
+        void beginContainer(bool is_object);
+        void endContainer();
+        void endMember();
+        void sortMembers(const Container& object);
+        bool isKeyLess(const Member& lhs, const Member& rhs) const;
+        void writeNewLine();
+        void writeEscapedString(const std::string& value);
+
+        std::ostream& m_stream;
+        std::string   m_buffer;
+        bool          m_is_pretty {false};
+        bool          m_is_valid {true};
+
+        uint32_t m_depth {0};
+        // no comma goes before the first value of an object or array, nor before the value of a member
+        bool m_is_first_value {true};
+        bool m_is_after_key {false};
+
+        std::vector<Container> m_containers;
+        std::vector<Member>    m_members;
+        size_t                 m_open_object_count {0};
+    };
+} // namespace Piccolo
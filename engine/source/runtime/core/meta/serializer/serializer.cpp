@@ -87,6 +87,101 @@ namespace Piccolo
         return instance = json_context.string_value();
     }
 
+    template<>
+    void Serializer::write(JsonWriter& writer, const char& instance)
+    {
+        writer.writeInt(instance);
+    }
+    template<>
+    void Serializer::write(JsonWriter& writer, const int& instance)
+    {
+        writer.writeInt(instance);
+    }
+    template<>
+    void Serializer::write(JsonWriter& writer, const unsigned int& instance)
+    {
+        writer.writeInt(static_cast<int>(instance));
+    }
+    template<>
+    void Serializer::write(JsonWriter& writer, const float& instance)
+    {
+        writer.writeFloat(instance);
+    }
+    template<>
+    void Serializer::write(JsonWriter& writer, const double& instance)
+    {
+        writer.writeDouble(instance);
+    }
+    template<>
+    void Serializer::write(JsonWriter& writer, const bool& instance)
+    {
+        writer.writeBool(instance);
+    }
+    template<>
+    void Serializer::write(JsonWriter& writer, const std::string& instance)
+    {
+        writer.writeString(instance);
+    }
+
+    template<>
+    char& Serializer::read(JsonReader& reader, char& instance)
+    {
+        double value;
+        if (reader.readNumber(value))
+        {
+            instance = static_cast<char>(value);
+        }
+        return instance;
+    }
+    template<>
+    int& Serializer::read(JsonReader& reader, int& instance)
+    {
+        double value;
+        if (reader.readNumber(value))
+        {
+            instance = static_cast<int>(value);
+        }
+        return instance;
+    }
+    template<>
+    unsigned int& Serializer::read(JsonReader& reader, unsigned int& instance)
+    {
+        double value;
+        if (reader.readNumber(value))
+        {
+            instance = static_cast<unsigned int>(value);
+        }
+        return instance;
+    }
+    template<>
+    float& Serializer::read(JsonReader& reader, float& instance)
+    {
+        double value;
+        if (reader.readNumber(value))
+        {
+            instance = static_cast<float>(value);
+        }
+        return instance;
+    }
+    template<>
+    double& Serializer::read(JsonReader& reader, double& instance)
+    {
+        reader.readNumber(instance);
+        return instance;
+    }
+    template<>
+    bool& Serializer::read(JsonReader& reader, bool& instance)
+    {
+        reader.readBool(instance);
+        return instance;
+    }
+    template<>
+    std::string& Serializer::read(JsonReader& reader, std::string& instance)
+    {
+        reader.readString(instance);
+        return instance;
+    }
+
     // template<>
     // Json Serializer::write(const Reflection::object& instance)
     //{
@@ -1,8 +1,11 @@
 #pragma once
 #include "runtime/core/meta/json.h"
 #include "runtime/core/meta/reflection/reflection.h"
+#include "runtime/core/meta/serializer/json_reader.h"
+#include "runtime/core/meta/serializer/json_writer.h"
 
 #include <cassert>
+#include <string_view>
 
 namespace Piccolo
 {
@@ -82,6 +85,155 @@ namespace Piccolo
                 return instance;
             }
         }
+
+        // streaming counterparts of the writes above, they produce the same document without building a Json tree.
+        // the class specializations are generated next to the tree ones
+
+        template<typename T>
+        static void writePointer(JsonWriter& writer, T* instance)
+        {
+            writer.beginObject();
+            writer.writeKey("$typeName");
+            writer.writeString("*");
+            writer.writeKey("$context");
+            Serializer::write(writer, *instance);
+            writer.endObject();
+        }
+
+        template<typename T>
+        static void write(JsonWriter& writer, const Reflection::ReflectionPtr<T>& instance)
+        {
+            T*                 instance_ptr = static_cast<T*>(instance.operator->());
+            const std::string& type_name    = instance.getTypeName();
+            writer.beginObject();
+            writer.writeKey("$typeName");
+            writer.writeString(type_name);
+            writer.writeKey("$context");
+            if (!Reflection::TypeMeta::writeByName(type_name, writer, instance_ptr))
+            {
+                writer.writeNull();
+            }
+            writer.endObject();
+        }
+
+        template<typename T>
+        static void write(JsonWriter& writer, const T& instance)
+        {
+            if constexpr (std::is_pointer<T>::value)
+            {
+                writePointer(writer, (T)instance);
+            }
+            else
+            {
+                static_assert(always_false<T>, "Serializer::write<T> has not been implemented yet!");
+            }
+        }
+
+        /// the members of a class without the braces around them, derived classes write the members of their
+        /// bases into their own object
+        template<typename T>
+        static void writeFields(JsonWriter& writer, const T& instance)
+        {
+            static_assert(always_false<T>, "Serializer::writeFields<T> has not been implemented yet!");
+        }
+
+        // streaming counterparts of the reads above, they fill the instance straight from the text. a value of
+        // another type than expected is skipped and leaves the member as it was, like a missing member does
+
+        template<typename T>
+        static T*& readPointer(JsonReader& reader, T*& instance)
+        {
+            std::string type_name;
+            return readPointer(reader, instance, type_name);
+        }
+
+        template<typename T>
+        static T*& readPointer(JsonReader& reader, T*& instance, std::string& type_name)
+        {
+            assert(instance == nullptr);
+            if (!reader.beginObject())
+            {
+                return instance;
+            }
+
+            // written json sorts the keys, so "$context" comes before the type it has to be read as
+            std::string_view context_text;
+            std::string_view key;
+            while (reader.nextKey(key))
+            {
+                if (key == "$typeName")
+                {
+                    reader.readString(type_name);
+                }
+                else if (key == "$context" && !type_name.empty())
+                {
+                    readPointerContext(reader, instance, type_name);
+                }
+                else if (key == "$context")
+                {
+                    context_text = reader.skipValueText();
+                }
+                else
+                {
+                    reader.skipValue();
+                }
+            }
+
+            if (instance == nullptr && !context_text.empty() && !type_name.empty())
+            {
+                JsonReader context_reader(context_text.data(), context_text.size());
+                readPointerContext(context_reader, instance, type_name);
+            }
+            return instance;
+        }
+
+        template<typename T>
+        static T*& read(JsonReader& reader, Reflection::ReflectionPtr<T>& instance)
+        {
+            std::string type_name;
+            readPointer(reader, instance.getPtrReference(), type_name);
+            instance.setTypeName(type_name);
+            return instance.getPtrReference();
+        }
+
+        template<typename T>
+        static T& read(JsonReader& reader, T& instance)
+        {
+            if constexpr (std::is_pointer<T>::value)
+            {
+                return readPointer(reader, instance);
+            }
+            else
+            {
+                static_assert(always_false<T>, "Serializer::read<T> has not been implemented yet!");
+                return instance;
+            }
+        }
+
+        /// reads the value of the member named key, false if the class and its bases have no such member and the
+        /// value is still to be consumed
+        template<typename T>
+        static bool readField(JsonReader& reader, std::string_view key, T& instance)
+        {
+            static_assert(always_false<T>, "Serializer::readField<T> has not been implemented yet!");
+            return false;
+        }
+
+    private:
+        template<typename T>
+        static void readPointerContext(JsonReader& reader, T*& instance, const std::string& type_name)
+        {
+            if ('*' == type_name[0])
+            {
+                instance = new T;
+                read(reader, *instance);
+            }
+            else
+            {
+                instance = static_cast<T*>(
+                    Reflection::TypeMeta::newFromNameAndJsonReader(type_name, reader).m_instance);
+            }
+        }
     };
 
     // implementation of base types
@@ -120,6 +272,36 @@ namespace Piccolo
     template<>
     std::string& Serializer::read(const Json& json_context, std::string& instance);
 
+    template<>
+    void Serializer::write(JsonWriter& writer, const char& instance);
+    template<>
+    void Serializer::write(JsonWriter& writer, const int& instance);
+    template<>
+    void Serializer::write(JsonWriter& writer, const unsigned int& instance);
+    template<>
+    void Serializer::write(JsonWriter& writer, const float& instance);
+    template<>
+    void Serializer::write(JsonWriter& writer, const double& instance);
+    template<>
+    void Serializer::write(JsonWriter& writer, const bool& instance);
+    template<>
+    void Serializer::write(JsonWriter& writer, const std::string& instance);
+
+    template<>
+    char& Serializer::read(JsonReader& reader, char& instance);
+    template<>
+    int& Serializer::read(JsonReader& reader, int& instance);
+    template<>
+    unsigned int& Serializer::read(JsonReader& reader, unsigned int& instance);
+    template<>
+    float& Serializer::read(JsonReader& reader, float& instance);
+    template<>
+    double& Serializer::read(JsonReader& reader, double& instance);
+    template<>
+    bool& Serializer::read(JsonReader& reader, bool& instance);
+    template<>
+    std::string& Serializer::read(JsonReader& reader, std::string& instance);
+
     // template<>
     // Json Serializer::write(const Reflection::object& instance);
     // template<>
@@ -3,6 +3,7 @@
 #include "runtime/core/base/macro.h"
 #include "runtime/core/meta/reflection/reflection_register.h"
 
+#include "runtime/function/framework/component/lua/lua_script_manager.h"
 #include "runtime/function/framework/world/world_manager.h"
 #include "runtime/function/global/global_context.h"
 #include "runtime/function/input/input_system.h"
@@ -103,9 +104,15 @@ namespace Piccolo
         //处理和检查来自操作系统的所有窗口事件 （鼠标点击、键盘按键等）
         g_runtime_global_context.m_window_system->pollEvents();
 
-        //在窗口上显示帧数
-        g_runtime_global_context.m_window_system->setTitle(
-            std::string("Piccolo - " + std::to_string(getFPS()) + " FPS").c_str());
+        //在窗口上显示帧数，后台加载关卡时同时显示加载进度
+        std::string title = "Piccolo - " + std::to_string(getFPS()) + " FPS";
+        if (g_runtime_global_context.m_world_manager->isLevelLoading())
+        {
+            const int loading_percent =
+                static_cast<int>(g_runtime_global_context.m_world_manager->getLevelLoadingProgress() * 100.f);
+            title += " - Loading " + std::to_string(loading_percent) + "%";
+        }
+        g_runtime_global_context.m_window_system->setTitle(title.c_str());
 
         //返回 !(窗口是否关闭)
         const bool should_window_close = g_runtime_global_context.m_window_system->shouldClose();
@@ -115,7 +122,9 @@ namespace Piccolo
     void PiccoloEngine::logicalTick(float delta_time)
     {
         //更新世界
+        g_runtime_global_context.m_lua_script_manager->tick();
         g_runtime_global_context.m_world_manager->tick(delta_time);
+        g_runtime_global_context.m_lua_script_manager->finishFrame();
         //更新输入系统
         g_runtime_global_context.m_input_system->tick();
     }
@@ -5,124 +5,119 @@
 #include "runtime/function/animation/animation_loader.h"
 #include "runtime/function/animation/skeleton.h"
 
+#include <algorithm>
+
 namespace Piccolo
 {
     std::map<std::string, std::shared_ptr<SkeletonData>>  AnimationManager::m_skeleton_definition_cache;
     std::map<std::string, std::shared_ptr<AnimationClip>> AnimationManager::m_animation_data_cache;
     std::map<std::string, std::shared_ptr<AnimSkelMap>>   AnimationManager::m_animation_skeleton_map_cache;
     std::map<std::string, std::shared_ptr<BoneBlendMask>> AnimationManager::m_skeleton_mask_cache;
+    std::mutex                                            AnimationManager::m_cache_mutex;
+
+    std::map<std::string, std::shared_ptr<const BlendStateWithClipHandles>> AnimationManager::m_blend_state_cache;
 
     std::shared_ptr<SkeletonData> AnimationManager::tryLoadSkeleton(std::string file_path)
     {
-        std::shared_ptr<SkeletonData> res;
-        AnimationLoader               loader;
-        auto                          found = m_skeleton_definition_cache.find(file_path);
-        if (found == m_skeleton_definition_cache.end())
-        {
-            res = loader.loadSkeletonData(file_path);
-            m_skeleton_definition_cache.emplace(file_path, res);
-        }
-        else
-        {
-            res = found->second;
-        }
-        return res;
+        return findOrLoad(m_skeleton_definition_cache, file_path, [](const std::string& path) {
+            return AnimationLoader().loadSkeletonData(path);
+        });
     }
 
     std::shared_ptr<AnimationClip> AnimationManager::tryLoadAnimation(std::string file_path)
     {
-        std::shared_ptr<AnimationClip> res;
-        AnimationLoader                loader;
-        auto                           found = m_animation_data_cache.find(file_path);
-        if (found == m_animation_data_cache.end())
-        {
-            res = loader.loadAnimationClipData(file_path);
-            m_animation_data_cache.emplace(file_path, res);
-        }
-        else
-        {
-            res = found->second;
-        }
-        return res;
+        return findOrLoad(m_animation_data_cache, file_path, [](const std::string& path) {
+            return AnimationLoader().loadAnimationClipData(path);
+        });
     }
 
     std::shared_ptr<AnimSkelMap> AnimationManager::tryLoadAnimationSkeletonMap(std::string file_path)
     {
-        std::shared_ptr<AnimSkelMap> res;
-        AnimationLoader              loader;
-        auto                         found = m_animation_skeleton_map_cache.find(file_path);
-        if (found == m_animation_skeleton_map_cache.end())
-        {
-            res = loader.loadAnimSkelMap(file_path);
-            m_animation_skeleton_map_cache.emplace(file_path, res);
-        }
-        else
-        {
-            res = found->second;
-        }
-        return res;
+        return findOrLoad(m_animation_skeleton_map_cache, file_path, [](const std::string& path) {
+            return AnimationLoader().loadAnimSkelMap(path);
+        });
     }
 
     std::shared_ptr<BoneBlendMask> AnimationManager::tryLoadSkeletonMask(std::string file_path)
     {
-        std::shared_ptr<BoneBlendMask> res;
-        AnimationLoader                loader;
-        auto                           found = m_skeleton_mask_cache.find(file_path);
-        if (found == m_skeleton_mask_cache.end())
+        return findOrLoad(m_skeleton_mask_cache, file_path, [](const std::string& path) {
+            return AnimationLoader().loadSkeletonMask(path);
+        });
+    }
+
+    std::shared_ptr<const BlendStateWithClipHandles>
+    AnimationManager::getBlendStateWithClipHandles(const BlendState& blend_state)
+    {
+        std::string blend_state_key;
+        for (const auto& iter : blend_state.blend_clip_file_path)
         {
-            res = loader.loadSkeletonMask(file_path);
-            m_skeleton_mask_cache.emplace(file_path, res);
+            blend_state_key += iter + ";";
         }
-        else
+        for (const auto& iter : blend_state.blend_anim_skel_map_path)
         {
-            res = found->second;
+            blend_state_key += iter + ";";
         }
-        return res;
-    }
-
-    BlendStateWithClipData AnimationManager::getBlendStateWithClipData(const BlendState& blend_state)
-    {
-
-        for (auto animation_file_path : blend_state.blend_clip_file_path)
+        for (const auto& iter : blend_state.blend_mask_file_path)
         {
-            tryLoadAnimation(animation_file_path);
+            blend_state_key += iter + ";";
         }
-        for (auto anim_skel_map_path : blend_state.blend_anim_skel_map_path)
+        for (float weight : blend_state.blend_weight)
         {
-            tryLoadAnimationSkeletonMap(anim_skel_map_path);
+            blend_state_key += std::to_string(weight) + ";";
         }
-        for (auto skeleton_mask_path : blend_state.blend_mask_file_path)
+
         {
-            tryLoadSkeletonMask(skeleton_mask_path);
+            std::lock_guard<std::mutex> lock(m_cache_mutex);
+            auto                        found = m_blend_state_cache.find(blend_state_key);
+            if (found != m_blend_state_cache.end())
+            {
+                return found->second;
+            }
         }
 
-        BlendStateWithClipData blend_state_with_clip_data;
-        blend_state_with_clip_data.clip_count  = blend_state.clip_count;
-        blend_state_with_clip_data.blend_ratio = blend_state.blend_ratio;
+        // built outside the lock, the tryLoad functions below lock the caches themselves
+        std::shared_ptr<BlendStateWithClipHandles> blend_state_with_clip_handles =
+            std::make_shared<BlendStateWithClipHandles>();
+        blend_state_with_clip_handles->clip_count = blend_state.clip_count;
+
+        float clip_weight_sum = 0;
+        for (float weight : blend_state.blend_weight)
+        {
+            clip_weight_sum += weight;
+        }
+        for (float weight : blend_state.blend_weight)
+        {
+            const float clip_weight = fabs(clip_weight_sum) < 0.0001f ? 0 : weight / clip_weight_sum;
+            blend_state_with_clip_handles->clip_weight.push_back(clip_weight);
+        }
         for (const auto& iter : blend_state.blend_clip_file_path)
         {
-            blend_state_with_clip_data.blend_clip.push_back(*m_animation_data_cache[iter]);
+            blend_state_with_clip_handles->blend_clip.push_back(tryLoadAnimation(iter));
         }
         for (const auto& iter : blend_state.blend_anim_skel_map_path)
         {
-            blend_state_with_clip_data.blend_anim_skel_map.push_back(*m_animation_skeleton_map_cache[iter]);
+            blend_state_with_clip_handles->blend_anim_skel_map.push_back(tryLoadAnimationSkeletonMap(iter));
         }
         std::vector<std::shared_ptr<BoneBlendMask>> blend_masks;
         for (auto& iter : blend_state.blend_mask_file_path)
         {
-            blend_masks.push_back(m_skeleton_mask_cache[iter]);
-            tryLoadAnimationSkeletonMap(m_skeleton_mask_cache[iter]->skeleton_file_path);
+            blend_masks.push_back(tryLoadSkeletonMask(iter));
+            tryLoadAnimationSkeletonMap(blend_masks.back()->skeleton_file_path);
         }
-        size_t skeleton_bone_count = m_skeleton_definition_cache[blend_masks[0]->skeleton_file_path]->bones_map.size();
-        blend_state_with_clip_data.blend_weight.resize(blend_state.clip_count);
-        for (size_t clip_index = 0; clip_index < blend_state.clip_count; clip_index++)
+        // without a mask for every clip the clip weights apply to all bones
+        const size_t clip_count = static_cast<size_t>(std::max(blend_state.clip_count, 0));
+        const bool   has_masks  = !blend_masks.empty() && blend_masks.size() >= clip_count;
+        const size_t skeleton_bone_count =
+            has_masks ? tryLoadSkeleton(blend_masks[0]->skeleton_file_path)->bones_map.size() : 0;
+        blend_state_with_clip_handles->blend_weight.resize(clip_count);
+        for (size_t clip_index = 0; clip_index < clip_count; clip_index++)
         {
-            blend_state_with_clip_data.blend_weight[clip_index].blend_weight.resize(skeleton_bone_count);
+            blend_state_with_clip_handles->blend_weight[clip_index].blend_weight.resize(skeleton_bone_count);
         }
         for (size_t bone_index = 0; bone_index < skeleton_bone_count; bone_index++)
         {
             float sum_weight = 0;
-            for (size_t clip_index = 0; clip_index < blend_state.clip_count; clip_index++)
+            for (size_t clip_index = 0; clip_index < clip_count; clip_index++)
             {
                 if (blend_masks[clip_index]->enabled[bone_index])
                 {
@@ -131,22 +126,26 @@ namespace Piccolo
             }
             if (fabs(sum_weight) < 0.0001f)
             {
-                // LOG_ERROR
+                // no clip drives this bone, it keeps its bind pose
+                continue;
             }
-            for (size_t clip_index = 0; clip_index < blend_state.clip_count; clip_index++)
+            for (size_t clip_index = 0; clip_index < clip_count; clip_index++)
             {
                 if (blend_masks[clip_index]->enabled[bone_index])
                 {
 
-                    blend_state_with_clip_data.blend_weight[clip_index].blend_weight[bone_index] =
+                    blend_state_with_clip_handles->blend_weight[clip_index].blend_weight[bone_index] =
                         blend_state.blend_weight[clip_index] / sum_weight;
                 }
                 else
                 {
-                    blend_state_with_clip_data.blend_weight[clip_index].blend_weight[bone_index] = 0;
+                    blend_state_with_clip_handles->blend_weight[clip_index].blend_weight[bone_index] = 0;
                 }
             }
         }
-        return blend_state_with_clip_data;
+
+        // another component may have resolved the same blend state meanwhile, everybody shares the first one
+        std::lock_guard<std::mutex> lock(m_cache_mutex);
+        return m_blend_state_cache.emplace(blend_state_key, blend_state_with_clip_handles).first->second;
     }
 } // namespace Piccolo
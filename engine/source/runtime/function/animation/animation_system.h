@@ -8,10 +8,25 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace Piccolo
 {
+    /// clips, skeleton maps and per-bone blend weights of a BlendState, resolved once and shared by every component
+    /// with the same blend setup. the clips are the cached ones, nothing here is copied per frame
+    struct BlendStateWithClipHandles
+    {
+        int                                               clip_count {0};
+        std::vector<std::shared_ptr<const AnimationClip>> blend_clip;
+        std::vector<std::shared_ptr<const AnimSkelMap>>   blend_anim_skel_map;
+        // per-bone weights of every clip after masking, empty without masks
+        std::vector<BoneBlendWeight> blend_weight;
+        // weights of every clip normalized to a sum of one, used for all bones when there are no masks
+        std::vector<float> clip_weight;
+    };
+
     class AnimationManager
     {
     private:
@@ -19,13 +34,42 @@ namespace Piccolo
         static std::map<std::string, std::shared_ptr<AnimationClip>> m_animation_data_cache;
         static std::map<std::string, std::shared_ptr<AnimSkelMap>>   m_animation_skeleton_map_cache;
         static std::map<std::string, std::shared_ptr<BoneBlendMask>> m_skeleton_mask_cache;
+        // keyed by the clip, map and mask paths and the weights of a BlendState
+        static std::map<std::string, std::shared_ptr<const BlendStateWithClipHandles>> m_blend_state_cache;
+        // guards all caches, animation components may tick concurrently
+        static std::mutex m_cache_mutex;
+
+        /// the file of a cache miss is read outside the lock, so a slow load does not stall the other components.
+        /// when two threads load the same file at once the first result is kept and the other one dropped
+        template<typename TData, typename TLoadFunction>
+        static std::shared_ptr<TData> findOrLoad(std::map<std::string, std::shared_ptr<TData>>& cache,
+                                                 const std::string&                             file_path,
+                                                 TLoadFunction                                  load_function)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_cache_mutex);
+                auto                        found = cache.find(file_path);
+                if (found != cache.end())
+                {
+                    return found->second;
+                }
+            }
+
+            std::shared_ptr<TData> res = load_function(file_path);
+
+            std::lock_guard<std::mutex> lock(m_cache_mutex);
+            return cache.emplace(file_path, std::move(res)).first->second;
+        }
 
     public:
         static std::shared_ptr<SkeletonData>  tryLoadSkeleton(std::string file_path);
         static std::shared_ptr<AnimationClip> tryLoadAnimation(std::string file_path);
         static std::shared_ptr<AnimSkelMap>   tryLoadAnimationSkeletonMap(std::string file_path);
         static std::shared_ptr<BoneBlendMask> tryLoadSkeletonMask(std::string file_path);
-        static BlendStateWithClipData         getBlendStateWithClipData(const BlendState& blend_state);
+
+        /// the blend ratios are not part of the result, they change every frame and are passed to the skeleton
+        static std::shared_ptr<const BlendStateWithClipHandles>
+        getBlendStateWithClipHandles(const BlendState& blend_state);
 
         AnimationManager() = default;
     };
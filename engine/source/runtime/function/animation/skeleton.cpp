@@ -2,10 +2,34 @@
 
 #include "runtime/core/math/math.h"
 
+#include "runtime/function/animation/animation_system.h"
 #include "runtime/function/animation/utilities.h"
 
+#include <algorithm>
+
 namespace Piccolo
 {
+    namespace
+    {
+        constexpr uint32_t k_lane_count = SimdFloat4::k_lane_count;
+
+        SimdFloat4 gatherLanes(const std::vector<float>& values, const uint32_t* bone_indices)
+        {
+            return SimdFloat4::set(
+                values[bone_indices[0]], values[bone_indices[1]], values[bone_indices[2]], values[bone_indices[3]]);
+        }
+
+        void scatterLanes(std::vector<float>& values, const uint32_t* bone_indices, const SimdFloat4& lanes)
+        {
+            float lane_values[k_lane_count];
+            lanes.store(lane_values);
+            for (uint32_t lane = 0; lane < k_lane_count; ++lane)
+            {
+                values[bone_indices[lane]] = lane_values[lane];
+            }
+        }
+    } // namespace
+
     Skeleton::~Skeleton() { delete[] m_bones; }
 
     void Skeleton::resetSkeleton()
@@ -20,6 +44,8 @@ namespace Piccolo
         if (m_bones != nullptr)
         {
             delete[] m_bones;
+            m_bones      = nullptr;
+            m_bone_count = 0;
         }
         if (!m_is_flat || !skeleton_definition.in_topological_order)
         {
@@ -28,131 +54,290 @@ namespace Piccolo
         }
         m_bone_count = skeleton_definition.bones_map.size();
         m_bones      = new Bone[m_bone_count];
+        m_parent_indices.assign(m_bone_count, -1);
         for (size_t i = 0; i < m_bone_count; i++)
         {
             const RawBone bone_definition = skeleton_definition.bones_map[i];
             Bone*         parent_bone     = find_by_index(m_bones, bone_definition.parent_index, i, m_is_flat);
             m_bones[i].initialize(std::make_shared<RawBone>(bone_definition), parent_bone);
+            if (parent_bone)
+            {
+                m_parent_indices[i] = static_cast<int32_t>(parent_bone - m_bones);
+            }
+        }
+
+        // bones are in topological order, so a parent's depth is known before its children's
+        std::vector<uint32_t> bone_depths(m_bone_count, 0);
+        uint32_t              max_depth = 0;
+        for (size_t i = 0; i < m_bone_count; i++)
+        {
+            bone_depths[i] = m_parent_indices[i] < 0 ? 0 : bone_depths[m_parent_indices[i]] + 1;
+            max_depth      = std::max(max_depth, bone_depths[i]);
+        }
+        m_hierarchy_order.clear();
+        m_hierarchy_level_ends.clear();
+        for (uint32_t depth = 0; m_bone_count > 0 && depth <= max_depth; depth++)
+        {
+            for (uint32_t i = 0; i < m_bone_count; i++)
+            {
+                if (bone_depths[i] == depth)
+                {
+                    m_hierarchy_order.push_back(i);
+                }
+            }
+            m_hierarchy_level_ends.push_back(static_cast<uint32_t>(m_hierarchy_order.size()));
         }
+
+        m_bind_pose.resize(m_bone_count);
+        for (size_t i = 0; i < m_bone_count; i++)
+        {
+            m_bind_pose.setBone(
+                i, m_bones[i].getInitialPosition(), m_bones[i].getInitialOrientation(), m_bones[i].getInitialScale());
+        }
+        m_identity_pose.resize(m_bone_count);
+        m_key_pose_low.resize(m_bone_count);
+        m_key_pose_high.resize(m_bone_count);
+        m_clip_pose.resize(m_bone_count);
+        m_local_pose.resize(m_bone_count);
+        m_model_pose.resize(m_bone_count);
+
+        const size_t padded_bone_count = m_bind_pose.m_positions[0].size();
+        m_bone_weights.assign(padded_bone_count, 0.f);
+        m_remaining_weights.assign(padded_bone_count, 0.f);
+
+        // bind pose until the first animation is applied
+        m_local_pose = m_bind_pose;
+        updateModelPose();
     }
 
-    void Skeleton::applyAnimation(const BlendStateWithClipData& blend_state)
+    void Skeleton::applyAnimation(const BlendStateWithClipHandles& blend_state, const std::vector<float>& blend_ratio)
     {
         if (!m_bones)
         {
             return;
         }
-        resetSkeleton();
-        for (size_t clip_index = 0; clip_index < 1; clip_index++)
-        {
-            const AnimationClip& animation_clip = blend_state.blend_clip[clip_index];
-            const float          phase          = blend_state.blend_ratio[clip_index];
-            const AnimSkelMap&   anim_skel_map  = blend_state.blend_anim_skel_map[clip_index];
-
-            float exact_frame        = phase * (animation_clip.total_frame - 1);
-            int   current_frame_low  = floor(exact_frame);
-            int   current_frame_high = ceil(exact_frame);
-            float lerp_ratio         = exact_frame - current_frame_low;
-            // for (size_t node_index = 0; node_index < 0; node_index++)
-            for (size_t node_index = 0;
-                 node_index < animation_clip.node_count && node_index < anim_skel_map.convert.size();
-                 node_index++)
+
+        m_local_pose.setZero();
+        std::fill(m_remaining_weights.begin(), m_remaining_weights.begin() + m_bone_count, 1.f);
+
+        const size_t clip_count = std::min({static_cast<size_t>(std::max(blend_state.clip_count, 0)),
+                                            blend_state.blend_clip.size(),
+                                            blend_state.blend_anim_skel_map.size(),
+                                            blend_ratio.size()});
+        for (size_t clip_index = 0; clip_index < clip_count; clip_index++)
+        {
+            // masked per-bone weights if the blend state has masks, the plain clip weight otherwise
+            const std::vector<float>* mask_weights =
+                clip_index < blend_state.blend_weight.size() ? &blend_state.blend_weight[clip_index].blend_weight
+                                                             : nullptr;
+            const size_t mask_weight_count = mask_weights ? mask_weights->size() : 0;
+            const float  clip_weight =
+                clip_index < blend_state.clip_weight.size() ? blend_state.clip_weight[clip_index] : 1.f;
+
+            bool is_clip_used = false;
+            for (size_t bone_index = 0; bone_index < m_bone_count; bone_index++)
             {
-                AnimationChannel channel    = animation_clip.node_channels[node_index];
-                size_t           bone_index = anim_skel_map.convert[node_index];
-                float            weight     = 1; // blend_state.blend_weight[clip_index]->blend_weight[bone_index];
-                weight                      = 1;
+                float weight = bone_index < mask_weight_count ? (*mask_weights)[bone_index] : clip_weight;
                 if (fabs(weight) < 0.0001f)
                 {
-                    continue;
-                }
-                if (bone_index == std::numeric_limits<size_t>().max())
-                {
-                    // LOG_WARNING
-                    continue;
+                    weight = 0.f;
                 }
-                Bone* bone = &m_bones[bone_index];
-                if (channel.position_keys.size() <= current_frame_high)
-                {
-                    current_frame_high = channel.position_keys.size() - 1;
-                }
-                if (channel.scaling_keys.size() <= current_frame_high)
-                {
-                    current_frame_high = channel.scaling_keys.size() - 1;
-                }
-                if (channel.rotation_keys.size() <= current_frame_high)
+                m_bone_weights[bone_index] = weight;
+                m_remaining_weights[bone_index] -= weight;
+                is_clip_used |= weight != 0.f;
+            }
+            if (!is_clip_used)
+            {
+                continue;
+            }
+
+            sampleClip(*blend_state.blend_clip[clip_index],
+                       *blend_state.blend_anim_skel_map[clip_index],
+                       blend_ratio[clip_index]);
+            m_local_pose.accumulate(m_clip_pose, m_bone_weights.data());
+        }
+
+        // weight no clip claimed keeps the bone in its bind pose
+        for (size_t bone_index = 0; bone_index < m_bone_count; bone_index++)
+        {
+            m_remaining_weights[bone_index] = std::max(m_remaining_weights[bone_index], 0.f);
+        }
+        m_local_pose.accumulate(m_identity_pose, m_remaining_weights.data());
+        m_local_pose.normalizeRotations();
+        m_local_pose.applyBindPose(m_bind_pose);
+
+        updateModelPose();
+    }
+
+    void Skeleton::sampleClip(const AnimationClip& animation_clip, const AnimSkelMap& anim_skel_map, float phase)
+    {
+        float exact_frame     = phase * (animation_clip.total_frame - 1);
+        int   clip_frame_low  = floor(exact_frame);
+        int   clip_frame_high = ceil(exact_frame);
+        float lerp_ratio      = exact_frame - clip_frame_low;
+
+        // bones the clip has no channel for do not move
+        m_key_pose_low.setIdentity();
+        m_key_pose_high.setIdentity();
+        for (size_t node_index = 0;
+             node_index < static_cast<size_t>(animation_clip.node_count) && node_index < anim_skel_map.convert.size();
+             node_index++)
+        {
+            const AnimationChannel& channel    = animation_clip.node_channels[node_index];
+            size_t                  bone_index = anim_skel_map.convert[node_index];
+            if (bone_index == std::numeric_limits<size_t>().max() || bone_index >= m_bone_count)
+            {
+                // LOG_WARNING
+                continue;
+            }
+            if (channel.position_keys.empty() || channel.scaling_keys.empty() || channel.rotation_keys.empty())
+            {
+                continue;
+            }
+
+            int current_frame_high = clip_frame_high;
+            if (static_cast<int>(channel.position_keys.size()) <= current_frame_high)
+            {
+                current_frame_high = channel.position_keys.size() - 1;
+            }
+            if (static_cast<int>(channel.scaling_keys.size()) <= current_frame_high)
+            {
+                current_frame_high = channel.scaling_keys.size() - 1;
+            }
+            if (static_cast<int>(channel.rotation_keys.size()) <= current_frame_high)
+            {
+                current_frame_high = channel.rotation_keys.size() - 1;
+            }
+            int current_frame_low = (clip_frame_low < current_frame_high) ? clip_frame_low : current_frame_high;
+
+            m_key_pose_low.setBone(bone_index,
+                                   channel.position_keys[current_frame_low],
+                                   channel.rotation_keys[current_frame_low],
+                                   channel.scaling_keys[current_frame_low]);
+            m_key_pose_high.setBone(bone_index,
+                                    channel.position_keys[current_frame_high],
+                                    channel.rotation_keys[current_frame_high],
+                                    channel.scaling_keys[current_frame_high]);
+        }
+
+        m_clip_pose.interpolate(m_key_pose_low, m_key_pose_high, lerp_ratio);
+    }
+
+    void Skeleton::updateModelPose()
+    {
+        if (m_hierarchy_level_ends.empty())
+        {
+            return;
+        }
+
+        // roots
+        for (uint32_t order_index = 0; order_index < m_hierarchy_level_ends[0]; order_index++)
+        {
+            const uint32_t bone_index = m_hierarchy_order[order_index];
+            m_model_pose.setBone(bone_index,
+                                 m_local_pose.getPosition(bone_index),
+                                 m_local_pose.getRotation(bone_index),
+                                 m_local_pose.getScale(bone_index));
+        }
+
+        // the bones of a level are independent of each other, four of them are combined with their parents at once
+        for (size_t level = 1; level < m_hierarchy_level_ends.size(); level++)
+        {
+            const uint32_t level_end = m_hierarchy_level_ends[level];
+            for (uint32_t order_index = m_hierarchy_level_ends[level - 1]; order_index < level_end;
+                 order_index += k_lane_count)
+            {
+                // a partial group repeats its last bone, which just writes the same result again
+                uint32_t bone_indices[k_lane_count];
+                uint32_t parent_indices[k_lane_count];
+                for (uint32_t lane = 0; lane < k_lane_count; ++lane)
                 {
-                    current_frame_high = channel.rotation_keys.size() - 1;
+                    bone_indices[lane]   = m_hierarchy_order[std::min(order_index + lane, level_end - 1)];
+                    parent_indices[lane] = static_cast<uint32_t>(m_parent_indices[bone_indices[lane]]);
                 }
-                current_frame_low = (current_frame_low < current_frame_high) ? current_frame_low : current_frame_high;
-                Vector3 position  = Vector3::lerp(
-                    channel.position_keys[current_frame_low], channel.position_keys[current_frame_high], lerp_ratio);
-                Vector3 scaling = Vector3::lerp(
-                    channel.scaling_keys[current_frame_low], channel.scaling_keys[current_frame_high], lerp_ratio);
-                Quaternion rotation = Quaternion::nLerp(lerp_ratio,
-                                                        channel.rotation_keys[current_frame_low],
-                                                        channel.rotation_keys[current_frame_high],
-                                                        true);
 
-                {
-                    bone->rotate(rotation);
-                    bone->scale(scaling);
-                    bone->translate(position);
+                const SimdFloat4 parent_x = gatherLanes(m_model_pose.m_rotations[0], parent_indices);
+                const SimdFloat4 parent_y = gatherLanes(m_model_pose.m_rotations[1], parent_indices);
+                const SimdFloat4 parent_z = gatherLanes(m_model_pose.m_rotations[2], parent_indices);
+                const SimdFloat4 parent_w = gatherLanes(m_model_pose.m_rotations[3], parent_indices);
+                const SimdFloat4 local_x  = gatherLanes(m_local_pose.m_rotations[0], bone_indices);
+                const SimdFloat4 local_y  = gatherLanes(m_local_pose.m_rotations[1], bone_indices);
+                const SimdFloat4 local_z  = gatherLanes(m_local_pose.m_rotations[2], bone_indices);
+                const SimdFloat4 local_w  = gatherLanes(m_local_pose.m_rotations[3], bone_indices);
+                const SimdFloat4 two      = SimdFloat4::splat(2.f);
+
+                // orientation = normalise(parent orientation * orientation)
+                const SimdFloat4 rotation_x =
+                    parent_w * local_x + parent_x * local_w + parent_y * local_z - parent_z * local_y;
+                const SimdFloat4 rotation_y =
+                    parent_w * local_y + parent_y * local_w + parent_z * local_x - parent_x * local_z;
+                const SimdFloat4 rotation_z =
+                    parent_w * local_z + parent_z * local_w + parent_x * local_y - parent_y * local_x;
+                const SimdFloat4 rotation_w =
+                    parent_w * local_w - parent_x * local_x - parent_y * local_y - parent_z * local_z;
+                const SimdFloat4 inverse_length =
+                    SimdFloat4::splat(1.f) / SimdFloat4::sqrt(rotation_x * rotation_x + rotation_y * rotation_y +
+                                                              rotation_z * rotation_z + rotation_w * rotation_w);
+                scatterLanes(m_model_pose.m_rotations[0], bone_indices, rotation_x * inverse_length);
+                scatterLanes(m_model_pose.m_rotations[1], bone_indices, rotation_y * inverse_length);
+                scatterLanes(m_model_pose.m_rotations[2], bone_indices, rotation_z * inverse_length);
+                scatterLanes(m_model_pose.m_rotations[3], bone_indices, rotation_w * inverse_length);
 
-                    // bone->rotate({ {},0.01,0,0,1 });
-                    // bone->scale({ {},0.9,0.9,0.9 });
+                // scale = parent scale * scale
+                SimdFloat4 parent_scale[3];
+                for (size_t axis = 0; axis < 3; ++axis)
+                {
+                    parent_scale[axis] = gatherLanes(m_model_pose.m_scales[axis], parent_indices);
+                    scatterLanes(m_model_pose.m_scales[axis],
+                                 bone_indices,
+                                 parent_scale[axis] * gatherLanes(m_local_pose.m_scales[axis], bone_indices));
                 }
+
+                // position = parent orientation * (parent scale * position) + parent position
+                const SimdFloat4 v_x   = parent_scale[0] * gatherLanes(m_local_pose.m_positions[0], bone_indices);
+                const SimdFloat4 v_y   = parent_scale[1] * gatherLanes(m_local_pose.m_positions[1], bone_indices);
+                const SimdFloat4 v_z   = parent_scale[2] * gatherLanes(m_local_pose.m_positions[2], bone_indices);
+                const SimdFloat4 uv_x  = parent_y * v_z - parent_z * v_y;
+                const SimdFloat4 uv_y  = parent_z * v_x - parent_x * v_z;
+                const SimdFloat4 uv_z  = parent_x * v_y - parent_y * v_x;
+                const SimdFloat4 uuv_x = parent_y * uv_z - parent_z * uv_y;
+                const SimdFloat4 uuv_y = parent_z * uv_x - parent_x * uv_z;
+                const SimdFloat4 uuv_z = parent_x * uv_y - parent_y * uv_x;
+                const SimdFloat4 two_w = two * parent_w;
+                scatterLanes(m_model_pose.m_positions[0],
+                             bone_indices,
+                             v_x + two_w * uv_x + two * uuv_x +
+                                 gatherLanes(m_model_pose.m_positions[0], parent_indices));
+                scatterLanes(m_model_pose.m_positions[1],
+                             bone_indices,
+                             v_y + two_w * uv_y + two * uuv_y +
+                                 gatherLanes(m_model_pose.m_positions[1], parent_indices));
+                scatterLanes(m_model_pose.m_positions[2],
+                             bone_indices,
+                             v_z + two_w * uv_z + two * uuv_z +
+                                 gatherLanes(m_model_pose.m_positions[2], parent_indices));
             }
         }
-        // bones[77].rotate(Quaternion{ {},1,0,0,1 });
-        // bones[18].translate(Vector3{ {},0,1,0 });
-        // bones[0].setScale(Vector3{ {},0,1,0.01 });
-        for (size_t i = 0; i < m_bone_count; i++)
-        {
-            m_bones[i].update();
-        }
-#ifdef _DEBUG
-        // bones[107].m_derived_position += Vector3{ {},10, 0, 0 };
-#endif
     }
 
-    AnimationResult Skeleton::outputAnimationResult()
+    void Skeleton::outputAnimationResult(AnimationResult& animation_result) const
     {
-        AnimationResult animation_result;
+        animation_result.node.resize(m_bone_count);
         for (size_t i = 0; i < m_bone_count; i++)
         {
-            std::shared_ptr<AnimationResultElement> animation_result_element =
-                std::make_shared<AnimationResultElement>();
-            Bone* bone                      = &m_bones[i];
-            animation_result_element->index = bone->getID() + 1;
-            Vector3 temp_translation        = bone->_getDerivedPosition();
+            AnimationResultElement& animation_result_element = animation_result.node[i];
+            const Bone*             bone                     = &m_bones[i];
+            animation_result_element.index                   = bone->getID() + 1;
 
             // TODO: the unit of the joint matrices is wrong
-            Vector3 temp_scale = bone->_getDerivedScale();
-
-            Quaternion temp_rotation = bone->_getDerivedOrientation();
-
-            // auto scale = bone->_getDerivedTScale();
-            // scale.x = 1.f / scale.x;
-            // scale.y = 1.f / scale.y;
-            // scale.z = 1.f / scale.z;
-
-            // auto revTmat = getMatrix(
-            //	-bone->_getDerivedTPosition(),
-            //	scale,
-            //	conjugate( bone->_getDerivedTOrientation())
-            //);
             auto objMat =
-                Transform(bone->_getDerivedPosition(), bone->_getDerivedOrientation(), bone->_getDerivedScale())
+                Transform(m_model_pose.getPosition(i), m_model_pose.getRotation(i), m_model_pose.getScale(i))
                     .getMatrix();
 
             auto resMat = objMat * bone->_getInverseTpose();
 
-            animation_result_element->transform = resMat.toMatrix4x4_();
-
-            animation_result.node.push_back(*animation_result_element);
+            animation_result_element.transform = resMat.toMatrix4x4_();
         }
-        return animation_result;
     }
 
     const Bone* Skeleton::getBones() const
@@ -162,6 +347,10 @@ namespace Piccolo
 
     int32_t Skeleton::getBonesCount() const
     {
-        return m_bone_count;
+        return static_cast<int32_t>(m_bone_count);
     }
-} // namespace Piccolo
\ No newline at end of file
+
+    int32_t Skeleton::getParentIndex(int32_t bone_index) const { return m_parent_indices[bone_index]; }
+
+    const SkeletonPose& Skeleton::getModelPose() const { return m_model_pose; }
+} // namespace Piccolo
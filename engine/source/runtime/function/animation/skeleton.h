@@ -3,27 +3,57 @@
 #include "runtime/resource/res_type/components/animation.h"
 
 #include "runtime/function/animation/node.h"
+#include "runtime/function/animation/skeleton_pose.h"
+
+#include <cstdint>
+#include <vector>
 
 namespace Piccolo
 {
     class SkeletonData;
-    class BlendStateWithClipData;
+    struct BlendStateWithClipHandles;
 
     class Skeleton
     {
     private:
-        bool  m_is_flat {false};
-        int   m_bone_count {0};
-        Bone* m_bones {nullptr};
+        bool   m_is_flat {false};
+        size_t m_bone_count {0};
+        Bone*  m_bones {nullptr};
+
+        // -1 for roots. m_hierarchy_order lists the bones level by level, a level only depends on the levels before
+        // it, m_hierarchy_level_ends holds the end of every level in m_hierarchy_order
+        std::vector<int32_t>  m_parent_indices;
+        std::vector<uint32_t> m_hierarchy_order;
+        std::vector<uint32_t> m_hierarchy_level_ends;
+
+        // sized once in buildSkeleton, applyAnimation does not allocate
+        SkeletonPose       m_bind_pose;
+        SkeletonPose       m_identity_pose;
+        SkeletonPose       m_key_pose_low;
+        SkeletonPose       m_key_pose_high;
+        SkeletonPose       m_clip_pose;
+        SkeletonPose       m_local_pose;
+        SkeletonPose       m_model_pose;
+        std::vector<float> m_bone_weights;
+        std::vector<float> m_remaining_weights;
+
+        void sampleClip(const AnimationClip& animation_clip, const AnimSkelMap& anim_skel_map, float phase);
+        void updateModelPose();
 
     public:
         ~Skeleton();
 
-        void            buildSkeleton(const SkeletonData& skeleton_definition);
-        void            applyAnimation(const BlendStateWithClipData& blend_state);
-        AnimationResult outputAnimationResult();
-        void            resetSkeleton();
-        const Bone*     getBones() const;
-        int32_t         getBonesCount() const;
+        void buildSkeleton(const SkeletonData& skeleton_definition);
+        /// samples every clip of the blend state and blends them by the clip weights and bone masks
+        void applyAnimation(const BlendStateWithClipHandles& blend_state, const std::vector<float>& blend_ratio);
+        /// overwrites the result in place, it only allocates when the bone count grows
+        void outputAnimationResult(AnimationResult& animation_result) const;
+        void resetSkeleton();
+
+        const Bone* getBones() const;
+        int32_t     getBonesCount() const;
+        int32_t     getParentIndex(int32_t bone_index) const;
+        /// object space transforms of the bones after the last applyAnimation
+        const SkeletonPose& getModelPose() const;
     };
 } // namespace Piccolo
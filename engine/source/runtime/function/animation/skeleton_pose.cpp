@@ -0,0 +1,232 @@
+#include "runtime/function/animation/skeleton_pose.h"
+
+namespace Piccolo
+{
+    namespace
+    {
+        constexpr size_t k_lane_count = SimdFloat4::k_lane_count;
+
+        SimdFloat4 loadLanes(const std::vector<float>& values, size_t first_bone)
+        {
+            return SimdFloat4::load(values.data() + first_bone);
+        }
+
+        void storeLanes(std::vector<float>& values, size_t first_bone, const SimdFloat4& lanes)
+        {
+            lanes.store(values.data() + first_bone);
+        }
+    } // namespace
+
+    void SkeletonPose::resize(size_t bone_count)
+    {
+        m_bone_count        = bone_count;
+        m_padded_bone_count = (bone_count + k_lane_count - 1) / k_lane_count * k_lane_count;
+        for (size_t axis = 0; axis < 3; ++axis)
+        {
+            m_positions[axis].resize(m_padded_bone_count);
+            m_scales[axis].resize(m_padded_bone_count);
+        }
+        for (size_t axis = 0; axis < 4; ++axis)
+        {
+            m_rotations[axis].resize(m_padded_bone_count);
+        }
+        setIdentity();
+    }
+
+    void SkeletonPose::setIdentity()
+    {
+        for (size_t axis = 0; axis < 3; ++axis)
+        {
+            m_positions[axis].assign(m_padded_bone_count, 0.f);
+            m_scales[axis].assign(m_padded_bone_count, 1.f);
+        }
+        for (size_t axis = 0; axis < 3; ++axis)
+        {
+            m_rotations[axis].assign(m_padded_bone_count, 0.f);
+        }
+        m_rotations[3].assign(m_padded_bone_count, 1.f);
+    }
+
+    void SkeletonPose::setZero()
+    {
+        for (size_t axis = 0; axis < 3; ++axis)
+        {
+            m_positions[axis].assign(m_padded_bone_count, 0.f);
+            m_scales[axis].assign(m_padded_bone_count, 0.f);
+        }
+        for (size_t axis = 0; axis < 4; ++axis)
+        {
+            m_rotations[axis].assign(m_padded_bone_count, 0.f);
+        }
+    }
+
+    void SkeletonPose::setBone(size_t            bone_index,
+                               const Vector3&    position,
+                               const Quaternion& rotation,
+                               const Vector3&    scale)
+    {
+        m_positions[0][bone_index] = position.x;
+        m_positions[1][bone_index] = position.y;
+        m_positions[2][bone_index] = position.z;
+        m_rotations[0][bone_index] = rotation.x;
+        m_rotations[1][bone_index] = rotation.y;
+        m_rotations[2][bone_index] = rotation.z;
+        m_rotations[3][bone_index] = rotation.w;
+        m_scales[0][bone_index]    = scale.x;
+        m_scales[1][bone_index]    = scale.y;
+        m_scales[2][bone_index]    = scale.z;
+    }
+
+    Vector3 SkeletonPose::getPosition(size_t bone_index) const
+    {
+        return Vector3(m_positions[0][bone_index], m_positions[1][bone_index], m_positions[2][bone_index]);
+    }
+
+    Quaternion SkeletonPose::getRotation(size_t bone_index) const
+    {
+        return Quaternion(m_rotations[3][bone_index],
+                          m_rotations[0][bone_index],
+                          m_rotations[1][bone_index],
+                          m_rotations[2][bone_index]);
+    }
+
+    Vector3 SkeletonPose::getScale(size_t bone_index) const
+    {
+        return Vector3(m_scales[0][bone_index], m_scales[1][bone_index], m_scales[2][bone_index]);
+    }
+
+    void SkeletonPose::interpolate(const SkeletonPose& from, const SkeletonPose& to, float ratio)
+    {
+        const SimdFloat4 t = SimdFloat4::splat(ratio);
+        for (size_t bone = 0; bone < m_padded_bone_count; bone += k_lane_count)
+        {
+            for (size_t axis = 0; axis < 3; ++axis)
+            {
+                const SimdFloat4 from_position = loadLanes(from.m_positions[axis], bone);
+                const SimdFloat4 to_position   = loadLanes(to.m_positions[axis], bone);
+                storeLanes(m_positions[axis], bone, from_position + t * (to_position - from_position));
+
+                const SimdFloat4 from_scale = loadLanes(from.m_scales[axis], bone);
+                const SimdFloat4 to_scale   = loadLanes(to.m_scales[axis], bone);
+                storeLanes(m_scales[axis], bone, from_scale + t * (to_scale - from_scale));
+            }
+
+            SimdFloat4 from_rotation[4];
+            SimdFloat4 to_rotation[4];
+            SimdFloat4 cos_value = SimdFloat4::splat(0.f);
+            for (size_t axis = 0; axis < 4; ++axis)
+            {
+                from_rotation[axis] = loadLanes(from.m_rotations[axis], bone);
+                to_rotation[axis]   = loadLanes(to.m_rotations[axis], bone);
+                cos_value           = cos_value + from_rotation[axis] * to_rotation[axis];
+            }
+
+            const SimdFloat4 sign = SimdFloat4::select(SimdFloat4::lessThan(cos_value, SimdFloat4::splat(0.f)),
+                                                       SimdFloat4::splat(-1.f),
+                                                       SimdFloat4::splat(1.f));
+            SimdFloat4       rotation[4];
+            SimdFloat4       length_squared = SimdFloat4::splat(0.f);
+            for (size_t axis = 0; axis < 4; ++axis)
+            {
+                rotation[axis] = from_rotation[axis] + t * (sign * to_rotation[axis] - from_rotation[axis]);
+                length_squared = length_squared + rotation[axis] * rotation[axis];
+            }
+
+            const SimdFloat4 inverse_length = SimdFloat4::splat(1.f) / SimdFloat4::sqrt(length_squared);
+            for (size_t axis = 0; axis < 4; ++axis)
+            {
+                storeLanes(m_rotations[axis], bone, rotation[axis] * inverse_length);
+            }
+        }
+    }
+
+    void SkeletonPose::accumulate(const SkeletonPose& pose, const float* bone_weights)
+    {
+        for (size_t bone = 0; bone < m_padded_bone_count; bone += k_lane_count)
+        {
+            const SimdFloat4 weight = SimdFloat4::load(bone_weights + bone);
+            for (size_t axis = 0; axis < 3; ++axis)
+            {
+                storeLanes(m_positions[axis],
+                           bone,
+                           loadLanes(m_positions[axis], bone) + weight * loadLanes(pose.m_positions[axis], bone));
+                storeLanes(m_scales[axis],
+                           bone,
+                           loadLanes(m_scales[axis], bone) + weight * loadLanes(pose.m_scales[axis], bone));
+            }
+
+            SimdFloat4 sum_rotation[4];
+            SimdFloat4 pose_rotation[4];
+            SimdFloat4 cos_value = SimdFloat4::splat(0.f);
+            for (size_t axis = 0; axis < 4; ++axis)
+            {
+                sum_rotation[axis]  = loadLanes(m_rotations[axis], bone);
+                pose_rotation[axis] = loadLanes(pose.m_rotations[axis], bone);
+                cos_value           = cos_value + sum_rotation[axis] * pose_rotation[axis];
+            }
+
+            const SimdFloat4 signed_weight =
+                SimdFloat4::select(SimdFloat4::lessThan(cos_value, SimdFloat4::splat(0.f)), -weight, weight);
+            for (size_t axis = 0; axis < 4; ++axis)
+            {
+                storeLanes(m_rotations[axis], bone, sum_rotation[axis] + signed_weight * pose_rotation[axis]);
+            }
+        }
+    }
+
+    void SkeletonPose::normalizeRotations()
+    {
+        for (size_t bone = 0; bone < m_padded_bone_count; bone += k_lane_count)
+        {
+            SimdFloat4 rotation[4];
+            SimdFloat4 length_squared = SimdFloat4::splat(0.f);
+            for (size_t axis = 0; axis < 4; ++axis)
+            {
+                rotation[axis] = loadLanes(m_rotations[axis], bone);
+                length_squared = length_squared + rotation[axis] * rotation[axis];
+            }
+
+            const SimdFloat4 is_degenerate  = SimdFloat4::lessThan(length_squared, SimdFloat4::splat(1e-8f));
+            const SimdFloat4 inverse_length = SimdFloat4::splat(1.f) /
+                                              SimdFloat4::sqrt(SimdFloat4::select(
+                                                  is_degenerate, SimdFloat4::splat(1.f), length_squared));
+            for (size_t axis = 0; axis < 4; ++axis)
+            {
+                const SimdFloat4 identity = SimdFloat4::splat(axis == 3 ? 1.f : 0.f);
+                storeLanes(m_rotations[axis],
+                           bone,
+                           SimdFloat4::select(is_degenerate, identity, rotation[axis] * inverse_length));
+            }
+        }
+    }
+
+    void SkeletonPose::applyBindPose(const SkeletonPose& bind_pose)
+    {
+        for (size_t bone = 0; bone < m_padded_bone_count; bone += k_lane_count)
+        {
+            for (size_t axis = 0; axis < 3; ++axis)
+            {
+                storeLanes(m_positions[axis],
+                           bone,
+                           loadLanes(bind_pose.m_positions[axis], bone) + loadLanes(m_positions[axis], bone));
+                storeLanes(m_scales[axis],
+                           bone,
+                           loadLanes(bind_pose.m_scales[axis], bone) * loadLanes(m_scales[axis], bone));
+            }
+
+            // bind rotation * rotation, the animated rotation is applied in local space
+            const SimdFloat4 x1 = loadLanes(bind_pose.m_rotations[0], bone);
+            const SimdFloat4 y1 = loadLanes(bind_pose.m_rotations[1], bone);
+            const SimdFloat4 z1 = loadLanes(bind_pose.m_rotations[2], bone);
+            const SimdFloat4 w1 = loadLanes(bind_pose.m_rotations[3], bone);
+            const SimdFloat4 x2 = loadLanes(m_rotations[0], bone);
+            const SimdFloat4 y2 = loadLanes(m_rotations[1], bone);
+            const SimdFloat4 z2 = loadLanes(m_rotations[2], bone);
+            const SimdFloat4 w2 = loadLanes(m_rotations[3], bone);
+            storeLanes(m_rotations[0], bone, w1 * x2 + x1 * w2 + y1 * z2 - z1 * y2);
+            storeLanes(m_rotations[1], bone, w1 * y2 + y1 * w2 + z1 * x2 - x1 * z2);
+            storeLanes(m_rotations[2], bone, w1 * z2 + z1 * w2 + x1 * y2 - y1 * x2);
+            storeLanes(m_rotations[3], bone, w1 * w2 - x1 * x2 - y1 * y2 - z1 * z2);
+        }
+    }
+} // namespace Piccolo
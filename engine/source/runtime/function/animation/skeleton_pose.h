@@ -0,0 +1,50 @@
+#pragma once
+
+#include "runtime/core/math/quaternion.h"
+#include "runtime/core/math/simd_float4.h"
+#include "runtime/core/math/vector3.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace Piccolo
+{
+    /// translation, rotation and scale of every bone of a skeleton, stored as structure of arrays
+    ///
+    /// every component lives in its own array padded to a multiple of SimdFloat4::k_lane_count, so the kernels below
+    /// evaluate four bones per instruction. the padding lanes hold identity transforms
+    class SkeletonPose
+    {
+    public:
+        void   resize(size_t bone_count);
+        size_t getBoneCount() const { return m_bone_count; }
+
+        void setIdentity();
+        void setZero();
+
+        void setBone(size_t bone_index, const Vector3& position, const Quaternion& rotation, const Vector3& scale);
+
+        Vector3    getPosition(size_t bone_index) const;
+        Quaternion getRotation(size_t bone_index) const;
+        Vector3    getScale(size_t bone_index) const;
+
+        /// lerp of positions and scales, shortest path nlerp of rotations, same as Vector3::lerp and Quaternion::nLerp
+        void interpolate(const SkeletonPose& from, const SkeletonPose& to, float ratio);
+        /// adds pose weighted per bone, bone_weights is padded like the pose. rotations are flipped into the
+        /// hemisphere of the sum so opposite but equal rotations do not cancel out
+        void accumulate(const SkeletonPose& pose, const float* bone_weights);
+        /// zero length rotations, bones no clip contributed to, become the identity
+        void normalizeRotations();
+        /// applies the pose as offsets to the bind pose the way Bone::translate, rotate and scale do
+        void applyBindPose(const SkeletonPose& bind_pose);
+
+        // x, y, z and x, y, z, w arrays
+        std::vector<float> m_positions[3];
+        std::vector<float> m_rotations[4];
+        std::vector<float> m_scales[3];
+
+    private:
+        size_t m_bone_count {0};
+        size_t m_padded_bone_count {0};
+    };
+} // namespace Piccolo
@@ -20,7 +20,7 @@ namespace Piccolo
     }
 
     /// <summary>
-    /// ýɫָgobject󶨣ʼtransform
+    /// 设置角色与指定的gobject绑定，并初始化他的transform组件
     /// </summary>
     void Character::setObject(std::shared_ptr<GObject> gobject)
     {
@@ -33,7 +33,7 @@ namespace Piccolo
             m_position                 = transform.m_position;
             m_rotation                 = transform.m_rotation;
         }
-        else //ɫڣΪĬֵ
+        else //如果角色不存在，则设为默认值
         {
             m_position = Vector3::ZERO;
             m_rotation = Quaternion::IDENTITY;
@@ -42,46 +42,46 @@ namespace Piccolo
 
     void Character::tick(float delta_time)
     {
-        if (m_character_object == nullptr) //ɫǷЧ
+        if (m_character_object == nullptr) //角色是否有效
             return;
 
-        //commandϵͳȡǰָ
+        //command：从输入系统获取当前的指令
         unsigned int command = g_runtime_global_context.m_input_system->getGameCommand();
-        if (command < (unsigned int)GameCommand::invalid) //Чָ
+        if (command < (unsigned int)GameCommand::invalid) //输入的是有效指令
         {
-            //Ƿģʽ
+            //是否是自由相机模式
             if ((((unsigned int)GameCommand::free_carema & command) > 0) != m_is_free_camera)
             {
-                //ǣģʽ    ǣǿƽɫƶ
+                //如果是，则开启自由相机模式    若不是，则是控制角色移动
                 toggleFreeCamera();
             }
         }
 
-        //ȡɫTransformComponent
+        //获取角色的TransformComponent组件
         TransformComponent* transform_component = m_character_object->tryGetComponent(TransformComponent);
 
-        //ǷҪת
+        //是否要旋转
         if (m_rotation_dirty)
         {
             transform_component->setRotation(m_rotation_buffer);
             m_rotation_dirty = false;
         }
 
-        //Իȡ˶
+        //尝试获取运动组件
         const MotorComponent* motor_component = m_character_object->tryGetComponentConst(MotorComponent);
         if (motor_component == nullptr)
         {
             return;
         }
 
-        if (motor_component->getIsMoving()) //Ƿƶ
+        if (motor_component->getIsMoving()) //是否正在移动
         {
             m_rotation_buffer = m_rotation;
             transform_component->setRotation(m_rotation_buffer);
             m_rotation_dirty = true;
         }
         const Vector3& new_position = motor_component->getTargetPosition();
-        //λ
+        //更新位移
         m_position = new_position;
 
         //float blend_ratio = std::max(1.f, motor_component->getSpeedRatio());
@@ -95,17 +95,17 @@ namespace Piccolo
 
     void Character::toggleFreeCamera()
     {
-        //ȡ
+        //获取相机组件
         CameraComponent* camera_component = m_character_object->tryGetComponent(CameraComponent);
         if (camera_component == nullptr) return;
 
-        // Ƿģʽ  ÿΰFлģʽ״̬
+        //更新 是否是相机模式  每次按F切换相机模式的状态
         m_is_free_camera = !m_is_free_camera;
 
         if (m_is_free_camera)
         {
             m_original_camera_mode = camera_component->getCameraMode();
-            camera_component->setCameraMode(CameraMode::free);//Ϊģʽ
+            camera_component->setCameraMode(CameraMode::free);//设置为自由模式
         }
         else
         {
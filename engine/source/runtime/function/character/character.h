@@ -17,22 +17,22 @@ namespace Piccolo
         Character(std::shared_ptr<GObject> character_object);
 
         /// <summary>
-        /// ؽɫid
+        /// 返回角色物体id
         /// </summary>
         GObjectID getObjectID() const;
 
         /// <summary>
-        /// ýɫָgobject󶨣ʼtransform
+        /// 设置角色与指定的gobject绑定，并初始化他的transform组件
         /// </summary>
         void setObject(std::shared_ptr<GObject> gobject);
 
         /// <summary>
-        /// ȡɫָ
+        /// 获取角色指针
         /// </summary>
         std::weak_ptr<GObject> getObject() const { return m_character_object; }
 
         /// <summary>
-        /// /ȡɫλúת
+        /// 设置/获取角色位置和旋转
         /// </summary>
         void setPosition(const Vector3& position) { m_position = position; }
         void setRotation(const Quaternion& rotation) { m_rotation = rotation; }
@@ -43,38 +43,38 @@ namespace Piccolo
 
     private:
         /// <summary>
-        /// Fл
+        /// 按F切换到自由相机
         /// </summary>
         void toggleFreeCamera();
 
         /// <summary>
-        /// ɫλá
+        /// 角色的位置、朝向
         /// </summary>
         Vector3 m_position;
         Quaternion m_rotation;
 
         /// <summary>
-        /// ɫobjectָ
+        /// 角色object指针
         /// </summary>
         std::shared_ptr<GObject> m_character_object;
 
         /// <summary>
-        /// ɫתĻ壬ڴתı仯   hack for setting rotation frame buffer
+        /// 角色旋转的缓冲，用于处理旋转的变化   hack for setting rotation frame buffer
         /// </summary>
         Quaternion m_rotation_buffer;
 
         /// <summary>
-        /// תǷб仯
+        /// 标记旋转是否有变化
         /// </summary>
         bool m_rotation_dirty {false};
 
         /// <summary>
-        ///   ģʽ
+        /// 相机组件  相机模式
         /// </summary>
         CameraMode m_original_camera_mode;
 
         /// <summary>
-        /// Ƿģʽ
+        /// 是否是相机模式
         /// </summary>
         bool m_is_free_camera{false};
     };
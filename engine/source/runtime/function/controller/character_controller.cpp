@@ -7,9 +7,22 @@
 #include "runtime/function/global/global_context.h"
 #include "runtime/function/physics/physics_scene.h"
 
+#include <algorithm>
+
 namespace Piccolo
 {
-    CharacterController::CharacterController(const Capsule& capsule) : m_capsule(capsule)
+    namespace
+    {
+        // gap kept between the capsule and what it touches, a sweep starting in contact would report a hit at once
+        constexpr float k_skin_width = 0.01f;
+        // each slide turns along one more surface, a corner of two walls needs two
+        constexpr uint32_t k_max_slide_iterations = 4;
+        constexpr float    k_min_move_distance    = 0.0001f;
+    } // namespace
+
+    CharacterController::CharacterController(const PhysicsControllerConfig& config) :
+        m_capsule(config.m_capsule_shape), m_step_height(std::max(config.m_step_height, 0.f)),
+        m_min_walkable_normal_z(Math::cos(Radian(Degree(config.m_max_slope_angle))))
     {
         m_rigidbody_shape                                    = RigidBodyShape();
         m_rigidbody_shape.m_geometry                         = PICCOLO_REFLECTION_NEW(Capsule);
@@ -21,7 +34,7 @@ namespace Piccolo
         orientation.fromAngleAxis(Radian(Degree(90.f)), Vector3::UNIT_X);
 
         m_rigidbody_shape.m_local_transform =
-            Transform(Vector3(0, 0, capsule.m_half_height + capsule.m_radius), orientation, Vector3::UNIT_SCALE);
+            Transform(Vector3(0, 0, m_capsule.m_half_height + m_capsule.m_radius), orientation, Vector3::UNIT_SCALE);
     }
 
     Vector3 CharacterController::move(const Vector3& current_position, const Vector3& displacement)
@@ -30,15 +43,149 @@ namespace Piccolo
             g_runtime_global_context.m_world_manager->getCurrentActivePhysicsScene().lock();
         ASSERT(physics_scene);
 
-        Vector3 final_position = current_position + displacement;
+        return move(*physics_scene, current_position, displacement);
+    }
+
+    Vector3 CharacterController::move(PhysicsScene&  physics_scene,
+                                      const Vector3& current_position,
+                                      const Vector3& displacement)
+    {
+        const Vector3 horizontal_displacement(displacement.x, displacement.y, 0.f);
+        const bool    is_walking = horizontal_displacement.squaredLength() > k_min_move_distance * k_min_move_distance;
+
+        // steps are climbed while walking on something, also when perched on an edge too steep to stand on
+        const bool is_stepping = m_has_ground_contact && is_walking && m_step_height > 0.f;
 
-        Transform final_transform = Transform(final_position, Quaternion::IDENTITY, Vector3::UNIT_SCALE);
+        Vector3 final_position =
+            moveWithStep(physics_scene, current_position, displacement, is_stepping ? m_step_height : 0.f);
 
-        if (physics_scene->isOverlap(m_rigidbody_shape, final_transform.getMatrix()))
+        // a step has to end on walkable ground or on an edge at most a step high, else the capsule would climb
+        // the edge of anything bit by bit
+        const bool is_step_landed = m_is_grounded || (m_has_ground_contact &&
+                                                      m_ground_contact_height - current_position.z <= m_step_height);
+        if (is_stepping && !is_step_landed)
         {
-            final_position = current_position;
+            final_position = moveWithStep(physics_scene, current_position, displacement, 0.f);
         }
 
         return final_position;
     }
+
+    Vector3 CharacterController::moveWithStep(PhysicsScene&  physics_scene,
+                                              const Vector3& current_position,
+                                              const Vector3& displacement,
+                                              float          step_offset)
+    {
+        Vector3 position = current_position;
+
+        // rise by the step and by a jump, a ceiling stops both
+        const float up_distance = step_offset + std::max(displacement.z, 0.f);
+        if (up_distance > k_min_move_distance)
+        {
+            position = slide(physics_scene, position, Vector3::UNIT_Z * up_distance, SWEEP_PASS_UP);
+        }
+        const float step_up_distance = std::min(position.z - current_position.z, step_offset);
+
+        const Vector3 horizontal_displacement(displacement.x, displacement.y, 0.f);
+        if (horizontal_displacement.squaredLength() > k_min_move_distance * k_min_move_distance)
+        {
+            position = slide(physics_scene, position, horizontal_displacement, SWEEP_PASS_SIDE);
+        }
+
+        // come down the step again and fall. unless rising, ground up to a step below is snapped to, so walking
+        // down stairs keeps the feet on them
+        const float drop_distance = step_up_distance + std::max(-displacement.z, 0.f);
+        const float snap_distance = displacement.z <= 0.f ? m_step_height : 0.f;
+
+        m_is_grounded        = false;
+        m_has_ground_contact = false;
+        if (drop_distance + snap_distance > k_min_move_distance)
+        {
+            PhysicsHitInfo hit;
+            if (sweep(physics_scene,
+                      position,
+                      Vector3::NEGATIVE_UNIT_Z,
+                      drop_distance + snap_distance + k_skin_width,
+                      hit))
+            {
+                position.z -= std::max(hit.hit_distance - k_skin_width, 0.f);
+                m_has_ground_contact    = true;
+                m_ground_contact_height = hit.hit_position.z;
+                // the sweep reports the axis into the surface, the ground normal points out of it
+                m_is_grounded = -hit.hit_normal.z >= m_min_walkable_normal_z;
+            }
+            else
+            {
+                position.z -= drop_distance;
+            }
+        }
+
+        return position;
+    }
+
+    Vector3 CharacterController::slide(PhysicsScene& physics_scene,
+                                       Vector3       position,
+                                       Vector3       displacement,
+                                       SweepPass     pass)
+    {
+        const Vector3 initial_direction = displacement.normalisedCopy();
+
+        for (uint32_t iteration = 0; iteration < k_max_slide_iterations; ++iteration)
+        {
+            const float distance = displacement.length();
+            if (distance < k_min_move_distance)
+            {
+                break;
+            }
+            const Vector3 direction = displacement / distance;
+
+            PhysicsHitInfo hit;
+            if (!sweep(physics_scene, position, direction, distance + k_skin_width, hit))
+            {
+                position += displacement;
+                break;
+            }
+
+            const float travel_distance = std::max(hit.hit_distance - k_skin_width, 0.f);
+            position += direction * travel_distance;
+
+            Vector3 normal = -hit.hit_normal;
+            if (pass == SWEEP_PASS_SIDE && normal.z < m_min_walkable_normal_z)
+            {
+                // walls are slid along horizontally, climbing them is left to the step up. walkable slopes keep
+                // their normal and are walked up
+                normal.z = 0.f;
+                if (normal.squaredLength() < k_min_move_distance)
+                {
+                    break;
+                }
+                normal.normalise();
+            }
+
+            displacement = direction * (distance - travel_distance);
+            displacement -= normal * displacement.dotProduct(normal);
+
+            // in a corner the slide would turn back against the move and bounce between the walls, it stops instead
+            if (displacement.dotProduct(initial_direction) <= 0.f)
+            {
+                break;
+            }
+        }
+
+        return position;
+    }
+
+    bool CharacterController::sweep(PhysicsScene&   physics_scene,
+                                    const Vector3&  position,
+                                    const Vector3&  direction,
+                                    float           length,
+                                    PhysicsHitInfo& out_hit)
+    {
+        if (!m_query_shape.place(m_rigidbody_shape, Matrix4x4::getTrans(position)))
+        {
+            out_hit = PhysicsHitInfo();
+            return false;
+        }
+        return physics_scene.sweep(m_query_shape, direction, length, PhysicsQueryMode::closest_hit, out_hit);
+    }
 } // namespace Piccolo
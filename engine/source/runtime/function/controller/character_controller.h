@@ -1,9 +1,12 @@
 #pragma once
 
 #include "runtime/core/math/vector3.h"
+#include "runtime/resource/res_type/components/motor.h"
 #include "runtime/resource/res_type/components/rigid_body.h"
 #include "runtime/resource/res_type/data/basic_shape.h"
 
+#include "runtime/function/physics/physics_scene.h"
+
 namespace Piccolo
 {
     enum SweepPass
@@ -20,18 +23,52 @@ namespace Piccolo
         virtual ~Controller() = default;
 
         virtual Vector3 move(const Vector3& current_position, const Vector3& displacement) = 0;
+
+        /// whether the last move ended standing on walkable ground
+        virtual bool isGrounded() const = 0;
     };
 
     class CharacterController : public Controller
     {
     public:
-        CharacterController(const Capsule& capsule);
+        CharacterController(const PhysicsControllerConfig& config);
         ~CharacterController() = default;
 
+        /// moves the capsule standing at current_position by displacement and slides it along what it touches.
+        /// walking climbs steps up to the step height and snaps down to ground within the same height, returns
+        /// the position the capsule ends at
         Vector3 move(const Vector3& current_position, const Vector3& displacement) override;
+        /// the same move in the given scene instead of the one of the active level
+        Vector3 move(PhysicsScene& physics_scene, const Vector3& current_position, const Vector3& displacement);
+
+        bool isGrounded() const override { return m_is_grounded; }
 
     private:
+        /// the up, side and down pass of one move, step_offset is how high the capsule is lifted to pass over steps
+        Vector3 moveWithStep(PhysicsScene&  physics_scene,
+                             const Vector3& current_position,
+                             const Vector3& displacement,
+                             float          step_offset);
+
+        /// sweeps along displacement and, on a hit, goes on along the surface with what is left
+        Vector3 slide(PhysicsScene& physics_scene, Vector3 position, Vector3 displacement, SweepPass pass);
+
+        /// closest hit of the capsule standing at position moved by length along direction
+        bool sweep(PhysicsScene&   physics_scene,
+                   const Vector3&  position,
+                   const Vector3&  direction,
+                   float           length,
+                   PhysicsHitInfo& out_hit);
+
         Capsule        m_capsule;
         RigidBodyShape m_rigidbody_shape;
+        // the capsule converted for sweeps, only converted again when its scale changes
+        PhysicsQueryShape m_query_shape;
+
+        float m_step_height {0.f};
+        float m_min_walkable_normal_z {0.f};
+        bool  m_is_grounded {false};
+        bool  m_has_ground_contact {false};
+        float m_ground_contact_height {0.f};
     };
 } // namespace Piccolo
@@ -3,8 +3,21 @@
 #include "runtime/function/animation/animation_system.h"
 #include "runtime/function/framework/object/object.h"
 
+#include <algorithm>
+
 namespace Piccolo
 {
+    namespace
+    {
+        // the blend ratios advance every frame and are not part of the resolved setup
+        bool isSameBlendSetup(const BlendState& lhs, const BlendState& rhs)
+        {
+            return lhs.clip_count == rhs.clip_count && lhs.blend_clip_file_path == rhs.blend_clip_file_path &&
+                   lhs.blend_anim_skel_map_path == rhs.blend_anim_skel_map_path &&
+                   lhs.blend_weight == rhs.blend_weight && lhs.blend_mask_file_path == rhs.blend_mask_file_path;
+        }
+    } // namespace
+
     void AnimationComponent::postLoadResource(std::weak_ptr<GObject> parent_object)
     {
         m_parent_object = parent_object;
@@ -16,12 +29,30 @@ namespace Piccolo
 
     void AnimationComponent::tick(float delta_time)
     {
-        m_animation_res.blend_state.blend_ratio[0] +=
-            (delta_time / m_animation_res.blend_state.blend_clip_file_length[0]);
-        m_animation_res.blend_state.blend_ratio[0] -= floor(m_animation_res.blend_state.blend_ratio[0]);
-
-        m_skeleton.applyAnimation(AnimationManager::getBlendStateWithClipData(m_animation_res.blend_state));
-        m_animation_res.animation_result = m_skeleton.outputAnimationResult();
+        // every clip advances by its own length and loops on its own
+        BlendState&  blend_state = m_animation_res.blend_state;
+        const size_t clip_count  = std::min({static_cast<size_t>(std::max(blend_state.clip_count, 0)),
+                                            blend_state.blend_ratio.size(),
+                                            blend_state.blend_clip_file_length.size()});
+        for (size_t clip_index = 0; clip_index < clip_count; clip_index++)
+        {
+            if (blend_state.blend_clip_file_length[clip_index] <= 0.f)
+            {
+                continue;
+            }
+            float& blend_ratio = blend_state.blend_ratio[clip_index];
+            blend_ratio += delta_time / blend_state.blend_clip_file_length[clip_index];
+            blend_ratio -= floor(blend_ratio);
+        }
+
+        if (!m_blend_state_handles || !isSameBlendSetup(m_animation_res.blend_state, m_resolved_blend_state))
+        {
+            m_blend_state_handles  = AnimationManager::getBlendStateWithClipHandles(m_animation_res.blend_state);
+            m_resolved_blend_state = m_animation_res.blend_state;
+        }
+
+        m_skeleton.applyAnimation(*m_blend_state_handles, m_animation_res.blend_state.blend_ratio);
+        m_skeleton.outputAnimationResult(m_animation_res.animation_result);
     }
 
     const AnimationResult& AnimationComponent::getResult() const { return m_animation_res.animation_result; }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "runtime/function/animation/animation_system.h"
 #include "runtime/function/animation/skeleton.h"
 #include "runtime/function/framework/component/component.h"
 #include "runtime/resource/res_type/components/animation.h"
@@ -10,6 +11,7 @@ namespace Piccolo
     CLASS(AnimationComponent : public Component, WhiteListFields)
     {
         REFLECTION_BODY(AnimationComponent)
+        PICCOLO_POOLED_COMPONENT(AnimationComponent)
 
     public:
         AnimationComponent() = default;
@@ -27,5 +29,10 @@ namespace Piccolo
         AnimationComponentRes m_animation_res;
 
         Skeleton m_skeleton;
+
+        // resolved clips of m_animation_res.blend_state and the setup they were resolved from, re-resolved only when
+        // the clips, masks or weights change
+        std::shared_ptr<const BlendStateWithClipHandles> m_blend_state_handles;
+        BlendState                                       m_resolved_blend_state;
     };
 } // namespace Piccolo
@@ -1,5 +1,6 @@
 #pragma once
 #include "runtime/core/meta/reflection/reflection.h"
+#include "runtime/function/framework/component/component_pool.h"
 
 namespace Piccolo
 {
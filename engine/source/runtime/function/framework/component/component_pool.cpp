@@ -0,0 +1,48 @@
+#include "runtime/function/framework/component/component_pool.h"
+
+#include <algorithm>
+
+namespace Piccolo
+{
+    ComponentPool::ComponentPool(std::size_t slot_size, std::size_t slot_alignment) :
+        m_slot_alignment(std::max(slot_alignment, alignof(FreeSlot)))
+    {
+        // a slot size that is a multiple of the alignment keeps every slot of a chunk aligned
+        m_slot_size = (std::max(slot_size, sizeof(FreeSlot)) + m_slot_alignment - 1) / m_slot_alignment *
+                      m_slot_alignment;
+    }
+
+    void* ComponentPool::allocate()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_free_list == nullptr)
+        {
+            // new slots are chained in address order, so consecutive allocations are adjacent
+            uint8_t* chunk = static_cast<uint8_t*>(
+                ::operator new(m_slot_size * k_slots_per_chunk, std::align_val_t(m_slot_alignment)));
+            for (std::size_t slot_index = k_slots_per_chunk; slot_index > 0; --slot_index)
+            {
+                FreeSlot* slot = reinterpret_cast<FreeSlot*>(chunk + (slot_index - 1) * m_slot_size);
+                slot->m_next   = m_free_list;
+                m_free_list    = slot;
+            }
+            m_chunks.push_back(chunk);
+        }
+
+        FreeSlot* slot = m_free_list;
+        m_free_list    = slot->m_next;
+        return slot;
+    }
+
+    void ComponentPool::deallocate(void* pointer)
+    {
+        if (pointer == nullptr)
+            return;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        FreeSlot* slot = static_cast<FreeSlot*>(pointer);
+        slot->m_next   = m_free_list;
+        m_free_list    = slot;
+    }
+} // namespace Piccolo
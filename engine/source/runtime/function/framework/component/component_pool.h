@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace Piccolo
+{
+    /// contiguous storage for the components of one type
+    ///
+    /// a component type opts in with PICCOLO_POOLED_COMPONENT in its class body, every other type stays on the
+    /// heap. slots are sizeof the type apart and aligned for it, in chunks of k_slots_per_chunk, so a level ticking
+    /// all components of the type walks through a few contiguous blocks. freed slots are reused, chunks are kept
+    /// until exit
+    class ComponentPool
+    {
+    public:
+        ComponentPool(std::size_t slot_size, std::size_t slot_alignment);
+
+        ComponentPool(const ComponentPool&) = delete;
+        ComponentPool& operator=(const ComponentPool&) = delete;
+
+        void* allocate();
+        void  deallocate(void* pointer);
+
+        template<typename TComponent>
+        static ComponentPool& getPool()
+        {
+            // never destroyed, components held by other statics may be released after static destruction began
+            static ComponentPool* pool = new ComponentPool(sizeof(TComponent), alignof(TComponent));
+            return *pool;
+        }
+
+    private:
+        static constexpr std::size_t k_slots_per_chunk = 64;
+
+        struct FreeSlot
+        {
+            FreeSlot* m_next;
+        };
+
+        std::size_t m_slot_size;
+        std::size_t m_slot_alignment;
+
+        std::mutex         m_mutex;
+        std::vector<void*> m_chunks;
+        FreeSlot*          m_free_list {nullptr};
+    };
+
+    /// true for a component type declared with PICCOLO_POOLED_COMPONENT, false for types deriving from one
+    template<typename TComponent, typename = void>
+    struct IsPooledComponent : std::false_type
+    {};
+
+    template<typename TComponent>
+    struct IsPooledComponent<TComponent, std::void_t<typename TComponent::PooledComponentType>>
+        : std::is_same<typename TComponent::PooledComponentType, TComponent>
+    {};
+} // namespace Piccolo
+
+/// allocates the components of class_name from ComponentPool::getPool<class_name>(). a derived class of another
+/// size falls back to the heap
+#define PICCOLO_POOLED_COMPONENT(class_name) \
+public: \
+    using PooledComponentType = class_name; \
+    static void* operator new(std::size_t size) \
+    { \
+        return size == sizeof(class_name) ? ComponentPool::getPool<class_name>().allocate() : ::operator new(size); \
+    } \
+    static void operator delete(void* pointer, std::size_t size) \
+    { \
+        if (size == sizeof(class_name)) \
+            ComponentPool::getPool<class_name>().deallocate(pointer); \
+        else \
+            ::operator delete(pointer); \
+    }
@@ -0,0 +1,21 @@
+#include "runtime/function/framework/component/component_type_index.h"
+
+#include <unordered_map>
+
+namespace Piccolo
+{
+    uint32_t getComponentTypeIndex(const std::string& component_type_name)
+    {
+        static const std::unordered_map<std::string, uint32_t> component_type_indices = []() {
+            std::unordered_map<std::string, uint32_t> indices;
+            for (uint32_t type_index = 0; type_index < k_component_type_count; ++type_index)
+            {
+                indices.emplace(k_component_type_names[type_index], type_index);
+            }
+            return indices;
+        }();
+
+        auto iter = component_type_indices.find(component_type_name);
+        return iter != component_type_indices.end() ? iter->second : k_invalid_component_type_index;
+    }
+} // namespace Piccolo
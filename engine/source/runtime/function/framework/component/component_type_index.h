@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Piccolo
+{
+    /// dense index of a component type, ComponentTypeIndex<TComponent>::value is generated by the meta parser for
+    /// every class derived from Component so that objects can keep their components in a fixed size table
+    template<typename TComponent>
+    struct ComponentTypeIndex;
+
+    constexpr uint32_t k_invalid_component_type_index = UINT32_MAX;
+
+    /// string keyed lookup for the editor and lua, returns k_invalid_component_type_index for unknown names
+    uint32_t getComponentTypeIndex(const std::string& component_type_name);
+} // namespace Piccolo
+
+#include "_generated/reflection/component_type_index.h"
@@ -1,184 +1,308 @@
 #include "runtime/function/framework/component/lua/lua_component.h"
 #include "runtime/core/base/macro.h"
+#include "runtime/function/framework/component/lua/lua_script_manager.h"
 #include "runtime/function/framework/object/object.h"
+#include "runtime/function/global/global_context.h"
+
+#include <cstring>
+#include <deque>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
 namespace Piccolo
 {
 
+    void LuaComponent::openLibraries(sol::state& lua_state)
+    {
+        lua_state.open_libraries(sol::lib::base);
+        lua_state.set_function("set_float", &LuaComponent::set<float>);
+        lua_state.set_function("get_float", &LuaComponent::get<float>);
+        lua_state.set_function("set_int", &LuaComponent::set<int>);
+        lua_state.set_function("get_int", &LuaComponent::get<int>);
+        lua_state.set_function("set_bool", &LuaComponent::set<bool>);
+        lua_state.set_function("get_bool", &LuaComponent::get<bool>);
+        lua_state.set_function("invoke", &LuaComponent::invoke);
+    }
+
+    LuaComponent::~LuaComponent()
+    {
+        // a run kept for the end of the frame must not outlive the state of this component
+        if (g_runtime_global_context.m_lua_script_manager)
+        {
+            g_runtime_global_context.m_lua_script_manager->cancelRuns(this);
+        }
+    }
+
     void LuaComponent::postLoadResource(std::weak_ptr<GObject> parent_object)
     {
         m_parent_object = parent_object;
-        m_lua_state.open_libraries(sol::lib::base);
-        m_lua_state.set_function("set_float", &LuaComponent::set<float>);
-        m_lua_state.set_function("get_bool", &LuaComponent::get<bool>);
-        m_lua_state.set_function("invoke", &LuaComponent::invoke);
-        m_lua_state["GameObject"] = m_parent_object;
+
+        std::shared_ptr<LuaScriptManager> script_manager = g_runtime_global_context.m_lua_script_manager;
+        if (!script_manager->isSharedStateEnabled())
+        {
+            m_lua_state = std::make_unique<sol::state>();
+            openLibraries(*m_lua_state);
+        }
+        sol::state& lua_state = m_lua_state ? *m_lua_state : script_manager->getSharedState();
+
+        // globals the script writes stay in the environment of this object
+        m_lua_environment               = sol::environment(lua_state, sol::create, lua_state.globals());
+        m_lua_environment["GameObject"] = m_parent_object;
+
+        loadScript();
+    }
+
+    void LuaComponent::loadScript()
+    {
+        std::shared_ptr<LuaScriptManager> script_manager = g_runtime_global_context.m_lua_script_manager;
+
+        m_loaded_lua_script = m_lua_script;
+        m_lua_function      = sol::protected_function();
+        m_lua_script_id     = script_manager->compileScript(m_lua_script);
+        if (m_lua_script_id == LuaScriptManager::k_invalid_script_id)
+        {
+            return;
+        }
+
+        sol::state& lua_state = m_lua_state ? *m_lua_state : script_manager->getSharedState();
+        m_lua_function        = script_manager->loadScript(lua_state, m_lua_script_id);
+        if (m_lua_function.valid())
+        {
+            m_lua_environment.set_on(m_lua_function);
+        }
     }
 
     void LuaComponent::tick(float delta_time)
     {
-        // LOG_INFO(m_lua_script);
-        m_lua_state.script(m_lua_script);
+        // the script is compiled once, it is only reloaded when it was edited
+        if (m_lua_script != m_loaded_lua_script)
+        {
+            loadScript();
+        }
+        if (m_lua_function.valid())
+        {
+            g_runtime_global_context.m_lua_script_manager->runScript(this, m_lua_script_id, m_lua_function);
+        }
     }
 
-    /// <summary>
-    /// ڲҲ GameObject ֶָ  set get invokeͨfind_component_fieldʹ÷书
-    /// </summary>
-    /// <param name="game_object">ҵ</param>
-    /// <param name="field_name">Ҫҵֶ</param>
-    /// <param name="field_accessor">ֶ</param>
-    /// <param name="target_instance">ֵֶεĵַ</param>
-    /// <returns></returns>
-    bool find_component_field(std::weak_ptr<GObject> game_object,
-                              const char *field_name,
-                              Reflection::FieldAccessor &field_accessor,
-                              void *&target_instance)
+    namespace
     {
-        auto components = game_object.lock()->getComponents();
+        enum class LuaFieldType : uint8_t
+        {
+            other,
+            boolean,
+            integer,
+            floating
+        };
+
+        template<typename T>
+        constexpr LuaFieldType lua_field_type_of()
+        {
+            if constexpr (std::is_same_v<T, bool>)
+                return LuaFieldType::boolean;
+            else if constexpr (std::is_same_v<T, int>)
+                return LuaFieldType::integer;
+            else if constexpr (std::is_same_v<T, float>)
+                return LuaFieldType::floating;
+            else
+                return LuaFieldType::other;
+        }
 
-        std::istringstream iss(field_name);
-        std::string current_name;
-        std::getline(iss, current_name, '.');
-        auto component_iter = std::find_if(
-            components.begin(), components.end(), [current_name](auto c)
-            { return c.getTypeName() == current_name; });
-        if (component_iter != components.end())
+        LuaFieldType lua_field_type_from_name(const char *type_name)
         {
-            auto meta = Reflection::TypeMeta::newMetaFromName(current_name);
-            void *field_instance = component_iter->getPtr();
+            if (std::strcmp(type_name, "bool") == 0)
+                return LuaFieldType::boolean;
+            if (std::strcmp(type_name, "int") == 0)
+                return LuaFieldType::integer;
+            if (std::strcmp(type_name, "float") == 0)
+                return LuaFieldType::floating;
+            return LuaFieldType::other;
+        }
+
+        /// a dotted path resolved once, "Component.field.field" for fields and "Component.field.method" for methods
+        struct LuaReflectionPath
+        {
+            std::string                            path;
+            bool                                   is_valid {false};
+            uint32_t                               component_type_index {k_invalid_component_type_index};
+            std::vector<Reflection::FieldAccessor> fields;
+            LuaFieldType                           field_type {LuaFieldType::other};
+            Reflection::MethodAccessor             method;
+        };
+
+        /// the reflection registry does not change after startup, so resolved paths (and failed ones) are kept for
+        /// good. lua components tick serially, the caches are not thread safe
+        class LuaReflectionPathCache
+        {
+        public:
+            LuaReflectionPath &getFieldPath(const char *path) { return getPath(m_field_paths, path, false); }
+            LuaReflectionPath &getMethodPath(const char *path) { return getPath(m_method_paths, path, true); }
+
+        private:
+            typedef std::unordered_map<std::string_view, LuaReflectionPath *> PathMap;
+
+            LuaReflectionPath &getPath(PathMap &paths, const char *path, bool ends_with_method)
+            {
+                auto find_it = paths.find(std::string_view(path));
+                if (find_it != paths.end())
+                {
+                    return *find_it->second;
+                }
+
+                // the deque never moves its elements, so the keys may view the strings they own
+                LuaReflectionPath &resolved_path = m_paths.emplace_back();
+                resolved_path.path               = path;
+                resolved_path.is_valid           = resolve(resolved_path, ends_with_method);
+                paths.emplace(std::string_view(resolved_path.path), &resolved_path);
+                return resolved_path;
+            }
 
-            // find target field
-            while (std::getline(iss, current_name, '.'))
+            static bool resolve(LuaReflectionPath &resolved_path, bool ends_with_method)
             {
-                Reflection::FieldAccessor *fields;
-                int fields_count = meta.getFieldsList(fields);
-                auto field_iter = std::find_if(
-                    fields, fields + fields_count, [current_name](auto f)
-                    { return f.getFieldName() == current_name; });
-                if (field_iter == fields + fields_count) // not found
+                std::vector<std::string> names;
+                size_t                   name_begin = 0;
+                while (true)
+                {
+                    const size_t name_end = resolved_path.path.find('.', name_begin);
+                    names.push_back(resolved_path.path.substr(name_begin, name_end - name_begin));
+                    if (name_end == std::string::npos)
+                        break;
+                    name_begin = name_end + 1;
+                }
+
+                // a component alone is neither a field nor a method
+                if (names.size() < 2)
+                {
+                    return false;
+                }
+
+                resolved_path.component_type_index = getComponentTypeIndex(names.front());
+                Reflection::TypeMeta meta          = Reflection::TypeMeta::newMetaFromName(names.front());
+                if (resolved_path.component_type_index == k_invalid_component_type_index || !meta.isValid())
                 {
-                    delete[] fields;
                     return false;
                 }
 
-                field_accessor = *field_iter;
-                delete[] fields;
+                const size_t field_name_end = ends_with_method ? names.size() - 1 : names.size();
+                for (size_t name_index = 1; name_index < field_name_end; ++name_index)
+                {
+                    Reflection::FieldAccessor field = meta.getFieldByName(names[name_index].c_str());
+                    // a field that is not found comes back with the unknown name
+                    if (std::strcmp(field.getFieldName(), names[name_index].c_str()) != 0)
+                    {
+                        return false;
+                    }
+                    resolved_path.fields.push_back(field);
+                    // fields of non reflected types are leaves, a later name can not be found in them
+                    if (!field.getTypeMeta(meta) && name_index + 1 < names.size())
+                    {
+                        return false;
+                    }
+                }
 
-                target_instance = field_instance;
+                if (ends_with_method)
+                {
+                    resolved_path.method = meta.getMethodByName(names.back().c_str());
+                    return std::strcmp(resolved_path.method.getMethodName(), names.back().c_str()) == 0;
+                }
 
-                // for next iteration
-                field_instance = field_accessor.get(target_instance);
-                field_accessor.getTypeMeta(meta);
+                resolved_path.field_type = lua_field_type_from_name(resolved_path.fields.back().getFieldTypeName());
+                return true;
+            }
+
+            std::deque<LuaReflectionPath> m_paths;
+            PathMap                       m_field_paths;
+            PathMap                       m_method_paths;
+        };
+
+        LuaReflectionPathCache g_lua_reflection_path_cache;
+
+        /// walks the resolved fields from the component, returns the instance of the last field or of the component
+        /// when the path has no fields, nullptr when the object lacks the component
+        void *find_path_instance(const std::weak_ptr<GObject> &game_object, LuaReflectionPath &resolved_path)
+        {
+            std::shared_ptr<GObject> object = game_object.lock();
+            if (!object)
+            {
+                return nullptr;
+            }
+
+            void *instance = object->getComponentByTypeIndex(resolved_path.component_type_index);
+            if (instance == nullptr)
+            {
+                return nullptr;
+            }
+            for (Reflection::FieldAccessor &field : resolved_path.fields)
+            {
+                instance = field.get(instance);
             }
-            return true;
+            return instance;
         }
-        return false;
-    }
+    } // namespace
 
     /// <summary>
-    /// ֶͨεֵ
+    /// 通过反射设置字段的值，路径只在第一次访问时解析
     /// </summary>
     template <typename T>
     void LuaComponent::set(std::weak_ptr<GObject> game_object, const char *name, T value)
     {
-        LOG_INFO(name);
-        Reflection::FieldAccessor field_accessor;
-        void *target_instance;
-        if (find_component_field(game_object, name, field_accessor, target_instance))
+        LuaReflectionPath &resolved_path = g_lua_reflection_path_cache.getFieldPath(name);
+        if (!resolved_path.is_valid || resolved_path.field_type != lua_field_type_of<T>())
         {
-            field_accessor.set(target_instance, &value);
+            LOG_ERROR("Can't find target field {}.", name);
+            return;
         }
-        else
+
+        void *field_instance = find_path_instance(game_object, resolved_path);
+        if (field_instance == nullptr)
         {
-            LOG_ERROR("Can't find target field.");
+            LOG_ERROR("Can't find target component {}.", name);
+            return;
         }
+        *static_cast<T *>(field_instance) = value;
     }
 
     /// <summary>
-    /// ͨȡֶεֵ
+    /// 通过反射获取字段的值，路径只在第一次访问时解析
     /// </summary>
     template <typename T>
     T LuaComponent::get(std::weak_ptr<GObject> game_object, const char *name)
     {
-
-        LOG_INFO(name);
-
-        Reflection::FieldAccessor field_accessor;
-        void *target_instance;
-        if (find_component_field(game_object, name, field_accessor, target_instance))
+        LuaReflectionPath &resolved_path = g_lua_reflection_path_cache.getFieldPath(name);
+        if (!resolved_path.is_valid || resolved_path.field_type != lua_field_type_of<T>())
         {
-            return *(T *)field_accessor.get(target_instance);
+            LOG_ERROR("Can't find target field {}.", name);
+            return T {};
         }
-        else
+
+        void *field_instance = find_path_instance(game_object, resolved_path);
+        if (field_instance == nullptr)
         {
-            LOG_ERROR("Can't find target field.");
+            LOG_ERROR("Can't find target component {}.", name);
+            return T {};
         }
+        return *static_cast<T *>(field_instance);
     }
 
     /// <summary>
-    /// ִͨжӦĺ
+    /// 通过反射执行对应的函数，路径只在第一次调用时解析
     /// </summary>
     void LuaComponent::invoke(std::weak_ptr<GObject> game_object, const char *name)
     {
-        LOG_INFO(name);
-
-        Reflection::TypeMeta meta;
-        void *target_instance = nullptr;
-        std::string method_name;
-
-        // get target instance and meta
-        std::string target_name(name);
-        size_t pos = target_name.find_last_of('.');
-        method_name = target_name.substr(pos + 1, target_name.size());
-        target_name = target_name.substr(0, pos);
-
-        if (target_name.find_first_of('.') == target_name.npos)
+        LuaReflectionPath &resolved_path = g_lua_reflection_path_cache.getMethodPath(name);
+        if (!resolved_path.is_valid)
         {
-            // target is a component
-            auto components = game_object.lock()->getComponents();
-
-            auto component_iter = std::find_if(
-                components.begin(), components.end(), [target_name](auto c)
-                { return c.getTypeName() == target_name; });
-            if (component_iter != components.end())
-            {
-                meta = Reflection::TypeMeta::newMetaFromName(target_name);
-                target_instance = component_iter->getPtr();
-            }
-            else
-            {
-                LOG_ERROR("Cand find component");
-                return;
-            }
-        }
-        else
-        {
-            Reflection::FieldAccessor field_accessor;
-            if (find_component_field(game_object, name, field_accessor, target_instance))
-            {
-                target_instance = field_accessor.get(target_instance);
-                field_accessor.getTypeMeta(meta);
-            }
-            else
-            {
-                LOG_ERROR("Can't find target field.");
-                return;
-            }
+            LOG_ERROR("Cand find method {}.", name);
+            return;
         }
 
-        // invoke function
-        Reflection::MethodAccessor *methods;
-        size_t method_count = meta.getMethodsList(methods);
-        auto method_iter = std::find_if(
-            methods, methods + method_count, [method_name](auto m)
-            { return m.getMethodName() == method_name; });
-        if (method_iter != methods + method_count)
-        {
-            method_iter->invoke(target_instance);
-        }
-        else
+        void *target_instance = find_path_instance(game_object, resolved_path);
+        if (target_instance == nullptr)
         {
-            LOG_ERROR("Cand find method");
+            LOG_ERROR("Cand find component {}.", name);
+            return;
         }
-        delete[] methods;
+        resolved_path.method.invoke(target_instance);
     }
 } // namespace Piccolo
@@ -2,6 +2,8 @@
 #include "sol/sol.hpp"
 #include "runtime/function/framework/component/component.h"
 
+#include <memory>
+
 namespace Piccolo
 {
     REFLECTION_TYPE(LuaComponent)
@@ -11,6 +13,7 @@ namespace Piccolo
 
     public:
         LuaComponent() = default;
+        ~LuaComponent() override;
 
         void postLoadResource(std::weak_ptr<GObject> parent_object) override;
 
@@ -24,8 +27,19 @@ namespace Piccolo
 
         static void invoke(std::weak_ptr<GObject> game_object, const char *name);
 
+        // registers the engine functions scripts can call
+        static void openLibraries(sol::state& lua_state);
+
     protected:
-        sol::state m_lua_state;
+        void loadScript();
+
+        // only used when the lua script manager has no shared state
+        std::unique_ptr<sol::state> m_lua_state;
+        sol::environment            m_lua_environment;
+        sol::protected_function     m_lua_function;
+        uint32_t                    m_lua_script_id {UINT32_MAX};
+        std::string                 m_loaded_lua_script;
+
         META(Enable)
         std::string m_lua_script;
     };
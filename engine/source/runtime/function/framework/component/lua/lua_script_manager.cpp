@@ -0,0 +1,184 @@
+#include "runtime/function/framework/component/lua/lua_script_manager.h"
+
+#include "runtime/core/base/macro.h"
+
+#include "runtime/function/framework/component/lua/lua_component.h"
+
+#include <algorithm>
+
+namespace Piccolo
+{
+    void LuaScriptManager::initialize(bool use_shared_state, float frame_budget_ms)
+    {
+        if (use_shared_state)
+        {
+            m_shared_state = std::make_unique<sol::state>();
+            LuaComponent::openLibraries(*m_shared_state);
+        }
+
+        m_frame_budget = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<float, std::milli>(std::max(frame_budget_ms, 0.f)));
+    }
+
+    void LuaScriptManager::clear()
+    {
+        m_script_ids.clear();
+        m_script_bytecodes.clear();
+        m_profiles.clear();
+        m_last_frame_profiles.clear();
+        m_wrapped_runs.clear();
+        m_shared_state.reset();
+    }
+
+    void LuaScriptManager::tick()
+    {
+        m_profiles.swap(m_last_frame_profiles);
+        for (LuaScriptProfile& profile : m_profiles)
+        {
+            profile.m_run_count      = 0;
+            profile.m_deferred_count = 0;
+            profile.m_total_time_ms  = 0.0;
+            profile.m_max_time_ms    = 0.0;
+        }
+
+        if (m_first_deferred_run_index != UINT32_MAX)
+        {
+            m_start_run_index = m_first_deferred_run_index;
+        }
+        else if (m_first_deferred_wrapped_run_index != UINT32_MAX)
+        {
+            m_start_run_index = m_first_deferred_wrapped_run_index;
+        }
+        else
+        {
+            m_start_run_index = 0;
+        }
+        m_first_deferred_run_index         = UINT32_MAX;
+        m_first_deferred_wrapped_run_index = UINT32_MAX;
+        m_run_index                        = 0;
+        m_frame_time                       = Clock::duration::zero();
+        m_wrapped_runs.clear();
+    }
+
+    void LuaScriptManager::finishFrame()
+    {
+        // a script may destroy objects, cancelRuns only clears their runs, so the indices stay valid
+        for (size_t wrapped_run_index = 0; wrapped_run_index < m_wrapped_runs.size(); ++wrapped_run_index)
+        {
+            const WrappedRun& run = m_wrapped_runs[wrapped_run_index];
+            if (run.m_owner == nullptr)
+            {
+                continue;
+            }
+            if (!runBudgeted(run.m_script_id, run.m_function))
+            {
+                m_first_deferred_wrapped_run_index = std::min(m_first_deferred_wrapped_run_index, run.m_run_index);
+            }
+        }
+        m_wrapped_runs.clear();
+    }
+
+    uint32_t LuaScriptManager::compileScript(const std::string& script)
+    {
+        auto find_it = m_script_ids.find(script);
+        if (find_it != m_script_ids.end())
+        {
+            return find_it->second;
+        }
+
+        const uint32_t    script_id  = static_cast<uint32_t>(m_script_bytecodes.size());
+        const std::string chunk_name = "lua_script_" + std::to_string(script_id);
+
+        sol::load_result load_result = m_compile_state.load(script, chunk_name, sol::load_mode::text);
+        if (!load_result.valid())
+        {
+            sol::error error = load_result;
+            LOG_ERROR("failed to compile lua script: {}", error.what());
+            return k_invalid_script_id;
+        }
+
+        sol::protected_function chunk = load_result;
+        m_script_bytecodes.push_back(chunk.dump());
+        m_script_ids.emplace(script, script_id);
+
+        LuaScriptProfile profile;
+        profile.m_chunk_name = chunk_name;
+        m_profiles.push_back(profile);
+        m_last_frame_profiles.push_back(profile);
+        return script_id;
+    }
+
+    sol::protected_function LuaScriptManager::loadScript(sol::state& state, uint32_t script_id) const
+    {
+        sol::load_result load_result = state.load(m_script_bytecodes[script_id].as_string_view(),
+                                                  m_profiles[script_id].m_chunk_name,
+                                                  sol::load_mode::binary);
+        if (!load_result.valid())
+        {
+            sol::error error = load_result;
+            LOG_ERROR("failed to load lua script {}: {}", m_profiles[script_id].m_chunk_name, error.what());
+            return sol::protected_function();
+        }
+        return load_result;
+    }
+
+    bool LuaScriptManager::runScript(const void* owner, uint32_t script_id, const sol::protected_function& function)
+    {
+        const uint32_t run_index = m_run_index++;
+        if (run_index < m_start_run_index)
+        {
+            m_wrapped_runs.push_back(WrappedRun {owner, run_index, script_id, function});
+            return false;
+        }
+        if (!runBudgeted(script_id, function))
+        {
+            m_first_deferred_run_index = std::min(m_first_deferred_run_index, run_index);
+            return false;
+        }
+        return true;
+    }
+
+    void LuaScriptManager::cancelRuns(const void* owner)
+    {
+        for (WrappedRun& run : m_wrapped_runs)
+        {
+            if (run.m_owner == owner)
+            {
+                run.m_owner    = nullptr;
+                run.m_function = sol::protected_function();
+            }
+        }
+    }
+
+    bool LuaScriptManager::runBudgeted(uint32_t script_id, const sol::protected_function& function)
+    {
+        LuaScriptProfile& profile = m_profiles[script_id];
+        if (isOverBudget())
+        {
+            ++profile.m_deferred_count;
+            return false;
+        }
+
+        const Clock::time_point        begin_time = Clock::now();
+        sol::protected_function_result result     = function();
+        const Clock::duration          run_time   = Clock::now() - begin_time;
+
+        if (!result.valid())
+        {
+            sol::error error = result;
+            LOG_ERROR("lua script {} failed: {}", profile.m_chunk_name, error.what());
+        }
+
+        const double run_time_ms = std::chrono::duration<double, std::milli>(run_time).count();
+        m_frame_time += run_time;
+        ++profile.m_run_count;
+        profile.m_total_time_ms += run_time_ms;
+        profile.m_max_time_ms = std::max(profile.m_max_time_ms, run_time_ms);
+        return true;
+    }
+
+    bool LuaScriptManager::isOverBudget() const
+    {
+        return m_frame_budget != Clock::duration::zero() && m_frame_time >= m_frame_budget;
+    }
+} // namespace Piccolo
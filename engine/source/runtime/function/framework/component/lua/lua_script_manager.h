@@ -0,0 +1,100 @@
+#pragma once
+
+#include "sol/sol.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Piccolo
+{
+    /// what one unique script cost in a frame
+    struct LuaScriptProfile
+    {
+        std::string m_chunk_name;
+        uint32_t    m_run_count {0};
+        uint32_t    m_deferred_count {0};
+        double      m_total_time_ms {0.0};
+        double      m_max_time_ms {0.0};
+    };
+
+    /// compiles lua scripts once and runs them under a per frame time budget
+    ///
+    /// scripts with the same text share one compiled chunk, its bytecode is loaded into the state of every component
+    /// running it, so no component lexes or parses the source again. with the shared state enabled all components
+    /// run in one lua state, each one in its own environment whose reads fall back to the globals of the state.
+    /// lua components tick serially, so none of this is thread safe
+    ///
+    /// with a budget the runs of a frame start at the first run deferred in the frame before. the runs ahead of it
+    /// wrap around and wait for finishFrame, so every script gets its turn to run first
+    class LuaScriptManager
+    {
+    public:
+        static constexpr uint32_t k_invalid_script_id = UINT32_MAX;
+
+        /// a frame budget of 0 runs every script every frame
+        void initialize(bool use_shared_state, float frame_budget_ms);
+        void clear();
+
+        /// starts a new frame of the budget and the profiles, called before the world ticks
+        void tick();
+        /// runs the scripts that wrapped around to the end of the frame, called after the world ticked
+        void finishFrame();
+
+        bool        isSharedStateEnabled() const { return m_shared_state != nullptr; }
+        sol::state& getSharedState() { return *m_shared_state; }
+
+        /// compiles the script unless a script with the same text was compiled before, returns k_invalid_script_id
+        /// and logs the error when it does not compile
+        uint32_t compileScript(const std::string& script);
+        /// a new function running the compiled script in the given state
+        sol::protected_function loadScript(sol::state& state, uint32_t script_id) const;
+
+        /// runs the function of the script unless the budget of the frame is used up, returns whether it ran now.
+        /// a run ahead of the start of the frame is kept for finishFrame, owner identifies it for cancelRuns
+        bool runScript(const void* owner, uint32_t script_id, const sol::protected_function& function);
+        /// drops the wrapped runs of owner, which is about to be destroyed
+        void cancelRuns(const void* owner);
+
+        const std::vector<LuaScriptProfile>& getLastFrameProfiles() const { return m_last_frame_profiles; }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct WrappedRun
+        {
+            const void*             m_owner;
+            uint32_t                m_run_index;
+            uint32_t                m_script_id;
+            sol::protected_function m_function;
+        };
+
+        bool isOverBudget() const;
+        bool runBudgeted(uint32_t script_id, const sol::protected_function& function);
+
+        std::unique_ptr<sol::state> m_shared_state;
+        // only compiles scripts, nothing runs in it
+        sol::state m_compile_state;
+
+        std::unordered_map<std::string, uint32_t> m_script_ids;
+        std::vector<sol::bytecode>                m_script_bytecodes;
+
+        std::vector<LuaScriptProfile> m_profiles;
+        std::vector<LuaScriptProfile> m_last_frame_profiles;
+
+        Clock::duration m_frame_budget {Clock::duration::zero()};
+        Clock::duration m_frame_time {Clock::duration::zero()};
+
+        // runs are counted in the order the components tick. the frame starts at m_start_run_index, the runs before
+        // it wrap around into m_wrapped_runs. the next frame starts at the first run deferred in this one, counted
+        // from the start, or at 0 when nothing was deferred
+        uint32_t                m_run_index {0};
+        uint32_t                m_start_run_index {0};
+        uint32_t                m_first_deferred_run_index {UINT32_MAX};
+        uint32_t                m_first_deferred_wrapped_run_index {UINT32_MAX};
+        std::vector<WrappedRun> m_wrapped_runs;
+    };
+} // namespace Piccolo
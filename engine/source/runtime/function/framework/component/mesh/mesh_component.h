@@ -16,12 +16,14 @@ namespace Piccolo
     CLASS(MeshComponent : public Component, WhiteListFields)
     {
         REFLECTION_BODY(MeshComponent)
+        PICCOLO_POOLED_COMPONENT(MeshComponent)
     public:
         MeshComponent() {};
 
         void postLoadResource(std::weak_ptr<GObject> parent_object) override;
 
         const std::vector<GameObjectPartDesc>& getRawMeshes() const { return m_raw_meshes; }
+        const MeshComponentRes&                getMeshRes() const { return m_mesh_res; }
 
         void tick(float delta_time) override;
 
@@ -9,8 +9,16 @@
 #include "runtime/function/render/render_swap_context.h"
 #include "runtime/function/render/render_system.h"
 
+#include <mutex>
+
 namespace Piccolo
 {
+    namespace
+    {
+        // particle components tick in parallel, their requests go into the one logic swap data
+        std::mutex g_particle_swap_data_mutex;
+    } // namespace
+
     void ParticleComponent::postLoadResource(std::weak_ptr<GObject> parent_object)
     {
         m_parent_object = parent_object;
@@ -27,8 +35,7 @@ namespace Piccolo
 
     void ParticleComponent::computeGlobalTransform()
     {
-        TransformComponent* transform_component =
-            m_parent_object.lock()->tryGetComponent<TransformComponent>("TransformComponent");
+        TransformComponent* transform_component = m_parent_object.lock()->tryGetComponent(TransformComponent);
 
         Matrix4x4 global_transform_matrix = transform_component->getMatrix() * m_local_transform;
 
@@ -47,13 +54,18 @@ namespace Piccolo
 
         RenderSwapData& logic_swap_data = swap_context.getLogicSwapData();
 
-        logic_swap_data.addTickParticleEmitter(m_transform_desc.m_id);
-
         TransformComponent* transform_component = m_parent_object.lock()->tryGetComponent(TransformComponent);
-        if (transform_component->isDirty())
+        const bool          is_transform_dirty  = transform_component->isDirty();
+        if (is_transform_dirty)
         {
             computeGlobalTransform();
+        }
+
+        std::lock_guard<std::mutex> lock(g_particle_swap_data_mutex);
 
+        logic_swap_data.addTickParticleEmitter(m_transform_desc.m_id);
+        if (is_transform_dirty)
+        {
             logic_swap_data.updateParticleTransform(m_transform_desc);
         }
     }
@@ -14,6 +14,7 @@ namespace Piccolo
     CLASS(ParticleComponent : public Component, WhiteListFields)
     {
         REFLECTION_BODY(ParticleComponent)
+        PICCOLO_POOLED_COMPONENT(ParticleComponent)
 
     public:
         ParticleComponent() {}
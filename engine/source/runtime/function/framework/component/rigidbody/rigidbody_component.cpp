@@ -27,11 +27,19 @@ namespace Piccolo
             g_runtime_global_context.m_world_manager->getCurrentActivePhysicsScene().lock();
         ASSERT(physics_scene);
 
-        m_rigidbody_id = physics_scene->createRigidBody(parent_transform->getTransformConst(), m_rigidbody_res);
+        // the scene hands the component back with the poses of the bodies it moved
+        m_rigidbody_id = physics_scene->createRigidBody(
+            parent_transform->getTransformConst(), m_rigidbody_res, reinterpret_cast<uint64_t>(this));
     }
 
     RigidBodyComponent::~RigidBodyComponent()
     {
+        // never instantiated, e.g. a definition prototype or a component of a cooked resource
+        if (m_rigidbody_id == 0xffffffff)
+        {
+            return;
+        }
+
         std::shared_ptr<PhysicsScene> physics_scene =
             g_runtime_global_context.m_world_manager->getCurrentActivePhysicsScene().lock();
         ASSERT(physics_scene);
@@ -39,49 +47,40 @@ namespace Piccolo
         physics_scene->removeRigidBody(m_rigidbody_id);
     }
 
-    void RigidBodyComponent::createRigidBody(const Transform& global_transform)
+    void RigidBodyComponent::updateGlobalTransform(const Transform& transform, bool is_scale_dirty)
     {
         std::shared_ptr<PhysicsScene> physics_scene =
             g_runtime_global_context.m_world_manager->getCurrentActivePhysicsScene().lock();
         ASSERT(physics_scene);
 
-        m_rigidbody_id = physics_scene->createRigidBody(global_transform, m_rigidbody_res);
+        // the shapes are scaled in place, the body and its id stay
+        if (is_scale_dirty)
+        {
+            physics_scene->updateRigidBodyShape(m_rigidbody_id, transform, m_rigidbody_res);
+        }
+        physics_scene->updateRigidBodyGlobalTransform(m_rigidbody_id, transform);
     }
 
-    void RigidBodyComponent::removeRigidBody()
+    void RigidBodyComponent::getShapeBoundingBoxes(std::vector<AxisAlignedBox>& out_bounding_boxes) const
     {
         std::shared_ptr<PhysicsScene> physics_scene =
             g_runtime_global_context.m_world_manager->getCurrentActivePhysicsScene().lock();
         ASSERT(physics_scene);
 
-        physics_scene->removeRigidBody(m_rigidbody_id);
+        physics_scene->getShapeBoundingBoxes(m_rigidbody_id, out_bounding_boxes);
     }
 
-    void RigidBodyComponent::updateGlobalTransform(const Transform& transform, bool is_scale_dirty)
+    void RigidBodyComponent::setPhysicsTransform(const Vector3& position, const Quaternion& rotation)
     {
-        if (is_scale_dirty)
-        {
-            removeRigidBody();
+        std::shared_ptr<GObject> parent_object = m_parent_object.lock();
+        if (!parent_object)
+            return;
 
-            createRigidBody(transform);
-        }
-        else
+        TransformComponent* transform_component = parent_object->tryGetComponent(TransformComponent);
+        if (transform_component)
         {
-            std::shared_ptr<PhysicsScene> physics_scene =
-                g_runtime_global_context.m_world_manager->getCurrentActivePhysicsScene().lock();
-            ASSERT(physics_scene);
-
-            physics_scene->updateRigidBodyGlobalTransform(m_rigidbody_id, transform);
+            transform_component->setPhysicsTransform(position, rotation);
         }
     }
 
-    void RigidBodyComponent::getShapeBoundingBoxes(std::vector<AxisAlignedBox>& out_bounding_boxes) const
-    {
-        std::shared_ptr<PhysicsScene> physics_scene =
-            g_runtime_global_context.m_world_manager->getCurrentActivePhysicsScene().lock();
-        ASSERT(physics_scene);
-
-        physics_scene->getShapeBoundingBoxes(m_rigidbody_id, out_bounding_boxes);
-    }
-
 } // namespace Piccolo
@@ -6,10 +6,13 @@
 
 namespace Piccolo
 {
+    class PhysicsScene;
+
     REFLECTION_TYPE(RigidBodyComponent)
     CLASS(RigidBodyComponent : public Component, WhiteListFields)
     {
         REFLECTION_BODY(RigidBodyComponent)
+        PICCOLO_POOLED_COMPONENT(RigidBodyComponent)
     public:
         RigidBodyComponent() = default;
         ~RigidBodyComponent() override;
@@ -20,10 +23,10 @@ namespace Piccolo
         void updateGlobalTransform(const Transform& transform, bool is_scale_dirty);
         void getShapeBoundingBoxes(std::vector<AxisAlignedBox> & out_boudning_boxes) const;
 
-    protected:
-        void createRigidBody(const Transform& global_transform);
-        void removeRigidBody();
+        /// moves the transform of a dynamic body to the pose the simulation gave it
+        void setPhysicsTransform(const Vector3& position, const Quaternion& rotation);
 
+    protected:
         META(Enable)
         RigidBodyComponentRes m_rigidbody_res;
 
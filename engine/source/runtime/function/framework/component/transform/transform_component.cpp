@@ -18,6 +18,7 @@ namespace Piccolo
         m_transform_buffer[m_next_index].m_position = new_translation;
         m_transform.m_position                      = new_translation;
         m_is_dirty                                  = true;
+        m_is_moved_by_physics                       = false;
     }
 
     void TransformComponent::setScale(const Vector3& new_scale)
@@ -26,6 +27,7 @@ namespace Piccolo
         m_transform.m_scale                      = new_scale;
         m_is_dirty                               = true;
         m_is_scale_dirty                         = true;
+        m_is_moved_by_physics                    = false;
     }
 
     void TransformComponent::setRotation(const Quaternion& new_rotation)
@@ -33,17 +35,30 @@ namespace Piccolo
         m_transform_buffer[m_next_index].m_rotation = new_rotation;
         m_transform.m_rotation                      = new_rotation;
         m_is_dirty                                  = true;
+        m_is_moved_by_physics                       = false;
+    }
+
+    void TransformComponent::setPhysicsTransform(const Vector3& new_translation, const Quaternion& new_rotation)
+    {
+        m_transform_buffer[m_next_index].m_position = new_translation;
+        m_transform_buffer[m_next_index].m_rotation = new_rotation;
+        m_transform.m_position                      = new_translation;
+        m_transform.m_rotation                      = new_rotation;
+        m_is_dirty                                  = true;
+        m_is_moved_by_physics                       = true;
     }
 
     void TransformComponent::tick(float delta_time)
     {
         std::swap(m_current_index, m_next_index);
 
-        if (m_is_dirty)
+        // a pose that came from the simulation is not sent back to it
+        if (m_is_dirty && !m_is_moved_by_physics)
         {
             // update transform component, dirty flag will be reset in mesh component
             tryUpdateRigidBodyComponent();
         }
+        m_is_moved_by_physics = false;
 
         if (g_is_editor_mode)
         {
@@ -12,6 +12,7 @@ namespace Piccolo
     CLASS(TransformComponent : public Component, WhiteListFields)
     {
         REFLECTION_BODY(TransformComponent)
+        PICCOLO_POOLED_COMPONENT(TransformComponent)
 
     public:
         TransformComponent() = default;
@@ -28,6 +29,9 @@ namespace Piccolo
 
         void setRotation(const Quaternion& new_rotation);
 
+        /// pose written back by the physics simulation, unlike the setters it is not pushed to the rigid body again
+        void setPhysicsTransform(const Vector3& new_translation, const Quaternion& new_rotation);
+
         const Transform& getTransformConst() const { return m_transform_buffer[m_current_index]; }
         Transform&       getTransform() { return m_transform_buffer[m_next_index]; }
 
@@ -44,5 +48,7 @@ namespace Piccolo
         Transform m_transform_buffer[2];
         size_t    m_current_index {0};
         size_t    m_next_index {1};
+
+        bool m_is_moved_by_physics {false};
     };
 } // namespace Piccolo
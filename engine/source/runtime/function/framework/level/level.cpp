@@ -3,21 +3,194 @@
 #include "runtime/core/base/macro.h"
 
 #include "runtime/resource/asset_manager/asset_manager.h"
+#include "runtime/resource/config_manager/config_manager.h"
 #include "runtime/resource/res_type/common/level.h"
 
 #include "runtime/engine.h"
 #include "runtime/function/character/character.h"
+#include "runtime/function/framework/component/animation/animation_component.h"
+#include "runtime/function/framework/component/camera/camera_component.h"
+#include "runtime/function/framework/component/lua/lua_component.h"
+#include "runtime/function/framework/component/mesh/mesh_component.h"
+#include "runtime/function/framework/component/motor/motor_component.h"
+#include "runtime/function/framework/component/particle/particle_component.h"
+#include "runtime/function/framework/component/rigidbody/rigidbody_component.h"
+#include "runtime/function/framework/component/transform/transform_component.h"
 #include "runtime/function/framework/object/object.h"
+#include "runtime/function/framework/object/object_definition_cache.h"
+#include "runtime/function/global/global_context.h"
+#include "runtime/function/job/job_system.h"
 #include "runtime/function/particle/particle_manager.h"
 #include "runtime/function/physics/physics_manager.h"
 #include "runtime/function/physics/physics_scene.h"
+#include "runtime/function/render/render_mesh_blob.h"
+#include <algorithm>
+#include <filesystem>
 #include <limits>
+#include <unordered_set>
 
 namespace Piccolo
 {
+    namespace
+    {
+        // components handed to one job while ticking a parallel stage
+        constexpr uint32_t k_parallel_tick_batch_size = 16;
+
+        using ComponentBatchTick =
+            void (*)(Component* const* components, uint32_t begin, uint32_t end, float delta_time);
+
+        // the qualified call is bound at compile time, so the tick of the component type is inlined into the loop
+        template<typename TComponent>
+        void tickComponentBatch(Component* const* components, uint32_t begin, uint32_t end, float delta_time)
+        {
+            for (uint32_t component_index = begin; component_index < end; ++component_index)
+            {
+                static_cast<TComponent*>(components[component_index])->TComponent::tick(delta_time);
+            }
+        }
+
+        void tickComponentBatchVirtual(Component* const* components, uint32_t begin, uint32_t end, float delta_time)
+        {
+            for (uint32_t component_index = begin; component_index < end; ++component_index)
+            {
+                components[component_index]->tick(delta_time);
+            }
+        }
+
+        struct ComponentTickStage
+        {
+            uint32_t           m_type_index;
+            ComponentBatchTick m_tick;
+            // the components of this type may tick concurrently with each other: each one only writes itself, only
+            // reads components ticked in earlier stages and only calls into thread safe systems
+            bool m_is_parallel;
+            // the components of this type live in a ComponentPool and are ticked in address order, every other type
+            // keeps the order its objects were created in
+            bool m_is_pooled;
+        };
+
+        template<typename TComponent>
+        ComponentTickStage makeComponentTickStage(bool is_parallel)
+        {
+            return {ComponentTypeIndex<TComponent>::value,
+                    &tickComponentBatch<TComponent>,
+                    is_parallel,
+                    IsPooledComponent<TComponent>::value};
+        }
+
+        // component types are ticked in the order the object definitions list them in, so a component still sees
+        // the components of its own object it depends on already ticked this frame. types missing here follow
+        // serially in index order through the virtual tick
+        const std::vector<ComponentTickStage>& getComponentTickStages()
+        {
+            static const std::vector<ComponentTickStage> tick_stages = []() {
+                std::vector<ComponentTickStage> stages = {makeComponentTickStage<TransformComponent>(false),
+                                                          makeComponentTickStage<AnimationComponent>(true),
+                                                          makeComponentTickStage<MeshComponent>(false),
+                                                          makeComponentTickStage<MotorComponent>(false),
+                                                          makeComponentTickStage<CameraComponent>(false),
+                                                          makeComponentTickStage<LuaComponent>(false),
+                                                          makeComponentTickStage<ParticleComponent>(true),
+                                                          makeComponentTickStage<RigidBodyComponent>(false)};
+                for (uint32_t type_index = 0; type_index < k_component_type_count; ++type_index)
+                {
+                    const bool is_staged =
+                        std::any_of(stages.begin(), stages.end(), [type_index](const ComponentTickStage& stage) {
+                            return stage.m_type_index == type_index;
+                        });
+                    if (!is_staged)
+                    {
+                        stages.push_back({type_index, &tickComponentBatchVirtual, false, false});
+                    }
+                }
+                return stages;
+            }();
+            return tick_stages;
+        }
+
+        void tickComponentStage(const ComponentTickStage& stage,
+                                std::vector<Component*>&  typed_components,
+                                bool&                     is_order_dirty,
+                                float                     delta_time)
+        {
+            if (typed_components.empty() || !shouldComponentTick(k_component_type_names[stage.m_type_index]))
+                return;
+
+            // pooled components are walked in address order, which reused slots and deleted objects disturb. the
+            // address of a heap allocated component says nothing, those types tick in creation order
+            if (stage.m_is_pooled && is_order_dirty)
+            {
+                std::sort(typed_components.begin(), typed_components.end());
+                is_order_dirty = false;
+            }
+
+            const uint32_t component_count = static_cast<uint32_t>(typed_components.size());
+            if (stage.m_is_parallel)
+            {
+                const ComponentBatchTick tick       = stage.m_tick;
+                Component* const*        components = typed_components.data();
+                g_runtime_global_context.m_job_system->parallelFor(
+                    component_count,
+                    k_parallel_tick_batch_size,
+                    [tick, components, delta_time](uint32_t begin, uint32_t end) {
+                        tick(components, begin, end, delta_time);
+                    });
+            }
+            else
+            {
+                stage.m_tick(typed_components.data(), 0, component_count, delta_time);
+            }
+        }
+
+        /// ticks the components of every object whose type is marked in is_type_ticked, object by object in the
+        /// order each object lists them
+        void tickObjectComponents(const LevelObjectsMap&                          objects,
+                                  const std::array<bool, k_component_type_count>& is_type_ticked,
+                                  bool                                            is_unknown_type_ticked,
+                                  float                                           delta_time)
+        {
+            for (const auto& id_object_pair : objects)
+            {
+                assert(id_object_pair.second);
+                if (!id_object_pair.second)
+                    continue;
+
+                for (const auto& component : id_object_pair.second->getComponents())
+                {
+                    const std::string type_name  = component.getTypeName();
+                    const uint32_t    type_index = getComponentTypeIndex(type_name);
+                    const bool        is_ticked  = type_index != k_invalid_component_type_index ?
+                                                       is_type_ticked[type_index] :
+                                                       is_unknown_type_ticked;
+                    if (component && is_ticked && shouldComponentTick(type_name))
+                    {
+                        component->tick(delta_time);
+                    }
+                }
+            }
+        }
+
+        bool isComponentTypePooled(uint32_t type_index)
+        {
+            static const std::array<bool, k_component_type_count> is_type_pooled = []() {
+                std::array<bool, k_component_type_count> is_pooled {};
+                for (const ComponentTickStage& stage : getComponentTickStages())
+                {
+                    is_pooled[stage.m_type_index] = stage.m_is_pooled;
+                }
+                return is_pooled;
+            }();
+            return is_type_pooled[type_index];
+        }
+    } // namespace
+
     void Level::clear()
     {
         m_current_active_character.reset();
+        for (auto& typed_components : m_components_by_type)
+        {
+            typed_components.clear();
+        }
         m_gobjects.clear();
 
         ASSERT(g_runtime_global_context.m_physics_manager);
@@ -25,6 +198,14 @@ namespace Piccolo
     }
 
     GObjectID Level::createObject(const ObjectInstanceRes& object_instance_res)
+    {
+        std::shared_ptr<const ObjectDefinitionRes> definition_res =
+            g_runtime_global_context.m_object_definition_cache->acquire(object_instance_res.m_definition);
+        return createObject(object_instance_res, definition_res);
+    }
+
+    GObjectID Level::createObject(const ObjectInstanceRes&                   object_instance_res,
+                                  std::shared_ptr<const ObjectDefinitionRes> definition_res)
     {
         GObjectID object_id = ObjectIDAllocator::alloc();
         ASSERT(object_id != k_invalid_gobject_id);
@@ -39,10 +220,11 @@ namespace Piccolo
             LOG_FATAL("cannot allocate memory for new gobject");
         }
 
-        bool is_loaded = gobject->load(object_instance_res);
+        bool is_loaded = gobject->load(object_instance_res, definition_res);
         if (is_loaded)
         {
             m_gobjects.emplace(object_id, gobject);
+            registerComponents(*gobject);
         }
         else
         {
@@ -65,15 +247,29 @@ namespace Piccolo
             return false;
         }
 
-        ASSERT(g_runtime_global_context.m_physics_manager);
-        m_physics_scene = g_runtime_global_context.m_physics_manager->createPhysicsScene(level_res.m_gravity);
-        ParticleEmitterIDAllocator::reset();
+        beginLoad(level_res_url, level_res);
 
         for (const ObjectInstanceRes& object_instance_res : level_res.m_objects)
         {
             createObject(object_instance_res);
         }
 
+        finishLoad(level_res);
+
+        return true;
+    }
+
+    void Level::beginLoad(const std::string& level_res_url, const LevelRes& level_res)
+    {
+        m_level_res_url = level_res_url;
+
+        ASSERT(g_runtime_global_context.m_physics_manager);
+        m_physics_scene = g_runtime_global_context.m_physics_manager->createPhysicsScene(level_res.m_gravity);
+        ParticleEmitterIDAllocator::reset();
+    }
+
+    void Level::finishLoad(const LevelRes& level_res)
+    {
         // create active character
         for (const auto& object_pair : m_gobjects)
         {
@@ -90,9 +286,10 @@ namespace Piccolo
 
         m_is_loaded = true;
 
-        LOG_INFO("level load succeed");
+        // definitions only used by levels unloaded in the meantime are not referenced by any object any more
+        g_runtime_global_context.m_object_definition_cache->purgeUnused();
 
-        return true;
+        LOG_INFO("level load succeed");
     }
 
     void Level::unload()
@@ -135,6 +332,85 @@ namespace Piccolo
         return is_save_success;
     }
 
+    bool Level::cook() const
+    {
+        LOG_INFO("cooking level: {}", m_level_res_url);
+        std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
+        ASSERT(asset_manager);
+
+        // cook from the json source rather than from the objects in memory, which may carry unsaved edits
+        LevelRes level_res;
+        if (!asset_manager->loadJsonAsset(m_level_res_url, level_res))
+        {
+            return false;
+        }
+
+        bool is_cook_success = asset_manager->saveCookedAsset(level_res, m_level_res_url);
+
+        std::unordered_set<std::string> cooked_definition_urls;
+        std::unordered_set<std::string> mesh_files;
+
+        auto collect_and_release_components =
+            [&mesh_files](std::vector<Reflection::ReflectionPtr<Component>>& components) {
+                for (auto& component : components)
+                {
+                    if (component && component.getTypeName() == "MeshComponent")
+                    {
+                        const MeshComponent* mesh_component =
+                            static_cast<const MeshComponent*>(component.operator->());
+                        for (const SubMeshRes& sub_mesh : mesh_component->getMeshRes().m_sub_meshes)
+                        {
+                            if (std::filesystem::path(sub_mesh.m_obj_file_ref).extension() == ".json")
+                            {
+                                mesh_files.insert(sub_mesh.m_obj_file_ref);
+                            }
+                        }
+                    }
+                    PICCOLO_REFLECTION_DELETE(component);
+                }
+            };
+
+        for (ObjectInstanceRes& object_instance_res : level_res.m_objects)
+        {
+            collect_and_release_components(object_instance_res.m_instanced_components);
+
+            if (!cooked_definition_urls.insert(object_instance_res.m_definition).second)
+            {
+                continue;
+            }
+
+            ObjectDefinitionRes definition_res;
+            if (asset_manager->loadJsonAsset(object_instance_res.m_definition, definition_res))
+            {
+                is_cook_success &= asset_manager->saveCookedAsset(definition_res, object_instance_res.m_definition);
+            }
+            else
+            {
+                is_cook_success = false;
+            }
+
+            collect_and_release_components(definition_res.m_components);
+        }
+
+        for (const std::string& mesh_file : mesh_files)
+        {
+            is_cook_success &= MeshBlob::cook(mesh_file);
+        }
+
+        if (is_cook_success)
+        {
+            LOG_INFO("level cook succeed, {} object definitions, {} meshes",
+                     cooked_definition_urls.size(),
+                     mesh_files.size());
+        }
+        else
+        {
+            LOG_ERROR("failed to cook {}", m_level_res_url);
+        }
+
+        return is_cook_success;
+    }
+
     void Level::tick(float delta_time)
     {
         if (!m_is_loaded)
@@ -142,30 +418,78 @@ namespace Piccolo
             return;
         }
 
-        //tickؿÿһobject  objecttickÿһ
-        for (const auto& id_object_pair : m_gobjects)
+        if (g_runtime_global_context.m_config_manager->getBatchComponentTick())
         {
-            assert(id_object_pair.second);
-            if (id_object_pair.second)
-            {
-                id_object_pair.second->tick(delta_time);
-            }
+            tickComponentsByType(delta_time);
+        }
+        else
+        {
+            tickComponentsByObject(delta_time);
         }
 
-        //tickɫ
+        //tick角色
         if (m_current_active_character && g_is_editor_mode == false)
         {
             m_current_active_character->tick(delta_time);
         }
 
-        //tick峡
+        //tick物体场景
         std::shared_ptr<PhysicsScene> physics_scene = m_physics_scene.lock();
         if (physics_scene)
         {
             physics_scene->tick(delta_time);
+
+            // 上一物理步中移动过的动态刚体把插值出的位姿写回变换组件，静止与休眠的刚体不被访问
+            for (const PhysicsBodyTransform& body_transform : physics_scene->getMovedBodyTransforms())
+            {
+                reinterpret_cast<RigidBodyComponent*>(body_transform.user_data)
+                    ->setPhysicsTransform(body_transform.position, body_transform.rotation);
+            }
+        }
+    }
+
+    void Level::tickComponentsByType(float delta_time)
+    {
+        //按组件类型依次tick关卡中全部object的组件，同类组件连续更新，可并行的类型分发到任务系统
+        for (const ComponentTickStage& stage : getComponentTickStages())
+        {
+            tickComponentStage(stage,
+                               m_components_by_type[stage.m_type_index],
+                               m_is_component_order_dirty[stage.m_type_index],
+                               delta_time);
         }
     }
 
+    void Level::tickComponentsByObject(float delta_time)
+    {
+        //tick关卡中每一个object，object依次tick它的组件；可并行的类型仍按阶段分发到任务系统，
+        //此前阶段的类型先对全部object tick完，之后阶段的类型在其后再逐object tick
+        std::array<bool, k_component_type_count> is_type_pending {};
+        bool                                     has_pending_type = false;
+        for (const ComponentTickStage& stage : getComponentTickStages())
+        {
+            std::vector<Component*>& typed_components = m_components_by_type[stage.m_type_index];
+            if (stage.m_is_parallel && !typed_components.empty() &&
+                shouldComponentTick(k_component_type_names[stage.m_type_index]))
+            {
+                if (has_pending_type)
+                {
+                    tickObjectComponents(m_gobjects, is_type_pending, false, delta_time);
+                    is_type_pending.fill(false);
+                    has_pending_type = false;
+                }
+                tickComponentStage(
+                    stage, typed_components, m_is_component_order_dirty[stage.m_type_index], delta_time);
+            }
+            else
+            {
+                is_type_pending[stage.m_type_index] = true;
+                has_pending_type                    = true;
+            }
+        }
+        tickObjectComponents(m_gobjects, is_type_pending, true, delta_time);
+    }
+
     std::weak_ptr<GObject> Level::getGObjectByID(GObjectID go_id) const
     {
         auto iter = m_gobjects.find(go_id);
@@ -189,10 +513,52 @@ namespace Piccolo
                 {
                     m_current_active_character->setObject(nullptr);
                 }
+                unregisterComponents(*object);
             }
         }
 
         m_gobjects.erase(go_id);
     }
 
+    void Level::registerComponents(GObject& object)
+    {
+        for (const auto& component : object.getComponents())
+        {
+            const uint32_t type_index = getComponentTypeIndex(component.getTypeName());
+            if (component && type_index != k_invalid_component_type_index)
+            {
+                m_components_by_type[type_index].push_back(component.getPtr());
+                m_is_component_order_dirty[type_index] = true;
+            }
+        }
+    }
+
+    void Level::unregisterComponents(GObject& object)
+    {
+        for (const auto& component : object.getComponents())
+        {
+            const uint32_t type_index = getComponentTypeIndex(component.getTypeName());
+            if (!component || type_index == k_invalid_component_type_index)
+                continue;
+
+            std::vector<Component*>& typed_components = m_components_by_type[type_index];
+
+            auto iter = std::find(typed_components.begin(), typed_components.end(), component.getPtr());
+            if (iter == typed_components.end())
+                continue;
+
+            if (isComponentTypePooled(type_index))
+            {
+                // the list is sorted again before the next batched tick
+                *iter = typed_components.back();
+                typed_components.pop_back();
+                m_is_component_order_dirty[type_index] = true;
+            }
+            else
+            {
+                typed_components.erase(iter);
+            }
+        }
+    }
+
 } // namespace Piccolo
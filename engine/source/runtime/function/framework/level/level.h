@@ -1,15 +1,21 @@
 #pragma once
 
+#include "runtime/function/framework/component/component_type_index.h"
 #include "runtime/function/framework/object/object_id_allocator.h"
 
+#include <array>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace Piccolo
 {
     class Character;
+    class Component;
     class GObject;
+    class LevelRes;
+    class ObjectDefinitionRes;
     class ObjectInstanceRes;
     class PhysicsScene;
 
@@ -21,50 +27,73 @@ namespace Piccolo
     public:
         virtual ~Level(){};
         /// <summary>
-        /// Դ·صǰlevel
+        /// 根据资源路径加载当前level
         /// </summary>
         bool load(const std::string& level_res_url);
 
+        /// <summary>
+        /// 分步加载level：beginLoad创建物理场景，随后逐个createObject，最后finishLoad创建角色并标记加载完成
+        /// 用于LevelLoader在后台线程解析资源后，在主线程分帧创建object
+        /// </summary>
+        void beginLoad(const std::string& level_res_url, const LevelRes& level_res);
+        void finishLoad(const LevelRes& level_res);
+
         void unload();
 
         bool save();
 
+        /// <summary>
+        /// 将当前level的json资源及其引用的object定义、网格烘焙为二进制格式，之后的加载会优先读取烘焙文件
+        /// </summary>
+        bool cook() const;
+
         void tick(float delta_time);
 
         /// <summary>
-        /// ȡǰlevelԴ·
+        /// 获取当前level的资源路径
         /// </summary>
         const std::string& getLevelResUrl() const { return m_level_res_url; }
 
         /// <summary>
-        /// levelеȫobject
+        /// level是否已加载完成，分步加载过程中为false
+        /// </summary>
+        bool isLoaded() const { return m_is_loaded; }
+
+        /// <summary>
+        /// 返回level中的全部object
         /// </summary>
         const LevelObjectsMap& getAllGObjects() const { return m_gobjects; }
 
         /// <summary>
-        /// object_idȡ
+        /// 根据object_id获取物体
         /// </summary>
         std::weak_ptr<GObject> getGObjectByID(GObjectID go_id) const;
 
         /// <summary>
-        /// ȡǰɫָ
+        /// 获取当前角色指针
         /// </summary>
         std::weak_ptr<Character> getCurrentActiveCharacter() const { return m_current_active_character; }
 
         /// <summary>
-        /// һobject
+        /// 创建一个object
         /// </summary>
-        /// <param name="object_instance_res">objectname塢ȫ</param>
+        /// <param name="object_instance_res">object的name、定义、其包含的全部组件</param>
         /// <returns></returns>
         GObjectID createObject(const ObjectInstanceRes& object_instance_res);
 
         /// <summary>
-        /// idɾobject
+        /// 使用已加载的object定义创建object，定义中的组件作为原型被克隆
+        /// </summary>
+        GObjectID createObject(const ObjectInstanceRes&                   object_instance_res,
+                               std::shared_ptr<const ObjectDefinitionRes> definition_res);
+
+        /// <summary>
+        /// 根据id删除object
         /// </summary>
         void deleteGObjectByID(GObjectID go_id);
 
         /// <summary>
-        /// level
+        /// 返回level的物理场景
         /// </summary>
         std::weak_ptr<PhysicsScene> getPhysicsScene() const { return m_physics_scene; }
 
@@ -72,30 +101,53 @@ namespace Piccolo
         void clear();
 
         /// <summary>
-        /// ǰǷ񱻼
+        /// 将object的组件加入/移出按类型分组的组件池
+        /// </summary>
+        void registerComponents(GObject& object);
+        void unregisterComponents(GObject& object);
+
+        /// <summary>
+        /// 按组件类型依次tick全部组件，只在配置开启BatchComponentTick时使用
+        /// </summary>
+        void tickComponentsByType(float delta_time);
+
+        /// <summary>
+        /// 逐object tick组件，BatchComponentTick关闭时使用，可并行的组件类型仍按类型分发到任务系统
+        /// </summary>
+        void tickComponentsByObject(float delta_time);
+
+        /// <summary>
+        /// 当前场景是否被加载
         /// </summary>
         bool m_is_loaded {false};
 
         /// <summary>
-        /// ǰԴ·
+        /// 当前场景的资源路径
         /// </summary>
         std::string m_level_res_url;
 
         /// <summary>
-        /// 洢ǰlevelȫobjectall game objects in this level, key: object id, value: object instance
-        /// һun_map<id,object>
+        /// 存储当前level中全部object：all game objects in this level, key: object id, value: object instance
+        /// 是一个un_map<id,object>
         /// </summary>
         LevelObjectsMap m_gobjects;
 
         /// <summary>
-        /// ǰؿĽɫ
+        /// 当前关卡的角色
         /// </summary>
         std::shared_ptr<Character> m_current_active_character;
 
         /// <summary>
-        /// ǰؿ
-        /// ǰlevelȫobjectײɾ
+        /// 当前关卡的物理场景
+        /// 管理当前level中全部object的物理碰撞，创建、删除、重力等
         /// </summary>
         std::weak_ptr<PhysicsScene> m_physics_scene;
+
+        /// <summary>
+        /// 按ComponentTypeIndex分组的全部组件，开启BatchComponentTick时逐类型遍历，代替逐object遍历
+        /// 组件仍由各自的object持有，池化类型的列表按地址排序以顺序访问，其余类型保持创建顺序
+        /// </summary>
+        std::array<std::vector<Component*>, k_component_type_count> m_components_by_type;
+        std::array<bool, k_component_type_count>                    m_is_component_order_dirty {};
     };
 } // namespace Piccolo
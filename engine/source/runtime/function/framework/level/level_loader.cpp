@@ -0,0 +1,330 @@
+#include "runtime/function/framework/level/level_loader.h"
+
+#include "runtime/core/base/macro.h"
+
+#include "runtime/resource/asset_manager/asset_manager.h"
+#include "runtime/resource/res_type/data/material.h"
+
+#include "runtime/function/framework/component/mesh/mesh_component.h"
+#include "runtime/function/framework/level/level.h"
+#include "runtime/function/framework/object/object_definition_cache.h"
+#include "runtime/function/global/global_context.h"
+#include "runtime/function/render/render_system.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace Piccolo
+{
+    namespace
+    {
+        // main thread time spent instantiating objects per frame, at least one object is published every frame
+        constexpr std::chrono::milliseconds k_publish_time_budget {4};
+        constexpr uint32_t                  k_max_worker_count = 8;
+    } // namespace
+
+    LevelLoader::~LevelLoader() { clear(); }
+
+    void LevelLoader::initialize()
+    {
+        const uint32_t hardware_thread_count = std::thread::hardware_concurrency();
+        const uint32_t worker_count =
+            std::clamp(hardware_thread_count > 1 ? hardware_thread_count - 1 : 1u, 1u, k_max_worker_count);
+
+        m_is_stopping = false;
+        for (uint32_t worker_index = 0; worker_index < worker_count; ++worker_index)
+        {
+            m_workers.emplace_back(&LevelLoader::workerMain, this);
+        }
+    }
+
+    void LevelLoader::clear()
+    {
+        cancel();
+
+        {
+            std::lock_guard<std::mutex> lock(m_job_mutex);
+            m_is_stopping = true;
+        }
+        m_job_condition.notify_all();
+        for (std::thread& worker : m_workers)
+        {
+            worker.join();
+        }
+        m_workers.clear();
+    }
+
+    void LevelLoader::startLoad(const std::string& level_url, std::shared_ptr<Level> level)
+    {
+        cancel();
+
+        LOG_INFO("streaming level: {}", level_url);
+
+        m_level_url = level_url;
+        m_level     = level;
+        m_state     = State::parsing;
+
+        m_total_job_count    = 0;
+        m_finished_job_count = 0;
+        m_is_cancelled       = false;
+        m_is_parse_failed    = false;
+        m_object_count       = 0;
+        m_next_object_index  = 0;
+
+        // leftovers of a previous load that never reached the render system
+        g_runtime_global_context.m_render_system->clearPrefetchedData();
+
+        submit([this]() { parseLevel(); });
+    }
+
+    void LevelLoader::cancel()
+    {
+        m_is_cancelled = true;
+        waitIdle();
+
+        releaseParsedResources();
+
+        if (isLoading())
+        {
+            LOG_WARN("streaming level {} is cancelled", m_level_url);
+            m_state = State::idle;
+        }
+        m_level.reset();
+    }
+
+    void LevelLoader::tick()
+    {
+        if (isParsed())
+        {
+            if (m_is_parse_failed)
+            {
+                LOG_ERROR("streaming level {} failed", m_level_url);
+                releaseParsedResources();
+                m_state = State::failed;
+                return;
+            }
+
+            m_level->beginLoad(m_level_url, m_level_res);
+            m_state = State::publishing;
+        }
+
+        if (m_state == State::publishing)
+        {
+            publishObjects();
+        }
+    }
+
+    float LevelLoader::getProgress() const
+    {
+        switch (m_state)
+        {
+            case State::parsing:
+            case State::publishing:
+            {
+                // parsing jobs and object instantiations are weighted equally, the job total still grows while parsing
+                const float total_work    = static_cast<float>(m_total_job_count + m_object_count);
+                const float finished_work = static_cast<float>(m_finished_job_count + m_next_object_index);
+                return total_work > 0.f ? finished_work / total_work : 0.f;
+            }
+            case State::succeeded:
+                return 1.f;
+            default:
+                return 0.f;
+        }
+    }
+
+    void LevelLoader::submit(std::function<void()> job)
+    {
+        ++m_pending_job_count;
+        ++m_total_job_count;
+        {
+            std::lock_guard<std::mutex> lock(m_job_mutex);
+            m_jobs.push_back(std::move(job));
+        }
+        m_job_condition.notify_one();
+    }
+
+    void LevelLoader::workerMain()
+    {
+        while (true)
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(m_job_mutex);
+                m_job_condition.wait(lock, [this]() { return m_is_stopping || !m_jobs.empty(); });
+                if (m_jobs.empty())
+                {
+                    return;
+                }
+                job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+            }
+
+            if (!m_is_cancelled)
+            {
+                job();
+            }
+
+            ++m_finished_job_count;
+
+            std::lock_guard<std::mutex> lock(m_job_mutex);
+            if (--m_pending_job_count == 0)
+            {
+                m_idle_condition.notify_all();
+            }
+        }
+    }
+
+    void LevelLoader::waitIdle()
+    {
+        std::unique_lock<std::mutex> lock(m_job_mutex);
+        m_idle_condition.wait(lock, [this]() { return m_pending_job_count == 0; });
+    }
+
+    void LevelLoader::parseLevel()
+    {
+        std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
+        ASSERT(asset_manager);
+
+        if (!asset_manager->loadAsset(m_level_url, m_level_res))
+        {
+            m_is_parse_failed = true;
+            return;
+        }
+
+        // every definition is fetched once however many objects share it, the entries are created up front so the
+        // parsing jobs below never modify the map itself
+        for (const ObjectInstanceRes& object_instance_res : m_level_res.m_objects)
+        {
+            m_definitions.emplace(object_instance_res.m_definition, nullptr);
+            prefetchRenderResources(object_instance_res.m_instanced_components);
+        }
+        m_object_count = m_level_res.m_objects.size();
+
+        for (auto& definition_pair : m_definitions)
+        {
+            const std::string& definition_url = definition_pair.first;
+            DefinitionPtr&     definition_res = definition_pair.second;
+            submit([this, &definition_url, &definition_res]() { parseDefinition(definition_url, definition_res); });
+        }
+    }
+
+    void LevelLoader::parseDefinition(const std::string& definition_url, DefinitionPtr& out_definition_res)
+    {
+        out_definition_res = g_runtime_global_context.m_object_definition_cache->acquire(definition_url);
+        if (out_definition_res)
+        {
+            prefetchRenderResources(out_definition_res->m_components);
+        }
+    }
+
+    void LevelLoader::prefetchRenderResources(const std::vector<Reflection::ReflectionPtr<Component>>& components)
+    {
+        std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
+
+        for (const auto& component : components)
+        {
+            if (!component || component.getTypeName() != "MeshComponent")
+            {
+                continue;
+            }
+
+            const MeshComponent* mesh_component = static_cast<const MeshComponent*>(component.operator->());
+            for (const SubMeshRes& sub_mesh : mesh_component->getMeshRes().m_sub_meshes)
+            {
+                // same mesh path the MeshComponent hands to the render system
+                std::string mesh_file = asset_manager->getFullPath(sub_mesh.m_obj_file_ref).generic_string();
+                if (markRequested(mesh_file))
+                {
+                    submit([mesh_file]() {
+                        g_runtime_global_context.m_render_system->prefetchMeshData(MeshSourceDesc {mesh_file});
+                    });
+                }
+
+                if (!sub_mesh.m_material.empty() && markRequested(sub_mesh.m_material))
+                {
+                    std::string material_url = sub_mesh.m_material;
+                    submit([this, material_url]() { prefetchMaterial(material_url); });
+                }
+            }
+        }
+    }
+
+    void LevelLoader::prefetchMaterial(const std::string& material_url)
+    {
+        std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
+
+        MaterialRes material_res;
+        if (!asset_manager->loadAsset(material_url, material_res))
+        {
+            return;
+        }
+
+        // same texture paths the MeshComponent hands to the render system
+        MaterialSourceDesc material_source = {
+            asset_manager->getFullPath(material_res.m_base_colour_texture_file).generic_string(),
+            asset_manager->getFullPath(material_res.m_metallic_roughness_texture_file).generic_string(),
+            asset_manager->getFullPath(material_res.m_normal_texture_file).generic_string(),
+            asset_manager->getFullPath(material_res.m_occlusion_texture_file).generic_string(),
+            asset_manager->getFullPath(material_res.m_emissive_texture_file).generic_string()};
+        g_runtime_global_context.m_render_system->prefetchMaterialData(material_source);
+    }
+
+    bool LevelLoader::markRequested(const std::string& resource_key)
+    {
+        std::lock_guard<std::mutex> lock(m_requested_mutex);
+        return m_requested_resources.insert(resource_key).second;
+    }
+
+    void LevelLoader::publishObjects()
+    {
+        const auto start_time = std::chrono::steady_clock::now();
+
+        while (m_next_object_index < m_level_res.m_objects.size())
+        {
+            const ObjectInstanceRes& object_instance_res = m_level_res.m_objects[m_next_object_index];
+            ++m_next_object_index;
+
+            const DefinitionPtr& definition_res = m_definitions[object_instance_res.m_definition];
+            if (definition_res)
+            {
+                // the object takes over the instanced components
+                m_level->createObject(object_instance_res, definition_res);
+            }
+            else
+            {
+                LOG_ERROR("loading object " + object_instance_res.m_name + " failed");
+                for (auto component : object_instance_res.m_instanced_components)
+                {
+                    PICCOLO_REFLECTION_DELETE(component);
+                }
+            }
+
+            if (std::chrono::steady_clock::now() - start_time > k_publish_time_budget)
+            {
+                return;
+            }
+        }
+
+        m_level->finishLoad(m_level_res);
+        releaseParsedResources();
+        m_state = State::succeeded;
+    }
+
+    void LevelLoader::releaseParsedResources()
+    {
+        // instanced components of objects that were never published are still owned here
+        for (size_t object_index = m_next_object_index; object_index < m_level_res.m_objects.size(); ++object_index)
+        {
+            for (auto& component : m_level_res.m_objects[object_index].m_instanced_components)
+            {
+                PICCOLO_REFLECTION_DELETE(component);
+            }
+        }
+        m_level_res = LevelRes {};
+        m_definitions.clear();
+
+        std::lock_guard<std::mutex> lock(m_requested_mutex);
+        m_requested_resources.clear();
+    }
+} // namespace Piccolo
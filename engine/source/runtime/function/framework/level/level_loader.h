@@ -0,0 +1,110 @@
+#pragma once
+
+#include "runtime/function/framework/component/component.h"
+
+#include "runtime/resource/res_type/common/level.h"
+#include "runtime/resource/res_type/common/object.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Piccolo
+{
+    class Level;
+
+    /// streams a level in without blocking the main loop
+    ///
+    /// a pool of worker threads parses the level, fetches every distinct object definition from the
+    /// ObjectDefinitionCache, parses every material once and reads the meshes and textures they reference into the
+    /// render system's prefetch cache. once all of that is done, tick() instantiates the objects on the main thread a
+    /// few at a time, so every frame keeps running during the load
+    class LevelLoader
+    {
+    public:
+        enum class State : uint8_t
+        {
+            idle,
+            parsing,
+            publishing,
+            succeeded,
+            failed
+        };
+
+        LevelLoader() = default;
+        ~LevelLoader();
+
+        LevelLoader(const LevelLoader&) = delete;
+        LevelLoader& operator=(const LevelLoader&) = delete;
+
+        void initialize();
+        void clear();
+
+        /// main thread only. a load still in flight is cancelled first
+        void startLoad(const std::string& level_url, std::shared_ptr<Level> level);
+        void cancel();
+
+        /// main thread only, once per frame. publishes parsed objects to the level within a small time budget
+        void tick();
+
+        State                  getState() const { return m_state; }
+        bool                   isLoading() const { return m_state == State::parsing || m_state == State::publishing; }
+        bool                   isParsed() const { return m_state == State::parsing && m_pending_job_count == 0; }
+        /// the next tick() starts instantiating objects
+        bool                   isReadyToPublish() const { return isParsed() && !m_is_parse_failed; }
+        float                  getProgress() const;
+        const std::string&     getLevelUrl() const { return m_level_url; }
+        std::shared_ptr<Level> getLevel() const { return m_level; }
+
+    private:
+        using DefinitionPtr = std::shared_ptr<const ObjectDefinitionRes>;
+
+        void submit(std::function<void()> job);
+        void workerMain();
+        void waitIdle();
+
+        void parseLevel();
+        void parseDefinition(const std::string& definition_url, DefinitionPtr& out_definition_res);
+        void prefetchRenderResources(const std::vector<Reflection::ReflectionPtr<Component>>& components);
+        void prefetchMaterial(const std::string& material_url);
+        bool markRequested(const std::string& resource_key);
+
+        void publishObjects();
+        void releaseParsedResources();
+
+        std::vector<std::thread>          m_workers;
+        std::deque<std::function<void()>> m_jobs;
+        std::mutex                        m_job_mutex;
+        std::condition_variable           m_job_condition;
+        std::condition_variable           m_idle_condition;
+        bool                              m_is_stopping {false};
+
+        std::atomic<uint32_t> m_pending_job_count {0};
+        std::atomic<uint32_t> m_total_job_count {0};
+        std::atomic<uint32_t> m_finished_job_count {0};
+        std::atomic<bool>     m_is_cancelled {false};
+        std::atomic<bool>     m_is_parse_failed {false};
+
+        State                  m_state {State::idle};
+        std::string            m_level_url;
+        std::shared_ptr<Level> m_level;
+
+        // written by the workers while parsing, only touched by the main thread once every job has finished
+        LevelRes                                         m_level_res;
+        std::unordered_map<std::string, DefinitionPtr> m_definitions;
+        std::atomic<size_t>                            m_object_count {0};
+        size_t                                         m_next_object_index {0};
+
+        std::mutex                      m_requested_mutex;
+        std::unordered_set<std::string> m_requested_resources;
+    };
+} // namespace Piccolo
@@ -8,6 +8,7 @@
 
 #include "runtime/function/framework/component/component.h"
 #include "runtime/function/framework/component/transform/transform_component.h"
+#include "runtime/function/framework/object/object_definition_cache.h"
 #include "runtime/function/global/global_context.h"
 
 #include <cassert>
@@ -40,7 +41,7 @@ namespace Piccolo
 
     void GObject::tick(float delta_time)
     {
-        //Objectϵcomponent飬tick
+        //遍历Object上的component数组，并依次tick它们
         for (auto& component : m_components)
         {
             if (shouldComponentTick(component.getTypeName()))
@@ -52,24 +53,46 @@ namespace Piccolo
 
     bool GObject::hasComponent(const std::string& compenent_type_name) const
     {
-        for (const auto& component : m_components)
+        return getComponentByTypeName(compenent_type_name) != nullptr;
+    }
+
+    Component* GObject::getComponentByTypeName(const std::string& compenent_type_name) const
+    {
+        const uint32_t type_index = getComponentTypeIndex(compenent_type_name);
+        return type_index != k_invalid_component_type_index ? m_component_table[type_index] : nullptr;
+    }
+
+    void GObject::addComponent(const Reflection::ReflectionPtr<Component>& component)
+    {
+        m_components.push_back(component);
+
+        const uint32_t type_index = getComponentTypeIndex(component.getTypeName());
+        if (type_index != k_invalid_component_type_index)
         {
-            if (component.getTypeName() == compenent_type_name)
-                return true;
+            m_component_table[type_index] = component.getPtr();
         }
-
-        return false;
     }
 
     bool GObject::load(const ObjectInstanceRes& object_instance_res)
+    {
+        return load(object_instance_res,
+                    g_runtime_global_context.m_object_definition_cache->acquire(object_instance_res.m_definition));
+    }
+
+    bool GObject::load(const ObjectInstanceRes&                   object_instance_res,
+                       std::shared_ptr<const ObjectDefinitionRes> definition_res)
     {
         // clear old components
         m_components.clear();
+        m_component_table.fill(nullptr);
 
         setName(object_instance_res.m_name);
 
         // load object instanced components
-        m_components = object_instance_res.m_instanced_components;
+        for (const auto& component : object_instance_res.m_instanced_components)
+        {
+            addComponent(component);
+        }
         for (auto component : m_components)
         {
             if (component)
@@ -80,23 +103,34 @@ namespace Piccolo
 
         // load object definition components
         m_definition_url = object_instance_res.m_definition;
-
-        ObjectDefinitionRes definition_res;
-
-        const bool is_loaded_success = g_runtime_global_context.m_asset_manager->loadAsset(m_definition_url, definition_res);
-        if (!is_loaded_success)
+        m_definition_res = definition_res;
+        if (!m_definition_res)
             return false;
 
-        for (auto loaded_component : definition_res.m_components)
+        // the definition is shared by every object created from it, its components are prototypes and get cloned
+        for (const auto& prototype_component : m_definition_res->m_components)
         {
-            const std::string type_name = loaded_component.getTypeName();
+            if (!prototype_component)
+                continue;
+
+            const std::string type_name = prototype_component.getTypeName();
             // don't create component if it has been instanced
             if (hasComponent(type_name))
                 continue;
 
+            Reflection::ReflectionPtr<Component> loaded_component(
+                type_name,
+                static_cast<Component*>(
+                    Reflection::TypeMeta::cloneByName(type_name, prototype_component.getPtr()).m_instance));
+            if (!loaded_component)
+            {
+                LOG_ERROR("cloning component {} of {} failed", type_name, m_definition_url);
+                return false;
+            }
+
             loaded_component->postLoadResource(weak_from_this());
 
-            m_components.push_back(loaded_component);
+            addComponent(loaded_component);
         }
 
         return true;
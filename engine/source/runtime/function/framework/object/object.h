@@ -1,17 +1,23 @@
 #pragma once
 
 #include "runtime/function/framework/component/component.h"
+#include "runtime/function/framework/component/component_type_index.h"
 #include "runtime/function/framework/object/object_id_allocator.h"
 
 #include "runtime/resource/res_type/common/object.h"
 
+#include <array>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <unordered_set>
 #include <vector>
 
 namespace Piccolo
 {
+    // in editor mode only the component types registered by the editor tick
+    bool shouldComponentTick(std::string component_type_name);
+
     /// GObject : Game Object base class
     class GObject : public std::enable_shared_from_this<GObject>
     {
@@ -24,6 +30,9 @@ namespace Piccolo
         virtual void tick(float delta_time);
 
         bool load(const ObjectInstanceRes& object_instance_res);
+        // definition_res comes from the ObjectDefinitionCache, its components are prototypes and get cloned
+        bool load(const ObjectInstanceRes&                   object_instance_res,
+                  std::shared_ptr<const ObjectDefinitionRes> definition_res);
         void save(ObjectInstanceRes& out_object_instance_res);
 
         GObjectID getID() const { return m_id; }
@@ -33,45 +42,61 @@ namespace Piccolo
 
         bool hasComponent(const std::string& compenent_type_name) const;
 
-        std::vector<Reflection::ReflectionPtr<Component>> getComponents() { return m_components; }
+        const std::vector<Reflection::ReflectionPtr<Component>>& getComponents() const { return m_components; }
+
+        // typed lookup, a single table access
+        template<typename TComponent>
+        TComponent* tryGetComponent()
+        {
+            return static_cast<TComponent*>(
+                m_component_table[ComponentTypeIndex<std::remove_const_t<TComponent>>::value]);
+        }
 
+        template<typename TComponent>
+        const TComponent* tryGetComponentConst() const
+        {
+            return static_cast<const TComponent*>(
+                m_component_table[ComponentTypeIndex<std::remove_const_t<TComponent>>::value]);
+        }
+
+        // string keyed lookup, only meant for the editor and lua which know the type by name
         template<typename TComponent>
         TComponent* tryGetComponent(const std::string& compenent_type_name)
         {
-            for (auto& component : m_components)
-            {
-                if (component.getTypeName() == compenent_type_name)
-                {
-                    return static_cast<TComponent*>(component.operator->());
-                }
-            }
-
-            return nullptr;
+            return static_cast<TComponent*>(getComponentByTypeName(compenent_type_name));
         }
 
         template<typename TComponent>
         const TComponent* tryGetComponentConst(const std::string& compenent_type_name) const
         {
-            for (const auto& component : m_components)
-            {
-                if (component.getTypeName() == compenent_type_name)
-                {
-                    return static_cast<const TComponent*>(component.operator->());
-                }
-            }
-            return nullptr;
+            return static_cast<const TComponent*>(getComponentByTypeName(compenent_type_name));
+        }
+
+        // lookup by an index from getComponentTypeIndex, for callers that resolved a type name once up front
+        Component* getComponentByTypeIndex(uint32_t type_index) const
+        {
+            return type_index < k_component_type_count ? m_component_table[type_index] : nullptr;
         }
 
-#define tryGetComponent(COMPONENT_TYPE) tryGetComponent<COMPONENT_TYPE>(#COMPONENT_TYPE)
-#define tryGetComponentConst(COMPONENT_TYPE) tryGetComponentConst<const COMPONENT_TYPE>(#COMPONENT_TYPE)
+#define tryGetComponent(COMPONENT_TYPE) tryGetComponent<COMPONENT_TYPE>()
+#define tryGetComponentConst(COMPONENT_TYPE) tryGetComponentConst<const COMPONENT_TYPE>()
 
     protected:
+        Component* getComponentByTypeName(const std::string& compenent_type_name) const;
+        void       addComponent(const Reflection::ReflectionPtr<Component>& component);
+
         GObjectID   m_id {k_invalid_gobject_id};
         std::string m_name;
         std::string m_definition_url;
 
+        // keeps the shared definition cached while the object lives
+        std::shared_ptr<const ObjectDefinitionRes> m_definition_res;
+
         // we have to use the ReflectionPtr due to that the components need to be reflected 
         // in editor, and it's polymorphism
         std::vector<Reflection::ReflectionPtr<Component>> m_components;
+
+        // components indexed by ComponentTypeIndex, an object holds at most one component of each type
+        std::array<Component*, k_component_type_count> m_component_table {};
     };
 } // namespace Piccolo
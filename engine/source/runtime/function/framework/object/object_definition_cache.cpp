@@ -0,0 +1,100 @@
+#include "runtime/function/framework/object/object_definition_cache.h"
+
+#include "runtime/resource/asset_manager/asset_manager.h"
+
+#include "runtime/function/framework/component/component.h"
+#include "runtime/function/global/global_context.h"
+
+namespace Piccolo
+{
+    namespace
+    {
+        std::filesystem::file_time_type getSourceWriteTime(const std::string& definition_url)
+        {
+            std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
+
+            // shipped builds may only contain the cooked file
+            std::error_code       error;
+            std::filesystem::path source_path = asset_manager->getFullPath(definition_url);
+            if (!std::filesystem::exists(source_path, error))
+            {
+                source_path = asset_manager->getCookedPath(definition_url);
+            }
+
+            const std::filesystem::file_time_type write_time = std::filesystem::last_write_time(source_path, error);
+            return error ? std::filesystem::file_time_type::min() : write_time;
+        }
+
+        void deleteDefinition(ObjectDefinitionRes* definition_res)
+        {
+            for (auto& component : definition_res->m_components)
+            {
+                PICCOLO_REFLECTION_DELETE(component);
+            }
+            delete definition_res;
+        }
+    } // namespace
+
+    std::shared_ptr<const ObjectDefinitionRes> ObjectDefinitionCache::acquire(const std::string& definition_url)
+    {
+        std::shared_ptr<CacheEntry> entry;
+        {
+            std::lock_guard<std::mutex> lock(m_entries_mutex);
+            std::shared_ptr<CacheEntry>& cached_entry = m_entries[definition_url];
+            if (!cached_entry)
+            {
+                cached_entry = std::make_shared<CacheEntry>();
+            }
+            entry = cached_entry;
+        }
+
+        // concurrent requests of one definition wait for a single parse, other definitions are not blocked
+        std::lock_guard<std::mutex> load_lock(entry->m_load_mutex);
+
+        const std::filesystem::file_time_type source_write_time = getSourceWriteTime(definition_url);
+        if (entry->m_definition_res && entry->m_source_write_time == source_write_time)
+        {
+            return entry->m_definition_res;
+        }
+
+        if (entry->m_definition_res)
+        {
+            LOG_INFO("object definition {} changed on disk, reloading", definition_url);
+        }
+
+        std::shared_ptr<ObjectDefinitionRes> definition_res(new ObjectDefinitionRes(), deleteDefinition);
+        if (!g_runtime_global_context.m_asset_manager->loadAsset(definition_url, *definition_res))
+        {
+            // the stale definition is still better than nothing while the file is being written
+            return entry->m_definition_res;
+        }
+
+        entry->m_definition_res    = definition_res;
+        entry->m_source_write_time = source_write_time;
+        return entry->m_definition_res;
+    }
+
+    void ObjectDefinitionCache::purgeUnused()
+    {
+        std::lock_guard<std::mutex> lock(m_entries_mutex);
+        for (auto entry_iter = m_entries.begin(); entry_iter != m_entries.end();)
+        {
+            // an entry held elsewhere is being acquired right now
+            const std::shared_ptr<CacheEntry>& entry = entry_iter->second;
+            if (entry.use_count() == 1 && entry->m_definition_res.use_count() <= 1)
+            {
+                entry_iter = m_entries.erase(entry_iter);
+            }
+            else
+            {
+                ++entry_iter;
+            }
+        }
+    }
+
+    void ObjectDefinitionCache::clear()
+    {
+        std::lock_guard<std::mutex> lock(m_entries_mutex);
+        m_entries.clear();
+    }
+} // namespace Piccolo
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "runtime/resource/res_type/common/object.h"
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace Piccolo
+{
+    /// parsed object definitions shared by every object created from them, keyed by definition url
+    ///
+    /// a definition is parsed once and its components only serve as prototypes that objects clone. the objects keep
+    /// their definition alive, purgeUnused() drops definitions nobody references any more. a definition whose source
+    /// file changed on disk is parsed again on the next acquire, objects created earlier keep the old one
+    class ObjectDefinitionCache
+    {
+    public:
+        /// thread safe, returns nullptr if the definition can not be loaded
+        std::shared_ptr<const ObjectDefinitionRes> acquire(const std::string& definition_url);
+
+        void purgeUnused();
+        void clear();
+
+    private:
+        struct CacheEntry
+        {
+            std::mutex                                 m_load_mutex;
+            std::shared_ptr<const ObjectDefinitionRes> m_definition_res;
+            std::filesystem::file_time_type            m_source_write_time;
+        };
+
+        std::mutex                                                   m_entries_mutex;
+        std::unordered_map<std::string, std::shared_ptr<CacheEntry>> m_entries;
+    };
+} // namespace Piccolo
@@ -8,7 +8,7 @@ namespace Piccolo
     using GObjectID = std::size_t;
 
     /// <summary>
-    /// Чid
+    /// 无效物体id
     /// </summary>
     constexpr GObjectID k_invalid_gobject_id = std::numeric_limits<std::size_t>::max();
 
@@ -8,6 +8,7 @@
 #include "runtime/function/framework/level/level.h"
 #include "runtime/function/global/global_context.h"
 #include "runtime/function/framework/level/level_debugger.h"
+#include "runtime/function/framework/level/level_loader.h"
 
 #include "_generated/serializer/all_serializer.h"
 
@@ -18,15 +19,26 @@ namespace Piccolo
     void WorldManager::initialize()
     {
         m_is_world_loaded = false;
-        //ȡǰԴ·urlһstring
+        //获取当前世界的资源路径（url），就是一个string
         m_current_world_url = g_runtime_global_context.m_config_manager->getDefaultWorldUrl();
 
         //debugger
         m_level_debugger = std::make_shared<LevelDebugger>();
+
+        m_level_loader = std::make_shared<LevelLoader>();
+        m_level_loader->initialize();
     }
 
     void WorldManager::clear()
     {
+        // stop streaming before the levels it may touch go away
+        if (m_level_loader)
+        {
+            cancelLevelLoading();
+            m_level_loader->clear();
+            m_level_loader.reset();
+        }
+
         // unload all loaded levels
         for (auto level_pair : m_loaded_levels)
         {
@@ -47,14 +59,17 @@ namespace Piccolo
 
     void WorldManager::tick(float delta_time)
     {
-        if (!m_is_world_loaded)//ûмأͼ
+        if (!m_is_world_loaded && !m_level_loader->isLoading())//如果世界没有加载，就加载世界
         {
             loadWorld(m_current_world_url); 
         }
 
-        // µǰĹؿtick
+        // 推进后台加载的关卡
+        tickLevelLoading();
+
+        // 更新当前激活的关卡，并tick它，分帧创建object期间的关卡不tick
         std::shared_ptr<Level> active_level = m_current_active_level.lock();
-        if (active_level)
+        if (active_level && active_level->isLoaded())
         {
             active_level->tick(delta_time);
             m_level_debugger->tick(active_level);
@@ -64,9 +79,9 @@ namespace Piccolo
     std::weak_ptr<PhysicsScene> WorldManager::getCurrentActivePhysicsScene() const
     {
         std::shared_ptr<Level> active_level = m_current_active_level.lock();
-        if (!active_level)//ؿЧ
+        if (!active_level)//如果活动关卡无效
         {
-            return std::weak_ptr<PhysicsScene>();//nullûЧĳ
+            return std::weak_ptr<PhysicsScene>();//返回null，没有有效的场景
         }
         return active_level->getPhysicsScene();
     }
@@ -83,22 +98,92 @@ namespace Piccolo
 
         m_current_world_resource = std::make_shared<WorldRes>(world_res);
 
-        const bool is_level_load_success = loadLevel(world_res.m_default_level_url);
-        if (!is_level_load_success)
+        // the default level is streamed in, the world is loaded once it becomes the active level
+        loadLevelAsync(world_res.m_default_level_url);
+        return true;
+    }
+
+    void WorldManager::loadLevelAsync(const std::string& level_url)
+    {
+        cancelLevelLoading();
+        m_level_loader->startLoad(level_url, std::make_shared<Level>());
+    }
+
+    bool WorldManager::isLevelLoading() const { return m_level_loader && m_level_loader->isLoading(); }
+
+    float WorldManager::getLevelLoadingProgress() const
+    {
+        return m_level_loader ? m_level_loader->getProgress() : 0.f;
+    }
+
+    void WorldManager::tickLevelLoading()
+    {
+        if (!m_level_loader->isLoading())
         {
-            return false;
+            return;
         }
 
-        // set the default level to be active level
-        auto iter = m_loaded_levels.find(world_res.m_default_level_url);
-        ASSERT(iter != m_loaded_levels.end());
+        const std::string      level_url     = m_level_loader->getLevelUrl();
+        std::shared_ptr<Level> loading_level = m_level_loader->getLevel();
 
-        m_current_active_level = iter->second;
+        if (m_level_loader->isReadyToPublish())
+        {
+            // components look the physics scene up through the active level while objects are instantiated, a
+            // level that failed to parse never gets here and leaves the active level alone
+            m_level_active_before_loading = m_current_active_level;
+            m_current_active_level        = loading_level;
+        }
 
-        m_is_world_loaded = true;
+        m_level_loader->tick();
 
-        LOG_INFO("world load succeed!");
-        return true;
+        if (m_level_loader->getState() == LevelLoader::State::succeeded)
+        {
+            // only a complete level replaces the loaded one with the same url
+            auto iter = m_loaded_levels.find(level_url);
+            if (iter != m_loaded_levels.end())
+            {
+                iter->second->unload();
+                m_loaded_levels.erase(iter);
+            }
+
+            m_loaded_levels.emplace(level_url, loading_level);
+            m_current_active_level = loading_level;
+            m_level_active_before_loading.reset();
+
+            if (!m_is_world_loaded)
+            {
+                m_is_world_loaded = true;
+                LOG_INFO("world load succeed!");
+            }
+        }
+        else if (m_level_loader->getState() == LevelLoader::State::failed)
+        {
+            LOG_ERROR("load level failed {}", level_url);
+        }
+    }
+
+    void WorldManager::cancelLevelLoading()
+    {
+        if (!m_level_loader->isLoading())
+        {
+            return;
+        }
+
+        std::shared_ptr<Level> loading_level = m_level_loader->getLevel();
+        const bool is_publishing = m_level_loader->getState() == LevelLoader::State::publishing;
+
+        m_level_loader->cancel();
+
+        // a partially instantiated level owns a physics scene and objects already
+        if (is_publishing)
+        {
+            loading_level->unload();
+            if (m_current_active_level.lock() == loading_level)
+            {
+                m_current_active_level = m_level_active_before_loading;
+            }
+        }
+        m_level_active_before_loading.reset();
     }
 
     bool WorldManager::loadLevel(const std::string& level_url)
@@ -120,6 +205,8 @@ namespace Piccolo
 
     void WorldManager::reloadCurrentLevel()
     {
+        cancelLevelLoading();
+
         auto active_level = m_current_active_level.lock();
         if (active_level == nullptr)
         {
@@ -159,4 +246,17 @@ namespace Piccolo
 
         active_level->save();
     }
+
+    void WorldManager::cookCurrentLevel()
+    {
+        auto active_level = m_current_active_level.lock();
+
+        if (active_level == nullptr)
+        {
+            LOG_ERROR("cook level failed, no active level");
+            return;
+        }
+
+        active_level->cook();
+    }
 } // namespace Piccolo
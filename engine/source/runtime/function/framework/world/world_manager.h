@@ -9,6 +9,7 @@ namespace Piccolo
 {
     class Level;
     class LevelDebugger;
+    class LevelLoader;
     class PhysicsScene;
 
     /// Manage all game worlds, it should be support multiple worlds, including game world and editor world.
@@ -23,17 +24,33 @@ namespace Piccolo
 
         void reloadCurrentLevel();
         void saveCurrentLevel();
+        void cookCurrentLevel();
+
+        /// <summary>
+        /// 在后台线程加载关卡，加载期间主循环照常tick，完成后该关卡成为当前激活关卡
+        /// </summary>
+        void loadLevelAsync(const std::string& level_url);
+
+        /// <summary>
+        /// 是否有关卡正在后台加载
+        /// </summary>
+        bool isLevelLoading() const;
+
+        /// <summary>
+        /// 后台加载关卡的进度，范围[0,1]
+        /// </summary>
+        float getLevelLoadingProgress() const;
 
         void tick(float delta_time);
 
         /// <summary>
-        /// ȡǰؿ
+        /// 获取当前激活关卡
         /// </summary>
         /// <returns></returns>
         std::weak_ptr<Level> getCurrentActiveLevel() const { return m_current_active_level; }
 
         /// <summary>
-        /// ȡǰ
+        /// 获取当前活动的物理场景
         /// </summary>
         std::weak_ptr<PhysicsScene> getCurrentActivePhysicsScene() const;
 
@@ -42,27 +59,43 @@ namespace Piccolo
         bool loadLevel(const std::string& level_url);
 
         /// <summary>
-        /// Ƿ
+        /// 推进后台关卡加载，加载成功后激活该关卡
+        /// </summary>
+        void tickLevelLoading();
+
+        /// <summary>
+        /// 取消后台加载，已创建了部分object的关卡会被卸载，之前激活的关卡恢复激活
+        /// </summary>
+        void cancelLevelLoading();
+
+        /// <summary>
+        /// 世界是否加载
         /// </summary>
         bool m_is_world_loaded {false}; 
 
         /// <summary>
-        /// ǰurl
+        /// 当前世界的url
         /// </summary>
         std::string m_current_world_url;
 
         /// <summary>
-        /// ǰԴ
+        /// 当前世界资源
         /// </summary>
         std::shared_ptr<WorldRes> m_current_world_resource;
 
-        // мعĹؿǹؿURL(·)ֵǶӦĹؿʵ
+        // 所有加载过的关卡，键是关卡URL(路径)，值是对应的关卡实例
         std::unordered_map<std::string, std::shared_ptr<Level>> m_loaded_levels;
 
-        // ǰĹؿ֧һԾؿ
+        // 当前激活的关卡，仅支持一个活跃关卡
         std::weak_ptr<Level> m_current_active_level;
 
-        // ڵԹؿĵ
+        // 后台加载的关卡开始创建object之前激活的关卡，加载被取消时恢复为激活关卡
+        std::weak_ptr<Level> m_level_active_before_loading;
+
+        // 用于调试关卡的调试器
         std::shared_ptr<LevelDebugger> m_level_debugger;
+
+        // 后台加载关卡
+        std::shared_ptr<LevelLoader> m_level_loader;
     };
 } // namespace Piccolo
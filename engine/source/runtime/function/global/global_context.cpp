@@ -10,8 +10,11 @@
 #include "runtime/resource/config_manager/config_manager.h"
 
 #include "runtime/engine.h"
+#include "runtime/function/framework/component/lua/lua_script_manager.h"
+#include "runtime/function/framework/object/object_definition_cache.h"
 #include "runtime/function/framework/world/world_manager.h"
 #include "runtime/function/input/input_system.h"
+#include "runtime/function/job/job_system.h"
 #include "runtime/function/particle/particle_manager.h"
 #include "runtime/function/physics/physics_manager.h"
 #include "runtime/function/render/debugdraw/debug_draw_manager.h"
@@ -24,9 +27,9 @@ namespace Piccolo
     RuntimeGlobalContext g_runtime_global_context;
 
     /// <summary>
-    /// ʼȫĹϵͳ
+    /// 初始化全部的功能系统
     /// </summary>
-    /// <param name="config_file_path">ļ·</param>
+    /// <param name="config_file_path">配置文件路径</param>
     void RuntimeGlobalContext::startSystems(const std::string& config_file_path)
     {
         m_config_manager = std::make_shared<ConfigManager>();
@@ -38,9 +41,24 @@ namespace Piccolo
 
         m_asset_manager = std::make_shared<AssetManager>();
 
+        // 工作线程数默认为硬件线程数减去主线程，配置为0时全部任务在主线程上顺序执行
+        const int      config_worker_count   = m_config_manager->getJobWorkerCount();
+        const uint32_t hardware_thread_count = std::thread::hardware_concurrency();
+        const uint32_t job_worker_count =
+            config_worker_count >= 0 ? static_cast<uint32_t>(config_worker_count) :
+                                       (hardware_thread_count > 1 ? hardware_thread_count - 1 : 0);
+        m_job_system = std::make_shared<JobSystem>();
+        m_job_system->initialize(job_worker_count);
+
+        m_lua_script_manager = std::make_shared<LuaScriptManager>();
+        m_lua_script_manager->initialize(m_config_manager->getLuaSharedState(),
+                                         m_config_manager->getLuaFrameBudgetMs());
+
         m_physics_manager = std::make_shared<PhysicsManager>();
         m_physics_manager->initialize();
 
+        m_object_definition_cache = std::make_shared<ObjectDefinitionCache>();
+
         m_world_manager = std::make_shared<WorldManager>();
         m_world_manager->initialize();
 
@@ -66,7 +84,7 @@ namespace Piccolo
     }
 
     /// <summary>
-    /// رȫϵͳ
+    /// 关闭全部系统
     /// </summary>
     void RuntimeGlobalContext::shutdownSystems()
     {
@@ -82,6 +100,15 @@ namespace Piccolo
         m_world_manager->clear();
         m_world_manager.reset();
 
+        m_lua_script_manager->clear();
+        m_lua_script_manager.reset();
+
+        m_object_definition_cache->clear();
+        m_object_definition_cache.reset();
+
+        m_job_system->clear();
+        m_job_system.reset();
+
         m_physics_manager->clear();
         m_physics_manager.reset();
 
@@ -12,6 +12,9 @@ namespace Piccolo
     class AssetManager;
     class ConfigManager;
     class WorldManager;
+    class ObjectDefinitionCache;
+    class JobSystem;
+    class LuaScriptManager;
     class RenderSystem;
     class WindowSystem;
     class ParticleManager;
@@ -20,38 +23,41 @@ namespace Piccolo
     struct EngineInitParams;
 
     /// <summary>
-    /// ȫϵͳʼ͹ر
+    /// 管理引擎的全部系统，负责初始化和关闭
     ///  Manage the lifetime and creation/destruction order of all global system
     /// </summary>
     class RuntimeGlobalContext
     {
     public:
         /// <summary>
-        /// ʼȫĹϵͳ
+        /// 初始化全部的功能系统
         /// create all global systems and initialize these systems
         /// </summary>
-        /// <param name="config_file_path">ļ·</param>
+        /// <param name="config_file_path">配置文件路径</param>
         void startSystems(const std::string& config_file_path);
 
         /// <summary>
-        /// رȫϵͳ  destroy all global systems
+        /// 关闭全部系统  destroy all global systems
         /// </summary>
         void shutdownSystems();
 
     public:
-        std::shared_ptr<LogSystem>         m_logger_system;     //־
-        std::shared_ptr<InputSystem>       m_input_system;      //
-        std::shared_ptr<FileSystem>        m_file_system;       //ļ
-        std::shared_ptr<AssetManager>      m_asset_manager;     //Դ
-        std::shared_ptr<ConfigManager>     m_config_manager;    //
-        std::shared_ptr<WorldManager>      m_world_manager;     //
-        std::shared_ptr<PhysicsManager>    m_physics_manager;   //
-        std::shared_ptr<WindowSystem>      m_window_system;     //
-        std::shared_ptr<RenderSystem>      m_render_system;     //Ⱦ
-        std::shared_ptr<ParticleManager>   m_particle_manager;  //
-        std::shared_ptr<DebugDrawManager>  m_debugdraw_manager; //
-        std::shared_ptr<RenderDebugConfig> m_render_debug_config;   //Ⱦ
+        std::shared_ptr<LogSystem>             m_logger_system;           //日志
+        std::shared_ptr<InputSystem>           m_input_system;            //输入
+        std::shared_ptr<FileSystem>            m_file_system;             //文件
+        std::shared_ptr<AssetManager>          m_asset_manager;           //资源
+        std::shared_ptr<ConfigManager>         m_config_manager;          //配置
+        std::shared_ptr<JobSystem>             m_job_system;              //任务调度
+        std::shared_ptr<LuaScriptManager>      m_lua_script_manager;      //脚本
+        std::shared_ptr<WorldManager>          m_world_manager;           //世界
+        std::shared_ptr<ObjectDefinitionCache> m_object_definition_cache; //物体定义缓存
+        std::shared_ptr<PhysicsManager>        m_physics_manager;         //物理
+        std::shared_ptr<WindowSystem>          m_window_system;           //窗口
+        std::shared_ptr<RenderSystem>          m_render_system;           //渲染
+        std::shared_ptr<ParticleManager>       m_particle_manager;        //粒子
+        std::shared_ptr<DebugDrawManager>      m_debugdraw_manager;       //调试
+        std::shared_ptr<RenderDebugConfig>     m_render_debug_config;     //渲染调试配置
     };
 
-    extern RuntimeGlobalContext g_runtime_global_context; //ȫֵ
+    extern RuntimeGlobalContext g_runtime_global_context; //全局的运行上下文
 } // namespace Piccolo
\ No newline at end of file
@@ -16,23 +16,23 @@ namespace Piccolo
 
     void InputSystem::onKey(int key, int scancode, int action, int mods)
     {
-        if (!g_is_editor_mode) //Ƿڱ༭״̬
+        if (!g_is_editor_mode) //是否处于编辑状态
         {
             onKeyInGameMode(key, scancode, action, mods);
         }
     }
 
     /// <summary>
-    /// 
+    /// 处理按键输出
     /// </summary>
     void InputSystem::onKeyInGameMode(int key, int scancode, int action, int mods)
     {
-        //ȷڴµİ֮ǰ jump ״̬
+        //确保在处理新的按键之前清除 jump 状态。
         m_game_command &= (k_complement_control_command ^ (unsigned int)GameCommand::jump);
 
-        if (action == GLFW_PRESS) //°ʱ
+        if (action == GLFW_PRESS) //按下按键时
         {
-            switch (key) //ݶӦİm_game_commandӦΪ1
+            switch (key) //根据对应的按键设置m_game_command，将对应按键设置为1
             {
                 case GLFW_KEY_ESCAPE:
                     // close();
@@ -72,9 +72,9 @@ namespace Piccolo
                     break;
             }
         }
-        else if (action == GLFW_RELEASE) //ͷʱ
+        else if (action == GLFW_RELEASE) //按键释放时
         {
-            switch (key)//ݶӦİm_game_commandӦΪ0
+            switch (key)//根据对应的按键设置m_game_command，将对应按键设置为0
             {
                 case GLFW_KEY_ESCAPE:
                     // close();
@@ -106,7 +106,7 @@ namespace Piccolo
     }
 
     /// <summary>
-    /// ƶ
+    /// 计算鼠标的移动
     /// </summary>
     /// <param name="current_cursor_x"></param>
     /// <param name="current_cursor_y"></param>
@@ -122,7 +122,7 @@ namespace Piccolo
     }
 
     /// <summary>
-    /// ƶ
+    /// 清理鼠标移动距离
     /// </summary>
     void InputSystem::clear()
     {
@@ -132,20 +132,20 @@ namespace Piccolo
 
 
     /// <summary>
-    /// λƾƶ
+    /// 根据鼠标位移距离计算移动弧度
     /// </summary>
     void InputSystem::calculateCursorDeltaAngles()
     {
-        //ȡڴС
+        //获取窗口大小
         std::array<int, 2> window_size = g_runtime_global_context.m_window_system->getWindowSize();
-        if (window_size[0] < 1 || window_size[1] < 1) //δȫʼ
+        if (window_size[0] < 1 || window_size[1] < 1) //窗口未完全初始化
         {
             return;
         }
 
-        //ȡȾ
+        //获取渲染相机
         std::shared_ptr<RenderCamera> render_camera = g_runtime_global_context.m_render_system->getRenderCamera();
-        //ȡҰFOV
+        //获取摄像机的视野FOV
         const Vector2& fov = render_camera->getFOV();
 
         Radian cursor_delta_x(Math::degreesToRadians(m_cursor_delta_x));
@@ -157,31 +157,31 @@ namespace Piccolo
 
     void InputSystem::initialize()
     {
-        //ȡϵͳ
+        //获取窗口系统对象
         std::shared_ptr<WindowSystem> window_system = g_runtime_global_context.m_window_system;
         ASSERT(window_system);
 
-        //עᰴ  ԰window_systemд
+        //注册按键函数  所以按键输入检测是在window_system中处理的
         window_system->registerOnKeyFunc(std::bind(&InputSystem::onKey,
                                                    this,
                                                    std::placeholders::_1,
                                                    std::placeholders::_2,
                                                    std::placeholders::_3,
                                                    std::placeholders::_4));
-        //עλûص
+        //注册鼠标光标位置回调
         window_system->registerOnCursorPosFunc(
             std::bind(&InputSystem::onCursorPos, this, std::placeholders::_1, std::placeholders::_2));
     }
 
     void InputSystem::tick()
     {
-        //㻡
+        //计算弧度
         calculateCursorDeltaAngles();
-        //ƶ¼
+        //清空鼠标移动记录
         clear();
 
         std::shared_ptr<WindowSystem> window_system = g_runtime_global_context.m_window_system;
-        if (window_system->getFocusMode()) //Ǿ۽ģʽƶ
+        if (window_system->getFocusMode()) //如果是聚焦模式，则可以移动相机
         {
             m_game_command &= (k_complement_control_command ^ (unsigned int)GameCommand::invalid);
         }
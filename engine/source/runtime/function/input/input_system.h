@@ -25,12 +25,12 @@ namespace Piccolo
 
     public:
         /// <summary>
-        /// ¼
+        /// 处理键盘事件
         /// </summary>
         void onKey(int key, int scancode, int action, int mods);
 
         /// <summary>
-        /// λƾ
+        /// 计算鼠标位移距离
         /// </summary>
         /// <param name="current_cursor_x"></param>
         /// <param name="current_cursor_y"></param>
@@ -41,24 +41,24 @@ namespace Piccolo
         void clear();
 
         /// <summary>
-        /// ¼굱ǰλƣͨm_last_cursorcurrent_cursorɼ
+        /// 记录鼠标当前的位移，通过m_last_cursor和current_cursor可计算出
         /// </summary>
         int m_cursor_delta_x {0};
         int m_cursor_delta_y {0};
 
         /// <summary>
-        /// λƼӦƶĻ
+        /// 根据鼠标的位移计算相机应该移动的弧度
         /// </summary>
         Radian m_cursor_delta_yaw {0};
         Radian m_cursor_delta_pitch {0};
 
         /// <summary>
-        /// ָ
+        /// 重置指令
         /// </summary>
         void resetGameCommand() { m_game_command = 0; }
 
         /// <summary>
-        /// صǰϷָ
+        /// 返回当前的游戏指令
         /// </summary>
         unsigned int getGameCommand() const { return m_game_command; }
 
@@ -66,17 +66,17 @@ namespace Piccolo
         void onKeyInGameMode(int key, int scancode, int action, int mods);
 
         /// <summary>
-        /// λƾƶ
+        /// 根据鼠标位移距离计算移动弧度
         /// </summary>
         void calculateCursorDeltaAngles();
 
         /// <summary>
-        /// ¼ǰϷָ
+        /// 记录当前输入的游戏指令
         /// </summary>
         unsigned int m_game_command {0};
 
         /// <summary>
-        /// ¼һεĹλ
+        /// 记录上一次的光标位置
         /// </summary>
         int m_last_cursor_x {0};
         int m_last_cursor_y {0};
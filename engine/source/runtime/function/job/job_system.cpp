@@ -0,0 +1,163 @@
+#include "runtime/function/job/job_system.h"
+
+#include <algorithm>
+
+namespace Piccolo
+{
+    namespace
+    {
+        // set on worker threads only
+        thread_local const JobSystem* t_worker_owner       = nullptr;
+        thread_local uint32_t         t_worker_queue_index = 0;
+    } // namespace
+
+    JobSystem::~JobSystem() { clear(); }
+
+    void JobSystem::initialize(uint32_t worker_count)
+    {
+        m_is_stopping = false;
+
+        for (uint32_t queue_index = 0; queue_index <= worker_count; ++queue_index)
+        {
+            m_queues.push_back(std::make_unique<JobQueue>());
+        }
+        for (uint32_t worker_index = 0; worker_index < worker_count; ++worker_index)
+        {
+            m_workers.emplace_back(&JobSystem::workerMain, this, worker_index);
+        }
+    }
+
+    void JobSystem::clear()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_sleep_mutex);
+            m_is_stopping = true;
+        }
+        m_sleep_condition.notify_all();
+
+        for (std::thread& worker : m_workers)
+        {
+            worker.join();
+        }
+        m_workers.clear();
+        m_queues.clear();
+    }
+
+    void JobSystem::parallelFor(uint32_t count, uint32_t batch_size, const RangeFunction& job)
+    {
+        if (count == 0)
+            return;
+
+        batch_size = std::max(batch_size, 1u);
+        if (m_workers.empty() || count <= batch_size)
+        {
+            // deterministic fallback, everything runs in order on this thread
+            for (uint32_t begin = 0; begin < count; begin += batch_size)
+            {
+                job(begin, std::min(begin + batch_size, count));
+            }
+            return;
+        }
+
+        const uint32_t job_count   = (count + batch_size - 1) / batch_size;
+        const uint32_t queue_index = getCurrentQueueIndex();
+
+        JobGroup group;
+        group.m_function            = &job;
+        group.m_remaining_job_count = job_count;
+
+        // counted before any job is visible, a worker running one right away decrements the count afterwards, so
+        // it never drops below the jobs actually queued
+        {
+            std::lock_guard<std::mutex> lock(m_sleep_mutex);
+            m_queued_job_count += job_count;
+        }
+
+        // spread the jobs over all queues so the workers start without stealing
+        for (uint32_t job_index = 0; job_index < job_count; ++job_index)
+        {
+            const uint32_t begin = job_index * batch_size;
+            const uint32_t end   = std::min(begin + batch_size, count);
+
+            JobQueue&                   queue = *m_queues[(queue_index + job_index) % m_queues.size()];
+            std::lock_guard<std::mutex> lock(queue.m_mutex);
+            queue.m_jobs.push_back(Job {&group, begin, end});
+        }
+        m_sleep_condition.notify_all();
+
+        // help instead of waiting, the group lives on this stack until its last job finished
+        while (group.m_remaining_job_count.load(std::memory_order_acquire) > 0)
+        {
+            if (!tryRunJob(queue_index))
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void JobSystem::workerMain(uint32_t queue_index)
+    {
+        t_worker_owner       = this;
+        t_worker_queue_index = queue_index;
+
+        while (true)
+        {
+            if (tryRunJob(queue_index))
+                continue;
+
+            std::unique_lock<std::mutex> lock(m_sleep_mutex);
+            m_sleep_condition.wait(lock, [this]() { return m_is_stopping || m_queued_job_count > 0; });
+            if (m_is_stopping)
+                return;
+        }
+    }
+
+    uint32_t JobSystem::getCurrentQueueIndex() const
+    {
+        return t_worker_owner == this ? t_worker_queue_index : static_cast<uint32_t>(m_queues.size() - 1);
+    }
+
+    bool JobSystem::tryRunJob(uint32_t queue_index)
+    {
+        Job job;
+        if (!tryPopJob(queue_index, job) && !tryStealJob(queue_index, job))
+            return false;
+
+        --m_queued_job_count;
+
+        (*job.m_group->m_function)(job.m_begin, job.m_end);
+        job.m_group->m_remaining_job_count.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    bool JobSystem::tryPopJob(uint32_t queue_index, Job& out_job)
+    {
+        JobQueue& queue = *m_queues[queue_index];
+
+        std::lock_guard<std::mutex> lock(queue.m_mutex);
+        if (queue.m_jobs.empty())
+            return false;
+
+        out_job = queue.m_jobs.back();
+        queue.m_jobs.pop_back();
+        return true;
+    }
+
+    bool JobSystem::tryStealJob(uint32_t queue_index, Job& out_job)
+    {
+        const size_t queue_count = m_queues.size();
+        for (size_t offset = 1; offset < queue_count; ++offset)
+        {
+            JobQueue& queue = *m_queues[(queue_index + offset) % queue_count];
+
+            std::lock_guard<std::mutex> lock(queue.m_mutex);
+            if (!queue.m_jobs.empty())
+            {
+                out_job = queue.m_jobs.front();
+                queue.m_jobs.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+} // namespace Piccolo
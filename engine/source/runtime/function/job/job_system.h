@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Piccolo
+{
+    /// engine wide pool of worker threads for short jobs that finish within the frame
+    ///
+    /// every worker owns a queue, it runs its own jobs newest first and steals the oldest jobs of the other queues
+    /// once it runs dry. a thread waiting for parallelFor keeps running jobs instead of blocking. with no workers
+    /// every job runs in order on the calling thread, so a frame stays deterministic
+    class JobSystem
+    {
+    public:
+        using RangeFunction = std::function<void(uint32_t begin, uint32_t end)>;
+
+        ~JobSystem();
+
+        void initialize(uint32_t worker_count);
+        void clear();
+
+        uint32_t getWorkerCount() const { return static_cast<uint32_t>(m_workers.size()); }
+
+        /// calls job for consecutive ranges of at most batch_size indices covering [0, count), returns once every
+        /// range ran. ranges may run concurrently and in any order unless there are no workers
+        void parallelFor(uint32_t count, uint32_t batch_size, const RangeFunction& job);
+
+    private:
+        struct JobGroup
+        {
+            const RangeFunction*  m_function {nullptr};
+            std::atomic<uint32_t> m_remaining_job_count {0};
+        };
+
+        struct Job
+        {
+            JobGroup* m_group {nullptr};
+            uint32_t  m_begin {0};
+            uint32_t  m_end {0};
+        };
+
+        struct JobQueue
+        {
+            std::mutex      m_mutex;
+            std::deque<Job> m_jobs;
+        };
+
+        void     workerMain(uint32_t queue_index);
+        uint32_t getCurrentQueueIndex() const;
+        bool     tryRunJob(uint32_t queue_index);
+        bool     tryPopJob(uint32_t queue_index, Job& out_job);
+        bool     tryStealJob(uint32_t queue_index, Job& out_job);
+
+        std::vector<std::thread> m_workers;
+        // one queue per worker, the last one is shared by all threads that are not workers
+        std::vector<std::unique_ptr<JobQueue>> m_queues;
+
+        std::mutex              m_sleep_mutex;
+        std::condition_variable m_sleep_condition;
+        std::atomic<uint32_t>   m_queued_job_count {0};
+        bool                    m_is_stopping {false};
+    };
+} // namespace Piccolo
@@ -18,10 +18,14 @@ namespace Piccolo
         // job setting
         uint32_t m_max_job_count {1024};
         uint32_t m_max_barrier_count {8};
+        // worker threads of the pool all scenes share
         uint32_t m_max_concurrent_job_count {4};
 
         Vector3 m_gravity {0.f, 0.f, -9.8f};
 
+        // fixed steps per second, the simulation speed does not depend on the frame rate
         float m_update_frequency {60.f};
+        // steps one tick may take to catch up, the time beyond them is dropped
+        uint32_t m_max_substeps {4};
     };
 } // namespace Piccolo
@@ -5,6 +5,7 @@
 #include "runtime/function/framework/world/world_manager.h"
 #include "runtime/function/global/global_context.h"
 #include "runtime/function/physics/jolt/utils.h"
+#include "runtime/function/physics/physics_runtime.h"
 #include "runtime/function/physics/physics_scene.h"
 #include "runtime/function/render/render_system.h"
 
@@ -21,10 +22,25 @@ namespace Piccolo
 {
     void PhysicsManager::initialize()
     {
-#ifdef ENABLE_PHYSICS_DEBUG_RENDERER
         std::shared_ptr<ConfigManager> config_manager = g_runtime_global_context.m_config_manager;
         ASSERT(config_manager);
 
+        if (config_manager->getPhysicsUpdateFrequency() > 0.f)
+        {
+            m_config.m_update_frequency = config_manager->getPhysicsUpdateFrequency();
+        }
+        if (config_manager->getPhysicsMaxSubsteps() > 0)
+        {
+            m_config.m_max_substeps = static_cast<uint32_t>(config_manager->getPhysicsMaxSubsteps());
+        }
+        if (config_manager->getPhysicsWorkerCount() > 0)
+        {
+            m_config.m_max_concurrent_job_count = static_cast<uint32_t>(config_manager->getPhysicsWorkerCount());
+        }
+
+        m_runtime = std::make_unique<PhysicsRuntime>(m_config);
+
+#ifdef ENABLE_PHYSICS_DEBUG_RENDERER
         Trace = TraceImpl;
 
         m_renderer = new Renderer;
@@ -40,6 +56,7 @@ namespace Piccolo
     void PhysicsManager::clear()
     {
         m_scenes.clear();
+        m_runtime.reset();
 
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
         delete m_debug_renderer;
@@ -50,7 +67,7 @@ namespace Piccolo
 
     std::weak_ptr<PhysicsScene> PhysicsManager::createPhysicsScene(const Vector3& gravity)
     {
-        std::shared_ptr<PhysicsScene> physics_scene = std::make_shared<PhysicsScene>(gravity);
+        std::shared_ptr<PhysicsScene> physics_scene = std::make_shared<PhysicsScene>(*m_runtime, gravity, m_config);
 
         m_scenes.push_back(physics_scene);
 
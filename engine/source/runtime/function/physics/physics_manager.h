@@ -2,6 +2,8 @@
 
 #include "runtime/core/math/vector3.h"
 
+#include "runtime/function/physics/physics_config.h"
+
 #include <memory>
 #include <vector>
 
@@ -17,6 +19,7 @@ namespace JPH
 
 namespace Piccolo
 {
+    class PhysicsRuntime;
     class PhysicsScene;
 
     class PhysicsManager
@@ -34,7 +37,17 @@ namespace Piccolo
 
     protected:
         /// <summary>
-        /// 飬аȫlevel
+        /// 新建物理场景使用的配置
+        /// </summary>
+        PhysicsConfig m_config;
+
+        /// <summary>
+        /// 所有物理场景共享的jolt运行时，须在场景之后销毁
+        /// </summary>
+        std::unique_ptr<PhysicsRuntime> m_runtime;
+
+        /// <summary>
+        /// 物理场景数组，其中包含全部level的物理场景
         /// </summary>
         std::vector<std::shared_ptr<PhysicsScene>> m_scenes;
 
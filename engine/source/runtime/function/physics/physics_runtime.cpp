@@ -0,0 +1,91 @@
+#include "runtime/function/physics/physics_runtime.h"
+
+#include "Jolt/Jolt.h"
+#include "Jolt/RegisterTypes.h"
+
+#include "Jolt/Core/Color.h"
+#include "Jolt/Core/Factory.h"
+#include "Jolt/Core/JobSystemThreadPool.h"
+#include "Jolt/Core/TempAllocator.h"
+
+#include <algorithm>
+
+namespace Piccolo
+{
+    namespace
+    {
+        // temp memory of one step, enough for the contact and constraint data of a full scene
+        constexpr uint32_t k_physics_temp_allocator_size = 16 * 1024 * 1024;
+    } // namespace
+
+    PhysicsRuntime::PhysicsRuntime(const PhysicsConfig& config)
+    {
+        JPH::Factory::sInstance = new JPH::Factory();
+        JPH::RegisterTypes();
+
+        m_job_system = std::make_unique<JPH::JobSystemThreadPool>(config.m_max_job_count,
+                                                                  config.m_max_barrier_count,
+                                                                  static_cast<int>(config.m_max_concurrent_job_count));
+
+        // the common case of one scene stepping at a time never allocates again
+        m_temp_allocators.push_back(std::make_unique<JPH::TempAllocatorImpl>(k_physics_temp_allocator_size));
+        m_free_temp_allocators.push_back(m_temp_allocators.back().get());
+    }
+
+    PhysicsRuntime::~PhysicsRuntime()
+    {
+        m_free_temp_allocators.clear();
+        m_temp_allocators.clear();
+        m_job_system.reset();
+
+        delete JPH::Factory::sInstance;
+        JPH::Factory::sInstance = nullptr;
+    }
+
+    JPH::TempAllocator* PhysicsRuntime::acquireTempAllocator()
+    {
+        std::lock_guard<std::mutex> lock(m_temp_allocator_mutex);
+
+        if (m_free_temp_allocators.empty())
+        {
+            m_temp_allocators.push_back(std::make_unique<JPH::TempAllocatorImpl>(k_physics_temp_allocator_size));
+            return m_temp_allocators.back().get();
+        }
+
+        JPH::TempAllocator* temp_allocator = m_free_temp_allocators.back();
+        m_free_temp_allocators.pop_back();
+        return temp_allocator;
+    }
+
+    void PhysicsRuntime::releaseTempAllocator(JPH::TempAllocator* temp_allocator)
+    {
+        std::lock_guard<std::mutex> lock(m_temp_allocator_mutex);
+        m_free_temp_allocators.push_back(temp_allocator);
+    }
+
+    void PhysicsRuntime::parallelFor(uint32_t count, uint32_t batch_size, const RangeFunction& job)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        batch_size = std::max(batch_size, 1u);
+        if (count <= batch_size)
+        {
+            job(0, count);
+            return;
+        }
+
+        JPH::JobSystem::Barrier* barrier = m_job_system->CreateBarrier();
+        for (uint32_t begin = 0; begin < count; begin += batch_size)
+        {
+            const uint32_t end = std::min(begin + batch_size, count);
+            barrier->AddJob(m_job_system->CreateJob("PhysicsParallelFor", JPH::Color::sGreen, [&job, begin, end]() {
+                job(begin, end);
+            }));
+        }
+        m_job_system->WaitForJobs(barrier);
+        m_job_system->DestroyBarrier(barrier);
+    }
+} // namespace Piccolo
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "runtime/function/physics/physics_config.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace JPH
+{
+    class JobSystem;
+    class TempAllocator;
+} // namespace JPH
+
+namespace Piccolo
+{
+    /// the Jolt state all physics scenes share: the type registry, one pool of worker threads and the temp memory
+    /// of a step. the physics manager owns it for the lifetime of the engine, so loading a level creates neither
+    /// threads nor allocators
+    class PhysicsRuntime
+    {
+    public:
+        using RangeFunction = std::function<void(uint32_t begin, uint32_t end)>;
+
+        explicit PhysicsRuntime(const PhysicsConfig& config);
+        ~PhysicsRuntime();
+
+        PhysicsRuntime(const PhysicsRuntime&) = delete;
+        PhysicsRuntime& operator=(const PhysicsRuntime&) = delete;
+
+        JPH::JobSystem* getJobSystem() const { return m_job_system.get(); }
+
+        /// temp memory is a stack that only one step may use at a time. scenes stepping on different threads get
+        /// an allocator each, released allocators are kept for the next step
+        JPH::TempAllocator* acquireTempAllocator();
+        void                releaseTempAllocator(JPH::TempAllocator* temp_allocator);
+
+        /// calls job for consecutive ranges of at most batch_size indices covering [0, count) on the physics workers,
+        /// returns once every range ran. the calling thread runs ranges too while it waits
+        void parallelFor(uint32_t count, uint32_t batch_size, const RangeFunction& job);
+
+    private:
+        std::unique_ptr<JPH::JobSystem> m_job_system;
+
+        std::mutex                                       m_temp_allocator_mutex;
+        std::vector<std::unique_ptr<JPH::TempAllocator>> m_temp_allocators;
+        std::vector<JPH::TempAllocator*>                 m_free_temp_allocators;
+    };
+} // namespace Piccolo
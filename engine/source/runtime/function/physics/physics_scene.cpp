@@ -6,16 +6,15 @@
 
 #include "runtime/function/physics/jolt/utils.h"
 #include "runtime/function/physics/physics_config.h"
+#include "runtime/function/physics/physics_runtime.h"
 
 #include "Jolt/Jolt.h"
-#include "Jolt/RegisterTypes.h"
 
-#include "Jolt/Core/Factory.h"
 #include "Jolt/Core/JobSystem.h"
-#include "Jolt/Core/JobSystemThreadPool.h"
 #include "Jolt/Core/TempAllocator.h"
 
 #include "Jolt/Physics/Body/BodyCreationSettings.h"
+#include "Jolt/Physics/Body/MassProperties.h"
 #include "Jolt/Physics/Collision/CastResult.h"
 #include "Jolt/Physics/Collision/CollideShape.h"
 #include "Jolt/Physics/Collision/CollisionCollectorImpl.h"
@@ -29,25 +28,114 @@
 #include "Jolt/Physics/Collision/ShapeCast.h"
 #include "Jolt/Physics/PhysicsSystem.h"
 
+#include <algorithm>
+
 namespace Piccolo
 {
-    PhysicsScene::PhysicsScene(const Vector3& gravity)
+    namespace
     {
-        static_assert(s_invalid_rigidbody_id == JPH::BodyID::cInvalidBodyID);
+        // batches smaller than this run on the calling thread, waking the workers would cost more than the queries
+        constexpr uint32_t k_parallel_query_min_count = 64;
+
+        void getRaycastHit(const JPH::PhysicsSystem& physics_system,
+                           const JPH::RayCast&       ray,
+                           float                     ray_length,
+                           const JPH::RayCastResult& cast_result,
+                           PhysicsHitInfo&           out_hit)
+        {
+            out_hit.hit_position = toVec3(ray.mOrigin + cast_result.mFraction * ray.mDirection);
+            out_hit.hit_distance = cast_result.mFraction * ray_length;
+            out_hit.body_id      = cast_result.mBodyID.GetIndexAndSequenceNumber();
 
-        JPH::Factory::sInstance = new JPH::Factory();
-        JPH::RegisterTypes();
+            // get hit normal
+            JPH::BodyLockRead body_lock(physics_system.GetBodyLockInterface(), cast_result.mBodyID);
+            if (body_lock.Succeeded())
+            {
+                const JPH::Body& hit_body = body_lock.GetBody();
+                out_hit.hit_normal =
+                    toVec3(hit_body.GetWorldSpaceSurfaceNormal(cast_result.mSubShapeID2, toVec3(out_hit.hit_position)));
+            }
+        }
 
-        m_physics.m_jolt_physics_system              = new JPH::PhysicsSystem();
-        m_physics.m_jolt_broad_phase_layer_interface = new BPLayerInterfaceImpl();
+        /// all shapes of a rigid body in one compound, each scaled by its global scale
+        JPH::RefConst<JPH::Shape> createBodyShape(const Transform&             global_transform,
+                                                  const RigidBodyComponentRes& rigidbody_actor_res)
+        {
+            JPH::Ref<JPH::StaticCompoundShapeSettings> compund_shape_setting = new JPH::StaticCompoundShapeSettings;
+            for (const RigidBodyShape& shape : rigidbody_actor_res.m_shapes)
+            {
+                const Matrix4x4 shape_global_transform =
+                    global_transform.getMatrix() * shape.m_local_transform.getMatrix();
+
+                Vector3    global_position, global_scale;
+                Quaternion global_rotation;
+                shape_global_transform.decomposition(global_position, global_scale, global_rotation);
+
+                JPH::Shape* jph_shape = toShape(shape, global_scale);
+                if (jph_shape)
+                {
+                    compund_shape_setting->AddShape(toVec3(shape.m_local_transform.m_position * global_scale),
+                                                    toQuat(shape.m_local_transform.m_rotation),
+                                                    jph_shape);
+                }
+            }
 
-        m_physics.m_jolt_job_system =
-            new JPH::JobSystemThreadPool(m_config.m_max_job_count,
-                                         m_config.m_max_barrier_count,
-                                         static_cast<int>(m_config.m_max_concurrent_job_count));
+            if (compund_shape_setting->mSubShapes.empty())
+            {
+                return nullptr;
+            }
 
-        // 16M temp memory
-        m_physics.m_temp_allocator = new JPH::TempAllocatorImpl(16 * 1024 * 1024);
+            JPH::ShapeSettings::ShapeResult shape_result = compund_shape_setting->Create();
+            if (shape_result.HasError())
+            {
+                return nullptr;
+            }
+            return shape_result.Get();
+        }
+    } // namespace
+
+    PhysicsQueryShape::~PhysicsQueryShape()
+    {
+        if (m_jph_shape)
+        {
+            m_jph_shape->Release();
+        }
+    }
+
+    bool PhysicsQueryShape::place(const RigidBodyShape& shape, const Matrix4x4& global_transform)
+    {
+        m_shape_global_transform = global_transform * shape.m_local_transform.getMatrix();
+
+        Vector3    global_position, global_scale;
+        Quaternion global_rotation;
+        m_shape_global_transform.decomposition(global_position, global_scale, global_rotation);
+
+        if (&shape != m_shape || global_scale != m_global_scale)
+        {
+            const JPH::Shape* jph_shape = toShape(shape, global_scale);
+            if (jph_shape)
+            {
+                jph_shape->AddRef();
+            }
+            if (m_jph_shape)
+            {
+                m_jph_shape->Release();
+            }
+            m_jph_shape    = jph_shape;
+            m_shape        = &shape;
+            m_global_scale = global_scale;
+        }
+        return m_jph_shape != nullptr;
+    }
+
+    PhysicsScene::PhysicsScene(PhysicsRuntime& runtime, const Vector3& gravity, const PhysicsConfig& config) :
+        m_runtime(&runtime), m_config(config)
+    {
+        static_assert(s_invalid_rigidbody_id == JPH::BodyID::cInvalidBodyID);
+
+        // the factory, the worker threads and the temp memory belong to the shared runtime
+        m_physics.m_jolt_physics_system              = new JPH::PhysicsSystem();
+        m_physics.m_jolt_broad_phase_layer_interface = new BPLayerInterfaceImpl();
 
         m_physics.m_jolt_physics_system->Init(m_config.m_max_body_count,
                                               m_config.m_body_mutex_count,
@@ -66,116 +154,221 @@ namespace Piccolo
     PhysicsScene::~PhysicsScene()
     {
         delete m_physics.m_jolt_physics_system;
-        delete m_physics.m_jolt_job_system;
-        delete m_physics.m_temp_allocator;
         delete m_physics.m_jolt_broad_phase_layer_interface;
-
-        delete JPH::Factory::sInstance;
-        JPH::Factory::sInstance = nullptr;
     }
 
     uint32_t PhysicsScene::createRigidBody(const Transform&             global_transform,
-                                           const RigidBodyComponentRes& rigidbody_actor_res)
+                                           const RigidBodyComponentRes& rigidbody_actor_res,
+                                           uint64_t                     user_data)
     {
         JPH::BodyInterface& body_interface = m_physics.m_jolt_physics_system->GetBodyInterface();
 
-        struct JPHShapeData
-        {
-            JPH::Shape* shape {nullptr};
-            Transform   local_transform;
-            Vector3     global_position;
-            Vector3     global_scale;
-            Quaternion  global_rotation;
-        };
-
-        std::vector<JPHShapeData> jph_shapes;
-
-        for (size_t shape_index = 0; shape_index < rigidbody_actor_res.m_shapes.size(); shape_index++)
-        {
-            const RigidBodyShape& shape = rigidbody_actor_res.m_shapes[shape_index];
-
-            const Matrix4x4 shape_global_transform = global_transform.getMatrix() * shape.m_local_transform.getMatrix();
-
-            Vector3    global_position, global_scale;
-            Quaternion global_rotation;
-
-            shape_global_transform.decomposition(global_position, global_scale, global_rotation);
-
-            JPH::Shape* jph_shape = toShape(shape, global_scale);
-
-            if (jph_shape)
-            {
-                jph_shapes.push_back(
-                    {jph_shape, shape.m_local_transform, global_position, global_scale, global_rotation});
-            }
-        }
-
-        if (jph_shapes.empty())
+        JPH::RefConst<JPH::Shape> jph_shape = createBodyShape(global_transform, rigidbody_actor_res);
+        if (jph_shape == nullptr)
         {
             LOG_ERROR("Create JPH Shapes Failed");
             return JPH::BodyID::cInvalidBodyID;
         }
 
-        //$TODO: currently just support static object
         JPH::EMotionType motion_type = JPH::EMotionType::Static;
         JPH::ObjectLayer layer       = Layers::NON_MOVING;
-
-        JPH::Ref<JPH::StaticCompoundShapeSettings> compund_shape_setting = new JPH::StaticCompoundShapeSettings;
-        for (const JPHShapeData& shape_data : jph_shapes)
+        switch (static_cast<RigidBodyActorType>(rigidbody_actor_res.m_actor_type))
         {
-            compund_shape_setting->AddShape(toVec3(shape_data.local_transform.m_position * shape_data.global_scale),
-                                            toQuat(shape_data.local_transform.m_rotation),
-                                            shape_data.shape);
+            case RigidBodyActorType::dynamic_body:
+                motion_type = JPH::EMotionType::Dynamic;
+                layer       = Layers::MOVING;
+                break;
+            case RigidBodyActorType::kinematic_body:
+                motion_type = JPH::EMotionType::Kinematic;
+                layer       = Layers::MOVING;
+                break;
+            default:
+                break;
         }
 
-        JPH::Body* jph_body = body_interface.CreateBody(JPH::BodyCreationSettings(compund_shape_setting,
-                                                                                  toVec3(global_transform.m_position),
-                                                                                  toQuat(global_transform.m_rotation),
-                                                                                  motion_type,
-                                                                                  layer));
+        JPH::BodyCreationSettings body_settings(jph_shape,
+                                                toVec3(global_transform.m_position),
+                                                toQuat(global_transform.m_rotation),
+                                                motion_type,
+                                                layer);
+
+        // a given mass scales the inertia of the shapes, otherwise both follow from their volume
+        const float mass = motion_type == JPH::EMotionType::Dynamic && rigidbody_actor_res.m_inverse_mass > 0.f ?
+                               1.f / rigidbody_actor_res.m_inverse_mass :
+                               0.f;
+        if (mass > 0.f)
+        {
+            body_settings.mOverrideMassProperties       = JPH::EOverrideMassProperties::CalculateInertia;
+            body_settings.mMassPropertiesOverride.mMass = mass;
+        }
 
+        JPH::Body* jph_body = body_interface.CreateBody(body_settings);
         if (jph_body == nullptr)
         {
             LOG_ERROR("Create JPH Body Failed");
-            for (const JPHShapeData& shape_data : jph_shapes)
-            {
-                delete shape_data.shape;
-            }
-
             return JPH::BodyID::cInvalidBodyID;
         }
 
+        const uint32_t body_id = jph_body->GetID().GetIndexAndSequenceNumber();
         body_interface.AddBody(jph_body->GetID(), JPH::EActivation::Activate);
-        LOG_INFO("Add Body: {}", jph_body->GetID().GetIndexAndSequenceNumber());
+        LOG_INFO("Add Body: {}", body_id);
 
-        return jph_body->GetID().GetIndexAndSequenceNumber();
+        if (motion_type != JPH::EMotionType::Static)
+        {
+            const BodyPose pose {global_transform.m_position, global_transform.m_rotation};
+
+            MovingBody& moving_body    = m_moving_bodies[body_id];
+            moving_body.m_previous     = pose;
+            moving_body.m_current      = pose;
+            moving_body.m_user_data    = user_data;
+            moving_body.m_mass         = mass;
+            moving_body.m_is_kinematic = motion_type == JPH::EMotionType::Kinematic;
+        }
+
+        return body_id;
     }
 
-    void PhysicsScene::removeRigidBody(uint32_t body_id) { m_pending_remove_bodies.push_back(body_id); }
+    void PhysicsScene::removeRigidBody(uint32_t body_id)
+    {
+        m_pending_remove_bodies.push_back(body_id);
+
+        // the owner is gone before the body is removed on the next tick, its pose is not written back any more
+        m_moving_bodies.erase(body_id);
+    }
 
     void PhysicsScene::updateRigidBodyGlobalTransform(uint32_t body_id, const Transform& global_transform)
     {
+        const BodyPose pose {global_transform.m_position, global_transform.m_rotation};
+
+        auto moving_body_iter = m_moving_bodies.find(body_id);
+        if (moving_body_iter != m_moving_bodies.end() && moving_body_iter->second.m_is_kinematic)
+        {
+            // a kinematic body is moved to the pose over the next steps instead of jumping there, so it pushes the
+            // dynamic bodies in its way
+            MovingBody& moving_body        = moving_body_iter->second;
+            moving_body.m_kinematic_target = pose;
+            if (!moving_body.m_has_kinematic_target)
+            {
+                moving_body.m_has_kinematic_target = true;
+                m_pending_kinematic_bodies.push_back(body_id);
+            }
+            return;
+        }
+
         JPH::BodyInterface& body_interface = m_physics.m_jolt_physics_system->GetBodyInterface();
 
         body_interface.SetPositionAndRotation(JPH::BodyID(body_id),
                                               toVec3(global_transform.m_position),
                                               toQuat(global_transform.m_rotation),
                                               JPH::EActivation::Activate);
+
+        // a teleport is not interpolated
+        if (moving_body_iter != m_moving_bodies.end())
+        {
+            moving_body_iter->second.m_previous = pose;
+            moving_body_iter->second.m_current  = pose;
+        }
+    }
+
+    void PhysicsScene::updateRigidBodyShape(uint32_t                     body_id,
+                                            const Transform&             global_transform,
+                                            const RigidBodyComponentRes& rigidbody_actor_res)
+    {
+        JPH::RefConst<JPH::Shape> jph_shape = createBodyShape(global_transform, rigidbody_actor_res);
+        if (jph_shape == nullptr)
+        {
+            LOG_ERROR("Create JPH Shapes Failed");
+            return;
+        }
+
+        auto       moving_body_iter = m_moving_bodies.find(body_id);
+        const bool is_dynamic = moving_body_iter != m_moving_bodies.end() && !moving_body_iter->second.m_is_kinematic;
+
+        // the body keeps its id, contacts and velocity, only the broad phase bounds are updated
+        JPH::BodyInterface& body_interface = m_physics.m_jolt_physics_system->GetBodyInterface();
+        body_interface.SetShape(JPH::BodyID(body_id), jph_shape, is_dynamic, JPH::EActivation::Activate);
+
+        // the new shapes brought their own mass, a given one is applied to them again
+        if (is_dynamic && moving_body_iter->second.m_mass > 0.f)
+        {
+            JPH::MassProperties mass_properties = jph_shape->GetMassProperties();
+            mass_properties.ScaleToMass(moving_body_iter->second.m_mass);
+
+            JPH::BodyLockWrite body_lock(m_physics.m_jolt_physics_system->GetBodyLockInterface(), JPH::BodyID(body_id));
+            if (body_lock.Succeeded())
+            {
+                body_lock.GetBody().GetMotionProperties()->SetMassProperties(mass_properties);
+            }
+        }
     }
 
     void PhysicsScene::tick(float delta_time)
     {
-        //m_update_frequency ʾµƵ
-        const float time_step = 1.f / m_config.m_update_frequency;
+        //m_update_frequency 表示物理更新的频率，按固定步长推进，不足一步的时间留到下一帧
+        const float    time_step     = 1.f / m_config.m_update_frequency;
+        const uint32_t max_substeps  = std::max(m_config.m_max_substeps, 1u);
+        const float    max_step_time = time_step * static_cast<float>(max_substeps);
 
-        m_physics.m_jolt_physics_system->Update(time_step,
-                                                m_physics.m_collision_steps,
-                                                m_physics.m_integration_substeps,
-                                                m_physics.m_temp_allocator,
-                                                m_physics.m_jolt_job_system);
+        // after a hitch only max_substeps steps are taken, the simulation slows down instead of falling behind
+        m_accumulated_time = std::min(m_accumulated_time + std::max(delta_time, 0.f), max_step_time);
+        const uint32_t step_count =
+            std::min(static_cast<uint32_t>(m_accumulated_time * m_config.m_update_frequency), max_substeps);
 
-        //ɾ
         JPH::BodyInterface& body_interface = m_physics.m_jolt_physics_system->GetBodyInterface();
+
+        // kinematic bodies reach their targets at the end of the steps of this tick
+        if (step_count > 0)
+        {
+            const float step_time = time_step * static_cast<float>(step_count);
+            for (uint32_t body_id : m_pending_kinematic_bodies)
+            {
+                auto moving_body_iter = m_moving_bodies.find(body_id);
+                if (moving_body_iter != m_moving_bodies.end())
+                {
+                    const BodyPose& target = moving_body_iter->second.m_kinematic_target;
+                    body_interface.MoveKinematic(
+                        JPH::BodyID(body_id), toVec3(target.m_position), toQuat(target.m_rotation), step_time);
+                }
+            }
+        }
+
+        JPH::TempAllocator* temp_allocator = step_count > 0 ? m_runtime->acquireTempAllocator() : nullptr;
+        for (uint32_t step_index = 0; step_index < step_count; ++step_index)
+        {
+            // only the last two steps are interpolated between
+            if (step_index + 1 == step_count)
+            {
+                storeMovingBodyPoses(true);
+            }
+
+            m_physics.m_jolt_physics_system->Update(time_step,
+                                                    m_physics.m_collision_steps,
+                                                    m_physics.m_integration_substeps,
+                                                    temp_allocator,
+                                                    m_runtime->getJobSystem());
+        }
+
+        if (step_count > 0)
+        {
+            m_runtime->releaseTempAllocator(temp_allocator);
+            storeMovingBodyPoses(false);
+            m_accumulated_time = std::max(m_accumulated_time - time_step * static_cast<float>(step_count), 0.f);
+
+            // a kinematic body stops at its target instead of going on with the velocity that took it there
+            for (uint32_t body_id : m_pending_kinematic_bodies)
+            {
+                auto moving_body_iter = m_moving_bodies.find(body_id);
+                if (moving_body_iter != m_moving_bodies.end())
+                {
+                    body_interface.SetLinearAndAngularVelocity(
+                        JPH::BodyID(body_id), JPH::Vec3::sZero(), JPH::Vec3::sZero());
+                    moving_body_iter->second.m_has_kinematic_target = false;
+                }
+            }
+            m_pending_kinematic_bodies.clear();
+        }
+
+        //处理待删除的物体
         for (uint32_t body_id : m_pending_remove_bodies)
         {
             LOG_INFO("Remove Body {}", body_id)
@@ -185,6 +378,114 @@ namespace Piccolo
         m_pending_remove_bodies.clear();
     }
 
+    bool PhysicsScene::getInterpolatedTransform(uint32_t body_id, Transform& out_transform) const
+    {
+        auto moving_body_iter = m_moving_bodies.find(body_id);
+        if (moving_body_iter == m_moving_bodies.end())
+        {
+            return false;
+        }
+
+        const MovingBody& moving_body = moving_body_iter->second;
+        const float       alpha       = getInterpolationAlpha();
+
+        out_transform.m_position =
+            Vector3::lerp(moving_body.m_previous.m_position, moving_body.m_current.m_position, alpha);
+        out_transform.m_rotation =
+            Quaternion::nLerp(alpha, moving_body.m_previous.m_rotation, moving_body.m_current.m_rotation, true);
+        return true;
+    }
+
+    float PhysicsScene::getInterpolationAlpha() const
+    {
+        return std::min(m_accumulated_time * m_config.m_update_frequency, 1.f);
+    }
+
+    const std::vector<PhysicsBodyTransform>& PhysicsScene::getMovedBodyTransforms()
+    {
+        m_moved_body_transforms.clear();
+
+        const float alpha = getInterpolationAlpha();
+        for (uint32_t body_id : m_moved_body_ids)
+        {
+            // a kinematic body follows its transform, not the other way round
+            auto moving_body_iter = m_moving_bodies.find(body_id);
+            if (moving_body_iter == m_moving_bodies.end() || moving_body_iter->second.m_is_kinematic)
+            {
+                continue;
+            }
+
+            const MovingBody&     moving_body    = moving_body_iter->second;
+            PhysicsBodyTransform& body_transform = m_moved_body_transforms.emplace_back();
+            body_transform.user_data             = moving_body.m_user_data;
+            body_transform.position =
+                Vector3::lerp(moving_body.m_previous.m_position, moving_body.m_current.m_position, alpha);
+            body_transform.rotation =
+                Quaternion::nLerp(alpha, moving_body.m_previous.m_rotation, moving_body.m_current.m_rotation, true);
+        }
+        return m_moved_body_transforms;
+    }
+
+    void PhysicsScene::storeMovingBodyPoses(bool is_before_step)
+    {
+        if (is_before_step)
+        {
+            // the bodies that moved in the previous step and fell asleep since come to rest at their last pose
+            for (uint32_t body_id : m_moved_body_ids)
+            {
+                auto moving_body_iter = m_moving_bodies.find(body_id);
+                if (moving_body_iter != m_moving_bodies.end())
+                {
+                    moving_body_iter->second.m_previous = moving_body_iter->second.m_current;
+                }
+            }
+            m_moved_body_ids.clear();
+        }
+
+        // only the bodies jolt keeps awake move during a step, the poses of all others stay as they are
+        m_physics.m_jolt_physics_system->GetActiveBodies(m_active_body_ids);
+        for (const JPH::BodyID& jph_body_id : m_active_body_ids)
+        {
+            const uint32_t body_id          = jph_body_id.GetIndexAndSequenceNumber();
+            auto           moving_body_iter = m_moving_bodies.find(body_id);
+            if (moving_body_iter == m_moving_bodies.end())
+            {
+                // removed but still in the system until the end of the tick
+                continue;
+            }
+
+            m_moved_body_ids.push_back(body_id);
+            if (is_before_step)
+            {
+                readBodyPose(jph_body_id, moving_body_iter->second.m_previous);
+            }
+        }
+
+        if (!is_before_step)
+        {
+            // the bodies awake before the step, including those that fell asleep in it, and those woken during it
+            std::sort(m_moved_body_ids.begin(), m_moved_body_ids.end());
+            m_moved_body_ids.erase(std::unique(m_moved_body_ids.begin(), m_moved_body_ids.end()),
+                                   m_moved_body_ids.end());
+            for (uint32_t body_id : m_moved_body_ids)
+            {
+                readBodyPose(JPH::BodyID(body_id), m_moving_bodies[body_id].m_current);
+            }
+        }
+    }
+
+    void PhysicsScene::readBodyPose(const JPH::BodyID& body_id, BodyPose& out_pose) const
+    {
+        // only called between steps on the ticking thread, no lock is needed to read the body
+        JPH::BodyLockRead body_lock(m_physics.m_jolt_physics_system->GetBodyLockInterfaceNoLock(), body_id);
+        if (body_lock.Succeeded())
+        {
+            const JPH::Body& body = body_lock.GetBody();
+            out_pose.m_position   = toVec3(body.GetPosition());
+            out_pose.m_rotation   = toQuat(body.GetRotation());
+        }
+    }
+
     bool PhysicsScene::raycast(Vector3                      ray_origin,
                                Vector3                      ray_directory,
                                float                        ray_length,
@@ -218,17 +519,7 @@ namespace Piccolo
         {
             const JPH::RayCastResult& cast_result = raycast_results[index];
 
-            PhysicsHitInfo& hit = out_hits[index];
-            hit.hit_position    = toVec3(ray.mOrigin + cast_result.mFraction * ray.mDirection);
-            hit.hit_distance    = cast_result.mFraction * ray_length;
-            hit.body_id         = cast_result.mBodyID.GetIndexAndSequenceNumber();
-
-            // get hit normal
-            JPH::BodyLockRead body_lock(m_physics.m_jolt_physics_system->GetBodyLockInterface(), cast_result.mBodyID);
-            const JPH::Body&  hit_body = body_lock.GetBody();
-
-            hit.hit_normal =
-                toVec3(hit_body.GetWorldSpaceSurfaceNormal(cast_result.mSubShapeID2, toVec3(hit.hit_position)));
+            getRaycastHit(*m_physics.m_jolt_physics_system, ray, ray_length, cast_result, out_hits[index]);
         }
 
         return true;
@@ -249,7 +540,8 @@ namespace Piccolo
 
         shape_global_transform.decomposition(global_position, global_scale, global_rotation);
 
-        JPH::Shape* jph_shape = toShape(shape, global_scale);
+        // the query holds the only reference, the shape is freed when it goes out of scope
+        JPH::RefConst<JPH::Shape> jph_shape = toShape(shape, global_scale);
 
         if (jph_shape == nullptr)
         {
@@ -301,7 +593,7 @@ namespace Piccolo
 
         shape_global_transform.decomposition(global_position, global_scale, global_rotation);
 
-        JPH::Shape* jph_shape = toShape(shape, global_scale);
+        JPH::RefConst<JPH::Shape> jph_shape = toShape(shape, global_scale);
 
         if (jph_shape == nullptr)
         {
@@ -318,6 +610,175 @@ namespace Piccolo
         return collector.HadHit();
     }
 
+    void PhysicsScene::raycastBatch(const std::vector<PhysicsRaycastQuery>& queries,
+                                    PhysicsQueryMode                        mode,
+                                    std::vector<PhysicsHitInfo>&            out_hits)
+    {
+        out_hits.resize(queries.size());
+
+        const JPH::PhysicsSystem&    physics_system = *m_physics.m_jolt_physics_system;
+        const JPH::NarrowPhaseQuery& scene_query    = physics_system.GetNarrowPhaseQuery();
+
+        runQueryBatch(static_cast<uint32_t>(queries.size()), [&](uint32_t begin, uint32_t end) {
+            for (uint32_t index = begin; index < end; ++index)
+            {
+                const PhysicsRaycastQuery& query = queries[index];
+                PhysicsHitInfo&            hit   = out_hits[index];
+                hit                              = PhysicsHitInfo();
+
+                JPH::RayCast ray;
+                ray.mOrigin    = toVec3(query.ray_origin);
+                ray.mDirection = toVec3(query.ray_direction.normalisedCopy() * query.ray_length);
+
+                JPH::RayCastResult cast_result;
+                bool               had_hit = false;
+                if (mode == PhysicsQueryMode::closest_hit)
+                {
+                    had_hit = scene_query.CastRay(ray, cast_result);
+                }
+                else
+                {
+                    JPH::AnyHitCollisionCollector<JPH::CastRayCollector> collector;
+                    scene_query.CastRay(ray, JPH::RayCastSettings(), collector);
+                    had_hit     = collector.HadHit();
+                    cast_result = collector.mHit;
+                }
+
+                if (had_hit)
+                {
+                    getRaycastHit(physics_system, ray, query.ray_length, cast_result, hit);
+                }
+            }
+        });
+    }
+
+    bool PhysicsScene::sweep(const PhysicsQueryShape& shape,
+                             const Vector3&           sweep_direction,
+                             float                    sweep_length,
+                             PhysicsQueryMode         mode,
+                             PhysicsHitInfo&          out_hit) const
+    {
+        out_hit = PhysicsHitInfo();
+        if (shape.m_jph_shape == nullptr)
+        {
+            return false;
+        }
+
+        const JPH::NarrowPhaseQuery& scene_query = m_physics.m_jolt_physics_system->GetNarrowPhaseQuery();
+
+        const Vector3  sweep_vector = sweep_direction.normalisedCopy() * sweep_length;
+        JPH::ShapeCast shape_cast   = JPH::ShapeCast::sFromWorldTransform(shape.m_jph_shape,
+                                                                        JPH::Vec3::sReplicate(1.f),
+                                                                        toMat44(shape.m_shape_global_transform),
+                                                                        toVec3(sweep_vector));
+
+        auto cast_shape = [&](auto& collector) {
+            scene_query.CastShape(shape_cast, JPH::ShapeCastSettings(), collector);
+            if (!collector.HadHit())
+            {
+                return;
+            }
+
+            const JPH::ShapeCastResult& sweep_result = collector.mHit;
+
+            out_hit.hit_position = toVec3(sweep_result.mContactPointOn2);
+            out_hit.hit_normal   = toVec3(sweep_result.mPenetrationAxis.NormalizedOr(JPH::Vec3::sZero()));
+            out_hit.hit_distance = sweep_result.mFraction * sweep_length;
+            out_hit.body_id      = sweep_result.mBodyID2.GetIndexAndSequenceNumber();
+        };
+
+        if (mode == PhysicsQueryMode::closest_hit)
+        {
+            JPH::ClosestHitCollisionCollector<JPH::CastShapeCollector> collector;
+            cast_shape(collector);
+        }
+        else
+        {
+            JPH::AnyHitCollisionCollector<JPH::CastShapeCollector> collector;
+            cast_shape(collector);
+        }
+        return out_hit.body_id != s_invalid_rigidbody_id;
+    }
+
+    void PhysicsScene::sweepBatch(const std::vector<PhysicsSweepQuery>& queries,
+                                  PhysicsQueryMode                      mode,
+                                  std::vector<PhysicsHitInfo>&          out_hits)
+    {
+        out_hits.resize(queries.size());
+
+        runQueryBatch(static_cast<uint32_t>(queries.size()), [&](uint32_t begin, uint32_t end) {
+            // the shapes of a batch are mostly the same few, e.g. one capsule per kind of agent
+            PhysicsQueryShape query_shape;
+            for (uint32_t index = begin; index < end; ++index)
+            {
+                const PhysicsSweepQuery& query = queries[index];
+                PhysicsHitInfo&          hit   = out_hits[index];
+                hit                            = PhysicsHitInfo();
+
+                if (query.shape == nullptr || !query_shape.place(*query.shape, query.shape_transform))
+                {
+                    continue;
+                }
+                sweep(query_shape, query.sweep_direction, query.sweep_length, mode, hit);
+            }
+        });
+    }
+
+    void PhysicsScene::overlapBatch(const std::vector<PhysicsOverlapQuery>& queries,
+                                    std::vector<PhysicsHitInfo>&            out_hits)
+    {
+        out_hits.resize(queries.size());
+
+        const JPH::NarrowPhaseQuery& scene_query = m_physics.m_jolt_physics_system->GetNarrowPhaseQuery();
+
+        runQueryBatch(static_cast<uint32_t>(queries.size()), [&](uint32_t begin, uint32_t end) {
+            PhysicsQueryShape query_shape;
+            for (uint32_t index = begin; index < end; ++index)
+            {
+                const PhysicsOverlapQuery& query = queries[index];
+                PhysicsHitInfo&            hit   = out_hits[index];
+                hit                              = PhysicsHitInfo();
+
+                if (query.shape == nullptr || !query_shape.place(*query.shape, query.global_transform))
+                {
+                    continue;
+                }
+
+                JPH::AnyHitCollisionCollector<JPH::CollideShapeCollector> collector;
+                scene_query.CollideShape(query_shape.m_jph_shape,
+                                         JPH::Vec3::sReplicate(1.0f),
+                                         toMat44(query_shape.m_shape_global_transform),
+                                         JPH::CollideShapeSettings(),
+                                         collector);
+                if (collector.HadHit())
+                {
+                    const JPH::CollideShapeResult& overlap_result = collector.mHit;
+
+                    hit.hit_position = toVec3(overlap_result.mContactPointOn2);
+                    hit.hit_normal   = toVec3(overlap_result.mPenetrationAxis.NormalizedOr(JPH::Vec3::sZero()));
+                    hit.hit_distance = overlap_result.mPenetrationDepth;
+                    hit.body_id      = overlap_result.mBodyID2.GetIndexAndSequenceNumber();
+                }
+            }
+        });
+    }
+
+    template<typename QueryFunction>
+    void PhysicsScene::runQueryBatch(uint32_t query_count, const QueryFunction& query_function)
+    {
+        if (query_count < k_parallel_query_min_count)
+        {
+            query_function(0, query_count);
+            return;
+        }
+
+        // a few ranges per worker balance uneven queries without flooding the job queue
+        const uint32_t range_count = std::max(m_config.m_max_concurrent_job_count, 1u) * 4;
+        const uint32_t batch_size =
+            std::max((query_count + range_count - 1) / range_count, k_parallel_query_min_count / 4);
+        m_runtime->parallelFor(query_count, batch_size, query_function);
+    }
+
     void PhysicsScene::getShapeBoundingBoxes(uint32_t body_id, std::vector<AxisAlignedBox>& out_bounding_boxes) const
     {
         JPH::BodyLockRead body_lock(m_physics.m_jolt_physics_system->GetBodyLockInterface(), JPH::BodyID(body_id));
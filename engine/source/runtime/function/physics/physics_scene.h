@@ -1,15 +1,20 @@
 #pragma once
 
 #include "runtime/core/math/axis_aligned.h"
+#include "runtime/core/math/matrix4.h"
+#include "runtime/core/math/quaternion.h"
 
 #include "runtime/function/physics/physics_config.h"
 
+#include <unordered_map>
+#include <vector>
+
 namespace JPH
 {
+    class BodyID;
     class PhysicsSystem;
-    class JobSystem;
-    class TempAllocator;
     class BroadPhaseLayerInterface;
+    class Shape;
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
     class DebugRenderer;
 #endif
@@ -18,6 +23,7 @@ namespace JPH
 namespace Piccolo
 {
     class Transform;
+    class PhysicsRuntime;
     class RigidBodyComponentRes;
     class RigidBodyShape;
 
@@ -31,13 +37,71 @@ namespace Piccolo
         uint32_t body_id {s_invalid_rigidbody_id};
     };
 
+    /// pose of a dynamic body the simulation moved, for writing it back to the owner given by user_data
+    struct PhysicsBodyTransform
+    {
+        uint64_t   user_data {0};
+        Vector3    position;
+        Quaternion rotation;
+    };
+
+    enum class PhysicsQueryMode : unsigned char
+    {
+        any_hit,    // whichever hit is found first, enough to tell whether anything is in the way
+        closest_hit // the hit nearest to the start
+    };
+
+    struct PhysicsRaycastQuery
+    {
+        Vector3 ray_origin;
+        Vector3 ray_direction;
+        float   ray_length {0.f};
+    };
+
+    struct PhysicsSweepQuery
+    {
+        const RigidBodyShape* shape {nullptr};
+        Matrix4x4             shape_transform;
+        Vector3               sweep_direction;
+        float                 sweep_length {0.f};
+    };
+
+    struct PhysicsOverlapQuery
+    {
+        const RigidBodyShape* shape {nullptr};
+        Matrix4x4             global_transform;
+    };
+
+    /// a rigid body shape converted for scene queries. the conversion is only redone when another shape is placed or
+    /// the global scale changes, so a caster moving the same shape around converts it once. a shape edited in place
+    /// has to be placed through a new PhysicsQueryShape
+    class PhysicsQueryShape
+    {
+    public:
+        PhysicsQueryShape() = default;
+        ~PhysicsQueryShape();
+
+        PhysicsQueryShape(const PhysicsQueryShape&) = delete;
+        PhysicsQueryShape& operator=(const PhysicsQueryShape&) = delete;
+
+        /// places shape under global_transform, false if the shape has no geometry to query with
+        bool place(const RigidBodyShape& shape, const Matrix4x4& global_transform);
+
+    private:
+        friend class PhysicsScene;
+
+        const RigidBodyShape* m_shape {nullptr};
+        Vector3               m_global_scale;
+        Matrix4x4             m_shape_global_transform;
+        // holds a reference while set
+        const JPH::Shape* m_jph_shape {nullptr};
+    };
+
     class PhysicsScene
     {
         struct JoltPhysics
         {
             JPH::PhysicsSystem*            m_jolt_physics_system {nullptr};
-            JPH::JobSystem*                m_jolt_job_system {nullptr};
-            JPH::TempAllocator*            m_temp_allocator {nullptr};
             JPH::BroadPhaseLayerInterface* m_jolt_broad_phase_layer_interface {nullptr};
 
             int m_collision_steps {1};
@@ -46,32 +110,58 @@ namespace Piccolo
 
     public:
         /// <summary>
-        /// ʼ
+        /// 初始化物理场景
         /// </summary>
-        /// <param name="gravity">ȫ</param>
-        PhysicsScene(const Vector3& gravity);
+        /// <param name="runtime">所有物理场景共享的jolt运行时，线程池与临时内存</param>
+        /// <param name="gravity">全局重力</param>
+        /// <param name="config">步长、子步数等设置</param>
+        PhysicsScene(PhysicsRuntime& runtime, const Vector3& gravity, const PhysicsConfig& config);
 
         virtual ~PhysicsScene();
 
         const Vector3& getGravity() const { return m_config.m_gravity; }
         /// <summary>
-        /// һ
+        /// 创建一个刚体，运动类型由m_actor_type决定
         /// </summary>
-        uint32_t createRigidBody(const Transform& global_transform, const RigidBodyComponentRes& rigidbody_actor_res);
+        /// <param name="user_data">刚体的拥有者，随getMovedBodyTransforms返回</param>
+        uint32_t createRigidBody(const Transform&             global_transform,
+                                 const RigidBodyComponentRes& rigidbody_actor_res,
+                                 uint64_t                     user_data = 0);
 
         /// <summary>
-        /// idɾһ
+        /// 根据id删除一个刚体
         /// </summary>
         void removeRigidBody(uint32_t body_id);
 
         /// <summary>
-        /// ¸λ
+        /// 更新刚体位置
         /// </summary>
         void updateRigidBodyGlobalTransform(uint32_t body_id, const Transform& global_transform);
 
+        /// <summary>
+        /// 缩放改变后原地替换刚体的形状，刚体本身不重建
+        /// </summary>
+        void updateRigidBodyShape(uint32_t                     body_id,
+                                  const Transform&             global_transform,
+                                  const RigidBodyComponentRes& rigidbody_actor_res);
+
+        /// advances the simulation in fixed steps of 1 / update frequency, as many as fit in the accumulated time but
+        /// at most max substeps. the time left over is carried to the next tick. different scenes may tick on
+        /// different threads at once
         void tick(float delta_time);
 
-        /// cast a ray and find the hits  ߼
+        /// pose of a moving body between its last two steps, by how far the accumulated time is into the next one.
+        /// false for static bodies, they are not tracked
+        bool getInterpolatedTransform(uint32_t body_id, Transform& out_transform) const;
+
+        /// fraction of a step accumulated but not simulated yet, in [0, 1)
+        float getInterpolationAlpha() const;
+
+        /// interpolated poses of the dynamic bodies that moved in the last step, taken from the bodies jolt kept
+        /// awake. sleeping and static bodies are not visited. the result is valid until the next call
+        const std::vector<PhysicsBodyTransform>& getMovedBodyTransforms();
+
+        /// cast a ray and find the hits  射线检测
         /// @ray_origin: origin of ray
         /// @ray_direction: ray direction
         /// @ray_length: ray length, anything beyond this length will not be reported as a hit
@@ -79,7 +169,7 @@ namespace Piccolo
         /// @return: true if any hits found, else false
         bool raycast(Vector3 ray_origin, Vector3 ray_direction, float ray_length, std::vector<PhysicsHitInfo>& out_hits);
 
-        /// cast a shape and find the hits  ״⣬߼⣬ڼĳһײ
+        /// cast a shape and find the hits  物体的形状检测，类似于射线检测，但用于检测物体沿着某一方向的碰撞。
         /// @shape: the casted rigidbody shape
         /// @shape_transform: the initial global transform of the casted shape
         /// @sweep_direction: sweep direction
@@ -92,13 +182,33 @@ namespace Piccolo
                    float                        sweep_length,
                    std::vector<PhysicsHitInfo>& out_hits);
 
-        /// overlap test  Ƿص
+        /// the closest or any hit of one placed shape, out_hit.body_id is s_invalid_rigidbody_id if nothing was hit.
+        /// unlike the sweep above it neither converts the shape nor allocates
+        bool sweep(const PhysicsQueryShape& shape,
+                   const Vector3&           sweep_direction,
+                   float                    sweep_length,
+                   PhysicsQueryMode         mode,
+                   PhysicsHitInfo&          out_hit) const;
+
+        /// overlap test  检查物体是否与其他物体重叠。
         /// @shape: rigidbody shape
         /// @return: true if overlapped with any rigidbodies
         bool isOverlap(const RigidBodyShape& shape, const Matrix4x4& global_transform);
 
+        /// batched scene queries, out_hits[i] is the hit of queries[i] and its body_id is s_invalid_rigidbody_id if
+        /// nothing was hit. out_hits is resized but keeps its capacity, so a buffer reused every frame does not
+        /// allocate. large batches are split across the physics workers
+        void raycastBatch(const std::vector<PhysicsRaycastQuery>& queries,
+                          PhysicsQueryMode                        mode,
+                          std::vector<PhysicsHitInfo>&            out_hits);
+        void sweepBatch(const std::vector<PhysicsSweepQuery>& queries,
+                        PhysicsQueryMode                      mode,
+                        std::vector<PhysicsHitInfo>&          out_hits);
+        /// reports any one body each shape overlaps, hit_distance is the penetration depth
+        void overlapBatch(const std::vector<PhysicsOverlapQuery>& queries, std::vector<PhysicsHitInfo>& out_hits);
+
         /// <summary>
-        /// ȡ߽BoundingBoxes
+        /// 获取物体边界框（BoundingBoxes）
         /// </summary>
         void getShapeBoundingBoxes(uint32_t body_id, std::vector<AxisAlignedBox>& out_bounding_boxes) const;
 
@@ -109,18 +219,70 @@ namespace Piccolo
     protected:
         // we use single Jolt physics system for each scene
         /// <summary>
-        /// װjolt
+        /// 封装了jolt引擎
         /// </summary>
         JoltPhysics m_physics;
 
         /// <summary>
-        /// 
+        /// 共享的jolt运行时，由PhysicsManager持有
+        /// </summary>
+        PhysicsRuntime* m_runtime {nullptr};
+
+        /// <summary>
+        /// 物理场景的配置
         /// </summary>
         PhysicsConfig m_config;
 
         /// <summary>
-        /// ɾĸid
+        /// 待删除的刚体id
         /// </summary>
         std::vector<uint32_t> m_pending_remove_bodies;
+
+    private:
+        struct BodyPose
+        {
+            Vector3    m_position;
+            Quaternion m_rotation;
+        };
+
+        struct MovingBody
+        {
+            BodyPose m_previous;
+            BodyPose m_current;
+            BodyPose m_kinematic_target;
+            uint64_t m_user_data {0};
+            float    m_mass {0.f}; // 0 if the mass comes from the shapes
+            bool     m_is_kinematic {false};
+            bool     m_has_kinematic_target {false};
+        };
+
+        void storeMovingBodyPoses(bool is_before_step);
+        void readBodyPose(const JPH::BodyID& body_id, BodyPose& out_pose) const;
+
+        template<typename QueryFunction>
+        void runQueryBatch(uint32_t query_count, const QueryFunction& query_function);
+
+        /// <summary>
+        /// 非静态刚体最近两个物理步的位姿，用于插值
+        /// </summary>
+        std::unordered_map<uint32_t, MovingBody> m_moving_bodies;
+
+        /// <summary>
+        /// 最近一步开始前与结束后处于激活状态的刚体，只有它们的位姿会改变
+        /// </summary>
+        std::vector<JPH::BodyID> m_active_body_ids;
+        std::vector<uint32_t>    m_moved_body_ids;
+
+        /// <summary>
+        /// 等待下一步移向目标位姿的运动学刚体
+        /// </summary>
+        std::vector<uint32_t> m_pending_kinematic_bodies;
+
+        std::vector<PhysicsBodyTransform> m_moved_body_transforms;
+
+        /// <summary>
+        /// 累积但尚未模拟的时间
+        /// </summary>
+        float m_accumulated_time {0.f};
     };
 } // namespace Piccolo
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "runtime/function/render/render_draw_batch.h"
 #include "runtime/function/render/render_pass.h"
 
 namespace Piccolo
@@ -29,5 +30,6 @@ namespace Piccolo
         RHIDescriptorSetLayout* m_per_mesh_layout;
         MeshDirectionalLightShadowPerframeStorageBufferObject
             m_mesh_directional_light_shadow_perframe_storage_buffer_object;
+        RenderDrawBatchTable m_mesh_drawcall_batch_table;
     };
 } // namespace Piccolo
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "runtime/function/render/render_draw_batch.h"
 #include "runtime/function/render/render_pass.h"
 
 #include "runtime/function/render/passes/color_grading_pass.h"
@@ -122,5 +123,6 @@ namespace Piccolo
     private:
         std::vector<RHIFramebuffer*> m_swapchain_framebuffers;
         std::shared_ptr<ParticlePass> m_particle_pass;
+        RenderDrawBatchTable          m_mesh_drawcall_batch_table;
     };
 } // namespace Piccolo
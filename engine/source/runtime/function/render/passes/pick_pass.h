@@ -1,6 +1,7 @@
 #pragma once
 
 #include "runtime/core/math/vector2.h"
+#include "runtime/function/render/render_draw_batch.h"
 #include "runtime/function/render/render_pass.h"
 
 namespace Piccolo
@@ -39,5 +40,7 @@ namespace Piccolo
         RHIImageView*      _object_id_image_view = nullptr;
 
         RHIDescriptorSetLayout* _per_mesh_layout = nullptr;
+
+        RenderDrawBatchTable _mesh_drawcall_batch_table;
     };
 } // namespace Piccolo
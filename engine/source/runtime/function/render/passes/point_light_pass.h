@@ -1,5 +1,6 @@
 #pragma once
 
+#include "runtime/function/render/render_draw_batch.h"
 #include "runtime/function/render/render_pass.h"
 
 namespace Piccolo
@@ -28,5 +29,6 @@ namespace Piccolo
     private:
         RHIDescriptorSetLayout* m_per_mesh_layout;
         MeshPointLightShadowPerframeStorageBufferObject m_mesh_point_light_shadow_perframe_storage_buffer_object;
+        RenderDrawBatchTable                            m_mesh_drawcall_batch_table;
     };
 } // namespace Piccolo
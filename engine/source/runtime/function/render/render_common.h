@@ -193,7 +193,8 @@ namespace Piccolo
         RHIBuffer*    mesh_vertex_varying_buffer;
         VmaAllocation mesh_vertex_varying_buffer_allocation;
 
-        uint32_t mesh_index_count;
+        uint32_t     mesh_index_count;
+        RHIIndexType mesh_index_type;
 
         RHIBuffer*    mesh_index_buffer;
         VmaAllocation mesh_index_buffer_allocation;
@@ -236,6 +237,8 @@ namespace Piccolo
         uint32_t           joint_count {0};
         VulkanMesh*        ref_mesh {nullptr};
         VulkanPBRMaterial* ref_material {nullptr};
+        size_t             mesh_asset_id {0};
+        size_t             material_asset_id {0};
         uint32_t           node_id;
         bool               enable_vertex_blending {false};
     };
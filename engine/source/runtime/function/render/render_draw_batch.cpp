@@ -0,0 +1,107 @@
+#include "runtime/function/render/render_draw_batch.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+namespace Piccolo
+{
+    uint64_t RenderDrawBatchTable::getBatchKey(const RenderMeshNode& node)
+    {
+        assert(node.material_asset_id <= UINT32_MAX && node.mesh_asset_id <= UINT32_MAX);
+        return (static_cast<uint64_t>(node.material_asset_id) << 32) | static_cast<uint64_t>(node.mesh_asset_id);
+    }
+
+    void RenderDrawBatchTable::update(const std::vector<RenderMeshNode>& nodes)
+    {
+        bool is_changed = nodes.size() != m_node_keys.size();
+        for (size_t node_index = 0; !is_changed && node_index < nodes.size(); ++node_index)
+        {
+            is_changed = getBatchKey(nodes[node_index]) != m_node_keys[node_index];
+        }
+
+        if (is_changed)
+        {
+            m_node_keys.resize(nodes.size());
+            for (size_t node_index = 0; node_index < nodes.size(); ++node_index)
+            {
+                m_node_keys[node_index] = getBatchKey(nodes[node_index]);
+            }
+            sortNodes();
+            buildBatches();
+        }
+
+        // the nodes are rebuilt every frame, so the instance data is always taken from the current ones
+        for (size_t instance_index = 0; instance_index < m_sorted_node_indices.size(); ++instance_index)
+        {
+            const RenderMeshNode& node     = nodes[m_sorted_node_indices[instance_index]];
+            RenderDrawInstance&   instance = m_instances[instance_index];
+            instance.model_matrix          = node.model_matrix;
+            instance.joint_matrices        = node.enable_vertex_blending ? node.joint_matrices : nullptr;
+            instance.joint_count           = node.enable_vertex_blending ? node.joint_count : 0;
+            instance.node_id               = node.node_id;
+        }
+        for (RenderDrawBatch& batch : m_batches)
+        {
+            const RenderMeshNode& node = nodes[m_sorted_node_indices[batch.first_instance]];
+            batch.material             = node.ref_material;
+            batch.mesh                 = node.ref_mesh;
+        }
+    }
+
+    void RenderDrawBatchTable::sortNodes()
+    {
+        const uint32_t node_count = static_cast<uint32_t>(m_node_keys.size());
+        m_sorted_node_indices.resize(node_count);
+        m_sort_scratch.resize(node_count);
+        for (uint32_t node_index = 0; node_index < node_count; ++node_index)
+        {
+            m_sorted_node_indices[node_index] = node_index;
+        }
+
+        // least significant digit first, a pass whose digit is the same for every key keeps the order as it is.
+        // asset ids are small, so most of the eight passes are skipped
+        for (uint32_t shift = 0; shift < 64; shift += 8)
+        {
+            std::array<uint32_t, 256> digit_offsets {};
+            for (uint64_t key : m_node_keys)
+            {
+                ++digit_offsets[(key >> shift) & 0xff];
+            }
+            if (std::find(digit_offsets.begin(), digit_offsets.end(), node_count) != digit_offsets.end())
+            {
+                continue;
+            }
+
+            uint32_t offset = 0;
+            for (uint32_t& digit_offset : digit_offsets)
+            {
+                const uint32_t digit_count = digit_offset;
+                digit_offset               = offset;
+                offset += digit_count;
+            }
+            for (uint32_t node_index : m_sorted_node_indices)
+            {
+                m_sort_scratch[digit_offsets[(m_node_keys[node_index] >> shift) & 0xff]++] = node_index;
+            }
+            m_sorted_node_indices.swap(m_sort_scratch);
+        }
+    }
+
+    void RenderDrawBatchTable::buildBatches()
+    {
+        m_batches.clear();
+        m_instances.resize(m_sorted_node_indices.size());
+
+        for (uint32_t instance_index = 0; instance_index < m_sorted_node_indices.size(); ++instance_index)
+        {
+            const uint64_t key = m_node_keys[m_sorted_node_indices[instance_index]];
+            if (m_batches.empty() || m_node_keys[m_sorted_node_indices[m_batches.back().first_instance]] != key)
+            {
+                RenderDrawBatch& batch = m_batches.emplace_back();
+                batch.first_instance   = instance_index;
+            }
+            ++m_batches.back().instance_count;
+        }
+    }
+} // namespace Piccolo
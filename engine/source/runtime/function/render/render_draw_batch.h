@@ -0,0 +1,56 @@
+#pragma once
+
+#include "runtime/function/render/render_common.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Piccolo
+{
+    struct RenderDrawInstance
+    {
+        const Matrix4x4* model_matrix {nullptr};
+        const Matrix4x4* joint_matrices {nullptr};
+        uint32_t         joint_count {0};
+        uint32_t         node_id {0};
+    };
+
+    /// instances sharing one material and one mesh, drawn with as few instanced draw calls as possible
+    struct RenderDrawBatch
+    {
+        VulkanPBRMaterial* material {nullptr};
+        VulkanMesh*        mesh {nullptr};
+        uint32_t           first_instance {0};
+        uint32_t           instance_count {0};
+    };
+
+    /// visible mesh nodes grouped by material and mesh, kept from frame to frame
+    ///
+    /// the nodes are sorted by a key packing the material and mesh asset ids with a radix sort, batches of one
+    /// material are adjacent. the sort and the batches are only rebuilt when the keys of the visible nodes differ
+    /// from the last update, otherwise only the per instance data is refreshed. the buffers are reused, so a frame
+    /// without changes does not allocate
+    class RenderDrawBatchTable
+    {
+    public:
+        void update(const std::vector<RenderMeshNode>& nodes);
+
+        const std::vector<RenderDrawBatch>& getBatches() const { return m_batches; }
+        const RenderDrawInstance*           getInstances(const RenderDrawBatch& batch) const
+        {
+            return m_instances.data() + batch.first_instance;
+        }
+
+        static uint64_t getBatchKey(const RenderMeshNode& node);
+
+    private:
+        void sortNodes();
+        void buildBatches();
+
+        std::vector<uint64_t>           m_node_keys;
+        std::vector<uint32_t>           m_sorted_node_indices;
+        std::vector<uint32_t>           m_sort_scratch;
+        std::vector<RenderDrawBatch>    m_batches;
+        std::vector<RenderDrawInstance> m_instances;
+    };
+} // namespace Piccolo
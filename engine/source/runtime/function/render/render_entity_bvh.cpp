@@ -0,0 +1,313 @@
+#include "runtime/function/render/render_entity_bvh.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace Piccolo
+{
+    namespace
+    {
+        // fraction of the extent a leaf box grows by on every side
+        constexpr float k_leaf_margin_ratio = 0.1f;
+        constexpr float k_leaf_margin_min   = 0.05f;
+
+        BoundingBox unionBounds(const BoundingBox& a, const BoundingBox& b)
+        {
+            BoundingBox result = a;
+            result.merge(b);
+            return result;
+        }
+
+        float surfaceArea(const BoundingBox& bounds)
+        {
+            const Vector3 extent = bounds.max_bound - bounds.min_bound;
+            return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+        }
+
+        bool containsBounds(const BoundingBox& outer, const BoundingBox& inner)
+        {
+            return outer.min_bound.x <= inner.min_bound.x && outer.min_bound.y <= inner.min_bound.y &&
+                   outer.min_bound.z <= inner.min_bound.z && inner.max_bound.x <= outer.max_bound.x &&
+                   inner.max_bound.y <= outer.max_bound.y && inner.max_bound.z <= outer.max_bound.z;
+        }
+
+        BoundingBox enlargeBounds(const BoundingBox& bounds)
+        {
+            const Vector3 extent = bounds.max_bound - bounds.min_bound;
+            const Vector3 margin(std::max(extent.x * k_leaf_margin_ratio, k_leaf_margin_min),
+                                 std::max(extent.y * k_leaf_margin_ratio, k_leaf_margin_min),
+                                 std::max(extent.z * k_leaf_margin_ratio, k_leaf_margin_min));
+            return BoundingBox(bounds.min_bound - margin, bounds.max_bound + margin);
+        }
+    } // namespace
+
+    uint32_t RenderEntityBVH::createProxy(const BoundingBox& bounds, uint32_t user_index)
+    {
+        const uint32_t proxy = allocateNode();
+        Node&          leaf  = m_nodes[proxy];
+        leaf.bounds          = enlargeBounds(bounds);
+        leaf.user_index      = user_index;
+        leaf.height          = 0;
+        insertLeaf(proxy);
+        return proxy;
+    }
+
+    void RenderEntityBVH::destroyProxy(uint32_t proxy)
+    {
+        assert(m_nodes[proxy].isLeaf());
+        removeLeaf(proxy);
+        freeNode(proxy);
+    }
+
+    bool RenderEntityBVH::moveProxy(uint32_t proxy, const BoundingBox& bounds)
+    {
+        assert(m_nodes[proxy].isLeaf());
+        if (containsBounds(m_nodes[proxy].bounds, bounds))
+        {
+            return false;
+        }
+
+        removeLeaf(proxy);
+        m_nodes[proxy].bounds = enlargeBounds(bounds);
+        insertLeaf(proxy);
+        return true;
+    }
+
+    void RenderEntityBVH::clear()
+    {
+        m_nodes.clear();
+        m_root      = k_null_node;
+        m_free_list = k_null_node;
+    }
+
+    uint32_t RenderEntityBVH::allocateNode()
+    {
+        uint32_t node_index = m_free_list;
+        if (node_index == k_null_node)
+        {
+            node_index = static_cast<uint32_t>(m_nodes.size());
+            m_nodes.emplace_back();
+        }
+        else
+        {
+            m_free_list = m_nodes[node_index].parent;
+        }
+
+        Node& node       = m_nodes[node_index];
+        node.parent      = k_null_node;
+        node.children[0] = k_null_node;
+        node.children[1] = k_null_node;
+        node.height      = 0;
+        return node_index;
+    }
+
+    void RenderEntityBVH::freeNode(uint32_t node_index)
+    {
+        m_nodes[node_index].parent = m_free_list;
+        m_nodes[node_index].height = -1;
+        m_free_list                = node_index;
+    }
+
+    void RenderEntityBVH::insertLeaf(uint32_t leaf)
+    {
+        if (m_root == k_null_node)
+        {
+            m_root               = leaf;
+            m_nodes[leaf].parent = k_null_node;
+            return;
+        }
+
+        // find the sibling that grows the surface area of the tree least
+        const BoundingBox leaf_bounds = m_nodes[leaf].bounds;
+        uint32_t          sibling     = m_root;
+        while (!m_nodes[sibling].isLeaf())
+        {
+            const Node& node = m_nodes[sibling];
+
+            const float area          = surfaceArea(node.bounds);
+            const float combined_area = surfaceArea(unionBounds(node.bounds, leaf_bounds));
+
+            // cost of a new parent for this node and the leaf, and the cost pushed down to the children
+            const float cost             = 2.0f * combined_area;
+            const float inheritance_cost = 2.0f * (combined_area - area);
+
+            float child_costs[2];
+            for (size_t child = 0; child < 2; ++child)
+            {
+                const Node& child_node = m_nodes[node.children[child]];
+                const float new_area   = surfaceArea(unionBounds(child_node.bounds, leaf_bounds));
+                child_costs[child] =
+                    (child_node.isLeaf() ? new_area : new_area - surfaceArea(child_node.bounds)) + inheritance_cost;
+            }
+
+            if (cost < child_costs[0] && cost < child_costs[1])
+            {
+                break;
+            }
+            sibling = child_costs[0] < child_costs[1] ? node.children[0] : node.children[1];
+        }
+
+        const uint32_t old_parent = m_nodes[sibling].parent;
+        const uint32_t new_parent = allocateNode();
+        {
+            Node& node       = m_nodes[new_parent];
+            node.parent      = old_parent;
+            node.bounds      = unionBounds(leaf_bounds, m_nodes[sibling].bounds);
+            node.height      = m_nodes[sibling].height + 1;
+            node.children[0] = sibling;
+            node.children[1] = leaf;
+        }
+
+        if (old_parent != k_null_node)
+        {
+            Node& parent = m_nodes[old_parent];
+            parent.children[parent.children[0] == sibling ? 0 : 1] = new_parent;
+        }
+        else
+        {
+            m_root = new_parent;
+        }
+        m_nodes[sibling].parent = new_parent;
+        m_nodes[leaf].parent    = new_parent;
+
+        refitAncestors(new_parent);
+    }
+
+    void RenderEntityBVH::removeLeaf(uint32_t leaf)
+    {
+        if (leaf == m_root)
+        {
+            m_root = k_null_node;
+            return;
+        }
+
+        const uint32_t parent       = m_nodes[leaf].parent;
+        const uint32_t grand_parent = m_nodes[parent].parent;
+        const uint32_t sibling =
+            m_nodes[parent].children[0] == leaf ? m_nodes[parent].children[1] : m_nodes[parent].children[0];
+
+        if (grand_parent != k_null_node)
+        {
+            Node& grand_parent_node = m_nodes[grand_parent];
+            grand_parent_node.children[grand_parent_node.children[0] == parent ? 0 : 1] = sibling;
+            m_nodes[sibling].parent                                                       = grand_parent;
+            freeNode(parent);
+            refitAncestors(grand_parent);
+        }
+        else
+        {
+            m_root                  = sibling;
+            m_nodes[sibling].parent = k_null_node;
+            freeNode(parent);
+        }
+        m_nodes[leaf].parent = k_null_node;
+    }
+
+    void RenderEntityBVH::refitAncestors(uint32_t node_index)
+    {
+        while (node_index != k_null_node)
+        {
+            node_index = balance(node_index);
+
+            Node&       node  = m_nodes[node_index];
+            const Node& left  = m_nodes[node.children[0]];
+            const Node& right = m_nodes[node.children[1]];
+            node.height       = 1 + std::max(left.height, right.height);
+            node.bounds       = unionBounds(left.bounds, right.bounds);
+
+            node_index = node.parent;
+        }
+    }
+
+    uint32_t RenderEntityBVH::balance(uint32_t index_a)
+    {
+        Node& a = m_nodes[index_a];
+        if (a.isLeaf() || a.height < 2)
+        {
+            return index_a;
+        }
+
+        const uint32_t index_b = a.children[0];
+        const uint32_t index_c = a.children[1];
+        Node&          b       = m_nodes[index_b];
+        Node&          c       = m_nodes[index_c];
+
+        const int32_t height_difference = c.height - b.height;
+        if (height_difference > 1)
+        {
+            // rotate c up
+            const uint32_t index_f = c.children[0];
+            const uint32_t index_g = c.children[1];
+            Node&          f       = m_nodes[index_f];
+            Node&          g       = m_nodes[index_g];
+
+            c.children[0] = index_a;
+            c.parent      = a.parent;
+            a.parent      = index_c;
+            if (c.parent != k_null_node)
+            {
+                Node& parent = m_nodes[c.parent];
+                parent.children[parent.children[0] == index_a ? 0 : 1] = index_c;
+            }
+            else
+            {
+                m_root = index_c;
+            }
+
+            // the higher grand child stays below c
+            const bool     keep_f      = f.height > g.height;
+            const uint32_t index_kept  = keep_f ? index_f : index_g;
+            const uint32_t index_moved = keep_f ? index_g : index_f;
+            Node&          kept        = m_nodes[index_kept];
+            Node&          moved       = m_nodes[index_moved];
+
+            c.children[1] = index_kept;
+            a.children[1] = index_moved;
+            moved.parent  = index_a;
+            a.bounds      = unionBounds(b.bounds, moved.bounds);
+            c.bounds      = unionBounds(a.bounds, kept.bounds);
+            a.height      = 1 + std::max(b.height, moved.height);
+            c.height      = 1 + std::max(a.height, kept.height);
+            return index_c;
+        }
+
+        if (height_difference < -1)
+        {
+            // rotate b up
+            const uint32_t index_d = b.children[0];
+            const uint32_t index_e = b.children[1];
+            Node&          d       = m_nodes[index_d];
+            Node&          e       = m_nodes[index_e];
+
+            b.children[0] = index_a;
+            b.parent      = a.parent;
+            a.parent      = index_b;
+            if (b.parent != k_null_node)
+            {
+                Node& parent = m_nodes[b.parent];
+                parent.children[parent.children[0] == index_a ? 0 : 1] = index_b;
+            }
+            else
+            {
+                m_root = index_b;
+            }
+
+            const bool     keep_d      = d.height > e.height;
+            const uint32_t index_kept  = keep_d ? index_d : index_e;
+            const uint32_t index_moved = keep_d ? index_e : index_d;
+            Node&          kept        = m_nodes[index_kept];
+            Node&          moved       = m_nodes[index_moved];
+
+            b.children[1] = index_kept;
+            a.children[0] = index_moved;
+            moved.parent  = index_a;
+            a.bounds      = unionBounds(c.bounds, moved.bounds);
+            b.bounds      = unionBounds(a.bounds, kept.bounds);
+            a.height      = 1 + std::max(c.height, moved.height);
+            b.height      = 1 + std::max(a.height, kept.height);
+            return index_b;
+        }
+
+        return index_a;
+    }
+} // namespace Piccolo
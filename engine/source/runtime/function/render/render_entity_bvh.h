@@ -0,0 +1,88 @@
+#pragma once
+
+#include "runtime/core/math/matrix4.h"
+#include "runtime/function/render/render_helper.h"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace Piccolo
+{
+    /// dynamic bounding volume hierarchy over the world space bounds of the render entities
+    ///
+    /// every entity owns a leaf whose box is the entity bounds enlarged by a margin, so an entity moving a little does
+    /// not touch the tree. leaves are inserted where they grow the surface area least and the tree is kept balanced
+    /// with rotations, the same way as the dynamic aabb tree of box2d. a query rejects a whole subtree when the node
+    /// test fails for its box, the leaves hand their user index to the caller, which tests the exact bounds
+    class RenderEntityBVH
+    {
+    public:
+        static constexpr uint32_t k_null_node = std::numeric_limits<uint32_t>::max();
+
+        uint32_t createProxy(const BoundingBox& bounds, uint32_t user_index);
+        void     destroyProxy(uint32_t proxy);
+        /// returns false when the bounds are still inside the enlarged leaf box and the tree is unchanged
+        bool moveProxy(uint32_t proxy, const BoundingBox& bounds);
+        void setUserIndex(uint32_t proxy, uint32_t user_index) { m_nodes[proxy].user_index = user_index; }
+
+        void clear();
+
+        template<typename NodeTest, typename LeafVisitor>
+        void query(NodeTest&& node_test, LeafVisitor&& leaf_visitor) const
+        {
+            if (m_root == k_null_node)
+            {
+                return;
+            }
+
+            m_query_stack.clear();
+            m_query_stack.push_back(m_root);
+            while (!m_query_stack.empty())
+            {
+                const Node& node = m_nodes[m_query_stack.back()];
+                m_query_stack.pop_back();
+
+                if (!node_test(node.bounds))
+                {
+                    continue;
+                }
+                if (node.isLeaf())
+                {
+                    leaf_visitor(node.user_index);
+                }
+                else
+                {
+                    m_query_stack.push_back(node.children[1]);
+                    m_query_stack.push_back(node.children[0]);
+                }
+            }
+        }
+
+    private:
+        struct Node
+        {
+            BoundingBox bounds;
+            uint32_t    parent {k_null_node}; // next free node while the node is in the free list
+            uint32_t    children[2] {k_null_node, k_null_node};
+            uint32_t    user_index {0};
+            int32_t     height {0}; // -1 for free nodes
+
+            bool isLeaf() const { return children[0] == k_null_node; }
+        };
+
+        uint32_t allocateNode();
+        void     freeNode(uint32_t node_index);
+
+        void     insertLeaf(uint32_t leaf);
+        void     removeLeaf(uint32_t leaf);
+        void     refitAncestors(uint32_t node_index);
+        uint32_t balance(uint32_t node_index);
+
+        std::vector<Node> m_nodes;
+        uint32_t          m_root {k_null_node};
+        uint32_t          m_free_list {k_null_node};
+
+        mutable std::vector<uint32_t> m_query_stack;
+    };
+} // namespace Piccolo
@@ -1,11 +1,19 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <unordered_map>
+#include <vector>
 
 namespace Piccolo
 {
     static const size_t s_invalid_guid = 0;
 
+    /// hands out guids for elements, a guid packs the slot of the element and the generation of the slot
+    ///
+    /// freed slots are reused from a free list and their generation is bumped, so a stale guid of a freed element
+    /// does not resolve to the element now living in the slot. a slot whose generation would wrap is retired instead
+    /// of reused, so no guid ever comes back. every operation is O(1), guids fit in 32 bits
     template<typename T>
     class GuidAllocator
     {
@@ -20,26 +28,36 @@ namespace Piccolo
                 return find_it->second;
             }
 
-            for (size_t i = 0; i < m_guid_elements_map.size() + 1; i++)
+            uint32_t slot_index;
+            if (!m_free_slots.empty())
             {
-                size_t guid = i + 1;
-                if (m_guid_elements_map.find(guid) == m_guid_elements_map.end())
+                slot_index = m_free_slots.back();
+                m_free_slots.pop_back();
+            }
+            else
+            {
+                if (m_slots.size() >= s_max_slot_count)
                 {
-                    m_guid_elements_map.insert(std::make_pair(guid, t));
-                    m_elements_guid_map.insert(std::make_pair(t, guid));
-                    return guid;
+                    return s_invalid_guid;
                 }
+                slot_index = static_cast<uint32_t>(m_slots.size());
+                m_slots.emplace_back();
             }
 
-            return s_invalid_guid;
+            Slot& slot    = m_slots[slot_index];
+            slot.element  = t;
+            slot.is_used  = true;
+            size_t guid   = makeGuid(slot_index, slot.generation);
+            m_elements_guid_map.insert(std::make_pair(t, guid));
+            return guid;
         }
 
         bool getGuidRelatedElement(size_t guid, T& t)
         {
-            auto find_it = m_guid_elements_map.find(guid);
-            if (find_it != m_guid_elements_map.end())
+            const Slot* slot = findSlot(guid);
+            if (slot != nullptr)
             {
-                t = find_it->second;
+                t = slot->element;
                 return true;
             }
             return false;
@@ -60,12 +78,9 @@ namespace Piccolo
 
         void freeGuid(size_t guid)
         {
-            auto find_it = m_guid_elements_map.find(guid);
-            if (find_it != m_guid_elements_map.end())
+            if (findSlot(guid) != nullptr)
             {
-                const auto& ele = find_it->second;
-                m_elements_guid_map.erase(ele);
-                m_guid_elements_map.erase(guid);
+                freeSlot(getSlotIndex(guid));
             }
         }
 
@@ -74,18 +89,20 @@ namespace Piccolo
             auto find_it = m_elements_guid_map.find(t);
             if (find_it != m_elements_guid_map.end())
             {
-                const auto& guid = find_it->second;
-                m_elements_guid_map.erase(t);
-                m_guid_elements_map.erase(guid);
+                freeSlot(getSlotIndex(find_it->second));
             }
         }
 
         std::vector<size_t> getAllocatedGuids() const
         {
             std::vector<size_t> allocated_guids;
-            for (const auto& ele : m_guid_elements_map)
+            allocated_guids.reserve(m_elements_guid_map.size());
+            for (uint32_t slot_index = 0; slot_index < m_slots.size(); ++slot_index)
             {
-                allocated_guids.push_back(ele.first);
+                if (m_slots[slot_index].is_used)
+                {
+                    allocated_guids.push_back(makeGuid(slot_index, m_slots[slot_index].generation));
+                }
             }
             return allocated_guids;
         }
@@ -93,12 +110,65 @@ namespace Piccolo
         void clear()
         {
             m_elements_guid_map.clear();
-            m_guid_elements_map.clear();
+            m_slots.clear();
+            m_free_slots.clear();
         }
 
     private:
+        struct Slot
+        {
+            T        element {};
+            uint32_t generation {0};
+            bool     is_used {false};
+        };
+
+        // the low bits hold the slot index plus one, so no guid is s_invalid_guid
+        static constexpr uint32_t s_slot_index_bits = 24;
+        static constexpr uint32_t s_max_slot_count  = (1u << s_slot_index_bits) - 1;
+        static constexpr uint32_t s_generation_mask = (1u << (32 - s_slot_index_bits)) - 1;
+
+        static size_t makeGuid(uint32_t slot_index, uint32_t generation)
+        {
+            return (static_cast<size_t>(generation) << s_slot_index_bits) | (slot_index + 1);
+        }
+        static uint32_t getSlotIndex(size_t guid)
+        {
+            return static_cast<uint32_t>(guid & ((1u << s_slot_index_bits) - 1)) - 1;
+        }
+
+        const Slot* findSlot(size_t guid) const
+        {
+            if (!isValidGuid(guid))
+            {
+                return nullptr;
+            }
+            uint32_t slot_index = getSlotIndex(guid);
+            if (slot_index >= m_slots.size())
+            {
+                return nullptr;
+            }
+            const Slot& slot = m_slots[slot_index];
+            return slot.is_used && makeGuid(slot_index, slot.generation) == guid ? &slot : nullptr;
+        }
+
+        void freeSlot(uint32_t slot_index)
+        {
+            Slot& slot = m_slots[slot_index];
+            m_elements_guid_map.erase(slot.element);
+            slot.element    = T {};
+            slot.is_used    = false;
+            if (slot.generation == s_generation_mask)
+            {
+                // the next generation would hand out the guids of the first one again, the slot stays unused
+                return;
+            }
+            slot.generation++;
+            m_free_slots.push_back(slot_index);
+        }
+
         std::unordered_map<T, size_t> m_elements_guid_map;
-        std::unordered_map<size_t, T> m_guid_elements_map;
+        std::vector<Slot>             m_slots;
+        std::vector<uint32_t>         m_free_slots;
     };
 
 } // namespace Piccolo
@@ -2,6 +2,8 @@
 #include "runtime/function/render/render_camera.h"
 #include "runtime/function/render/render_scene.h"
 
+#include "runtime/core/math/simd_float4.h"
+
 namespace Piccolo
 {
     ClusterFrustum CreateClusterFrustumFromMatrix(Matrix4x4 mat,
@@ -179,6 +181,73 @@ namespace Piccolo
         return true;
     }
 
+    void BoundingBoxArray::resize(size_t count)
+    {
+        size_t padded_count = roundUp(static_cast<uint32_t>(count), SimdFloat4::k_lane_count);
+        for (size_t axis = 0; axis < 3; ++axis)
+        {
+            min_bounds[axis].resize(padded_count);
+            max_bounds[axis].resize(padded_count);
+        }
+        size = count;
+    }
+
+    void BoundingBoxArray::setBox(size_t index, BoundingBox const& b)
+    {
+        for (size_t axis = 0; axis < 3; ++axis)
+        {
+            min_bounds[axis][index] = b.min_bound[axis];
+            max_bounds[axis][index] = b.max_bound[axis];
+        }
+    }
+
+    void TiledFrustumIntersectBoxes(ClusterFrustum const&  f,
+                                    BoundingBoxArray const& boxes,
+                                    std::vector<uint32_t>&  visibility_mask)
+    {
+        Vector4 const* planes[6] = {
+            &f.m_plane_right, &f.m_plane_left, &f.m_plane_top, &f.m_plane_bottom, &f.m_plane_near, &f.m_plane_far};
+
+        visibility_mask.assign((boxes.size + 31) / 32, 0);
+
+        SimdFloat4 const half = SimdFloat4::splat(0.5f);
+        for (size_t first_box = 0; first_box < boxes.size; first_box += SimdFloat4::k_lane_count)
+        {
+            SimdFloat4 box_center[3];
+            SimdFloat4 box_extents[3];
+            for (size_t axis = 0; axis < 3; ++axis)
+            {
+                SimdFloat4 min_bound = SimdFloat4::load(boxes.min_bounds[axis].data() + first_box);
+                SimdFloat4 max_bound = SimdFloat4::load(boxes.max_bounds[axis].data() + first_box);
+                box_center[axis]     = (max_bound + min_bound) * half;
+                box_extents[axis]    = (max_bound - min_bound) * half;
+            }
+
+            // a box is culled when it is completely on the outer side of any plane
+            SimdFloat4 is_visible;
+            for (size_t plane_index = 0; plane_index < 6; ++plane_index)
+            {
+                Vector4 const* plane = planes[plane_index];
+                SimdFloat4 signed_distance = SimdFloat4::splat(plane->x) * box_center[0] +
+                                             SimdFloat4::splat(plane->y) * box_center[1] +
+                                             SimdFloat4::splat(plane->z) * box_center[2] + SimdFloat4::splat(plane->w);
+                SimdFloat4 radius_project = SimdFloat4::splat(fabs(plane->x)) * box_extents[0] +
+                                            SimdFloat4::splat(fabs(plane->y)) * box_extents[1] +
+                                            SimdFloat4::splat(fabs(plane->z)) * box_extents[2];
+                SimdFloat4 is_inside = SimdFloat4::lessThan(signed_distance, radius_project);
+                is_visible           = plane_index == 0 ? is_inside : is_visible & is_inside;
+            }
+
+            visibility_mask[first_box / 32] |= SimdFloat4::moveMask(is_visible) << (first_box % 32);
+        }
+
+        // the padding lanes are not boxes
+        if (boxes.size % 32 != 0)
+        {
+            visibility_mask.back() &= (1u << (boxes.size % 32)) - 1;
+        }
+    }
+
     BoundingBox BoundingBoxTransform(BoundingBox const& b, Matrix4x4 const& m)
     {
         // we follow the "BoundingBox::Transform"
@@ -305,13 +374,8 @@ namespace Piccolo
             scene_bounding_box.min_bound = Vector3(FLT_MAX, FLT_MAX, FLT_MAX);
             scene_bounding_box.max_bound = Vector3(FLT_MIN, FLT_MIN, FLT_MIN);
 
-            for (const RenderEntity& entity : scene.m_render_entities)
+            for (const BoundingBox& mesh_bounding_box_world : scene.getRenderEntityWorldBounds())
             {
-                BoundingBox mesh_asset_bounding_box {entity.m_bounding_box.getMinCorner(),
-                                                     entity.m_bounding_box.getMaxCorner()};
-
-                BoundingBox mesh_bounding_box_world =
-                    BoundingBoxTransform(mesh_asset_bounding_box, entity.m_model_matrix);
                 scene_bounding_box.merge(mesh_bounding_box_world);
             }
         }
@@ -3,6 +3,9 @@
 #include "runtime/core/math/vector3.h"
 #include "runtime/core/math/vector4.h"
 
+#include <cstdint>
+#include <vector>
+
 namespace Piccolo
 {
     class RenderScene;
@@ -56,6 +59,17 @@ namespace Piccolo
         }
     };
 
+    // the bounds of many boxes as structure of arrays, padded to a multiple of SimdFloat4::k_lane_count
+    struct BoundingBoxArray
+    {
+        std::vector<float> min_bounds[3];
+        std::vector<float> max_bounds[3];
+        size_t             size {0};
+
+        void resize(size_t count);
+        void setBox(size_t index, BoundingBox const& b);
+    };
+
     struct BoundingSphere
     {
         Vector3   m_center;
@@ -77,6 +91,12 @@ namespace Piccolo
 
     bool TiledFrustumIntersectBox(ClusterFrustum const& f, BoundingBox const& b);
 
+    // same test as TiledFrustumIntersectBox for four boxes at a time, bit (i % 32) of visibility_mask[i / 32] is set
+    // when box i intersects the frustum
+    void TiledFrustumIntersectBoxes(ClusterFrustum const&  f,
+                                    BoundingBoxArray const& boxes,
+                                    std::vector<uint32_t>&  visibility_mask);
+
     BoundingBox BoundingBoxTransform(BoundingBox const& b, Matrix4x4 const& m);
 
     bool BoxIntersectsWithSphere(BoundingBox const& b, BoundingSphere const& s);
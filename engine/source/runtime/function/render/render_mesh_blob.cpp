@@ -0,0 +1,206 @@
+#include "runtime/function/render/render_mesh_blob.h"
+
+#include "runtime/core/base/macro.h"
+
+#include "runtime/platform/file_service/mapped_file.h"
+
+#include "runtime/resource/asset_manager/asset_manager.h"
+#include "runtime/resource/res_type/data/mesh_data.h"
+
+#include "runtime/function/global/global_context.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace Piccolo
+{
+    namespace
+    {
+        size_t alignBlobOffset(size_t offset)
+        {
+            return (offset + k_mesh_blob_alignment - 1) & ~(k_mesh_blob_alignment - 1);
+        }
+
+        bool isBlobSectionValid(uint64_t offset, uint64_t count, size_t element_size, size_t blob_size)
+        {
+            if (count == 0)
+            {
+                return true;
+            }
+            return offset % k_mesh_blob_alignment == 0 && offset <= blob_size &&
+                   count <= (blob_size - offset) / element_size;
+        }
+    } // namespace
+
+    std::filesystem::path MeshBlob::getBlobPath(const std::string& mesh_file)
+    {
+        std::filesystem::path blob_path = g_runtime_global_context.m_asset_manager->getFullPath(mesh_file);
+        return blob_path.replace_extension(".blob");
+    }
+
+    bool MeshBlob::cook(const std::string& mesh_file)
+    {
+        std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
+        ASSERT(asset_manager);
+
+        MeshData mesh_data;
+        if (!asset_manager->loadJsonAsset(mesh_file, mesh_data))
+        {
+            return false;
+        }
+        return write(mesh_data, getBlobPath(mesh_file));
+    }
+
+    bool MeshBlob::write(const MeshData& mesh_data, const std::filesystem::path& blob_path)
+    {
+        uint32_t max_index = 0;
+        for (const auto index : mesh_data.index_buffer)
+        {
+            max_index = std::max(max_index, static_cast<uint32_t>(index));
+        }
+
+        MeshBlobHeader header;
+        header.m_magic         = k_mesh_blob_magic;
+        header.m_version       = k_mesh_blob_version;
+        header.m_vertex_count  = static_cast<uint32_t>(mesh_data.vertex_buffer.size());
+        header.m_index_count   = static_cast<uint32_t>(mesh_data.index_buffer.size());
+        header.m_index_stride  = max_index > std::numeric_limits<uint16_t>::max() ? sizeof(uint32_t) : sizeof(uint16_t);
+        header.m_binding_count = static_cast<uint32_t>(mesh_data.bind.size());
+
+        AxisAlignedBox bounding_box;
+        for (const Vertex& vertex : mesh_data.vertex_buffer)
+        {
+            bounding_box.merge(Vector3(vertex.px, vertex.py, vertex.pz));
+        }
+        if (!mesh_data.vertex_buffer.empty())
+        {
+            const Vector3& min_corner = bounding_box.getMinCorner();
+            const Vector3& max_corner = bounding_box.getMaxCorner();
+            std::copy(min_corner.ptr(), min_corner.ptr() + 3, header.m_bounding_min);
+            std::copy(max_corner.ptr(), max_corner.ptr() + 3, header.m_bounding_max);
+        }
+
+        header.m_vertex_offset  = alignBlobOffset(sizeof(MeshBlobHeader));
+        header.m_index_offset   = alignBlobOffset(static_cast<size_t>(header.m_vertex_offset) +
+                                                header.m_vertex_count * sizeof(MeshVertexDataDefinition));
+        header.m_binding_offset = alignBlobOffset(static_cast<size_t>(header.m_index_offset) +
+                                                  header.m_index_count * header.m_index_stride);
+        const size_t blob_size  = static_cast<size_t>(header.m_binding_offset) +
+                                 header.m_binding_count * sizeof(MeshVertexBindingDataDefinition);
+
+        std::vector<uint8_t> blob(blob_size, 0);
+        std::memcpy(blob.data(), &header, sizeof(header));
+
+        MeshVertexDataDefinition* vertex =
+            reinterpret_cast<MeshVertexDataDefinition*>(blob.data() + header.m_vertex_offset);
+        for (size_t i = 0; i < mesh_data.vertex_buffer.size(); i++)
+        {
+            const Vertex& source = mesh_data.vertex_buffer[i];
+            vertex[i]            = {source.px,
+                         source.py,
+                         source.pz,
+                         source.nx,
+                         source.ny,
+                         source.nz,
+                         source.tx,
+                         source.ty,
+                         source.tz,
+                         source.u,
+                         source.v};
+        }
+
+        if (header.m_index_stride == sizeof(uint32_t))
+        {
+            uint32_t* index = reinterpret_cast<uint32_t*>(blob.data() + header.m_index_offset);
+            for (size_t i = 0; i < mesh_data.index_buffer.size(); i++)
+            {
+                index[i] = static_cast<uint32_t>(mesh_data.index_buffer[i]);
+            }
+        }
+        else
+        {
+            uint16_t* index = reinterpret_cast<uint16_t*>(blob.data() + header.m_index_offset);
+            for (size_t i = 0; i < mesh_data.index_buffer.size(); i++)
+            {
+                index[i] = static_cast<uint16_t>(mesh_data.index_buffer[i]);
+            }
+        }
+
+        MeshVertexBindingDataDefinition* binding_data =
+            reinterpret_cast<MeshVertexBindingDataDefinition*>(blob.data() + header.m_binding_offset);
+        for (size_t i = 0; i < mesh_data.bind.size(); i++)
+        {
+            const SkeletonBinding& source = mesh_data.bind[i];
+            binding_data[i].m_index0      = source.index0;
+            binding_data[i].m_index1      = source.index1;
+            binding_data[i].m_index2      = source.index2;
+            binding_data[i].m_index3      = source.index3;
+            binding_data[i].m_weight0     = source.weight0;
+            binding_data[i].m_weight1     = source.weight1;
+            binding_data[i].m_weight2     = source.weight2;
+            binding_data[i].m_weight3     = source.weight3;
+        }
+
+        // a live MeshBlob may still map the old blob, truncating it in place would fault its readers
+        return g_runtime_global_context.m_asset_manager->writeDerivedFile(blob_path, blob);
+    }
+
+    bool MeshBlob::load(const std::string& mesh_file, RenderMeshData& out_mesh_data, AxisAlignedBox& out_bounding_box)
+    {
+        std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
+        ASSERT(asset_manager);
+
+        const std::filesystem::path blob_path = getBlobPath(mesh_file);
+        if (!asset_manager->isDerivedFileUpToDate(mesh_file, blob_path))
+        {
+            return false;
+        }
+
+        std::shared_ptr<MappedFile> mapped_file = std::make_shared<MappedFile>();
+        if (!mapped_file->open(blob_path) || mapped_file->size() < sizeof(MeshBlobHeader))
+        {
+            return false;
+        }
+
+        MeshBlobHeader header;
+        std::memcpy(&header, mapped_file->data(), sizeof(header));
+
+        const size_t blob_size = mapped_file->size();
+        if (header.m_magic != k_mesh_blob_magic || header.m_version != k_mesh_blob_version ||
+            (header.m_index_stride != sizeof(uint16_t) && header.m_index_stride != sizeof(uint32_t)) ||
+            !isBlobSectionValid(
+                header.m_vertex_offset, header.m_vertex_count, sizeof(MeshVertexDataDefinition), blob_size) ||
+            !isBlobSectionValid(header.m_index_offset, header.m_index_count, header.m_index_stride, blob_size) ||
+            !isBlobSectionValid(
+                header.m_binding_offset, header.m_binding_count, sizeof(MeshVertexBindingDataDefinition), blob_size))
+        {
+            LOG_WARN("mesh blob {} is invalid", blob_path.generic_string());
+            return false;
+        }
+
+        uint8_t* blob_data = static_cast<uint8_t*>(mapped_file->data());
+
+        out_mesh_data.m_static_mesh_data.m_vertex_buffer =
+            std::make_shared<BufferData>(blob_data + header.m_vertex_offset,
+                                         header.m_vertex_count * sizeof(MeshVertexDataDefinition),
+                                         mapped_file);
+        out_mesh_data.m_static_mesh_data.m_index_buffer = std::make_shared<BufferData>(
+            blob_data + header.m_index_offset, header.m_index_count * header.m_index_stride, mapped_file);
+        out_mesh_data.m_static_mesh_data.m_index_type =
+            header.m_index_stride == sizeof(uint32_t) ? RHI_INDEX_TYPE_UINT32 : RHI_INDEX_TYPE_UINT16;
+        out_mesh_data.m_skeleton_binding_buffer =
+            std::make_shared<BufferData>(blob_data + header.m_binding_offset,
+                                         header.m_binding_count * sizeof(MeshVertexBindingDataDefinition),
+                                         mapped_file);
+
+        if (header.m_vertex_count > 0)
+        {
+            out_bounding_box.merge(Vector3(header.m_bounding_min));
+            out_bounding_box.merge(Vector3(header.m_bounding_max));
+        }
+
+        return true;
+    }
+} // namespace Piccolo
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "runtime/core/math/axis_aligned.h"
+#include "runtime/function/render/render_type.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace Piccolo
+{
+    class MeshData;
+
+    /// cooked mesh whose sections are stored exactly as the render resource consumes them, so loading is a file
+    /// mapping plus pointer fix-ups: no json parsing, no MeshData and no per-vertex copies
+    ///
+    /// layout: MeshBlobHeader | vertices (MeshVertexDataDefinition) | indices (uint16 or uint32) | bindings
+    /// (MeshVertexBindingDataDefinition), every section starts on a k_mesh_blob_alignment boundary
+    struct MeshBlobHeader
+    {
+        uint32_t m_magic {0};
+        uint32_t m_version {0};
+
+        uint32_t m_vertex_count {0};
+        uint32_t m_index_count {0};
+        uint32_t m_index_stride {0};
+        uint32_t m_binding_count {0};
+
+        // precomputed bounds of every vertex position
+        float m_bounding_min[3] {0.f, 0.f, 0.f};
+        float m_bounding_max[3] {0.f, 0.f, 0.f};
+
+        uint64_t m_vertex_offset {0};
+        uint64_t m_index_offset {0};
+        uint64_t m_binding_offset {0};
+    };
+
+    static constexpr uint32_t k_mesh_blob_magic     = 0x424D4350; // "PCMB"
+    static constexpr uint32_t k_mesh_blob_version   = 3;
+    static constexpr size_t   k_mesh_blob_alignment = 16;
+
+    class MeshBlob
+    {
+    public:
+        /// xxx.mesh.json -> xxx.mesh.blob, next to the json source
+        static std::filesystem::path getBlobPath(const std::string& mesh_file);
+
+        static bool cook(const std::string& mesh_file);
+        static bool write(const MeshData& mesh_data, const std::filesystem::path& blob_path);
+
+        /// the returned buffers alias the mapped file, which stays mapped until the last of them is released
+        static bool load(const std::string& mesh_file, RenderMeshData& out_mesh_data, AxisAlignedBox& out_bounding_box);
+    };
+} // namespace Piccolo
@@ -85,17 +85,17 @@ namespace Piccolo
         };
 
         /// <summary>
-        /// Pass ʹõȫԴ
+        /// Pass 可以使用的全局资源
         /// </summary>
         GlobalRenderResource* m_global_render_resource{ nullptr };
 
         /// <summary>
-        /// Դ
+        /// 输入输出资源描述
         /// </summary>
         std::vector<Descriptor> m_descriptor_infos;
 
         /// <summary>
-        /// ִйϢ
+        /// 执行管线信息
         /// </summary>
         std::vector<RenderPipelineBase> m_render_pipelines;
 
@@ -111,7 +111,7 @@ namespace Piccolo
         virtual std::vector<RHIDescriptorSetLayout*> getDescriptorSetLayouts() const;
 
         /// <summary>
-        /// Passɼ
+        /// Pass可见的物体
         /// </summary>
         static VisiableNodes m_visiable_nodes;
 
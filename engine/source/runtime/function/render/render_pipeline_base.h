@@ -14,7 +14,7 @@ namespace Piccolo
 
     struct RenderPipelineInitInfo
     {
-        bool enable_fxaa {false}; //Ƿÿfxaa
+        bool enable_fxaa {false}; //是否启用抗锯齿fxaa
         std::shared_ptr<RenderResourceBase> render_resource;
     };
 
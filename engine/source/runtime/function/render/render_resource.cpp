@@ -287,6 +287,7 @@ namespace Piccolo
 
             uint32_t index_buffer_size = static_cast<uint32_t>(mesh_data.m_static_mesh_data.m_index_buffer->m_size);
             void* index_buffer_data = mesh_data.m_static_mesh_data.m_index_buffer->m_data;
+            RHIIndexType index_type = mesh_data.m_static_mesh_data.m_index_type;
 
             uint32_t vertex_buffer_size = static_cast<uint32_t>(mesh_data.m_static_mesh_data.m_vertex_buffer->m_size);
             MeshVertexDataDefinition* vertex_buffer_data =
@@ -303,6 +304,7 @@ namespace Piccolo
                                true,
                                index_buffer_size,
                                index_buffer_data,
+                               index_type,
                                vertex_buffer_size,
                                vertex_buffer_data,
                                joint_binding_buffer_size,
@@ -315,6 +317,7 @@ namespace Piccolo
                                false,
                                index_buffer_size,
                                index_buffer_data,
+                               index_type,
                                vertex_buffer_size,
                                vertex_buffer_data,
                                0,
@@ -592,6 +595,7 @@ namespace Piccolo
                                         bool                                   enable_vertex_blending,
                                         uint32_t                               index_buffer_size,
                                         void*                                  index_buffer_data,
+                                        RHIIndexType                           index_type,
                                         uint32_t                               vertex_buffer_size,
                                         MeshVertexDataDefinition const*        vertex_buffer_data,
                                         uint32_t                               joint_binding_buffer_size,
@@ -608,11 +612,10 @@ namespace Piccolo
                            joint_binding_buffer_size,
                            joint_binding_buffer_data,
                            index_buffer_size,
-                           reinterpret_cast<uint16_t*>(index_buffer_data),
+                           index_buffer_data,
+                           index_type,
                            now_mesh);
-        assert(0 == (index_buffer_size % sizeof(uint16_t)));
-        now_mesh.mesh_index_count = index_buffer_size / sizeof(uint16_t);
-        updateIndexBuffer(rhi, index_buffer_size, index_buffer_data, now_mesh);
+        updateIndexBuffer(rhi, index_buffer_size, index_buffer_data, index_type, now_mesh);
     }
 
     void RenderResource::updateVertexBuffer(std::shared_ptr<RHI>                   rhi,
@@ -622,7 +625,8 @@ namespace Piccolo
                                             uint32_t                               joint_binding_buffer_size,
                                             MeshVertexBindingDataDefinition const* joint_binding_buffer_data,
                                             uint32_t                               index_buffer_size,
-                                            uint16_t*                              index_buffer_data,
+                                            void const*                            index_buffer_data,
+                                            RHIIndexType                           index_type,
                                             VulkanMesh&                            now_mesh)
     {
         VulkanRHI* vulkan_context = static_cast<VulkanRHI*>(rhi.get());
@@ -631,8 +635,9 @@ namespace Piccolo
         {
             assert(0 == (vertex_buffer_size % sizeof(MeshVertexDataDefinition)));
             uint32_t vertex_count = vertex_buffer_size / sizeof(MeshVertexDataDefinition);
-            assert(0 == (index_buffer_size % sizeof(uint16_t)));
-            uint32_t index_count = index_buffer_size / sizeof(uint16_t);
+            uint32_t index_size = (index_type == RHI_INDEX_TYPE_UINT32) ? sizeof(uint32_t) : sizeof(uint16_t);
+            assert(0 == (index_buffer_size % index_size));
+            uint32_t index_count = index_buffer_size / index_size;
 
             RHIDeviceSize vertex_position_buffer_size = sizeof(MeshVertex::VulkanMeshVertexPostition) * vertex_count;
             RHIDeviceSize vertex_varying_enable_blending_buffer_size =
@@ -703,7 +708,10 @@ namespace Piccolo
 
             for (uint32_t index_index = 0; index_index < index_count; ++index_index)
             {
-                uint32_t vertex_buffer_index = index_buffer_data[index_index];
+                uint32_t vertex_buffer_index =
+                    (index_type == RHI_INDEX_TYPE_UINT32) ?
+                        static_cast<uint32_t const*>(index_buffer_data)[index_index] :
+                        static_cast<uint16_t const*>(index_buffer_data)[index_index];
 
                 // TODO: move to assets loading process
 
@@ -1007,10 +1015,16 @@ namespace Piccolo
     void RenderResource::updateIndexBuffer(std::shared_ptr<RHI> rhi,
                                            uint32_t             index_buffer_size,
                                            void*                index_buffer_data,
+                                           RHIIndexType         index_type,
                                            VulkanMesh&          now_mesh)
     {
         VulkanRHI* vulkan_context = static_cast<VulkanRHI*>(rhi.get());
 
+        uint32_t index_size = (index_type == RHI_INDEX_TYPE_UINT32) ? sizeof(uint32_t) : sizeof(uint16_t);
+        assert(0 == (index_buffer_size % index_size));
+        now_mesh.mesh_index_count = index_buffer_size / index_size;
+        now_mesh.mesh_index_type  = index_type;
+
         // temp staging buffer
         RHIDeviceSize buffer_size = index_buffer_size;
 
@@ -167,6 +167,7 @@ namespace Piccolo
                             bool                                          enable_vertex_blending,
                             uint32_t                                      index_buffer_size,
                             void*                                         index_buffer_data,
+                            RHIIndexType                                  index_type,
                             uint32_t                                      vertex_buffer_size,
                             struct MeshVertexDataDefinition const*        vertex_buffer_data,
                             uint32_t                                      joint_binding_buffer_size,
@@ -179,11 +180,13 @@ namespace Piccolo
                                 uint32_t                                      joint_binding_buffer_size,
                                 struct MeshVertexBindingDataDefinition const* joint_binding_buffer_data,
                                 uint32_t                                      index_buffer_size,
-                                uint16_t*                                     index_buffer_data,
+                                void const*                                   index_buffer_data,
+                                RHIIndexType                                  index_type,
                                 VulkanMesh&                                   now_mesh);
         void updateIndexBuffer(std::shared_ptr<RHI> rhi,
                                uint32_t             index_buffer_size,
                                void*                index_buffer_data,
+                               RHIIndexType         index_type,
                                VulkanMesh&          now_mesh);
         void updateTextureImageData(std::shared_ptr<RHI> rhi, const TextureDataToUpdate& texture_data);
     };
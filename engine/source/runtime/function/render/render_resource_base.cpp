@@ -7,6 +7,7 @@
 #include "runtime/resource/res_type/data/mesh_data.h"
 
 #include "runtime/function/global/global_context.h"
+#include "runtime/function/render/render_mesh_blob.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -16,6 +17,7 @@
 
 #include <algorithm>
 #include <filesystem>
+#include <limits>
 #include <vector>
 
 namespace Piccolo
@@ -84,9 +86,53 @@ namespace Piccolo
 
     RenderMeshData RenderResourceBase::loadMeshData(const MeshSourceDesc& source, AxisAlignedBox& bounding_box)
     {
-        std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
-        ASSERT(asset_manager);
+        RenderMeshData ret;
+
+        std::unique_lock<std::mutex> lock(m_prefetch_mutex);
+        m_resident_meshes.insert(source);
+        auto prefetched_it = m_prefetched_meshes.find(source);
+        if (prefetched_it != m_prefetched_meshes.end())
+        {
+            ret = std::move(prefetched_it->second.m_mesh_data);
+            bounding_box.merge(prefetched_it->second.m_bounding_box.getMinCorner());
+            bounding_box.merge(prefetched_it->second.m_bounding_box.getMaxCorner());
+            m_prefetched_meshes.erase(prefetched_it);
+            lock.unlock();
+        }
+        else
+        {
+            lock.unlock();
+            ret = readMeshData(source, bounding_box);
+        }
+
+        m_bounding_box_cache_map.insert(std::make_pair(source, bounding_box));
+
+        return ret;
+    }
+
+    void RenderResourceBase::prefetchMeshData(const MeshSourceDesc& source)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_prefetch_mutex);
+            if (m_resident_meshes.count(source) != 0 || m_prefetched_meshes.find(source) != m_prefetched_meshes.end())
+            {
+                return;
+            }
+        }
+
+        PrefetchedMeshData prefetched;
+        prefetched.m_mesh_data = readMeshData(source, prefetched.m_bounding_box);
+
+        // nothing would ever take the data of a mesh that was loaded while it was read
+        std::lock_guard<std::mutex> lock(m_prefetch_mutex);
+        if (m_resident_meshes.count(source) == 0)
+        {
+            m_prefetched_meshes.emplace(source, std::move(prefetched));
+        }
+    }
 
+    RenderMeshData RenderResourceBase::readMeshData(const MeshSourceDesc& source, AxisAlignedBox& bounding_box)
+    {
         RenderMeshData ret;
 
         if (std::filesystem::path(source.m_mesh_file).extension() == ".obj")
@@ -95,64 +141,33 @@ namespace Piccolo
         }
         else if (std::filesystem::path(source.m_mesh_file).extension() == ".json")
         {
-            std::shared_ptr<MeshData> bind_data = std::make_shared<MeshData>();
-            asset_manager->loadAsset<MeshData>(source.m_mesh_file, *bind_data);
-
-            // vertex buffer
-            size_t vertex_size                     = bind_data->vertex_buffer.size() * sizeof(MeshVertexDataDefinition);
-            ret.m_static_mesh_data.m_vertex_buffer = std::make_shared<BufferData>(vertex_size);
-            MeshVertexDataDefinition* vertex =
-                (MeshVertexDataDefinition*)ret.m_static_mesh_data.m_vertex_buffer->m_data;
-            for (size_t i = 0; i < bind_data->vertex_buffer.size(); i++)
+            if (!MeshBlob::load(source.m_mesh_file, ret, bounding_box))
             {
-                vertex[i].x  = bind_data->vertex_buffer[i].px;
-                vertex[i].y  = bind_data->vertex_buffer[i].py;
-                vertex[i].z  = bind_data->vertex_buffer[i].pz;
-                vertex[i].nx = bind_data->vertex_buffer[i].nx;
-                vertex[i].ny = bind_data->vertex_buffer[i].ny;
-                vertex[i].nz = bind_data->vertex_buffer[i].nz;
-                vertex[i].tx = bind_data->vertex_buffer[i].tx;
-                vertex[i].ty = bind_data->vertex_buffer[i].ty;
-                vertex[i].tz = bind_data->vertex_buffer[i].tz;
-                vertex[i].u  = bind_data->vertex_buffer[i].u;
-                vertex[i].v  = bind_data->vertex_buffer[i].v;
-
-                bounding_box.merge(Vector3(vertex[i].x, vertex[i].y, vertex[i].z));
+                ret = loadJsonMesh(source.m_mesh_file, bounding_box);
             }
+        }
 
-            // index buffer
-            size_t index_size                     = bind_data->index_buffer.size() * sizeof(uint16_t);
-            ret.m_static_mesh_data.m_index_buffer = std::make_shared<BufferData>(index_size);
-            uint16_t* index                       = (uint16_t*)ret.m_static_mesh_data.m_index_buffer->m_data;
-            for (size_t i = 0; i < bind_data->index_buffer.size(); i++)
-            {
-                index[i] = static_cast<uint16_t>(bind_data->index_buffer[i]);
-            }
+        return ret;
+    }
 
-            // skeleton binding buffer
-            size_t data_size              = bind_data->bind.size() * sizeof(MeshVertexBindingDataDefinition);
-            ret.m_skeleton_binding_buffer = std::make_shared<BufferData>(data_size);
-            MeshVertexBindingDataDefinition* binding_data =
-                reinterpret_cast<MeshVertexBindingDataDefinition*>(ret.m_skeleton_binding_buffer->m_data);
-            for (size_t i = 0; i < bind_data->bind.size(); i++)
+    RenderMaterialData RenderResourceBase::loadMaterialData(const MaterialSourceDesc& source)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_prefetch_mutex);
+            m_resident_materials.insert(source);
+            auto prefetched_it = m_prefetched_materials.find(source);
+            if (prefetched_it != m_prefetched_materials.end())
             {
-                binding_data[i].m_index0  = bind_data->bind[i].index0;
-                binding_data[i].m_index1  = bind_data->bind[i].index1;
-                binding_data[i].m_index2  = bind_data->bind[i].index2;
-                binding_data[i].m_index3  = bind_data->bind[i].index3;
-                binding_data[i].m_weight0 = bind_data->bind[i].weight0;
-                binding_data[i].m_weight1 = bind_data->bind[i].weight1;
-                binding_data[i].m_weight2 = bind_data->bind[i].weight2;
-                binding_data[i].m_weight3 = bind_data->bind[i].weight3;
+                RenderMaterialData ret = std::move(prefetched_it->second);
+                m_prefetched_materials.erase(prefetched_it);
+                return ret;
             }
         }
 
-        m_bounding_box_cache_map.insert(std::make_pair(source, bounding_box));
-
-        return ret;
+        return readMaterialData(source);
     }
 
-    RenderMaterialData RenderResourceBase::loadMaterialData(const MaterialSourceDesc& source)
+    RenderMaterialData RenderResourceBase::readMaterialData(const MaterialSourceDesc& source)
     {
         RenderMaterialData ret;
         ret.m_base_color_texture         = loadTexture(source.m_base_color_file, true);
@@ -163,6 +178,33 @@ namespace Piccolo
         return ret;
     }
 
+    void RenderResourceBase::prefetchMaterialData(const MaterialSourceDesc& source)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_prefetch_mutex);
+            if (m_resident_materials.count(source) != 0 ||
+                m_prefetched_materials.find(source) != m_prefetched_materials.end())
+            {
+                return;
+            }
+        }
+
+        RenderMaterialData prefetched = readMaterialData(source);
+
+        std::lock_guard<std::mutex> lock(m_prefetch_mutex);
+        if (m_resident_materials.count(source) == 0)
+        {
+            m_prefetched_materials.emplace(source, std::move(prefetched));
+        }
+    }
+
+    void RenderResourceBase::clearPrefetchedData()
+    {
+        std::lock_guard<std::mutex> lock(m_prefetch_mutex);
+        m_prefetched_meshes.clear();
+        m_prefetched_materials.clear();
+    }
+
     AxisAlignedBox RenderResourceBase::getCachedBoudingBox(const MeshSourceDesc& source) const
     {
         auto find_it = m_bounding_box_cache_map.find(source);
@@ -173,6 +215,87 @@ namespace Piccolo
         return AxisAlignedBox();
     }
 
+    RenderMeshData RenderResourceBase::loadJsonMesh(std::string mesh_file, AxisAlignedBox& bounding_box)
+    {
+        std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
+        ASSERT(asset_manager);
+
+        RenderMeshData mesh_data;
+
+        std::shared_ptr<MeshData> bind_data = std::make_shared<MeshData>();
+        asset_manager->loadAsset<MeshData>(mesh_file, *bind_data);
+
+        // vertex buffer
+        size_t vertex_size = bind_data->vertex_buffer.size() * sizeof(MeshVertexDataDefinition);
+        mesh_data.m_static_mesh_data.m_vertex_buffer = std::make_shared<BufferData>(vertex_size);
+        MeshVertexDataDefinition* vertex =
+            (MeshVertexDataDefinition*)mesh_data.m_static_mesh_data.m_vertex_buffer->m_data;
+        for (size_t i = 0; i < bind_data->vertex_buffer.size(); i++)
+        {
+            vertex[i].x  = bind_data->vertex_buffer[i].px;
+            vertex[i].y  = bind_data->vertex_buffer[i].py;
+            vertex[i].z  = bind_data->vertex_buffer[i].pz;
+            vertex[i].nx = bind_data->vertex_buffer[i].nx;
+            vertex[i].ny = bind_data->vertex_buffer[i].ny;
+            vertex[i].nz = bind_data->vertex_buffer[i].nz;
+            vertex[i].tx = bind_data->vertex_buffer[i].tx;
+            vertex[i].ty = bind_data->vertex_buffer[i].ty;
+            vertex[i].tz = bind_data->vertex_buffer[i].tz;
+            vertex[i].u  = bind_data->vertex_buffer[i].u;
+            vertex[i].v  = bind_data->vertex_buffer[i].v;
+
+            bounding_box.merge(Vector3(vertex[i].x, vertex[i].y, vertex[i].z));
+        }
+
+        // index buffer, 16 bit whenever every index fits
+        int max_index = 0;
+        for (int index : bind_data->index_buffer)
+        {
+            max_index = std::max(max_index, index);
+        }
+        if (max_index > std::numeric_limits<uint16_t>::max())
+        {
+            size_t index_size                           = bind_data->index_buffer.size() * sizeof(uint32_t);
+            mesh_data.m_static_mesh_data.m_index_buffer = std::make_shared<BufferData>(index_size);
+            mesh_data.m_static_mesh_data.m_index_type   = RHI_INDEX_TYPE_UINT32;
+            uint32_t* index = (uint32_t*)mesh_data.m_static_mesh_data.m_index_buffer->m_data;
+            for (size_t i = 0; i < bind_data->index_buffer.size(); i++)
+            {
+                index[i] = static_cast<uint32_t>(bind_data->index_buffer[i]);
+            }
+        }
+        else
+        {
+            size_t index_size                           = bind_data->index_buffer.size() * sizeof(uint16_t);
+            mesh_data.m_static_mesh_data.m_index_buffer = std::make_shared<BufferData>(index_size);
+            mesh_data.m_static_mesh_data.m_index_type   = RHI_INDEX_TYPE_UINT16;
+            uint16_t* index = (uint16_t*)mesh_data.m_static_mesh_data.m_index_buffer->m_data;
+            for (size_t i = 0; i < bind_data->index_buffer.size(); i++)
+            {
+                index[i] = static_cast<uint16_t>(bind_data->index_buffer[i]);
+            }
+        }
+
+        // skeleton binding buffer
+        size_t data_size                    = bind_data->bind.size() * sizeof(MeshVertexBindingDataDefinition);
+        mesh_data.m_skeleton_binding_buffer = std::make_shared<BufferData>(data_size);
+        MeshVertexBindingDataDefinition* binding_data =
+            reinterpret_cast<MeshVertexBindingDataDefinition*>(mesh_data.m_skeleton_binding_buffer->m_data);
+        for (size_t i = 0; i < bind_data->bind.size(); i++)
+        {
+            binding_data[i].m_index0  = bind_data->bind[i].index0;
+            binding_data[i].m_index1  = bind_data->bind[i].index1;
+            binding_data[i].m_index2  = bind_data->bind[i].index2;
+            binding_data[i].m_index3  = bind_data->bind[i].index3;
+            binding_data[i].m_weight0 = bind_data->bind[i].weight0;
+            binding_data[i].m_weight1 = bind_data->bind[i].weight1;
+            binding_data[i].m_weight2 = bind_data->bind[i].weight2;
+            binding_data[i].m_weight3 = bind_data->bind[i].weight3;
+        }
+
+        return mesh_data;
+    }
+
     StaticMeshData RenderResourceBase::loadStaticMesh(std::string filename, AxisAlignedBox& bounding_box)
     {
         StaticMeshData mesh_data;
@@ -325,17 +448,31 @@ namespace Piccolo
 
         uint32_t stride           = sizeof(MeshVertexDataDefinition);
         mesh_data.m_vertex_buffer = std::make_shared<BufferData>(mesh_vertices.size() * stride);
-        mesh_data.m_index_buffer  = std::make_shared<BufferData>(mesh_vertices.size() * sizeof(uint16_t));
-
-        assert(mesh_vertices.size() <= std::numeric_limits<uint16_t>::max()); // take care of the index range, should be
-                                                                              // consistent with the index range used by
-                                                                              // vulkan
-
-        uint16_t* indices = (uint16_t*)mesh_data.m_index_buffer->m_data;
         for (size_t i = 0; i < mesh_vertices.size(); i++)
         {
             ((MeshVertexDataDefinition*)(mesh_data.m_vertex_buffer->m_data))[i] = mesh_vertices[i];
-            indices[i]                                                          = static_cast<uint16_t>(i);
+        }
+
+        // take care of the index range, it should be consistent with the index type used by vulkan
+        if (mesh_vertices.size() > std::numeric_limits<uint16_t>::max())
+        {
+            mesh_data.m_index_buffer = std::make_shared<BufferData>(mesh_vertices.size() * sizeof(uint32_t));
+            mesh_data.m_index_type   = RHI_INDEX_TYPE_UINT32;
+            uint32_t* indices        = (uint32_t*)mesh_data.m_index_buffer->m_data;
+            for (size_t i = 0; i < mesh_vertices.size(); i++)
+            {
+                indices[i] = static_cast<uint32_t>(i);
+            }
+        }
+        else
+        {
+            mesh_data.m_index_buffer = std::make_shared<BufferData>(mesh_vertices.size() * sizeof(uint16_t));
+            mesh_data.m_index_type   = RHI_INDEX_TYPE_UINT16;
+            uint16_t* indices        = (uint16_t*)mesh_data.m_index_buffer->m_data;
+            for (size_t i = 0; i < mesh_vertices.size(); i++)
+            {
+                indices[i] = static_cast<uint16_t>(i);
+            }
         }
 
         return mesh_data;
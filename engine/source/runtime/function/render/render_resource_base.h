@@ -5,8 +5,10 @@
 #include "runtime/function/render/render_type.h"
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace Piccolo
 {
@@ -46,9 +48,31 @@ namespace Piccolo
         RenderMaterialData           loadMaterialData(const MaterialSourceDesc& source);
         AxisAlignedBox               getCachedBoudingBox(const MeshSourceDesc& source) const;
 
+        // may be called from any thread, the next loadMeshData / loadMaterialData of the same source takes the
+        // prefetched data instead of reading the files again. a source that was loaded before is resident on the
+        // gpu and is never loaded again, so it is not prefetched
+        void prefetchMeshData(const MeshSourceDesc& source);
+        void prefetchMaterialData(const MaterialSourceDesc& source);
+        void clearPrefetchedData();
+
     private:
-        StaticMeshData loadStaticMesh(std::string mesh_file, AxisAlignedBox& bounding_box);
+        struct PrefetchedMeshData
+        {
+            RenderMeshData m_mesh_data;
+            AxisAlignedBox m_bounding_box;
+        };
+
+        RenderMeshData     readMeshData(const MeshSourceDesc& source, AxisAlignedBox& bounding_box);
+        RenderMaterialData readMaterialData(const MaterialSourceDesc& source);
+        StaticMeshData     loadStaticMesh(std::string mesh_file, AxisAlignedBox& bounding_box);
+        RenderMeshData     loadJsonMesh(std::string mesh_file, AxisAlignedBox& bounding_box);
 
         std::unordered_map<MeshSourceDesc, AxisAlignedBox> m_bounding_box_cache_map;
+
+        std::mutex                                                 m_prefetch_mutex;
+        std::unordered_map<MeshSourceDesc, PrefetchedMeshData>     m_prefetched_meshes;
+        std::unordered_map<MaterialSourceDesc, RenderMaterialData> m_prefetched_materials;
+        std::unordered_set<MeshSourceDesc>                         m_resident_meshes;
+        std::unordered_set<MaterialSourceDesc>                     m_resident_materials;
     };
 } // namespace Piccolo
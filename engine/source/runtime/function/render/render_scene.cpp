@@ -38,7 +38,10 @@ namespace Piccolo
 
     void RenderScene::addInstanceIdToMap(uint32_t instance_id, GObjectID go_id)
     {
-        m_mesh_object_id_map[instance_id] = go_id;
+        if (m_mesh_object_id_map.insert(std::make_pair(instance_id, go_id)).second)
+        {
+            m_gobject_instance_ids_map[go_id].push_back(instance_id);
+        }
     }
 
     GObjectID RenderScene::getGObjectIDByMeshID(uint32_t mesh_id) const
@@ -51,37 +54,139 @@ namespace Piccolo
         return GObjectID();
     }
 
+    void RenderScene::addOrUpdateRenderEntity(const RenderEntity& entity)
+    {
+        BoundingBox mesh_asset_bounding_box {entity.m_bounding_box.getMinCorner(),
+                                             entity.m_bounding_box.getMaxCorner()};
+        BoundingBox world_bounding_box = BoundingBoxTransform(mesh_asset_bounding_box, entity.m_model_matrix);
+
+        auto find_it = m_render_entity_index_map.find(entity.m_instance_id);
+        if (find_it != m_render_entity_index_map.end())
+        {
+            size_t entity_index                        = find_it->second;
+            m_render_entities[entity_index]            = entity;
+            m_render_entity_world_bounds[entity_index] = world_bounding_box;
+            m_render_entity_bvh.moveProxy(m_render_entity_proxies[entity_index], world_bounding_box);
+            return;
+        }
+
+        size_t entity_index = m_render_entities.size();
+        m_render_entities.push_back(entity);
+        m_render_entity_world_bounds.push_back(world_bounding_box);
+        m_render_entity_proxies.push_back(
+            m_render_entity_bvh.createProxy(world_bounding_box, static_cast<uint32_t>(entity_index)));
+        m_render_entity_index_map[entity.m_instance_id] = entity_index;
+    }
+
+    void RenderScene::removeRenderEntity(size_t entity_index)
+    {
+        m_render_entity_bvh.destroyProxy(m_render_entity_proxies[entity_index]);
+        m_render_entity_index_map.erase(m_render_entities[entity_index].m_instance_id);
+
+        // move the last entity into the hole so the indices held by the bvh stay dense
+        size_t last_index = m_render_entities.size() - 1;
+        if (entity_index != last_index)
+        {
+            m_render_entities[entity_index]            = std::move(m_render_entities[last_index]);
+            m_render_entity_world_bounds[entity_index] = m_render_entity_world_bounds[last_index];
+            m_render_entity_proxies[entity_index]      = m_render_entity_proxies[last_index];
+
+            m_render_entity_bvh.setUserIndex(m_render_entity_proxies[entity_index],
+                                             static_cast<uint32_t>(entity_index));
+            m_render_entity_index_map[m_render_entities[entity_index].m_instance_id] = entity_index;
+        }
+        m_render_entities.pop_back();
+        m_render_entity_world_bounds.pop_back();
+        m_render_entity_proxies.pop_back();
+    }
+
     void RenderScene::deleteEntityByGObjectID(GObjectID go_id)
     {
-        for (auto it = m_mesh_object_id_map.begin(); it != m_mesh_object_id_map.end(); it++)
+        auto instance_ids_it = m_gobject_instance_ids_map.find(go_id);
+        if (instance_ids_it == m_gobject_instance_ids_map.end())
         {
-            if (it->second == go_id)
-            {
-                m_mesh_object_id_map.erase(it);
-                break;
-            }
+            return;
         }
 
-        GameObjectPartId part_id = {go_id, 0};
-        size_t           find_guid;
-        if (m_instance_id_allocator.getElementGuid(part_id, find_guid))
+        // every part of the game object has its own render entity
+        for (uint32_t instance_id : instance_ids_it->second)
         {
-            for (auto it = m_render_entities.begin(); it != m_render_entities.end(); it++)
+            m_mesh_object_id_map.erase(instance_id);
+
+            auto find_it = m_render_entity_index_map.find(instance_id);
+            if (find_it != m_render_entity_index_map.end())
             {
-                if (it->m_instance_id == find_guid)
-                {
-                    m_render_entities.erase(it);
-                    break;
-                }
+                removeRenderEntity(find_it->second);
             }
+            m_instance_id_allocator.freeGuid(instance_id);
         }
+        m_gobject_instance_ids_map.erase(instance_ids_it);
     }
 
     void RenderScene::clearForLevelReloading()
     {
         m_instance_id_allocator.clear();
         m_mesh_object_id_map.clear();
+        m_gobject_instance_ids_map.clear();
         m_render_entities.clear();
+        m_render_entity_world_bounds.clear();
+        m_render_entity_proxies.clear();
+        m_render_entity_index_map.clear();
+        m_render_entity_bvh.clear();
+    }
+
+    void RenderScene::addVisibleMeshNode(std::vector<RenderMeshNode>&    visible_mesh_nodes,
+                                         const RenderEntity&             entity,
+                                         std::shared_ptr<RenderResource> render_resource)
+    {
+        visible_mesh_nodes.emplace_back();
+        RenderMeshNode& temp_node = visible_mesh_nodes.back();
+
+        temp_node.model_matrix = &entity.m_model_matrix;
+
+        assert(entity.m_joint_matrices.size() <= s_mesh_vertex_blending_max_joint_count);
+        if (!entity.m_joint_matrices.empty())
+        {
+            temp_node.joint_count    = static_cast<uint32_t>(entity.m_joint_matrices.size());
+            temp_node.joint_matrices = entity.m_joint_matrices.data();
+        }
+        temp_node.node_id = entity.m_instance_id;
+
+        VulkanMesh& mesh_asset           = render_resource->getEntityMesh(entity);
+        temp_node.ref_mesh               = &mesh_asset;
+        temp_node.enable_vertex_blending = entity.m_enable_vertex_blending;
+
+        VulkanPBRMaterial& material_asset = render_resource->getEntityMaterial(entity);
+        temp_node.ref_material            = &material_asset;
+        temp_node.mesh_asset_id           = entity.m_mesh_asset_id;
+        temp_node.material_asset_id       = entity.m_material_asset_id;
+    }
+
+    void RenderScene::addFrustumVisibleMeshNodes(const ClusterFrustum&           frustum,
+                                                 std::vector<RenderMeshNode>&    visible_mesh_nodes,
+                                                 std::shared_ptr<RenderResource> render_resource)
+    {
+        // subtrees outside of the frustum are skipped, the entities of the leaves left are tested with their exact
+        // bounds in one batch
+        m_culling_candidates.clear();
+        m_render_entity_bvh.query(
+            [&frustum](const BoundingBox& bounds) { return TiledFrustumIntersectBox(frustum, bounds); },
+            [this](uint32_t entity_index) { m_culling_candidates.push_back(entity_index); });
+
+        m_culling_candidate_bounds.resize(m_culling_candidates.size());
+        for (size_t i = 0; i < m_culling_candidates.size(); ++i)
+        {
+            m_culling_candidate_bounds.setBox(i, m_render_entity_world_bounds[m_culling_candidates[i]]);
+        }
+        TiledFrustumIntersectBoxes(frustum, m_culling_candidate_bounds, m_culling_visibility_mask);
+
+        for (size_t i = 0; i < m_culling_candidates.size(); ++i)
+        {
+            if ((m_culling_visibility_mask[i / 32] >> (i % 32)) & 1u)
+            {
+                addVisibleMeshNode(visible_mesh_nodes, m_render_entities[m_culling_candidates[i]], render_resource);
+            }
+        }
     }
 
     void RenderScene::updateVisibleObjectsDirectionalLight(std::shared_ptr<RenderResource> render_resource,
@@ -99,34 +204,7 @@ namespace Piccolo
         ClusterFrustum frustum =
             CreateClusterFrustumFromMatrix(directional_light_proj_view, -1.0, 1.0, -1.0, 1.0, 0.0, 1.0);
 
-        for (const RenderEntity& entity : m_render_entities)
-        {
-            BoundingBox mesh_asset_bounding_box {entity.m_bounding_box.getMinCorner(),
-                                                 entity.m_bounding_box.getMaxCorner()};
-
-            if (TiledFrustumIntersectBox(frustum, BoundingBoxTransform(mesh_asset_bounding_box, entity.m_model_matrix)))
-            {
-                m_directional_light_visible_mesh_nodes.emplace_back();
-                RenderMeshNode& temp_node = m_directional_light_visible_mesh_nodes.back();
-
-                temp_node.model_matrix = &entity.m_model_matrix;
-
-                assert(entity.m_joint_matrices.size() <= s_mesh_vertex_blending_max_joint_count);
-                if (!entity.m_joint_matrices.empty())
-                {
-                    temp_node.joint_count    = static_cast<uint32_t>(entity.m_joint_matrices.size());
-                    temp_node.joint_matrices = entity.m_joint_matrices.data();
-                }
-                temp_node.node_id = entity.m_instance_id;
-
-                VulkanMesh& mesh_asset           = render_resource->getEntityMesh(entity);
-                temp_node.ref_mesh               = &mesh_asset;
-                temp_node.enable_vertex_blending = entity.m_enable_vertex_blending;
-
-                VulkanPBRMaterial& material_asset = render_resource->getEntityMaterial(entity);
-                temp_node.ref_material            = &material_asset;
-            }
-        }
+        addFrustumVisibleMeshNodes(frustum, m_directional_light_visible_mesh_nodes, render_resource);
     }
 
     void RenderScene::updateVisibleObjectsPointLight(std::shared_ptr<RenderResource> render_resource)
@@ -142,45 +220,23 @@ namespace Piccolo
             point_lights_bounding_spheres[i].m_radius = m_point_light_list.m_lights[i].calculateRadius();
         }
 
-        for (const RenderEntity& entity : m_render_entities)
-        {
-            BoundingBox mesh_asset_bounding_box {entity.m_bounding_box.getMinCorner(),
-                                                 entity.m_bounding_box.getMaxCorner()};
-
-            bool intersect_with_point_lights = true;
-            for (size_t i = 0; i < point_light_num; i++)
+        auto intersect_with_point_lights = [&point_lights_bounding_spheres](const BoundingBox& bounds) {
+            for (const BoundingSphere& point_light_bounding_sphere : point_lights_bounding_spheres)
             {
-                if (!BoxIntersectsWithSphere(BoundingBoxTransform(mesh_asset_bounding_box, entity.m_model_matrix),
-                                             point_lights_bounding_spheres[i]))
+                if (!BoxIntersectsWithSphere(bounds, point_light_bounding_sphere))
                 {
-                    intersect_with_point_lights = false;
-                    break;
+                    return false;
                 }
             }
+            return true;
+        };
 
-            if (intersect_with_point_lights)
+        m_render_entity_bvh.query(intersect_with_point_lights, [&](uint32_t entity_index) {
+            if (intersect_with_point_lights(m_render_entity_world_bounds[entity_index]))
             {
-                m_point_lights_visible_mesh_nodes.emplace_back();
-                RenderMeshNode& temp_node = m_point_lights_visible_mesh_nodes.back();
-
-                temp_node.model_matrix = &entity.m_model_matrix;
-
-                assert(entity.m_joint_matrices.size() <= s_mesh_vertex_blending_max_joint_count);
-                if (!entity.m_joint_matrices.empty())
-                {
-                    temp_node.joint_count    = static_cast<uint32_t>(entity.m_joint_matrices.size());
-                    temp_node.joint_matrices = entity.m_joint_matrices.data();
-                }
-                temp_node.node_id = entity.m_instance_id;
-
-                VulkanMesh& mesh_asset           = render_resource->getEntityMesh(entity);
-                temp_node.ref_mesh               = &mesh_asset;
-                temp_node.enable_vertex_blending = entity.m_enable_vertex_blending;
-
-                VulkanPBRMaterial& material_asset = render_resource->getEntityMaterial(entity);
-                temp_node.ref_material            = &material_asset;
+                addVisibleMeshNode(m_point_lights_visible_mesh_nodes, m_render_entities[entity_index], render_resource);
             }
-        }
+        });
     }
 
     void RenderScene::updateVisibleObjectsMainCamera(std::shared_ptr<RenderResource> render_resource,
@@ -194,33 +250,7 @@ namespace Piccolo
 
         ClusterFrustum f = CreateClusterFrustumFromMatrix(proj_view_matrix, -1.0, 1.0, -1.0, 1.0, 0.0, 1.0);
 
-        for (const RenderEntity& entity : m_render_entities)
-        {
-            BoundingBox mesh_asset_bounding_box {entity.m_bounding_box.getMinCorner(),
-                                                 entity.m_bounding_box.getMaxCorner()};
-
-            if (TiledFrustumIntersectBox(f, BoundingBoxTransform(mesh_asset_bounding_box, entity.m_model_matrix)))
-            {
-                m_main_camera_visible_mesh_nodes.emplace_back();
-                RenderMeshNode& temp_node = m_main_camera_visible_mesh_nodes.back();
-                temp_node.model_matrix    = &entity.m_model_matrix;
-
-                assert(entity.m_joint_matrices.size() <= s_mesh_vertex_blending_max_joint_count);
-                if (!entity.m_joint_matrices.empty())
-                {
-                    temp_node.joint_count    = static_cast<uint32_t>(entity.m_joint_matrices.size());
-                    temp_node.joint_matrices = entity.m_joint_matrices.data();
-                }
-                temp_node.node_id = entity.m_instance_id;
-
-                VulkanMesh& mesh_asset           = render_resource->getEntityMesh(entity);
-                temp_node.ref_mesh               = &mesh_asset;
-                temp_node.enable_vertex_blending = entity.m_enable_vertex_blending;
-
-                VulkanPBRMaterial& material_asset = render_resource->getEntityMaterial(entity);
-                temp_node.ref_material            = &material_asset;
-            }
-        }
+        addFrustumVisibleMeshNodes(f, m_main_camera_visible_mesh_nodes, render_resource);
     }
 
     void RenderScene::updateVisibleObjectsAxis(std::shared_ptr<RenderResource> render_resource)
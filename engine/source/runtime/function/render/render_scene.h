@@ -5,10 +5,12 @@
 #include "runtime/function/render/light.h"
 #include "runtime/function/render/render_common.h"
 #include "runtime/function/render/render_entity.h"
+#include "runtime/function/render/render_entity_bvh.h"
 #include "runtime/function/render/render_guid_allocator.h"
 #include "runtime/function/render/render_object.h"
 
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 namespace Piccolo
@@ -24,7 +26,7 @@ namespace Piccolo
         PDirectionalLight m_directional_light;
         PointLightList    m_point_light_list;
 
-        // render entities
+        // render entities, added, updated and removed through the methods below to keep the bvh in sync
         std::vector<RenderEntity> m_render_entities;
 
         // axis, for editor
@@ -50,6 +52,11 @@ namespace Piccolo
         GuidAllocator<MeshSourceDesc>&     getMeshAssetIdAllocator();
         GuidAllocator<MaterialSourceDesc>& getMaterialAssetdAllocator();
 
+        void addOrUpdateRenderEntity(const RenderEntity& entity);
+
+        // world space bounds of m_render_entities, same order
+        const std::vector<BoundingBox>& getRenderEntityWorldBounds() const { return m_render_entity_world_bounds; }
+
         void      addInstanceIdToMap(uint32_t instance_id, GObjectID go_id);
         GObjectID getGObjectIDByMeshID(uint32_t mesh_id) const;
         void      deleteEntityByGObjectID(GObjectID go_id);
@@ -61,7 +68,27 @@ namespace Piccolo
         GuidAllocator<MeshSourceDesc>     m_mesh_asset_id_allocator;
         GuidAllocator<MaterialSourceDesc> m_material_asset_id_allocator;
 
-        std::unordered_map<uint32_t, GObjectID> m_mesh_object_id_map;
+        std::unordered_map<uint32_t, GObjectID>              m_mesh_object_id_map;
+        std::unordered_map<GObjectID, std::vector<uint32_t>> m_gobject_instance_ids_map;
+
+        // computed once when an entity is added or moved and shared by all the culling passes
+        std::vector<BoundingBox>             m_render_entity_world_bounds;
+        std::vector<uint32_t>                m_render_entity_proxies;
+        std::unordered_map<uint32_t, size_t> m_render_entity_index_map; // instance id to index in m_render_entities
+        RenderEntityBVH                      m_render_entity_bvh;
+
+        // scratch buffers of the frustum culling, kept to avoid allocations every frame
+        std::vector<uint32_t> m_culling_candidates;
+        BoundingBoxArray      m_culling_candidate_bounds;
+        std::vector<uint32_t> m_culling_visibility_mask;
+
+        void removeRenderEntity(size_t entity_index);
+        void addVisibleMeshNode(std::vector<RenderMeshNode>&    visible_mesh_nodes,
+                                const RenderEntity&             entity,
+                                std::shared_ptr<RenderResource> render_resource);
+        void addFrustumVisibleMeshNodes(const ClusterFrustum&           frustum,
+                                        std::vector<RenderMeshNode>&    visible_mesh_nodes,
+                                        std::shared_ptr<RenderResource> render_resource);
 
         void updateVisibleObjectsDirectionalLight(std::shared_ptr<RenderResource> render_resource,
                                                   std::shared_ptr<RenderCamera>   camera);
@@ -83,28 +83,28 @@ namespace Piccolo
 
 
     /// <summary>
-    /// ߼ȡҪµݽṹ
+    /// 从逻辑层获取要更新的数据结构
     /// </summary>
     struct RenderSwapData
     {
         /// <summary>
-        /// ָµպкcolor gradingͼ
+        /// 指定新的天空盒和color grading的贴图
         /// </summary>
         std::optional<LevelResourceDesc> m_level_resource_desc;
 
         /// <summary>
-        /// Ҫ/ɾobject
+        /// 要添加/删除的object
         /// </summary>
         std::optional<GameObjectResourceDesc> m_game_object_resource_desc;
         std::optional<GameObjectResourceDesc> m_game_object_to_delete;
 
         /// <summary>
-        /// 
+        /// 更新相机参数
         /// </summary>
         std::optional<CameraSwapData> m_camera_swap_data;
 
         /// <summary>
-        /// µӷ  Ҫtickӷ   ӷλ
+        /// 创建新的粒子发射器  需要tick的例子发射器   更新例子发射器的位置
         /// </summary>
         std::optional<ParticleSubmitRequest> m_particle_submit_request;
         std::optional<EmitterTickRequest> m_emitter_tick_request;
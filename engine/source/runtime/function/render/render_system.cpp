@@ -29,48 +29,48 @@ namespace Piccolo
 
     void RenderSystem::initialize(RenderSystemInitInfo init_info)
     {
-        // ȡáʲ
+        // 获取配置、资产管理器
         std::shared_ptr<ConfigManager> config_manager = g_runtime_global_context.m_config_manager;
         ASSERT(config_manager);
         std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
         ASSERT(asset_manager);
 
-        // ʼȾӿ   render context initialize
-        RHIInitInfo rhi_init_info; // ȾӿϢ()
+        // 初始化渲染接口   render context initialize
+        RHIInitInfo rhi_init_info; // 渲染接口信息(上下文)
         rhi_init_info.window_system = init_info.window_system;
         m_rhi = std::make_shared<VulkanRHI>();
         m_rhi->initialize(rhi_init_info);
 
-        // ȫȾԴ global rendering resource
+        // 加载全局渲染资源 global rendering resource
         GlobalRenderingRes global_rendering_res;
         const std::string& global_rendering_res_url = config_manager->getGlobalRenderingResUrl();
         asset_manager->loadAsset(global_rendering_res_url, global_rendering_res);
 
-        // صȫԴϴȾԴ upload ibl, color grading textures
+        // 将加载的全局资源上传到渲染资源中 upload ibl, color grading textures
         LevelResourceDesc level_resource_desc;
-        level_resource_desc.m_ibl_resource_desc.m_skybox_irradiance_map = global_rendering_res.m_skybox_irradiance_map; // պ  ͼ
-        level_resource_desc.m_ibl_resource_desc.m_skybox_specular_map = global_rendering_res.m_skybox_specular_map;     // պ ߹ͼ
-        level_resource_desc.m_ibl_resource_desc.m_brdf_map = global_rendering_res.m_brdf_map;                           // ˫ֲͼ
+        level_resource_desc.m_ibl_resource_desc.m_skybox_irradiance_map = global_rendering_res.m_skybox_irradiance_map; // 加载天空盒  光照贴图
+        level_resource_desc.m_ibl_resource_desc.m_skybox_specular_map = global_rendering_res.m_skybox_specular_map;     // 加载天空盒 高光贴图
+        level_resource_desc.m_ibl_resource_desc.m_brdf_map = global_rendering_res.m_brdf_map;                           // 双向反射分布贴图？？？
         level_resource_desc.m_color_grading_resource_desc.m_color_grading_map = global_rendering_res.m_color_grading_map;
 
         m_render_resource = std::make_shared<RenderResource>();
         m_render_resource->uploadGlobalRenderResource(m_rhi, level_resource_desc);
 
-        // Ⱦ setup render camera
+        // 设置渲染相机 setup render camera
         const CameraPose& camera_pose = global_rendering_res.m_camera_config.m_pose;
         m_render_camera = std::make_shared<RenderCamera>();
-        m_render_camera->lookAt(camera_pose.m_position, camera_pose.m_target, camera_pose.m_up); // 
-        m_render_camera->m_zfar = global_rendering_res.m_camera_config.m_z_far;                  // Զƽ
-        m_render_camera->m_znear = global_rendering_res.m_camera_config.m_z_near;                // ƽ
-        // ߱
+        m_render_camera->lookAt(camera_pose.m_position, camera_pose.m_target, camera_pose.m_up); // 设置相机姿势
+        m_render_camera->m_zfar = global_rendering_res.m_camera_config.m_z_far;                  // 远平面
+        m_render_camera->m_znear = global_rendering_res.m_camera_config.m_z_near;                // 近平面
+        // 宽高比
         m_render_camera->setAspect(global_rendering_res.m_camera_config.m_aspect.x / global_rendering_res.m_camera_config.m_aspect.y);
 
-        // Ⱦ setup render scene
+        // 设置渲染场景 setup render scene
         m_render_scene = std::make_shared<RenderScene>();
-        m_render_scene->m_ambient_light = { global_rendering_res.m_ambient_light.toVector3() }; //
-        m_render_scene->m_directional_light.m_direction = global_rendering_res.m_directional_light.m_direction.normalisedCopy();//ⷽ
-        m_render_scene->m_directional_light.m_color = global_rendering_res.m_directional_light.m_color.toVector3();//ɫ
-        m_render_scene->setVisibleNodesReference(); //ÿӽڵο
+        m_render_scene->m_ambient_light = { global_rendering_res.m_ambient_light.toVector3() }; //环境光
+        m_render_scene->m_directional_light.m_direction = global_rendering_res.m_directional_light.m_direction.normalisedCopy();//定向光方向
+        m_render_scene->m_directional_light.m_color = global_rendering_res.m_directional_light.m_color.toVector3();//定向光颜色
+        m_render_scene->setVisibleNodesReference(); //设置可视节点参考？？？
 
         // initialize render pipeline
         RenderPipelineInitInfo pipeline_init_info;
@@ -94,29 +94,29 @@ namespace Piccolo
 
     void RenderSystem::tick(float delta_time)
     {
-        //Ⱦ߼ĺȾ֮ݽ process swap data between logic and render contexts
+        //处理渲染逻辑上下文和渲染上下文之间的数据交换 process swap data between logic and render contexts
         processSwapData();
 
-        //ȾϢ׼   prepare render command context
+        //进行渲染信息的准备   prepare render command context
         m_rhi->prepareContext();
 
-        //ÿ֡Ļ update per-frame buffer
+        //更新每帧的缓冲区 update per-frame buffer
         m_render_resource->updatePerFrameBuffer(m_render_scene, m_render_camera);
 
-        //ÿ֡Ŀ  update per-frame visible objects
+        //更新每帧的可视物体  update per-frame visible objects
         m_render_scene->updateVisibleObjects(std::static_pointer_cast<RenderResource>(m_render_resource), m_render_camera);
 
-        // ׼ȾߵȾͨ prepare pipeline's render passes data
+        // 准备渲染管线的渲染通道数据 prepare pipeline's render passes data
         m_render_pipeline->preparePassData(m_render_resource);
 
         g_runtime_global_context.m_debugdraw_manager->tick(delta_time);
          
-        //ȾߵִУȾͣ render one frame
-        if (m_render_pipeline_type == RENDER_PIPELINE_TYPE::FORWARD_PIPELINE) //ǰȾ
+        //渲染管线的执行（根据渲染管线类型） render one frame
+        if (m_render_pipeline_type == RENDER_PIPELINE_TYPE::FORWARD_PIPELINE) //前向渲染
         {
             m_render_pipeline->forwardRender(m_rhi, m_render_resource);
         }
-        else if (m_render_pipeline_type == RENDER_PIPELINE_TYPE::DEFERRED_PIPELINE)//ʱȾ
+        else if (m_render_pipeline_type == RENDER_PIPELINE_TYPE::DEFERRED_PIPELINE)//延时渲染
         {
             m_render_pipeline->deferredRender(m_rhi, m_render_resource);
         }
@@ -162,7 +162,7 @@ namespace Piccolo
     std::shared_ptr<RHI> RenderSystem::getRHI() const { return m_rhi; }
 
     /// <summary>
-    /// ȾӿڵĴСλ  
+    /// 更新渲染视口的大小和位置  
     /// </summary>
     void RenderSystem::updateEngineContentViewport(float offset_x, float offset_y, float width, float height)
     {
@@ -173,7 +173,7 @@ namespace Piccolo
         std::static_pointer_cast<VulkanRHI>(m_rhi)->m_viewport.minDepth = 0.0f;
         std::static_pointer_cast<VulkanRHI>(m_rhi)->m_viewport.maxDepth = 1.0f;
 
-        //Ŀ߱
+        //设置相机的宽高比
         m_render_camera->setAspect(width / height);
     }
 
@@ -187,7 +187,7 @@ namespace Piccolo
     }
 
     /// <summary>
-    /// ݵĻռ꣬ضӦλ
+    /// 根据点击的屏幕空间坐标，返回对应位置物体的网格
     /// </summary>
     uint32_t RenderSystem::getGuidOfPickedMesh(const Vector2& picked_uv)
     {
@@ -195,7 +195,7 @@ namespace Piccolo
     }
 
     /// <summary>
-    /// ͨidȡ Ϸid
+    /// 通过网格id获取 游戏对象id
     /// </summary>
     GObjectID RenderSystem::getGObjectIDByMeshID(uint32_t mesh_id) const
     {
@@ -203,7 +203,7 @@ namespace Piccolo
     }
 
     /// <summary>
-    /// ΪȾʵ崴
+    /// 为传入的渲染实体创建轴
     /// </summary>
     void RenderSystem::createAxis(std::array<RenderEntity, 3> axis_entities, std::array<RenderMeshData, 3> mesh_datas)
     {
@@ -215,13 +215,13 @@ namespace Piccolo
 
 
     /// <summary>
-    /// Ŀɼ
+    /// 设置坐标轴的可见性
     /// </summary>
     void RenderSystem::setVisibleAxis(std::optional<RenderEntity> axis)
     {
         m_render_scene->m_render_axis = axis;
 
-        if (axis.has_value())//Ч
+        if (axis.has_value())//如果坐标轴有效
         {
             std::static_pointer_cast<RenderPipeline>(m_render_pipeline)->setAxisVisibleState(true);
         }
@@ -232,7 +232,7 @@ namespace Piccolo
     }
 
     /// <summary>
-    /// õǰѡе
+    /// 设置当前选中的坐标轴
     /// </summary>
     void RenderSystem::setSelectedAxis(size_t selected_axis)
     {
@@ -254,6 +254,21 @@ namespace Piccolo
         m_render_scene->clearForLevelReloading();
     }
 
+    void RenderSystem::prefetchMeshData(const MeshSourceDesc& mesh_source)
+    {
+        m_render_resource->prefetchMeshData(mesh_source);
+    }
+
+    void RenderSystem::prefetchMaterialData(const MaterialSourceDesc& material_source)
+    {
+        m_render_resource->prefetchMaterialData(material_source);
+    }
+
+    void RenderSystem::clearPrefetchedData()
+    {
+        m_render_resource->clearPrefetchedData();
+    }
+
     void RenderSystem::setRenderPipelineType(RENDER_PIPELINE_TYPE pipeline_type)
     {
         m_render_pipeline_type = pipeline_type;
@@ -265,13 +280,13 @@ namespace Piccolo
     }
 
     /// <summary>
-    /// ߼ȡҪµ
+    /// 从逻辑层获取要更新的数据
     /// </summary>
     void RenderSystem::processSwapData()
     {
         RenderSwapData& swap_data = m_swap_context.getRenderSwapData();
 
-        //ǸRenderSwapDataȾ
+        //下面代码就是根据RenderSwapData，更新渲染
 
         std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
         ASSERT(asset_manager);
@@ -297,8 +312,6 @@ namespace Piccolo
                     const auto& game_object_part = gobject.getObjectParts()[part_index];
                     GameObjectPartId part_id = { gobject.getId(), part_index };
 
-                    bool is_entity_in_scene = m_render_scene->getInstanceIdAllocator().hasElement(part_id);
-
                     RenderEntity render_entity;
                     render_entity.m_instance_id =
                         static_cast<uint32_t>(m_render_scene->getInstanceIdAllocator().allocGuid(part_id));
@@ -373,22 +386,8 @@ namespace Piccolo
                         m_render_resource->uploadGameObjectRenderResource(m_rhi, render_entity, material_data);
                     }
 
-                    // add object to render scene if needed
-                    if (!is_entity_in_scene)
-                    {
-                        m_render_scene->m_render_entities.push_back(render_entity);
-                    }
-                    else
-                    {
-                        for (auto& entity : m_render_scene->m_render_entities)
-                        {
-                            if (entity.m_instance_id == render_entity.m_instance_id)
-                            {
-                                entity = render_entity;
-                                break;
-                            }
-                        }
-                    }
+                    // add object to render scene or update it
+                    m_render_scene->addOrUpdateRenderEntity(render_entity);
                 }
                 // after finished processing, pop this game object
                 swap_data.m_game_object_resource_desc->pop();
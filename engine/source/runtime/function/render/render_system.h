@@ -41,9 +41,9 @@ namespace Piccolo
         ~RenderSystem();
 
         /// <summary>
-        /// Ⱦϵͳʼ
+        /// 渲染系统初始化
         /// </summary>
-        /// <param name="init_info">ȾһڵϢ</param>
+        /// <param name="init_info">渲染的是哪一个窗口的信息</param>
         void initialize(RenderSystemInitInfo init_info);
 
         void tick(float delta_time);
@@ -70,40 +70,51 @@ namespace Piccolo
 
         void clearForLevelReloading();
 
+        /// <summary>
+        /// 在任意线程预先读取网格/材质纹理，之后处理交换数据时直接使用，不再在主线程读取文件
+        /// </summary>
+        void prefetchMeshData(const MeshSourceDesc& mesh_source);
+        void prefetchMaterialData(const MaterialSourceDesc& material_source);
+
+        /// <summary>
+        /// 丢弃尚未被使用的预读取数据
+        /// </summary>
+        void clearPrefetchedData();
+
     private:
         /// <summary>
-        /// Ⱦͣһöͣǰ/ʱȾ
+        /// 渲染管线类型，一个枚举类型：有前向/延时渲染
         /// </summary>
         RENDER_PIPELINE_TYPE m_render_pipeline_type{ RENDER_PIPELINE_TYPE::DEFERRED_PIPELINE };
 
         /// <summary>
-        /// ȾеĽ
+        /// 管理渲染上下文中的交换数据
         /// </summary>
         RenderSwapContext m_swap_context;
 
         /// <summary>
-        /// Ⱦӿ    RHIһ࣬ʹøͼAPIʵ֣ DirectXOpenGLVulkanȣ
-        /// PiccoloʹõVulkan
+        /// 渲染接口    RHI是一个抽象类，可以使用各种图形API来实现（如 DirectX、OpenGL、Vulkan等）
+        /// Piccolo使用的是Vulkan
         /// </summary>
         std::shared_ptr<RHI> m_rhi;
 
         /// <summary>
-        /// Ⱦ
+        /// 管理相机的渲染
         /// </summary>
         std::shared_ptr<RenderCamera> m_render_camera;
 
         /// <summary>
-        /// Ⱦ
+        /// 管理场景的渲染
         /// </summary>
         std::shared_ptr<RenderScene> m_render_scene;
 
         /// <summary>
-        /// ȾʹõԴ
+        /// 管理渲染过程中使用的资源
         /// </summary>
         std::shared_ptr<RenderResourceBase> m_render_resource;
 
         /// <summary>
-        /// Ⱦ
+        /// 渲染管线
         /// </summary>
         std::shared_ptr<RenderPipelineBase> m_render_pipeline;
 
@@ -1708,14 +1708,21 @@ namespace Piccolo
             m_size = size;
             m_data = malloc(size);
         }
+        // wraps memory owned by someone else (e.g. a mapped file), data_owner is kept alive instead of freeing m_data
+        BufferData(void* data, size_t size, std::shared_ptr<void> data_owner) :
+            m_size(size), m_data(data), m_data_owner(std::move(data_owner))
+        {}
         ~BufferData()
         {
-            if (m_data)
+            if (m_data && !m_data_owner)
             {
                 free(m_data);
             }
         }
         bool isValid() const { return m_data != nullptr; }
+
+    private:
+        std::shared_ptr<void> m_data_owner;
     };
 
     class TextureData
@@ -1805,6 +1812,8 @@ namespace Piccolo
     {
         std::shared_ptr<BufferData> m_vertex_buffer;
         std::shared_ptr<BufferData> m_index_buffer;
+        // 16 bit indices unless the mesh references a vertex beyond 65535
+        RHIIndexType m_index_type {RHI_INDEX_TYPE_UINT16};
     };
 
     struct RenderMeshData
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+namespace Piccolo
+{
+    /// read-only view of a whole file through the virtual memory system, pages are only faulted in when touched
+    /// the mapping is private copy-on-write, so writes to data() never reach the file
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool open(const std::filesystem::path& file_path);
+        void close();
+
+        void*  data() const { return m_data; }
+        size_t size() const { return m_size; }
+        bool   isOpen() const { return m_data != nullptr; }
+
+    private:
+        void*  m_data {nullptr};
+        size_t m_size {0};
+
+#if defined(_WIN32)
+        void* m_file_handle {nullptr};
+        void* m_mapping_handle {nullptr};
+#endif
+    };
+} // namespace Piccolo
@@ -12,4 +12,122 @@ namespace Piccolo
     {
         return std::filesystem::absolute(g_runtime_global_context.m_config_manager->getRootFolder() / relative_path);
     }
-} // namespace Piccolo
\ No newline at end of file
+
+    std::filesystem::path AssetManager::getCookedPath(const std::string& asset_url) const
+    {
+        std::filesystem::path cooked_path = getFullPath(asset_url);
+        if (cooked_path.extension() == ".json")
+        {
+            return cooked_path.replace_extension(".cooked");
+        }
+        return cooked_path += ".cooked";
+    }
+
+    bool AssetManager::isCookedAssetUpToDate(const std::string& asset_url) const
+    {
+        return isDerivedFileUpToDate(asset_url, getCookedPath(asset_url));
+    }
+
+    bool AssetManager::isDerivedFileUpToDate(const std::string&           asset_url,
+                                             const std::filesystem::path& derived_path) const
+    {
+        std::error_code error;
+        if (!std::filesystem::exists(derived_path, error))
+        {
+            return false;
+        }
+
+        // shipped builds may only contain the cooked files
+        const std::filesystem::path json_path = getFullPath(asset_url);
+        if (!std::filesystem::exists(json_path, error))
+        {
+            return true;
+        }
+
+        const auto derived_time = std::filesystem::last_write_time(derived_path, error);
+        if (error)
+        {
+            return false;
+        }
+        const auto json_time = std::filesystem::last_write_time(json_path, error);
+        if (error)
+        {
+            return false;
+        }
+        return derived_time >= json_time;
+    }
+
+    bool AssetManager::readCookedFile(const std::filesystem::path& cooked_path, std::vector<uint8_t>& out_data) const
+    {
+        std::ifstream cooked_file(cooked_path, std::ios::binary | std::ios::ate);
+        if (!cooked_file)
+        {
+            return false;
+        }
+
+        const std::streamsize file_size = cooked_file.tellg();
+        if (file_size <= 0)
+        {
+            return false;
+        }
+        cooked_file.seekg(0, std::ios::beg);
+
+        out_data.resize(static_cast<size_t>(file_size));
+        return static_cast<bool>(cooked_file.read(reinterpret_cast<char*>(out_data.data()), file_size));
+    }
+
+    bool AssetManager::writeDerivedFile(const std::filesystem::path&  derived_path,
+                                        const std::vector<uint8_t>& data) const
+    {
+        const std::filesystem::path temp_path = getTempPath(derived_path);
+
+        bool is_write_success = false;
+        {
+            std::ofstream derived_file(temp_path, std::ios::binary | std::ios::trunc);
+            if (!derived_file)
+            {
+                LOG_ERROR("open file {} failed!", temp_path.generic_string());
+                return false;
+            }
+
+            derived_file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            derived_file.flush();
+            is_write_success = static_cast<bool>(derived_file);
+        }
+
+        if (!is_write_success)
+        {
+            LOG_ERROR("write file {} failed!", temp_path.generic_string());
+            removeTempFile(temp_path);
+            return false;
+        }
+        return replaceWithTempFile(temp_path, derived_path);
+    }
+
+    std::filesystem::path AssetManager::getTempPath(const std::filesystem::path& path)
+    {
+        std::filesystem::path temp_path = path;
+        return temp_path += ".tmp";
+    }
+
+    bool AssetManager::replaceWithTempFile(const std::filesystem::path& temp_path,
+                                           const std::filesystem::path& path) const
+    {
+        // rename replaces an existing file in one step, readers see either the old or the new file
+        std::error_code error;
+        std::filesystem::rename(temp_path, path, error);
+        if (error)
+        {
+            LOG_ERROR("replace file {} failed: {}", path.generic_string(), error.message());
+            removeTempFile(temp_path);
+            return false;
+        }
+        return true;
+    }
+
+    void AssetManager::removeTempFile(const std::filesystem::path& temp_path) const
+    {
+        std::error_code error;
+        std::filesystem::remove(temp_path, error);
+    }
+} // namespace Piccolo
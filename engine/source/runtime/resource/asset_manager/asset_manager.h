@@ -1,13 +1,17 @@
 #pragma once
 
 #include "runtime/core/base/macro.h"
+#include "runtime/core/meta/serializer/binary_serializer.h"
+#include "runtime/core/meta/serializer/json_reader.h"
+#include "runtime/core/meta/serializer/json_writer.h"
 #include "runtime/core/meta/serializer/serializer.h"
 
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <functional>
-#include <sstream>
 #include <string>
+#include <vector>
 
 #include "_generated/serializer/all_serializer.h"
 
@@ -16,57 +20,164 @@ namespace Piccolo
     class AssetManager
     {
     public:
+        /// prefers the cooked binary counterpart of the asset when an up-to-date one exists, and falls back
+        /// to the json source otherwise
         template<typename AssetType>
         bool loadAsset(const std::string& asset_url, AssetType& out_asset) const
+        {
+            if (isCookedAssetUpToDate(asset_url))
+            {
+                if (loadCookedAsset(asset_url, out_asset))
+                {
+                    return true;
+                }
+
+                // the pointers read before the failure are already deleted, only the plain members are left
+                LOG_WARN("cooked asset of {} is invalid, fall back to json", asset_url);
+                out_asset = AssetType {};
+            }
+
+            return loadJsonAsset(asset_url, out_asset);
+        }
+
+        template<typename AssetType>
+        bool loadJsonAsset(const std::string& asset_url, AssetType& out_asset) const
         {
             // read json file to string
             std::filesystem::path asset_path = getFullPath(asset_url);
-            std::ifstream asset_json_file(asset_path);
+            std::ifstream asset_json_file(asset_path, std::ios::binary | std::ios::ate);
             if (!asset_json_file)
             {
                 LOG_ERROR("open file: {} failed!", asset_path.generic_string());
                 return false;
             }
 
-            std::stringstream buffer;
-            buffer << asset_json_file.rdbuf();
-            std::string asset_json_text(buffer.str());
+            std::string asset_json_text(static_cast<size_t>(asset_json_file.tellg()), '\0');
+            asset_json_file.seekg(0);
+            asset_json_file.read(asset_json_text.data(), static_cast<std::streamsize>(asset_json_text.size()));
 
-            // parse to json object and read to runtime res object
-            std::string error;
-            auto&& asset_json = Json::parse(asset_json_text, error);
-            if (!error.empty())
+            // read to runtime res object straight from the text, no json tree is built
+            JsonReader reader(asset_json_text.data(), asset_json_text.size());
+            Serializer::read(reader, out_asset);
+            if (!asset_json_file || !reader.isValid() || !reader.isAtEnd())
             {
                 LOG_ERROR("parse json file {} failed!", asset_url);
                 return false;
             }
+            return true;
+        }
+
+        /// reads the cooked file of asset_url straight into the reflected type, no json tree is built
+        template<typename AssetType>
+        bool loadCookedAsset(const std::string& asset_url, AssetType& out_asset) const
+        {
+            std::vector<uint8_t> cooked_data;
+            if (!readCookedFile(getCookedPath(asset_url), cooked_data))
+            {
+                return false;
+            }
+
+            BinaryReader reader(cooked_data.data(), cooked_data.size());
+            if (reader.readScalar<uint32_t>() != k_cooked_asset_magic ||
+                reader.readScalar<uint32_t>() != k_cooked_asset_version ||
+                reader.readScalar<uint32_t>() != k_serializer_schema_hash)
+            {
+                return false;
+            }
 
-            Serializer::read(asset_json, out_asset);
+            BinarySerializer::read(reader, out_asset);
+            if (!reader.isValid() || reader.getRemainingSize() != 0)
+            {
+                reader.releaseAllocations();
+                return false;
+            }
             return true;
         }
 
+        /// streams the json of the asset into a temporary file that replaces the asset file once it is complete,
+        /// so a failed save never leaves a truncated asset behind. no Json tree or document string is built
         template<typename AssetType>
-        bool saveAsset(const AssetType& out_asset, const std::string& asset_url) const
+        bool saveAsset(const AssetType& out_asset, const std::string& asset_url, bool is_pretty = false) const
         {
-            std::ofstream asset_json_file(getFullPath(asset_url));
-            if (!asset_json_file)
+            const std::filesystem::path asset_path = getFullPath(asset_url);
+            const std::filesystem::path temp_path  = getTempPath(asset_path);
+
+            bool is_write_success = false;
+            {
+                std::ofstream asset_json_file(temp_path, std::ios::binary | std::ios::trunc);
+                if (!asset_json_file)
+                {
+                    LOG_ERROR("open file {} failed!", temp_path.generic_string());
+                    return false;
+                }
+
+                JsonWriter writer(asset_json_file, is_pretty);
+                Serializer::write(writer, out_asset);
+                writer.flush();
+                asset_json_file.flush();
+                is_write_success = writer.isValid() && static_cast<bool>(asset_json_file);
+            }
+
+            if (!is_write_success)
             {
-                LOG_ERROR("open file {} failed!", asset_url);
+                LOG_ERROR("write file {} failed!", temp_path.generic_string());
+                removeTempFile(temp_path);
                 return false;
             }
+            return replaceWithTempFile(temp_path, asset_path);
+        }
 
-            // write to json object and dump to string
-            auto&&        asset_json      = Serializer::write(out_asset);
-            std::string&& asset_json_text = asset_json.dump();
+        template<typename AssetType>
+        bool saveCookedAsset(const AssetType& out_asset, const std::string& asset_url) const
+        {
+            BinaryWriter writer;
+            writer.writeScalar(k_cooked_asset_magic);
+            writer.writeScalar(k_cooked_asset_version);
+            writer.writeScalar(k_serializer_schema_hash);
+            BinarySerializer::write(writer, out_asset);
 
-            // write to file
-            asset_json_file << asset_json_text;
-            asset_json_file.flush();
+            if (!writer.isValid())
+            {
+                LOG_ERROR("cook asset {} failed, it references unregistered types", asset_url);
+                return false;
+            }
 
-            return true;
+            return writeDerivedFile(getCookedPath(asset_url), writer.getBuffer());
+        }
+
+        /// converts the json source of asset_url into its cooked counterpart
+        template<typename AssetType>
+        bool cookAsset(const std::string& asset_url) const
+        {
+            AssetType asset;
+            if (!loadJsonAsset(asset_url, asset))
+            {
+                return false;
+            }
+            return saveCookedAsset(asset, asset_url);
         }
 
         std::filesystem::path getFullPath(const std::string& relative_path) const;
 
+        /// xxx.level.json -> xxx.level.cooked, next to the json source
+        std::filesystem::path getCookedPath(const std::string& asset_url) const;
+
+        /// a cooked file older than its json source is stale and ignored
+        bool isCookedAssetUpToDate(const std::string& asset_url) const;
+
+        /// true if derived_path exists and is not older than the source of asset_url (or the source is gone)
+        bool isDerivedFileUpToDate(const std::string& asset_url, const std::filesystem::path& derived_path) const;
+
+        /// writes data into a temporary file that replaces derived_path once it is complete. the old file stays
+        /// intact for anyone who still has it open or mapped
+        bool writeDerivedFile(const std::filesystem::path& derived_path, const std::vector<uint8_t>& data) const;
+
+    private:
+        /// xxx.level.json -> xxx.level.json.tmp
+        static std::filesystem::path getTempPath(const std::filesystem::path& path);
+        bool replaceWithTempFile(const std::filesystem::path& temp_path, const std::filesystem::path& path) const;
+        void removeTempFile(const std::filesystem::path& temp_path) const;
+
+        bool readCookedFile(const std::filesystem::path& cooked_path, std::vector<uint8_t>& out_data) const;
     };
 } // namespace Piccolo
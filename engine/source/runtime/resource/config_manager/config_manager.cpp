@@ -56,6 +56,34 @@ namespace Piccolo
                 {
                     m_global_particle_res_url = value;
                 }
+                else if (name == "JobWorkerCount")
+                {
+                    m_job_worker_count = std::stoi(value);
+                }
+                else if (name == "BatchComponentTick")
+                {
+                    m_batch_component_tick = value == "true" || value == "1";
+                }
+                else if (name == "LuaSharedState")
+                {
+                    m_lua_shared_state = value == "true" || value == "1";
+                }
+                else if (name == "LuaFrameBudgetMs")
+                {
+                    m_lua_frame_budget_ms = std::stof(value);
+                }
+                else if (name == "PhysicsUpdateFrequency")
+                {
+                    m_physics_update_frequency = std::stof(value);
+                }
+                else if (name == "PhysicsMaxSubsteps")
+                {
+                    m_physics_max_substeps = std::stoi(value);
+                }
+                else if (name == "PhysicsWorkerCount")
+                {
+                    m_physics_worker_count = std::stoi(value);
+                }
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
                 else if (name == "JoltAssetFolder")
                 {
@@ -84,6 +112,20 @@ namespace Piccolo
 
     const std::string& ConfigManager::getGlobalParticleResUrl() const { return m_global_particle_res_url; }
 
+    int ConfigManager::getJobWorkerCount() const { return m_job_worker_count; }
+
+    bool ConfigManager::getBatchComponentTick() const { return m_batch_component_tick; }
+
+    bool ConfigManager::getLuaSharedState() const { return m_lua_shared_state; }
+
+    float ConfigManager::getLuaFrameBudgetMs() const { return m_lua_frame_budget_ms; }
+
+    float ConfigManager::getPhysicsUpdateFrequency() const { return m_physics_update_frequency; }
+
+    int ConfigManager::getPhysicsMaxSubsteps() const { return m_physics_max_substeps; }
+
+    int ConfigManager::getPhysicsWorkerCount() const { return m_physics_worker_count; }
+
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
     const std::filesystem::path& ConfigManager::getJoltPhysicsAssetFolder() const { return m_jolt_physics_asset_folder; }
 #endif
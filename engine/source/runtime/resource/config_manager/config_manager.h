@@ -26,6 +26,26 @@ namespace Piccolo
         const std::string& getGlobalRenderingResUrl() const;
         const std::string& getGlobalParticleResUrl() const;
 
+        // negative means one worker per hardware thread besides the main thread, 0 ticks everything on the main thread
+        int getJobWorkerCount() const;
+
+        // whether levels tick their components type by type out of the pooled storage instead of object by object.
+        // a batched level ticks one type in all objects before the next type, so an object can see a later object's
+        // components of an earlier type already ticked this frame. the types that may tick in parallel, animation and
+        // particles, go through the job system either way
+        bool getBatchComponentTick() const;
+
+        // whether all lua components run in one lua state
+        bool getLuaSharedState() const;
+        // milliseconds the lua scripts may take per frame, 0 runs all of them every frame
+        float getLuaFrameBudgetMs() const;
+
+        // fixed physics steps per second and the most steps one frame may take, 0 keeps the physics defaults
+        float getPhysicsUpdateFrequency() const;
+        int   getPhysicsMaxSubsteps() const;
+        // worker threads shared by all physics scenes, 0 keeps the physics default
+        int getPhysicsWorkerCount() const;
+
     private:
         std::filesystem::path m_root_folder;
         std::filesystem::path m_asset_folder;
@@ -41,5 +61,16 @@ namespace Piccolo
         std::string m_default_world_url;
         std::string m_global_rendering_res_url;
         std::string m_global_particle_res_url;
+
+        int m_job_worker_count {-1};
+
+        bool m_batch_component_tick {false};
+
+        bool  m_lua_shared_state {false};
+        float m_lua_frame_budget_ms {0.f};
+
+        float m_physics_update_frequency {0.f};
+        int   m_physics_max_substeps {0};
+        int   m_physics_worker_count {0};
     };
 } // namespace Piccolo
@@ -31,6 +31,8 @@ namespace Piccolo
         PhysicsControllerConfig() {}
         ~PhysicsControllerConfig() {}
         Capsule m_capsule_shape;
+        float   m_step_height {0.3f};     // highest ledge walked onto without jumping
+        float   m_max_slope_angle {45.f}; // steepest ground in degrees that is walked on rather than slid off
     };
 
     REFLECTION_TYPE(MotorComponentRes)
@@ -16,6 +16,14 @@ namespace Piccolo
         invalid
     };
 
+    /// how the simulation moves a rigid body, stored as the int m_actor_type
+    enum class RigidBodyActorType : unsigned char
+    {
+        dynamic_body,  // moved by gravity, forces and contacts, its pose is written back to the transform
+        static_body,   // never moves, the default
+        kinematic_body // moved only by its transform, pushes dynamic bodies on the way
+    };
+
     REFLECTION_TYPE(RigidBodyShape)
     CLASS(RigidBodyShape, WhiteListFields)
     {
@@ -44,7 +52,7 @@ namespace Piccolo
 
     public:
         std::vector<RigidBodyShape> m_shapes;
-        float                       m_inverse_mass;
-        int                         m_actor_type;
+        float                       m_inverse_mass {0.f}; // 0 takes the mass from the volume of the shapes
+        int                         m_actor_type {static_cast<int>(RigidBodyActorType::static_body)};
     };
 } // namespace Piccolo
\ No newline at end of file
@@ -16,19 +16,6 @@ namespace Piccolo
         std::vector<float> blend_weight;
     };
 
-    REFLECTION_TYPE(BlendStateWithClipData)
-    CLASS(BlendStateWithClipData, Fields)
-    {
-        REFLECTION_BODY(BlendStateWithClipData);
-
-    public:
-        int                          clip_count;
-        std::vector<AnimationClip>   blend_clip;
-        std::vector<AnimSkelMap>     blend_anim_skel_map;
-        std::vector<BoneBlendWeight> blend_weight;
-        std::vector<float>           blend_ratio;
-    };
-
     REFLECTION_TYPE(BlendState)
     CLASS(BlendState, Fields)
     {
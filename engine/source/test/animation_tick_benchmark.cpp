@@ -0,0 +1,198 @@
+#include "test_utilities.h"
+
+#include "runtime/core/math/math.h"
+#include "runtime/core/math/transform.h"
+
+#include "runtime/function/animation/animation_system.h"
+#include "runtime/function/animation/skeleton.h"
+#include "runtime/function/framework/component/animation/animation_component.h"
+
+#include "runtime/resource/res_type/data/animation_clip.h"
+#include "runtime/resource/res_type/data/animation_skeleton_node_map.h"
+#include "runtime/resource/res_type/data/skeleton_data.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::atomic<size_t> g_allocation_count {0};
+} // namespace
+
+// every allocation of the process goes through here, so the benchmark can count the ones made during a tick
+void* operator new(std::size_t size)
+{
+    ++g_allocation_count;
+    if (void* pointer = std::malloc(size == 0 ? 1 : size))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+using namespace Piccolo;
+
+namespace
+{
+    constexpr int k_character_count = 500;
+    constexpr int k_bone_count      = 67;
+    constexpr int k_frame_count     = 30;
+    constexpr int k_tick_count      = 200;
+
+    std::mt19937 g_random(20221017u);
+
+    float randomFloat(float min_value, float max_value)
+    {
+        return std::uniform_real_distribution<float>(min_value, max_value)(g_random);
+    }
+
+    Vector3 randomVector(float min_value, float max_value)
+    {
+        return Vector3(randomFloat(min_value, max_value),
+                       randomFloat(min_value, max_value),
+                       randomFloat(min_value, max_value));
+    }
+
+    Quaternion randomRotation()
+    {
+        Quaternion rotation(
+            randomFloat(-1.f, 1.f), randomFloat(-1.f, 1.f), randomFloat(-1.f, 1.f), randomFloat(-1.f, 1.f));
+        rotation.normalise();
+        return rotation;
+    }
+
+    /// a skeleton of the size of the player's
+    SkeletonData makeSkeleton()
+    {
+        SkeletonData skeleton;
+        skeleton.is_flat              = true;
+        skeleton.in_topological_order = true;
+        skeleton.root_index           = 0;
+        for (int bone_index = 0; bone_index < k_bone_count; ++bone_index)
+        {
+            RawBone bone;
+            bone.name         = "bone_" + std::to_string(bone_index);
+            bone.index        = bone_index;
+            bone.parent_index = bone_index == 0 ? -1 : static_cast<int>(g_random() % bone_index);
+            bone.binding_pose = Transform(randomVector(-1.f, 1.f), randomRotation(), randomVector(0.8f, 1.2f));
+
+            Matrix4x4 inverse_tpose;
+            inverse_tpose.makeInverseTransform(randomVector(-2.f, 2.f), randomVector(0.5f, 1.5f), randomRotation());
+            bone.tpose_matrix = inverse_tpose.toMatrix4x4_();
+
+            skeleton.bones_map.push_back(bone);
+        }
+        return skeleton;
+    }
+
+    /// a channel for every bone, node i drives bone i
+    void makeClip(AnimationClip& clip, AnimSkelMap& anim_skel_map)
+    {
+        clip.total_frame = k_frame_count;
+        clip.node_count  = k_bone_count;
+        clip.node_channels.resize(k_bone_count);
+        anim_skel_map.convert.resize(k_bone_count);
+        for (int node_index = 0; node_index < k_bone_count; ++node_index)
+        {
+            AnimationChannel& channel = clip.node_channels[node_index];
+            channel.name              = "node_" + std::to_string(node_index);
+            for (int frame = 0; frame < k_frame_count; ++frame)
+            {
+                channel.position_keys.push_back(randomVector(-0.5f, 0.5f));
+                channel.rotation_keys.push_back(randomRotation());
+                channel.scaling_keys.push_back(randomVector(0.9f, 1.1f));
+            }
+            anim_skel_map.convert[node_index] = node_index;
+        }
+    }
+
+    /// an animation component set up the way postLoadResource and the first tick leave it, without the asset files
+    class BenchmarkAnimationComponent : public AnimationComponent
+    {
+    public:
+        void setup(const SkeletonData&                              skeleton_definition,
+                   const BlendState&                                blend_state,
+                   std::shared_ptr<const BlendStateWithClipHandles> blend_state_handles)
+        {
+            m_skeleton.buildSkeleton(skeleton_definition);
+            m_animation_res.blend_state = blend_state;
+            m_resolved_blend_state      = blend_state;
+            m_blend_state_handles       = std::move(blend_state_handles);
+        }
+    };
+} // namespace
+
+// 500 characters blending two clips of a 67 bone skeleton, ticked through AnimationComponent::tick. prints the cost
+// of a frame and fails when a tick after the first one allocates
+int main()
+{
+    const SkeletonData skeleton_definition = makeSkeleton();
+
+    auto walk_clip          = std::make_shared<AnimationClip>();
+    auto walk_anim_skel_map = std::make_shared<AnimSkelMap>();
+    makeClip(*walk_clip, *walk_anim_skel_map);
+    auto run_clip          = std::make_shared<AnimationClip>();
+    auto run_anim_skel_map = std::make_shared<AnimSkelMap>();
+    makeClip(*run_clip, *run_anim_skel_map);
+
+    auto blend_state_handles                 = std::make_shared<BlendStateWithClipHandles>();
+    blend_state_handles->clip_count          = 2;
+    blend_state_handles->blend_clip          = {walk_clip, run_clip};
+    blend_state_handles->blend_anim_skel_map = {walk_anim_skel_map, run_anim_skel_map};
+    blend_state_handles->clip_weight         = {0.6f, 0.4f};
+
+    std::vector<std::unique_ptr<BenchmarkAnimationComponent>> characters;
+    for (int character_index = 0; character_index < k_character_count; ++character_index)
+    {
+        BlendState blend_state;
+        blend_state.clip_count             = 2;
+        blend_state.blend_clip_file_length = {1.f, 0.8f};
+        blend_state.blend_ratio            = {randomFloat(0.f, 1.f), randomFloat(0.f, 1.f)};
+
+        characters.push_back(std::make_unique<BenchmarkAnimationComponent>());
+        characters.back()->setup(skeleton_definition, blend_state, blend_state_handles);
+    }
+
+    const float delta_time = 1.f / 60.f;
+    auto        tick       = [&]() {
+        for (std::unique_ptr<BenchmarkAnimationComponent>& character : characters)
+        {
+            character->tick(delta_time);
+        }
+    };
+
+    // the first tick sizes the animation results
+    tick();
+
+    const size_t allocation_count_before = g_allocation_count.load();
+    const double milliseconds            = Test::measureMilliseconds(k_tick_count, tick);
+    const size_t allocation_count        = g_allocation_count.load() - allocation_count_before;
+
+    if (characters.front()->getResult().node.size() != static_cast<size_t>(k_bone_count))
+    {
+        std::fprintf(stderr, "the animation result holds %zu joints\n", characters.front()->getResult().node.size());
+        return EXIT_FAILURE;
+    }
+
+    std::printf("%d characters of %d bones: %.3f ms per frame, %.2f us per character, %.2f allocations per tick\n",
+                k_character_count,
+                k_bone_count,
+                milliseconds,
+                milliseconds * 1000.0 / k_character_count,
+                static_cast<double>(allocation_count) / (k_tick_count + 1));
+
+    if (allocation_count != 0)
+    {
+        std::fprintf(stderr, "%zu allocations in %d ticks\n", allocation_count, k_tick_count + 1);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,169 @@
+#include "test_utilities.h"
+
+#include "runtime/function/controller/character_controller.h"
+#include "runtime/function/physics/physics_runtime.h"
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace Piccolo;
+
+namespace
+{
+    constexpr int   k_box_count        = 1500;
+    constexpr int   k_controller_count = 500;
+    constexpr int   k_frame_count      = 120;
+    constexpr float k_delta_time       = 1.f / 60.f;
+
+    void addBox(PhysicsScene& physics_scene, const Vector3& center, const Vector3& half_extents)
+    {
+        Box* box            = new Box;
+        box->m_half_extents = half_extents;
+
+        RigidBodyComponentRes rigid_body;
+        rigid_body.m_shapes.resize(1);
+        rigid_body.m_shapes[0].m_geometry = Reflection::ReflectionPtr<Geometry>("Box", box);
+        rigid_body.m_shapes[0].m_local_transform =
+            Transform(Vector3::ZERO, Quaternion::IDENTITY, Vector3::UNIT_SCALE);
+
+        physics_scene.createRigidBody(Transform(center, Quaternion::IDENTITY, Vector3::UNIT_SCALE), rigid_body);
+    }
+
+    /// the standing capsule of the controllers, the way CharacterController builds it
+    RigidBodyShape makeCapsuleShape(const PhysicsControllerConfig& config)
+    {
+        Capsule* capsule       = new Capsule;
+        capsule->m_half_height = config.m_capsule_shape.m_half_height;
+        capsule->m_radius      = config.m_capsule_shape.m_radius;
+
+        Quaternion orientation;
+        orientation.fromAngleAxis(Radian(Degree(90.f)), Vector3::UNIT_X);
+
+        RigidBodyShape shape;
+        shape.m_geometry        = Reflection::ReflectionPtr<Geometry>("Capsule", capsule);
+        shape.m_local_transform = Transform(
+            Vector3(0.f, 0.f, capsule->m_half_height + capsule->m_radius), orientation, Vector3::UNIT_SCALE);
+        return shape;
+    }
+} // namespace
+
+// controllers walking through a field of boxes on a floor: the cost of a frame of moves, and the cost of one capsule
+// sweep as a one query sweepBatch, which converts the shape every call, and as a sweep of a cached query shape
+int main()
+{
+    PhysicsConfig  physics_config;
+    PhysicsRuntime physics_runtime(physics_config);
+    PhysicsScene   physics_scene(physics_runtime, Vector3(0.f, 0.f, -9.8f), physics_config);
+
+    std::mt19937                          random(20221017u);
+    std::uniform_real_distribution<float> position(-90.f, 90.f);
+    std::uniform_real_distribution<float> half_size(0.2f, 1.5f);
+    std::uniform_real_distribution<float> angle(0.f, 2.f * Math_PI);
+
+    addBox(physics_scene, Vector3(0.f, 0.f, -0.5f), Vector3(100.f, 100.f, 0.5f));
+    for (int box_index = 0; box_index < k_box_count; ++box_index)
+    {
+        addBox(physics_scene,
+               Vector3(position(random), position(random), 0.5f),
+               Vector3(half_size(random), half_size(random), 0.5f));
+    }
+    physics_scene.tick(k_delta_time);
+
+    PhysicsControllerConfig controller_config;
+    controller_config.m_capsule_shape.m_half_height = 0.7f;
+    controller_config.m_capsule_shape.m_radius      = 0.3f;
+    const RigidBodyShape capsule_shape              = makeCapsuleShape(controller_config);
+
+    // every controller starts clear of the boxes and walks straight on
+    std::vector<std::unique_ptr<CharacterController>> controllers;
+    std::vector<Vector3>                              positions;
+    std::vector<Vector3>                              velocities;
+    for (int controller_index = 0; controller_index < k_controller_count; ++controller_index)
+    {
+        Vector3 start_position;
+        do
+        {
+            start_position = Vector3(position(random), position(random), 0.01f);
+        } while (
+            physics_scene.isOverlap(capsule_shape, Matrix4x4::getTrans(start_position + Vector3(0.f, 0.f, 0.02f))));
+
+        const float direction_angle = angle(random);
+        controllers.emplace_back(std::make_unique<CharacterController>(controller_config));
+        positions.push_back(start_position);
+        velocities.push_back(Vector3(std::cos(direction_angle), std::sin(direction_angle), 0.f) * 3.f);
+    }
+
+    int    frame_index       = 0;
+    double move_milliseconds = Test::measureMilliseconds(k_frame_count, [&]() {
+        for (int controller_index = 0; controller_index < k_controller_count; ++controller_index)
+        {
+            positions[controller_index] = controllers[controller_index]->move(
+                physics_scene, positions[controller_index], velocities[controller_index] * k_delta_time);
+        }
+        ++frame_index;
+    });
+
+    int grounded_count = 0;
+    for (const std::unique_ptr<CharacterController>& controller : controllers)
+    {
+        grounded_count += controller->isGrounded() ? 1 : 0;
+    }
+    std::printf("%d controllers, %d boxes: %.3f ms per frame, %d grounded after %d frames\n",
+                k_controller_count,
+                k_box_count,
+                move_milliseconds,
+                grounded_count,
+                frame_index);
+
+    // the side sweep of every controller, once through the batch and once through the cached shape
+    std::vector<PhysicsSweepQuery> sweep_queries(1);
+    std::vector<PhysicsHitInfo>    batch_hits;
+    int                            batch_hit_count    = 0;
+    double                         batch_milliseconds = Test::measureMilliseconds(10, [&]() {
+        batch_hit_count = 0;
+        for (int controller_index = 0; controller_index < k_controller_count; ++controller_index)
+        {
+            const Vector3& velocity          = velocities[controller_index];
+            sweep_queries[0].shape           = &capsule_shape;
+            sweep_queries[0].shape_transform = Matrix4x4::getTrans(positions[controller_index]);
+            sweep_queries[0].sweep_direction = velocity / velocity.length();
+            sweep_queries[0].sweep_length    = 2.f;
+            physics_scene.sweepBatch(sweep_queries, PhysicsQueryMode::closest_hit, batch_hits);
+            batch_hit_count += batch_hits[0].body_id != s_invalid_rigidbody_id ? 1 : 0;
+        }
+    });
+
+    PhysicsQueryShape query_shape;
+    int               cached_hit_count    = 0;
+    double            cached_milliseconds = Test::measureMilliseconds(10, [&]() {
+        cached_hit_count = 0;
+        for (int controller_index = 0; controller_index < k_controller_count; ++controller_index)
+        {
+            const Vector3& velocity = velocities[controller_index];
+            PhysicsHitInfo hit;
+            query_shape.place(capsule_shape, Matrix4x4::getTrans(positions[controller_index]));
+            if (physics_scene.sweep(
+                    query_shape, velocity / velocity.length(), 2.f, PhysicsQueryMode::closest_hit, hit))
+            {
+                ++cached_hit_count;
+            }
+        }
+    });
+
+    if (batch_hit_count != cached_hit_count)
+    {
+        std::fprintf(stderr, "the cached sweep hits %d times, the batch %d times\n", cached_hit_count, batch_hit_count);
+        return EXIT_FAILURE;
+    }
+
+    std::printf("%d sweeps, %d hits: batch %.3f ms, cached shape %.3f ms, %.2fx\n",
+                k_controller_count,
+                cached_hit_count,
+                batch_milliseconds,
+                cached_milliseconds,
+                batch_milliseconds / cached_milliseconds);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,122 @@
+#include "test_utilities.h"
+
+#include "runtime/function/framework/component/animation/animation_component.h"
+#include "runtime/function/framework/component/camera/camera_component.h"
+#include "runtime/function/framework/component/lua/lua_component.h"
+#include "runtime/function/framework/component/mesh/mesh_component.h"
+#include "runtime/function/framework/component/motor/motor_component.h"
+#include "runtime/function/framework/component/transform/transform_component.h"
+#include "runtime/function/framework/object/object.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Piccolo;
+
+namespace
+{
+    constexpr int k_object_count = 10000;
+    constexpr int k_frame_count  = 100;
+    constexpr int k_lookup_count = 6;
+
+    /// an object holding the components of the player, in the order of its definition, added without loading them
+    class BenchmarkObject : public GObject
+    {
+    public:
+        explicit BenchmarkObject(GObjectID id) : GObject(id)
+        {
+            addComponent({"TransformComponent", new TransformComponent()});
+            addComponent({"AnimationComponent", new AnimationComponent()});
+            addComponent({"MeshComponent", new MeshComponent()});
+            addComponent({"MotorComponent", new MotorComponent()});
+            addComponent({"CameraComponent", new CameraComponent()});
+            addComponent({"LuaComponent", new LuaComponent()});
+        }
+    };
+
+    /// the lookup objects had before the component table: the type name compared with every component in turn
+    template<typename TComponent>
+    TComponent* scanComponents(const GObject& object, const std::string& component_type_name)
+    {
+        for (const auto& component : object.getComponents())
+        {
+            if (component.getTypeName() == component_type_name)
+            {
+                return static_cast<TComponent*>(component.getPtr());
+            }
+        }
+        return nullptr;
+    }
+
+    /// the k_lookup_count components one frame looks up on an object: the mesh, motor and camera fetch the
+    /// transform, the mesh also the animation, and the character finds its motor and camera
+    uintptr_t lookUpByTable(GObject& object)
+    {
+        return reinterpret_cast<uintptr_t>(object.tryGetComponent(TransformComponent)) +
+               reinterpret_cast<uintptr_t>(object.tryGetComponentConst(AnimationComponent)) +
+               reinterpret_cast<uintptr_t>(object.tryGetComponent(TransformComponent)) +
+               reinterpret_cast<uintptr_t>(object.tryGetComponent(TransformComponent)) +
+               reinterpret_cast<uintptr_t>(object.tryGetComponent(MotorComponent)) +
+               reinterpret_cast<uintptr_t>(object.tryGetComponent(CameraComponent));
+    }
+
+    uintptr_t lookUpByName(GObject& object)
+    {
+        return reinterpret_cast<uintptr_t>(scanComponents<TransformComponent>(object, "TransformComponent")) +
+               reinterpret_cast<uintptr_t>(scanComponents<AnimationComponent>(object, "AnimationComponent")) +
+               reinterpret_cast<uintptr_t>(scanComponents<TransformComponent>(object, "TransformComponent")) +
+               reinterpret_cast<uintptr_t>(scanComponents<TransformComponent>(object, "TransformComponent")) +
+               reinterpret_cast<uintptr_t>(scanComponents<MotorComponent>(object, "MotorComponent")) +
+               reinterpret_cast<uintptr_t>(scanComponents<CameraComponent>(object, "CameraComponent"));
+    }
+} // namespace
+
+// 10k objects with the components of the player, each frame looking up the components the ticks of one object fetch,
+// once through the component table and once by comparing type names along the component list
+int main()
+{
+    std::vector<std::shared_ptr<GObject>> objects;
+    for (int object_index = 0; object_index < k_object_count; ++object_index)
+    {
+        objects.push_back(std::make_shared<BenchmarkObject>(static_cast<GObjectID>(object_index)));
+    }
+
+    uintptr_t name_checksum     = 0;
+    double    name_milliseconds = Test::measureMilliseconds(k_frame_count, [&]() {
+        name_checksum = 0;
+        for (const std::shared_ptr<GObject>& object : objects)
+        {
+            name_checksum += lookUpByName(*object);
+        }
+    });
+
+    uintptr_t table_checksum     = 0;
+    double    table_milliseconds = Test::measureMilliseconds(k_frame_count, [&]() {
+        table_checksum = 0;
+        for (const std::shared_ptr<GObject>& object : objects)
+        {
+            table_checksum += lookUpByTable(*object);
+        }
+    });
+
+    if (name_checksum != table_checksum || table_checksum == 0)
+    {
+        std::fprintf(stderr, "the component table finds other components than the name scan\n");
+        return EXIT_FAILURE;
+    }
+
+    const double lookup_count = static_cast<double>(k_object_count) * k_lookup_count;
+    std::printf("%d objects, %d lookups each: name scan %.3f ms (%.1f ns per lookup), table %.3f ms (%.1f ns per "
+                "lookup), %.1fx\n",
+                k_object_count,
+                k_lookup_count,
+                name_milliseconds,
+                name_milliseconds * 1e6 / lookup_count,
+                table_milliseconds,
+                table_milliseconds * 1e6 / lookup_count,
+                name_milliseconds / table_milliseconds);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,111 @@
+#include "test_utilities.h"
+
+#include "runtime/core/log/log_system.h"
+#include "runtime/core/meta/reflection/reflection_register.h"
+
+#include "runtime/resource/asset_manager/asset_manager.h"
+#include "runtime/resource/config_manager/config_manager.h"
+
+#include "runtime/function/framework/component/mesh/mesh_component.h"
+#include "runtime/function/framework/component/transform/transform_component.h"
+#include "runtime/function/framework/level/level.h"
+#include "runtime/function/framework/object/object.h"
+#include "runtime/function/global/global_context.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Piccolo;
+
+namespace
+{
+    constexpr int k_object_count = 50000;
+    constexpr int k_tick_count   = 100;
+
+    /// a level that is ticked without loading a level file and without a physics scene
+    class BenchmarkLevel : public Level
+    {
+    public:
+        void markLoaded() { m_is_loaded = true; }
+    };
+
+    GObjectID createStaticMesh(Level& level, int object_index)
+    {
+        ObjectInstanceRes object_instance_res;
+        object_instance_res.m_name = "static_mesh_" + std::to_string(object_index);
+        object_instance_res.m_instanced_components.emplace_back("TransformComponent", new TransformComponent());
+        object_instance_res.m_instanced_components.emplace_back("MeshComponent", new MeshComponent());
+        return level.createObject(object_instance_res, std::make_shared<const ObjectDefinitionRes>());
+    }
+
+    /// milliseconds of one tick of the level, with the tick path chosen by BatchComponentTick in the config
+    double measureLevelTick(Level& level, const std::filesystem::path& config_path)
+    {
+        g_runtime_global_context.m_config_manager = std::make_shared<ConfigManager>();
+        g_runtime_global_context.m_config_manager->initialize(config_path);
+        return Test::measureMilliseconds(k_tick_count, [&]() { level.tick(1.f / 60.f); });
+    }
+} // namespace
+
+// a level of 50k static meshes, each a transform and a mesh component, ticked object by object and then type by type.
+// a quarter of the objects is deleted and spawned again first, so the pooled components are not in creation order
+int main()
+{
+    Reflection::TypeMetaRegister::metaRegister();
+
+    const std::filesystem::path root_folder =
+        std::filesystem::temp_directory_path() / "piccolo_component_tick_benchmark";
+    std::filesystem::create_directories(root_folder / "asset");
+    std::ofstream(root_folder / "per_object.ini") << "BinaryRootFolder=.\nAssetFolder=asset\nBatchComponentTick=0\n";
+    std::ofstream(root_folder / "by_type.ini") << "BinaryRootFolder=.\nAssetFolder=asset\nBatchComponentTick=1\n";
+
+    g_runtime_global_context.m_logger_system  = std::make_shared<LogSystem>();
+    g_runtime_global_context.m_config_manager = std::make_shared<ConfigManager>();
+    g_runtime_global_context.m_config_manager->initialize(root_folder / "per_object.ini");
+    g_runtime_global_context.m_asset_manager = std::make_shared<AssetManager>();
+
+    std::unique_ptr<BenchmarkLevel> level = std::make_unique<BenchmarkLevel>();
+
+    std::vector<GObjectID> object_ids;
+    for (int object_index = 0; object_index < k_object_count; ++object_index)
+    {
+        object_ids.push_back(createStaticMesh(*level, object_index));
+    }
+    for (int object_index = 0; object_index < k_object_count; object_index += 4)
+    {
+        level->deleteGObjectByID(object_ids[object_index]);
+        object_ids[object_index] = createStaticMesh(*level, object_index);
+    }
+
+    // nothing moves, the mesh components only look at their transform and do not reach the render system
+    for (const auto& id_object_pair : level->getAllGObjects())
+    {
+        id_object_pair.second->tryGetComponent(TransformComponent)->setDirtyFlag(false);
+    }
+    level->markLoaded();
+
+    if (level->getAllGObjects().size() != static_cast<size_t>(k_object_count))
+    {
+        std::fprintf(stderr, "the level holds %zu objects\n", level->getAllGObjects().size());
+        return EXIT_FAILURE;
+    }
+
+    const double per_object_milliseconds = measureLevelTick(*level, root_folder / "per_object.ini");
+    const double by_type_milliseconds    = measureLevelTick(*level, root_folder / "by_type.ini");
+
+    std::printf("%d objects: per object %.3f ms, by type %.3f ms per tick, %.2fx\n",
+                k_object_count,
+                per_object_milliseconds,
+                by_type_milliseconds,
+                per_object_milliseconds / by_type_milliseconds);
+
+    level.reset();
+    std::filesystem::remove_all(root_folder);
+
+    Reflection::TypeMetaRegister::metaUnregister();
+    return EXIT_SUCCESS;
+}
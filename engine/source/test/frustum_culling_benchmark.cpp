@@ -0,0 +1,71 @@
+#include "test_utilities.h"
+
+#include "runtime/core/math/math.h"
+#include "runtime/core/math/matrix4.h"
+
+#include "runtime/function/render/render_helper.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace Piccolo;
+
+// boxes per second of TiledFrustumIntersectBox called per box and of TiledFrustumIntersectBoxes, for scenes of a few
+// sizes with about a quarter of the boxes visible
+int main()
+{
+    std::mt19937                          random(20221017u);
+    std::uniform_real_distribution<float> position(-150.f, 150.f);
+    std::uniform_real_distribution<float> size(0.f, 20.f);
+
+    Matrix4x4 view_matrix =
+        Math::makeLookAtMatrix(Vector3(0.f, -40.f, 10.f), Vector3(10.f, 30.f, 0.f), Vector3::UNIT_Z);
+    Matrix4x4 proj_matrix = Math::makePerspectiveMatrix(Radian(Math_PI / 3.f), 16.f / 9.f, 0.1f, 200.f);
+    const ClusterFrustum frustum =
+        CreateClusterFrustumFromMatrix(proj_matrix * view_matrix, -1.0, 1.0, -1.0, 1.0, 0.0, 1.0);
+
+    std::printf("%10s %16s %16s %8s\n", "boxes", "scalar Mbox/s", "batch Mbox/s", "speedup");
+    for (size_t box_count : {1000, 10000, 100000, 1000000})
+    {
+        std::vector<BoundingBox> boxes;
+        BoundingBoxArray         box_array;
+        box_array.resize(box_count);
+        for (size_t box_index = 0; box_index < box_count; ++box_index)
+        {
+            Vector3 min_bound(position(random), position(random), position(random));
+            boxes.emplace_back(min_bound, min_bound + Vector3(size(random), size(random), size(random)));
+            box_array.setBox(box_index, boxes.back());
+        }
+
+        const int iteration_count = static_cast<int>(20000000 / box_count) + 1;
+
+        std::vector<uint32_t> scalar_visibility((box_count + 31) / 32);
+        double scalar_milliseconds = Test::measureMilliseconds(iteration_count, [&]() {
+            std::fill(scalar_visibility.begin(), scalar_visibility.end(), 0);
+            for (size_t box_index = 0; box_index < box_count; ++box_index)
+            {
+                scalar_visibility[box_index / 32] |=
+                    static_cast<uint32_t>(TiledFrustumIntersectBox(frustum, boxes[box_index])) << (box_index % 32);
+            }
+        });
+
+        std::vector<uint32_t> batch_visibility;
+        double                batch_milliseconds = Test::measureMilliseconds(
+            iteration_count, [&]() { TiledFrustumIntersectBoxes(frustum, box_array, batch_visibility); });
+
+        if (scalar_visibility != batch_visibility)
+        {
+            std::fprintf(stderr, "the batch test disagrees with the scalar test for %zu boxes\n", box_count);
+            return EXIT_FAILURE;
+        }
+
+        std::printf("%10zu %16.1f %16.1f %7.2fx\n",
+                    box_count,
+                    box_count / scalar_milliseconds / 1000.0,
+                    box_count / batch_milliseconds / 1000.0,
+                    scalar_milliseconds / batch_milliseconds);
+    }
+    return EXIT_SUCCESS;
+}
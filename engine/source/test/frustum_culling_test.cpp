@@ -0,0 +1,105 @@
+#include "test_utilities.h"
+
+#include "runtime/core/math/math.h"
+#include "runtime/core/math/matrix4.h"
+
+#include "runtime/function/render/render_helper.h"
+
+#include <random>
+#include <vector>
+
+using namespace Piccolo;
+
+namespace
+{
+    std::mt19937 g_random(20221017u);
+
+    float randomFloat(float min_value, float max_value)
+    {
+        return std::uniform_real_distribution<float>(min_value, max_value)(g_random);
+    }
+
+    Vector3 randomVector(float min_value, float max_value)
+    {
+        return Vector3(randomFloat(min_value, max_value),
+                       randomFloat(min_value, max_value),
+                       randomFloat(min_value, max_value));
+    }
+
+    ClusterFrustum makeFrustum(const Vector3& eye_position, const Vector3& target_position)
+    {
+        Matrix4x4 view_matrix = Math::makeLookAtMatrix(eye_position, target_position, Vector3::UNIT_Z);
+        Matrix4x4 proj_matrix = Math::makePerspectiveMatrix(Radian(Math_PI / 3.f), 16.f / 9.f, 0.1f, 200.f);
+        return CreateClusterFrustumFromMatrix(proj_matrix * view_matrix, -1.0, 1.0, -1.0, 1.0, 0.0, 1.0);
+    }
+
+    std::vector<BoundingBox> makeBoxes(size_t box_count)
+    {
+        std::vector<BoundingBox> boxes;
+        for (size_t box_index = 0; box_index < box_count; ++box_index)
+        {
+            Vector3 min_bound = randomVector(-150.f, 150.f);
+            boxes.emplace_back(min_bound, min_bound + randomVector(0.f, 20.f));
+        }
+        return boxes;
+    }
+
+    /// every box of the batch test must agree with the one box test, returns the number of visible boxes
+    size_t checkSameVisibility(const ClusterFrustum& frustum, const std::vector<BoundingBox>& boxes)
+    {
+        BoundingBoxArray box_array;
+        box_array.resize(boxes.size());
+        for (size_t box_index = 0; box_index < boxes.size(); ++box_index)
+        {
+            box_array.setBox(box_index, boxes[box_index]);
+        }
+
+        std::vector<uint32_t> visibility_mask {0xffffffffu};
+        TiledFrustumIntersectBoxes(frustum, box_array, visibility_mask);
+
+        PICCOLO_CHECK(visibility_mask.size() == (boxes.size() + 31) / 32);
+        size_t visible_count = 0;
+        for (size_t box_index = 0; box_index < boxes.size() && box_index / 32 < visibility_mask.size(); ++box_index)
+        {
+            bool is_visible = (visibility_mask[box_index / 32] >> (box_index % 32)) & 1u;
+            PICCOLO_CHECK(is_visible == TiledFrustumIntersectBox(frustum, boxes[box_index]));
+            visible_count += is_visible ? 1 : 0;
+        }
+
+        // the padding lanes of the last word stay clear
+        if (boxes.size() % 32 != 0 && !visibility_mask.empty())
+        {
+            PICCOLO_CHECK((visibility_mask.back() >> (boxes.size() % 32)) == 0);
+        }
+        return visible_count;
+    }
+} // namespace
+
+int main()
+{
+    const ClusterFrustum frustum = makeFrustum(Vector3(0.f, -40.f, 10.f), Vector3(10.f, 30.f, 0.f));
+
+    // counts around the lane width and the mask word width
+    for (size_t box_count : {0, 1, 3, 4, 5, 31, 32, 33, 64, 1000})
+    {
+        checkSameVisibility(frustum, makeBoxes(box_count));
+    }
+
+    // the scene has to mix visible and culled boxes for the comparison to mean something
+    const size_t visible_count = checkSameVisibility(frustum, makeBoxes(10007));
+    PICCOLO_CHECK(visible_count > 0 && visible_count < 10007);
+
+    // a point inside, a box around the whole frustum and a box behind the camera
+    std::vector<BoundingBox> special_boxes;
+    special_boxes.emplace_back(Vector3(1.f, 0.f, 5.f), Vector3(1.f, 0.f, 5.f));
+    special_boxes.emplace_back(Vector3(-1000.f, -1000.f, -1000.f), Vector3(1000.f, 1000.f, 1000.f));
+    special_boxes.emplace_back(Vector3(-2.f, -60.f, 8.f), Vector3(2.f, -50.f, 12.f));
+    checkSameVisibility(frustum, special_boxes);
+
+    for (int frustum_index = 0; frustum_index < 16; ++frustum_index)
+    {
+        checkSameVisibility(makeFrustum(randomVector(-50.f, 50.f), randomVector(-50.f, 50.f)), makeBoxes(257));
+    }
+
+    return Test::finish();
+}
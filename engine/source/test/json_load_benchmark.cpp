@@ -0,0 +1,196 @@
+#include "test_utilities.h"
+
+#include "runtime/core/meta/json.h"
+#include "runtime/core/meta/reflection/reflection_register.h"
+#include "runtime/core/meta/serializer/json_reader.h"
+#include "runtime/core/meta/serializer/serializer.h"
+
+#include "runtime/resource/res_type/common/level.h"
+#include "runtime/resource/res_type/common/object.h"
+#include "runtime/resource/res_type/data/animation_clip.h"
+#include "runtime/resource/res_type/data/skeleton_data.h"
+
+#include "_generated/serializer/all_serializer.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // every block carries its size in front of it, so the live heap of the process can be followed
+    constexpr size_t k_block_header_size = alignof(std::max_align_t);
+
+    std::atomic<size_t> g_allocation_count {0};
+    std::atomic<size_t> g_live_heap_size {0};
+    std::atomic<size_t> g_peak_heap_size {0};
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    char* block = static_cast<char*>(std::malloc(size + k_block_header_size));
+    if (block == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    *reinterpret_cast<size_t*>(block) = size;
+
+    ++g_allocation_count;
+    const size_t live_heap_size = g_live_heap_size += size;
+    size_t       peak_heap_size = g_peak_heap_size.load();
+    while (live_heap_size > peak_heap_size && !g_peak_heap_size.compare_exchange_weak(peak_heap_size, live_heap_size))
+    {
+    }
+    return block + k_block_header_size;
+}
+
+void operator delete(void* pointer) noexcept
+{
+    if (pointer == nullptr)
+    {
+        return;
+    }
+    char* block = static_cast<char*>(pointer) - k_block_header_size;
+    g_live_heap_size -= *reinterpret_cast<size_t*>(block);
+    std::free(block);
+}
+
+using namespace Piccolo;
+
+namespace
+{
+    constexpr int k_load_count = 20;
+
+    const char* const k_animation_clip_url =
+        "asset/objects/character/player/components/animation/data/W2_CrouchWalk_Aim_F_Loop_IP.animation_clip.json";
+    const char* const k_skeleton_url =
+        "asset/objects/character/player/components/animation/data/skeleton_data_root.skeleton.json";
+    const char* const k_level_url  = "asset/level/1-1.level.json";
+    const char* const k_object_url = "asset/objects/environment/wall/wall_with_window.object.json";
+
+    struct LoadResult
+    {
+        double milliseconds {0.0};
+        size_t allocation_count {0};
+        size_t peak_heap_size {0};
+        bool   is_valid {false};
+    };
+
+    /// the components a load creates, deleted again before the next load
+    template<typename AssetType>
+    void releaseAsset(AssetType&)
+    {}
+
+    void releaseComponents(std::vector<Reflection::ReflectionPtr<Component>>& components)
+    {
+        for (auto& component : components)
+        {
+            PICCOLO_REFLECTION_DELETE(component);
+        }
+    }
+
+    void releaseAsset(ObjectDefinitionRes& asset) { releaseComponents(asset.m_components); }
+
+    void releaseAsset(LevelRes& asset)
+    {
+        for (ObjectInstanceRes& object_res : asset.m_objects)
+        {
+            releaseComponents(object_res.m_instanced_components);
+        }
+    }
+
+    /// json11 tree first, then the asset filled from the tree, the way loadJsonAsset read assets before JsonReader
+    template<typename AssetType>
+    bool loadFromTree(const std::string& text)
+    {
+        std::string error;
+        const Json  tree = Json::parse(text, error);
+        AssetType   asset;
+        if (error.empty())
+        {
+            Serializer::read(tree, asset);
+        }
+        releaseAsset(asset);
+        return error.empty();
+    }
+
+    template<typename AssetType>
+    bool loadFromStream(const std::string& text)
+    {
+        JsonReader reader(text.data(), text.size());
+        AssetType  asset;
+        Serializer::read(reader, asset);
+        releaseAsset(asset);
+        return reader.isValid() && reader.isAtEnd();
+    }
+
+    /// time, allocation count and the growth of the heap at its peak of one load of text
+    template<typename TLoad>
+    LoadResult measureLoad(const std::string& text, TLoad&& load)
+    {
+        LoadResult result;
+
+        const size_t allocation_count_before = g_allocation_count.load();
+        const size_t live_heap_size_before   = g_live_heap_size.load();
+        g_peak_heap_size                     = live_heap_size_before;
+        result.is_valid                      = load(text);
+        result.allocation_count              = g_allocation_count.load() - allocation_count_before;
+        result.peak_heap_size                = g_peak_heap_size.load() - live_heap_size_before;
+
+        result.milliseconds = Test::measureMilliseconds(k_load_count, [&]() { load(text); });
+        return result;
+    }
+
+    template<typename AssetType>
+    bool measureAsset(const char* asset_url)
+    {
+        std::ifstream     asset_file(Test::getEngineRootFolder() / asset_url, std::ios::binary);
+        const std::string text {std::istreambuf_iterator<char>(asset_file), std::istreambuf_iterator<char>()};
+        if (text.empty())
+        {
+            std::fprintf(stderr, "reading %s failed\n", asset_url);
+            return false;
+        }
+
+        const LoadResult tree   = measureLoad(text, loadFromTree<AssetType>);
+        const LoadResult stream = measureLoad(text, loadFromStream<AssetType>);
+        if (!tree.is_valid || !stream.is_valid)
+        {
+            std::fprintf(stderr, "parsing %s failed\n", asset_url);
+            return false;
+        }
+
+        std::printf("%s, %.1f KB\n", asset_url, text.size() / 1024.0);
+        std::printf("    json11 tree: %9.3f ms %10zu allocations %10.1f KB peak heap\n",
+                    tree.milliseconds,
+                    tree.allocation_count,
+                    tree.peak_heap_size / 1024.0);
+        std::printf("    json reader: %9.3f ms %10zu allocations %10.1f KB peak heap\n",
+                    stream.milliseconds,
+                    stream.allocation_count,
+                    stream.peak_heap_size / 1024.0);
+        return true;
+    }
+} // namespace
+
+// the largest json assets of the engine read through a json11 tree and straight through JsonReader. the peak heap is
+// how far the live heap grows during one load above where it was before, the share of the peak rss a load adds. the
+// rss itself cannot be told apart per load in one process, its peak is never reset
+int main()
+{
+    // the components of the level and the object are created by their type names
+    Reflection::TypeMetaRegister::metaRegister();
+
+    const bool is_success = measureAsset<AnimationAsset>(k_animation_clip_url) &&
+                            measureAsset<SkeletonData>(k_skeleton_url) && measureAsset<LevelRes>(k_level_url) &&
+                            measureAsset<ObjectDefinitionRes>(k_object_url);
+
+    Reflection::TypeMetaRegister::metaUnregister();
+    return is_success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,590 @@
+#include "test_utilities.h"
+
+#include "runtime/core/meta/json.h"
+#include "runtime/core/meta/serializer/json_reader.h"
+#include "runtime/core/meta/serializer/serializer.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Piccolo
+{
+    // two types with serializers written the way the generated ones are, so the reads need no reflection
+
+    struct TestPoint
+    {
+        float       x {0.f};
+        float       y {0.f};
+        std::string name;
+    };
+
+    struct TestRecord
+    {
+        int                    count {0};
+        unsigned int           flags {0};
+        double                 weight {0.0};
+        bool                   is_active {false};
+        std::string            label;
+        std::vector<int>       ids;
+        std::vector<TestPoint> points;
+        TestPoint*             pivot {nullptr};
+    };
+
+    template<>
+    TestPoint& Serializer::read(const Json& json_context, TestPoint& instance)
+    {
+        if (!json_context["x"].is_null())
+            Serializer::read(json_context["x"], instance.x);
+        if (!json_context["y"].is_null())
+            Serializer::read(json_context["y"], instance.y);
+        if (!json_context["name"].is_null())
+            Serializer::read(json_context["name"], instance.name);
+        return instance;
+    }
+
+    template<>
+    bool Serializer::readField(JsonReader& reader, std::string_view key, TestPoint& instance)
+    {
+        if (key == "x")
+        {
+            Serializer::read(reader, instance.x);
+            return true;
+        }
+        if (key == "y")
+        {
+            Serializer::read(reader, instance.y);
+            return true;
+        }
+        if (key == "name")
+        {
+            Serializer::read(reader, instance.name);
+            return true;
+        }
+        return false;
+    }
+
+    template<>
+    TestPoint& Serializer::read(JsonReader& reader, TestPoint& instance)
+    {
+        if (reader.beginObject())
+        {
+            std::string_view key;
+            while (reader.nextKey(key))
+            {
+                if (!reader.readNull() && !Serializer::readField(reader, key, instance))
+                {
+                    reader.skipValue();
+                }
+            }
+        }
+        return instance;
+    }
+
+    template<>
+    TestRecord& Serializer::read(const Json& json_context, TestRecord& instance)
+    {
+        if (!json_context["count"].is_null())
+            Serializer::read(json_context["count"], instance.count);
+        if (!json_context["flags"].is_null())
+            Serializer::read(json_context["flags"], instance.flags);
+        if (!json_context["weight"].is_null())
+            Serializer::read(json_context["weight"], instance.weight);
+        if (!json_context["is_active"].is_null())
+            Serializer::read(json_context["is_active"], instance.is_active);
+        if (!json_context["label"].is_null())
+            Serializer::read(json_context["label"], instance.label);
+        if (!json_context["ids"].is_null())
+        {
+            const Json::array& ids = json_context["ids"].array_items();
+            instance.ids.resize(ids.size());
+            for (size_t index = 0; index < ids.size(); ++index)
+            {
+                Serializer::read(ids[index], instance.ids[index]);
+            }
+        }
+        if (!json_context["points"].is_null())
+        {
+            const Json::array& points = json_context["points"].array_items();
+            instance.points.resize(points.size());
+            for (size_t index = 0; index < points.size(); ++index)
+            {
+                Serializer::read(points[index], instance.points[index]);
+            }
+        }
+        if (!json_context["pivot"].is_null())
+            Serializer::read(json_context["pivot"], instance.pivot);
+        return instance;
+    }
+
+    template<>
+    bool Serializer::readField(JsonReader& reader, std::string_view key, TestRecord& instance)
+    {
+        if (key == "count")
+        {
+            Serializer::read(reader, instance.count);
+            return true;
+        }
+        if (key == "flags")
+        {
+            Serializer::read(reader, instance.flags);
+            return true;
+        }
+        if (key == "weight")
+        {
+            Serializer::read(reader, instance.weight);
+            return true;
+        }
+        if (key == "is_active")
+        {
+            Serializer::read(reader, instance.is_active);
+            return true;
+        }
+        if (key == "label")
+        {
+            Serializer::read(reader, instance.label);
+            return true;
+        }
+        if (key == "ids")
+        {
+            if (reader.beginArray())
+            {
+                size_t count = 0;
+                while (reader.nextElement())
+                {
+                    if (count == instance.ids.size())
+                    {
+                        instance.ids.resize(count + 1);
+                    }
+                    Serializer::read(reader, instance.ids[count++]);
+                }
+                instance.ids.resize(count);
+            }
+            return true;
+        }
+        if (key == "points")
+        {
+            if (reader.beginArray())
+            {
+                size_t count = 0;
+                while (reader.nextElement())
+                {
+                    if (count == instance.points.size())
+                    {
+                        instance.points.resize(count + 1);
+                    }
+                    Serializer::read(reader, instance.points[count++]);
+                }
+                instance.points.resize(count);
+            }
+            return true;
+        }
+        if (key == "pivot")
+        {
+            Serializer::read(reader, instance.pivot);
+            return true;
+        }
+        return false;
+    }
+
+    template<>
+    TestRecord& Serializer::read(JsonReader& reader, TestRecord& instance)
+    {
+        if (reader.beginObject())
+        {
+            std::string_view key;
+            while (reader.nextKey(key))
+            {
+                if (!reader.readNull() && !Serializer::readField(reader, key, instance))
+                {
+                    reader.skipValue();
+                }
+            }
+        }
+        return instance;
+    }
+} // namespace Piccolo
+
+using namespace Piccolo;
+
+namespace
+{
+    const char* const k_record_text = R"({
+        "count": 7,
+        "flags": 4294967295,
+        "weight": -1.25e2,
+        "is_active": true,
+        "label": "wall \"north\"",
+        "ids": [3, 1, 2],
+        "points": [{"x": 1.5, "y": -2, "name": "a"}, {"name": "b", "y": 0.25}],
+        "pivot": {"$typeName": "*", "$context": {"x": 4, "y": 5, "name": "pivot"}}
+    })";
+
+    /// reads text as a whole record, false if the reader failed or text goes on after the record
+    bool readRecord(std::string_view text, TestRecord& record)
+    {
+        JsonReader reader(text.data(), text.size());
+        Serializer::read(reader, record);
+        return reader.isValid() && reader.isAtEnd();
+    }
+
+    void deleteRecord(TestRecord& record)
+    {
+        delete record.pivot;
+        record.pivot = nullptr;
+    }
+
+    bool isPointEqual(const TestPoint& lhs, const TestPoint& rhs)
+    {
+        return lhs.x == rhs.x && lhs.y == rhs.y && lhs.name == rhs.name;
+    }
+
+    bool isRecordEqual(const TestRecord& lhs, const TestRecord& rhs)
+    {
+        if (lhs.count != rhs.count || lhs.flags != rhs.flags || lhs.weight != rhs.weight ||
+            lhs.is_active != rhs.is_active || lhs.label != rhs.label || lhs.ids != rhs.ids ||
+            lhs.points.size() != rhs.points.size() || (lhs.pivot == nullptr) != (rhs.pivot == nullptr))
+        {
+            return false;
+        }
+        for (size_t index = 0; index < lhs.points.size(); ++index)
+        {
+            if (!isPointEqual(lhs.points[index], rhs.points[index]))
+                return false;
+        }
+        return lhs.pivot == nullptr || isPointEqual(*lhs.pivot, *rhs.pivot);
+    }
+
+    /// the string value of a json string literal, or "<invalid>" when the reader fails on it
+    std::string readStringLiteral(std::string_view text)
+    {
+        JsonReader  reader(text.data(), text.size());
+        std::string value;
+        if (!reader.readString(value) || !reader.isValid() || !reader.isAtEnd())
+        {
+            return "<invalid>";
+        }
+        return value;
+    }
+
+    /// builds the tree of the value at the front of text with the reader alone, every value is cut out with
+    /// skipValueText and read again by a reader of its own, which also takes skipValueText through every value
+    Json readTree(std::string_view text, bool& is_valid)
+    {
+        JsonReader reader(text.data(), text.size());
+        Json       tree;
+        switch (text.empty() ? '\0' : text.front())
+        {
+            case '{': {
+                Json::object     members;
+                std::string_view key;
+                reader.beginObject();
+                while (reader.nextKey(key))
+                {
+                    // the key is only valid until the reader moves on
+                    const std::string key_copy(key);
+                    members[key_copy] = readTree(reader.skipValueText(), is_valid);
+                }
+                tree = members;
+                break;
+            }
+            case '[': {
+                Json::array elements;
+                reader.beginArray();
+                while (reader.nextElement())
+                {
+                    elements.push_back(readTree(reader.skipValueText(), is_valid));
+                }
+                tree = elements;
+                break;
+            }
+            case '"': {
+                std::string value;
+                reader.readString(value);
+                tree = value;
+                break;
+            }
+            case 't':
+            case 'f': {
+                bool value = false;
+                reader.readBool(value);
+                tree = value;
+                break;
+            }
+            case 'n':
+                reader.readNull();
+                break;
+            default: {
+                double value = 0.0;
+                reader.readNumber(value);
+                tree = value;
+                break;
+            }
+        }
+        is_valid &= reader.isValid() && reader.isAtEnd();
+        return tree;
+    }
+
+    void testEscapes()
+    {
+        PICCOLO_CHECK(readStringLiteral(R"("plain")") == "plain");
+        PICCOLO_CHECK(readStringLiteral(R"("")") == "");
+        PICCOLO_CHECK(readStringLiteral(R"("\"\\\/\b\f\n\r\t")") == "\"\\/\b\f\n\r\t");
+        PICCOLO_CHECK(readStringLiteral(R"("a\u0041b")") == "aAb");
+        PICCOLO_CHECK(readStringLiteral(R"("\u00e9\u00E9")") == "\xc3\xa9\xc3\xa9");
+        PICCOLO_CHECK(readStringLiteral(R"("\u4e2d")") == "\xe4\xb8\xad");
+        // a surrogate pair is one code point above the basic plane
+        PICCOLO_CHECK(readStringLiteral(R"("\ud83d\ude00")") == "\xf0\x9f\x98\x80");
+
+        // the reader agrees with json11 on every escape, a lone surrogate included
+        for (const char* literal : {R"("\ud83d")", R"("\ud83dx")", R"("\ud83dA")", R"("\u0000")"})
+        {
+            std::string error;
+            const Json  tree = Json::parse(literal, error);
+            PICCOLO_CHECK(error.empty());
+            PICCOLO_CHECK(readStringLiteral(literal) == tree.string_value());
+        }
+
+        for (const char* literal :
+             {R"("\x")", R"("\u12G4")", R"("\u12")", "\"tab\tinside\"", R"("open)", R"("escape at the end\)"})
+        {
+            PICCOLO_CHECK(readStringLiteral(literal) == "<invalid>");
+        }
+
+        // a key with escapes leaves the fast path that views keys in place
+        const std::string_view text = R"({"count": 3, "l\"abel": "x", "label": "y"})";
+        TestRecord             record;
+        PICCOLO_CHECK(readRecord(text, record));
+        PICCOLO_CHECK(record.count == 3);
+        PICCOLO_CHECK(record.label == "y");
+    }
+
+    void testPointerKeyOrder()
+    {
+        const std::string_view type_name_first = R"({"$typeName": "*", "$context": {"x": 1, "name": "first"}})";
+        const std::string_view context_first   = R"({"$context": {"x": 2, "name": "second"}, "$typeName": "*"})";
+        const std::string_view extra_keys      = R"({"$extra": [{"$typeName": 2}], "$context": {}, "$typeName": "*"})";
+
+        for (std::string_view text : {type_name_first, context_first, extra_keys})
+        {
+            JsonReader  reader(text.data(), text.size());
+            TestPoint*  point = nullptr;
+            std::string type_name;
+            Serializer::readPointer(reader, point, type_name);
+            PICCOLO_CHECK(reader.isValid() && reader.isAtEnd());
+            PICCOLO_CHECK(type_name == "*");
+            PICCOLO_CHECK(point != nullptr);
+            if (point == nullptr)
+                continue;
+
+            // the tree read of the same text gives the same point
+            std::string error;
+            TestPoint*  tree_point = nullptr;
+            Serializer::read(Json::parse(std::string(text), error), tree_point);
+            PICCOLO_CHECK(tree_point != nullptr && isPointEqual(*point, *tree_point));
+            delete point;
+            delete tree_point;
+        }
+
+        // without a type name nothing is created, and the context is still consumed
+        const std::string_view no_type_name = R"({"$context": {"x": 1}} )";
+        JsonReader             reader(no_type_name.data(), no_type_name.size());
+        TestPoint*             point = nullptr;
+        Serializer::readPointer(reader, point);
+        PICCOLO_CHECK(point == nullptr);
+        PICCOLO_CHECK(reader.isValid() && reader.isAtEnd());
+    }
+
+    void testSkippedValues()
+    {
+        // unknown members of every kind are skipped, strings holding brackets included
+        const std::string_view unknown_keys = R"({
+            "unknown_object": {"nested": [1, 2, {"a": "}]"}], "b": null},
+            "count": 5,
+            "unknown_array": [[], {}, "[", true, false, null, -0.5e-3],
+            "unknown_string": "\"}",
+            "label": "kept",
+            "unknown_literal": false
+        })";
+        TestRecord record;
+        PICCOLO_CHECK(readRecord(unknown_keys, record));
+        PICCOLO_CHECK(record.count == 5);
+        PICCOLO_CHECK(record.label == "kept");
+
+        // a value of another type is skipped and leaves the member as it was, the members after it are still read
+        const std::string_view mismatched = R"({
+            "count": "seven",
+            "flags": [1],
+            "weight": {"value": 2},
+            "is_active": 1,
+            "label": 12,
+            "ids": {"0": 1},
+            "points": [{"x": 1}, 5, "point", {"x": 2}],
+            "pivot": "pivot",
+            "label": null,
+            "is_active": "true"
+        })";
+        TestRecord expected;
+        expected.count     = 1;
+        expected.flags     = 2;
+        expected.weight    = 3.0;
+        expected.is_active = true;
+        expected.label     = "before";
+        expected.ids       = {9};
+
+        TestRecord mismatched_record = expected;
+        PICCOLO_CHECK(readRecord(mismatched, mismatched_record));
+        PICCOLO_CHECK(mismatched_record.count == expected.count);
+        PICCOLO_CHECK(mismatched_record.flags == expected.flags);
+        PICCOLO_CHECK(mismatched_record.weight == expected.weight);
+        PICCOLO_CHECK(mismatched_record.is_active == expected.is_active);
+        PICCOLO_CHECK(mismatched_record.label == expected.label);
+        PICCOLO_CHECK(mismatched_record.ids == expected.ids);
+        PICCOLO_CHECK(mismatched_record.pivot == nullptr);
+        // elements of another type are default points, like in the tree read
+        PICCOLO_CHECK(mismatched_record.points.size() == 4);
+        if (mismatched_record.points.size() == 4)
+        {
+            PICCOLO_CHECK(mismatched_record.points[0].x == 1.f);
+            PICCOLO_CHECK(mismatched_record.points[1].x == 0.f);
+            PICCOLO_CHECK(mismatched_record.points[2].x == 0.f);
+            PICCOLO_CHECK(mismatched_record.points[3].x == 2.f);
+        }
+
+        // so is a whole document of another type
+        TestRecord array_record;
+        PICCOLO_CHECK(readRecord(R"([{"count": 1}])", array_record));
+        PICCOLO_CHECK(array_record.count == 0);
+    }
+
+    void testMalformedInput()
+    {
+        // every prefix of a valid record misses at least its closing brace
+        const std::string_view text = k_record_text;
+        for (size_t size = 0; size < text.size(); ++size)
+        {
+            TestRecord record;
+            PICCOLO_CHECK(!readRecord(text.substr(0, size), record));
+            deleteRecord(record);
+        }
+
+        const char* const malformed_texts[] = {
+            R"({"count" 1})",
+            R"({"count": 1,})",
+            R"({"count": 1,, "flags": 2})",
+            R"({"count": 1 "flags": 2})",
+            R"({count: 1})",
+            R"({"count": tru})",
+            R"({"count": nul})",
+            R"({"count": -})",
+            R"({"count": 1.})",
+            R"({"count": 1e})",
+            R"({"count": 1e+})",
+            R"({"count": .5})",
+            R"({"ids": [1 2]})",
+            R"({"ids": [1, 2})",
+            R"({"points": [{"x": 1}, {"x": ]})",
+            R"({"label": "unterminated})",
+            R"({"label": "\q"})",
+            R"({"unknown": [1, {"a": 2])",
+            R"({"count": 1}})",
+            R"({"count": 1} trailing)",
+        };
+        for (const char* malformed_text : malformed_texts)
+        {
+            TestRecord record;
+            const bool is_read = readRecord(malformed_text, record);
+            if (is_read)
+            {
+                std::fprintf(stderr, "malformed text read: %s\n", malformed_text);
+            }
+            PICCOLO_CHECK(!is_read);
+            deleteRecord(record);
+        }
+
+        // once failed, the reader stays at the end and reads nothing more
+        const std::string_view failed_text = R"({"count" 1, "flags": 2})";
+        JsonReader             reader(failed_text.data(), failed_text.size());
+        std::string_view       key;
+        PICCOLO_CHECK(reader.beginObject());
+        PICCOLO_CHECK(!reader.nextKey(key));
+        PICCOLO_CHECK(!reader.isValid());
+        PICCOLO_CHECK(!reader.nextKey(key));
+        double number = 0.0;
+        PICCOLO_CHECK(!reader.readNumber(number));
+        PICCOLO_CHECK(reader.isAtEnd());
+    }
+
+    void testRoundTrip()
+    {
+        // the record read straight from the text equals the one read from the json11 tree
+        std::string error;
+        const Json  tree = Json::parse(k_record_text, error);
+        PICCOLO_CHECK(error.empty());
+
+        TestRecord tree_record;
+        Serializer::read(tree, tree_record);
+        TestRecord stream_record;
+        PICCOLO_CHECK(readRecord(k_record_text, stream_record));
+        PICCOLO_CHECK(isRecordEqual(tree_record, stream_record));
+        PICCOLO_CHECK(stream_record.flags == 4294967295u);
+        PICCOLO_CHECK(stream_record.weight == -125.0);
+        PICCOLO_CHECK(stream_record.points.size() == 2);
+        PICCOLO_CHECK(stream_record.pivot != nullptr && stream_record.pivot->name == "pivot");
+        deleteRecord(tree_record);
+        deleteRecord(stream_record);
+
+        // so is the record read from the compact dump of the tree, which sorts the keys
+        TestRecord dump_record;
+        PICCOLO_CHECK(readRecord(tree.dump(), dump_record));
+        TestRecord expected_record;
+        Serializer::read(tree, expected_record);
+        PICCOLO_CHECK(isRecordEqual(expected_record, dump_record));
+        deleteRecord(dump_record);
+        deleteRecord(expected_record);
+
+        // every json asset of the engine reads into the same tree both ways
+        const std::filesystem::path asset_folder = Test::getEngineRootFolder() / "asset";
+        int                         asset_count  = 0;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(asset_folder))
+        {
+            if (!entry.is_regular_file() || entry.path().extension() != ".json")
+                continue;
+
+            std::ifstream     asset_file(entry.path(), std::ios::binary);
+            const std::string asset_text {std::istreambuf_iterator<char>(asset_file), std::istreambuf_iterator<char>()};
+            const size_t      value_begin = asset_text.find_first_not_of(" \t\r\n");
+            const size_t      value_end   = asset_text.find_last_not_of(" \t\r\n");
+            if (value_begin == std::string::npos)
+                continue;
+
+            bool       is_valid    = true;
+            const Json stream_tree = readTree(
+                std::string_view(asset_text).substr(value_begin, value_end + 1 - value_begin), is_valid);
+            const Json asset_tree = Json::parse(asset_text, error);
+            PICCOLO_CHECK(error.empty());
+            PICCOLO_CHECK(is_valid);
+            if (stream_tree != asset_tree)
+            {
+                std::fprintf(stderr, "%s reads into another tree\n", entry.path().generic_string().c_str());
+                PICCOLO_CHECK(stream_tree == asset_tree);
+            }
+            ++asset_count;
+        }
+        PICCOLO_CHECK(asset_count > 0);
+    }
+} // namespace
+
+int main()
+{
+    testEscapes();
+    testPointerKeyOrder();
+    testSkippedValues();
+    testMalformedInput();
+    testRoundTrip();
+    return Test::finish();
+}
+
@@ -0,0 +1,108 @@
+#include "test_utilities.h"
+
+#include "runtime/core/meta/json.h"
+#include "runtime/core/meta/serializer/json_writer.h"
+
+#include <sstream>
+#include <string>
+
+using namespace Piccolo;
+
+namespace
+{
+    /// a pointer the way the serializer writes it, type name first
+    void writePointer(JsonWriter& writer, int value)
+    {
+        writer.beginObject();
+        writer.writeKey("$typeName");
+        writer.writeString("Transform");
+        writer.writeKey("$context");
+        writer.beginObject();
+        writer.writeKey("scale");
+        writer.writeInt(value);
+        writer.writeKey("position");
+        writer.beginArray();
+        writer.writeFloat(0.1f);
+        writer.writeInt(value);
+        writer.endArray();
+        writer.writeKey("is_active");
+        writer.writeBool(true);
+        writer.endObject();
+        writer.endObject();
+    }
+
+    Json makePointerJson(int value)
+    {
+        Json::object context {{"scale", value}, {"position", Json::array {0.1f, value}}, {"is_active", true}};
+        return Json::object {{"$typeName", "Transform"}, {"$context", context}};
+    }
+
+    std::string writeDocument(bool is_pretty, int element_count)
+    {
+        std::ostringstream stream;
+        {
+            JsonWriter writer(stream, is_pretty);
+            writer.beginObject();
+            writer.writeKey("name");
+            writer.writeString("level");
+            writer.writeKey("objects");
+            writer.beginArray();
+            for (int element = 0; element < element_count; ++element)
+            {
+                writePointer(writer, element);
+            }
+            writer.endArray();
+            // a prefix sorts before the longer key, a repeated key keeps the last value like insert_or_assign
+            writer.writeKey("name_suffix");
+            writer.writeNull();
+            writer.writeKey("b");
+            writer.writeInt(1);
+            writer.writeKey("b");
+            writer.writeInt(2);
+            writer.writeKey("empty");
+            writer.beginObject();
+            writer.endObject();
+            writer.endObject();
+        }
+        return stream.str();
+    }
+
+    Json makeDocumentJson(int element_count)
+    {
+        Json::array objects;
+        for (int element = 0; element < element_count; ++element)
+        {
+            objects.push_back(makePointerJson(element));
+        }
+        return Json::object {{"name", "level"},
+                             {"objects", objects},
+                             {"name_suffix", nullptr},
+                             {"b", 2},
+                             {"empty", Json::object {}}};
+    }
+} // namespace
+
+int main()
+{
+    // the compact text is the dump of the tree, whatever order the members were written in
+    for (int element_count : {0, 1, 3, 5000})
+    {
+        const std::string text = writeDocument(false, element_count);
+        PICCOLO_CHECK(text == makeDocumentJson(element_count).dump());
+    }
+
+    // the pretty text holds the same document with the members in the same order
+    {
+        const std::string text = writeDocument(true, 2);
+        std::string       error;
+        Json              document = Json::parse(text, error);
+        PICCOLO_CHECK(error.empty());
+        PICCOLO_CHECK(document == makeDocumentJson(2));
+        PICCOLO_CHECK(text.find("\"$context\"") < text.find("\"$typeName\""));
+        PICCOLO_CHECK(text.find("\"b\"") < text.find("\"empty\""));
+        PICCOLO_CHECK(text.find("\"name\"") < text.find("\"name_suffix\""));
+        PICCOLO_CHECK(text.find("\"is_active\"") < text.find("\"position\""));
+    }
+
+    return Test::finish();
+}
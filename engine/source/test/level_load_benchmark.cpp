@@ -0,0 +1,154 @@
+#include "test_utilities.h"
+
+#include "runtime/core/log/log_system.h"
+#include "runtime/core/meta/reflection/reflection_register.h"
+
+#include "runtime/resource/asset_manager/asset_manager.h"
+#include "runtime/resource/config_manager/config_manager.h"
+#include "runtime/resource/res_type/common/level.h"
+#include "runtime/resource/res_type/common/object.h"
+
+#include "runtime/function/framework/component/component.h"
+#include "runtime/function/global/global_context.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using namespace Piccolo;
+
+namespace
+{
+    constexpr int k_load_count = 50;
+
+    const char* const k_level_url = "asset/level/1-1.level.json";
+
+    void deleteComponents(std::vector<Reflection::ReflectionPtr<Component>>& components)
+    {
+        for (auto& component : components)
+        {
+            PICCOLO_REFLECTION_DELETE(component);
+        }
+        components.clear();
+    }
+
+    /// copies the asset from the engine into the benchmark folder, so cooking it leaves the engine tree alone
+    bool copyAsset(const std::filesystem::path& root_folder, const std::string& asset_url)
+    {
+        const std::filesystem::path target_path = root_folder / asset_url;
+        std::filesystem::create_directories(target_path.parent_path());
+
+        std::error_code error;
+        std::filesystem::copy_file(Test::getEngineRootFolder() / asset_url,
+                                   target_path,
+                                   std::filesystem::copy_options::overwrite_existing,
+                                   error);
+        return !error;
+    }
+
+    /// the assets a load of the level parses: the level itself and every object definition it references once,
+    /// the way the ObjectDefinitionCache loads them
+    template<typename TLoad>
+    bool loadLevelAssets(const std::vector<std::string>& definition_urls, TLoad&& load)
+    {
+        LevelRes level_res;
+        bool     is_load_success = load(k_level_url, level_res);
+        for (ObjectInstanceRes& object_instance_res : level_res.m_objects)
+        {
+            deleteComponents(object_instance_res.m_instanced_components);
+        }
+
+        for (const std::string& definition_url : definition_urls)
+        {
+            ObjectDefinitionRes definition_res;
+            is_load_success &= load(definition_url, definition_res);
+            deleteComponents(definition_res.m_components);
+        }
+        return is_load_success;
+    }
+} // namespace
+
+// level 1-1 and its object definitions loaded from their json sources and from their cooked files. only the
+// resources are read, no objects are created from them
+int main()
+{
+    Reflection::TypeMetaRegister::metaRegister();
+
+    const std::filesystem::path root_folder = std::filesystem::temp_directory_path() / "piccolo_level_load_benchmark";
+    std::filesystem::remove_all(root_folder);
+    std::filesystem::create_directories(root_folder);
+    std::ofstream(root_folder / "benchmark.ini") << "BinaryRootFolder=.\nAssetFolder=asset\n";
+
+    g_runtime_global_context.m_logger_system  = std::make_shared<LogSystem>();
+    g_runtime_global_context.m_config_manager = std::make_shared<ConfigManager>();
+    g_runtime_global_context.m_config_manager->initialize(root_folder / "benchmark.ini");
+    g_runtime_global_context.m_asset_manager = std::make_shared<AssetManager>();
+
+    AssetManager& asset_manager = *g_runtime_global_context.m_asset_manager;
+
+    // the level and its definitions are copied and cooked first
+    std::vector<std::string> definition_urls;
+    bool                     is_cook_success = copyAsset(root_folder, k_level_url);
+    {
+        LevelRes level_res;
+        is_cook_success = is_cook_success && asset_manager.loadJsonAsset(k_level_url, level_res);
+
+        std::unordered_set<std::string> unique_definition_urls;
+        for (ObjectInstanceRes& object_instance_res : level_res.m_objects)
+        {
+            deleteComponents(object_instance_res.m_instanced_components);
+            if (!object_instance_res.m_definition.empty() &&
+                unique_definition_urls.insert(object_instance_res.m_definition).second)
+            {
+                definition_urls.push_back(object_instance_res.m_definition);
+            }
+        }
+    }
+    is_cook_success = is_cook_success && asset_manager.cookAsset<LevelRes>(k_level_url);
+    for (const std::string& definition_url : definition_urls)
+    {
+        is_cook_success = is_cook_success && copyAsset(root_folder, definition_url) &&
+                          asset_manager.cookAsset<ObjectDefinitionRes>(definition_url);
+    }
+    if (!is_cook_success)
+    {
+        std::fprintf(stderr, "cooking %s and its object definitions failed\n", k_level_url);
+        return EXIT_FAILURE;
+    }
+
+    bool   is_json_success   = true;
+    double json_milliseconds = Test::measureMilliseconds(k_load_count, [&]() {
+        is_json_success &= loadLevelAssets(definition_urls, [&](const std::string& asset_url, auto& out_asset) {
+            return asset_manager.loadJsonAsset(asset_url, out_asset);
+        });
+    });
+
+    bool   is_cooked_success   = true;
+    double cooked_milliseconds = Test::measureMilliseconds(k_load_count, [&]() {
+        is_cooked_success &= loadLevelAssets(definition_urls, [&](const std::string& asset_url, auto& out_asset) {
+            return asset_manager.loadCookedAsset(asset_url, out_asset);
+        });
+    });
+
+    if (!is_json_success || !is_cooked_success)
+    {
+        std::fprintf(stderr, "loading the %s files failed\n", is_json_success ? "cooked" : "json");
+        return EXIT_FAILURE;
+    }
+
+    std::printf("%s and %zu object definitions: json %.3f ms, cooked %.3f ms, %.1fx\n",
+                k_level_url,
+                definition_urls.size(),
+                json_milliseconds,
+                cooked_milliseconds,
+                json_milliseconds / cooked_milliseconds);
+
+    std::filesystem::remove_all(root_folder);
+
+    Reflection::TypeMetaRegister::metaUnregister();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,76 @@
+#include "test_utilities.h"
+
+#include "runtime/core/log/log_system.h"
+#include "runtime/core/meta/reflection/reflection_register.h"
+
+#include "runtime/function/framework/component/lua/lua_component.h"
+#include "runtime/function/framework/component/transform/transform_component.h"
+#include "runtime/function/framework/object/object.h"
+#include "runtime/function/global/global_context.h"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+
+using namespace Piccolo;
+
+namespace
+{
+    constexpr int k_access_count = 1000000;
+
+    /// the lua loop around one binding call with the arguments of get_float/set_float, timed in ns per call
+    double measureScript(sol::state& lua_state, const std::string& loop_body)
+    {
+        sol::protected_function script =
+            lua_state.load("for i = 1, " + std::to_string(k_access_count) + " do " + loop_body + " end");
+        double milliseconds = Test::measureMilliseconds(1, [&]() { script(); });
+        return milliseconds * 1e6 / k_access_count;
+    }
+} // namespace
+
+// a million scripted reads and a million scripted writes of a nested float field through get_float/set_float,
+// next to the same loop calling a binding that does nothing, which is the cost of lua and sol alone
+int main()
+{
+    Reflection::TypeMetaRegister::metaRegister();
+    g_runtime_global_context.m_logger_system = std::make_shared<LogSystem>();
+
+    ObjectInstanceRes object_instance_res;
+    object_instance_res.m_name = "benchmark";
+    object_instance_res.m_instanced_components.emplace_back("TransformComponent", new TransformComponent());
+
+    std::shared_ptr<GObject> object = std::make_shared<GObject>(0);
+    if (!object->load(object_instance_res, std::make_shared<const ObjectDefinitionRes>()))
+    {
+        std::fprintf(stderr, "loading the object failed\n");
+        return EXIT_FAILURE;
+    }
+
+    sol::state lua_state;
+    LuaComponent::openLibraries(lua_state);
+    lua_state["GameObject"] = std::weak_ptr<GObject>(object);
+    lua_state.set_function("pass_float", [](std::weak_ptr<GObject>, const char*, float value) { return value; });
+
+    const std::string field_path = "\"TransformComponent.m_transform.m_position.x\"";
+
+    const double binding_nanoseconds = measureScript(lua_state, "pass_float(GameObject, " + field_path + ", i)");
+    const double set_nanoseconds     = measureScript(lua_state, "set_float(GameObject, " + field_path + ", i)");
+    const double get_nanoseconds     = measureScript(lua_state, "local x = get_float(GameObject, " + field_path + ")");
+
+    if (LuaComponent::get<float>(object, "TransformComponent.m_transform.m_position.x") !=
+        static_cast<float>(k_access_count))
+    {
+        std::fprintf(stderr, "set_float did not write the field\n");
+        return EXIT_FAILURE;
+    }
+
+    std::printf("%d accesses: empty binding %.1f ns, set_float %.1f ns, get_float %.1f ns per call\n",
+                k_access_count,
+                binding_nanoseconds,
+                set_nanoseconds,
+                get_nanoseconds);
+
+    object.reset();
+    Reflection::TypeMetaRegister::metaUnregister();
+    return EXIT_SUCCESS;
+}
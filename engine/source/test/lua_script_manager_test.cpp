@@ -0,0 +1,143 @@
+#include "test_utilities.h"
+
+#include "runtime/function/framework/component/lua/lua_script_manager.h"
+
+#include <string>
+#include <vector>
+
+using namespace Piccolo;
+
+namespace
+{
+    constexpr int k_script_count = 5;
+
+    /// every script is its own chunk, takes far longer than the budget and counts its runs in a global
+    std::vector<sol::protected_function> loadSlowScripts(LuaScriptManager& script_manager, sol::state& lua_state)
+    {
+        std::vector<sol::protected_function> functions;
+        for (int script_index = 0; script_index < k_script_count; ++script_index)
+        {
+            const std::string counter = "run_count_" + std::to_string(script_index);
+            const std::string script  = "local sum = 0 for i = 1, 300000 do sum = sum + i end " + counter + " = (" +
+                                       counter + " or 0) + 1";
+            uint32_t script_id = script_manager.compileScript(script);
+            PICCOLO_CHECK(script_id == static_cast<uint32_t>(script_index));
+            functions.push_back(script_manager.loadScript(lua_state, script_id));
+        }
+        return functions;
+    }
+
+    int getRunCount(sol::state& lua_state, int script_index)
+    {
+        return lua_state.get_or("run_count_" + std::to_string(script_index), 0);
+    }
+
+    /// one frame in which the scripts tick in index order, returns the index of the only script that ran
+    int runFrame(LuaScriptManager&                           script_manager,
+                 sol::state&                                 lua_state,
+                 const std::vector<sol::protected_function>& functions)
+    {
+        std::vector<int> run_counts;
+        for (int script_index = 0; script_index < k_script_count; ++script_index)
+        {
+            run_counts.push_back(getRunCount(lua_state, script_index));
+        }
+
+        script_manager.tick();
+        for (int script_index = 0; script_index < k_script_count; ++script_index)
+        {
+            script_manager.runScript(&functions[script_index], script_index, functions[script_index]);
+        }
+        script_manager.finishFrame();
+
+        int ran_script_index = -1;
+        int ran_count        = 0;
+        for (int script_index = 0; script_index < k_script_count; ++script_index)
+        {
+            if (getRunCount(lua_state, script_index) != run_counts[script_index])
+            {
+                ran_script_index = script_index;
+                ++ran_count;
+            }
+        }
+        PICCOLO_CHECK(ran_count == 1);
+        return ran_script_index;
+    }
+} // namespace
+
+int main()
+{
+    // without a budget every script runs every frame in tick order
+    {
+        LuaScriptManager script_manager;
+        script_manager.initialize(false, 0.f);
+        sol::state lua_state;
+        lua_state.open_libraries(sol::lib::base);
+        std::vector<sol::protected_function> functions = loadSlowScripts(script_manager, lua_state);
+
+        for (int frame = 0; frame < 3; ++frame)
+        {
+            script_manager.tick();
+            for (int script_index = 0; script_index < k_script_count; ++script_index)
+            {
+                PICCOLO_CHECK(script_manager.runScript(nullptr, script_index, functions[script_index]));
+            }
+            script_manager.finishFrame();
+        }
+        for (int script_index = 0; script_index < k_script_count; ++script_index)
+        {
+            PICCOLO_CHECK(getRunCount(lua_state, script_index) == 3);
+        }
+    }
+
+    // a budget only one script fits in, the first script of the frame rotates through all of them
+    {
+        LuaScriptManager script_manager;
+        script_manager.initialize(false, 0.001f);
+        sol::state lua_state;
+        lua_state.open_libraries(sol::lib::base);
+        std::vector<sol::protected_function> functions = loadSlowScripts(script_manager, lua_state);
+
+        for (int frame = 0; frame < 2 * k_script_count; ++frame)
+        {
+            PICCOLO_CHECK(runFrame(script_manager, lua_state, functions) == frame % k_script_count);
+        }
+        for (int script_index = 0; script_index < k_script_count; ++script_index)
+        {
+            PICCOLO_CHECK(getRunCount(lua_state, script_index) == 2);
+        }
+    }
+
+    // a wrapped run of a destroyed owner is dropped
+    {
+        LuaScriptManager script_manager;
+        script_manager.initialize(false, 0.001f);
+        sol::state lua_state;
+        lua_state.open_libraries(sol::lib::base);
+        std::vector<sol::protected_function> functions = loadSlowScripts(script_manager, lua_state);
+
+        // script 0 runs and defers the others, the next frame starts at script 1
+        script_manager.tick();
+        for (int script_index = 0; script_index < k_script_count; ++script_index)
+        {
+            script_manager.runScript(&functions[script_index], script_index, functions[script_index]);
+        }
+        script_manager.finishFrame();
+
+        // script 0 wraps around and would be deferred behind script 1, cancelled it neither runs nor counts as
+        // deferred
+        script_manager.tick();
+        for (int script_index = 0; script_index < k_script_count; ++script_index)
+        {
+            script_manager.runScript(&functions[script_index], script_index, functions[script_index]);
+        }
+        script_manager.cancelRuns(&functions[0]);
+        script_manager.finishFrame();
+        script_manager.tick();
+        PICCOLO_CHECK(script_manager.getLastFrameProfiles()[0].m_deferred_count == 0);
+        PICCOLO_CHECK(script_manager.getLastFrameProfiles()[1].m_run_count == 1);
+        PICCOLO_CHECK(getRunCount(lua_state, 0) == 1);
+    }
+
+    return Test::finish();
+}
@@ -0,0 +1,148 @@
+#include "test_utilities.h"
+
+#include "runtime/core/log/log_system.h"
+#include "runtime/core/meta/reflection/reflection_register.h"
+
+#include "runtime/resource/asset_manager/asset_manager.h"
+#include "runtime/resource/config_manager/config_manager.h"
+
+#include "runtime/function/framework/component/component.h"
+#include "runtime/function/framework/object/object_definition_cache.h"
+#include "runtime/function/global/global_context.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Piccolo;
+
+namespace
+{
+    constexpr int k_definition_count = 10;
+    constexpr int k_instance_count   = 5000;
+    constexpr int k_shape_count      = 8;
+
+    /// a transform and a rigid body of a few boxes, about the size of the definitions under asset/objects
+    std::string makeDefinitionJson(int definition_index)
+    {
+        std::string shapes;
+        for (int shape_index = 0; shape_index < k_shape_count; ++shape_index)
+        {
+            const std::string offset = std::to_string(shape_index + definition_index);
+            shapes += std::string(shape_index == 0 ? "" : ",") +
+                      "{\"geometry\": {\"$typeName\": \"Box\", \"$context\": {\"half_extents\": {\"x\": 1, \"y\": 2, "
+                      "\"z\": 0.5}}}, \"local_transform\": {\"position\": {\"x\": " +
+                      offset + ", \"y\": 0, \"z\": 0.5}, \"rotation\": {\"w\": 1, \"x\": 0, \"y\": 0, \"z\": 0}, "
+                               "\"scale\": {\"x\": 1, \"y\": 1, \"z\": 1}}}";
+        }
+
+        return "{\"components\": ["
+               "{\"$typeName\": \"TransformComponent\", \"$context\": {\"transform\": {\"position\": {\"x\": 0, \"y\": "
+               "0, \"z\": 0}, \"rotation\": {\"w\": 1, \"x\": 0, \"y\": 0, \"z\": 0}, \"scale\": {\"x\": 1, \"y\": 1, "
+               "\"z\": 1}}}},"
+               "{\"$typeName\": \"RigidBodyComponent\", \"$context\": {\"rigidbody_res\": {\"actor_type\": 1, "
+               "\"inverse_mass\": 0, \"shapes\": [" +
+               shapes + "]}}}]}";
+    }
+
+    void deleteComponents(std::vector<Reflection::ReflectionPtr<Component>>& components)
+    {
+        for (auto& component : components)
+        {
+            PICCOLO_REFLECTION_DELETE(component);
+        }
+        components.clear();
+    }
+} // namespace
+
+// a level of many objects made from a few definitions, once parsing the definition for every object the way objects
+// loaded before the cache, once acquiring it from the ObjectDefinitionCache and cloning its prototype components
+int main()
+{
+    Reflection::TypeMetaRegister::metaRegister();
+
+    const std::filesystem::path root_folder =
+        std::filesystem::temp_directory_path() / "piccolo_object_definition_cache_benchmark";
+    std::filesystem::create_directories(root_folder / "asset");
+    std::ofstream(root_folder / "benchmark.ini") << "BinaryRootFolder=.\nAssetFolder=asset\n";
+
+    std::vector<std::string> definition_urls;
+    for (int definition_index = 0; definition_index < k_definition_count; ++definition_index)
+    {
+        definition_urls.push_back("asset/definition_" + std::to_string(definition_index) + ".object.json");
+        std::ofstream(root_folder / definition_urls.back()) << makeDefinitionJson(definition_index);
+    }
+
+    g_runtime_global_context.m_logger_system  = std::make_shared<LogSystem>();
+    g_runtime_global_context.m_config_manager = std::make_shared<ConfigManager>();
+    g_runtime_global_context.m_config_manager->initialize(root_folder / "benchmark.ini");
+    g_runtime_global_context.m_asset_manager           = std::make_shared<AssetManager>();
+    g_runtime_global_context.m_object_definition_cache = std::make_shared<ObjectDefinitionCache>();
+
+    AssetManager&          asset_manager    = *g_runtime_global_context.m_asset_manager;
+    ObjectDefinitionCache& definition_cache = *g_runtime_global_context.m_object_definition_cache;
+
+    size_t parsed_component_count = 0;
+    double parse_milliseconds     = Test::measureMilliseconds(1, [&]() {
+        parsed_component_count = 0;
+        for (int instance_index = 0; instance_index < k_instance_count; ++instance_index)
+        {
+            ObjectDefinitionRes definition_res;
+            asset_manager.loadAsset(definition_urls[instance_index % k_definition_count], definition_res);
+            parsed_component_count += definition_res.m_components.size();
+            deleteComponents(definition_res.m_components);
+        }
+    });
+
+    // every load of a level starts from an empty cache, the way purgeUnused leaves it after the last level
+    size_t cloned_component_count = 0;
+    double cache_milliseconds     = Test::measureMilliseconds(1, [&]() {
+        definition_cache.clear();
+        cloned_component_count = 0;
+
+        std::vector<std::shared_ptr<const ObjectDefinitionRes>> object_definitions;
+        std::vector<Reflection::ReflectionPtr<Component>>       object_components;
+        for (int instance_index = 0; instance_index < k_instance_count; ++instance_index)
+        {
+            const std::string& definition_url = definition_urls[instance_index % k_definition_count];
+            object_definitions.push_back(definition_cache.acquire(definition_url));
+            if (!object_definitions.back())
+                continue;
+
+            for (const auto& prototype_component : object_definitions.back()->m_components)
+            {
+                const std::string type_name = prototype_component.getTypeName();
+                object_components.emplace_back(
+                    type_name,
+                    static_cast<Component*>(
+                        Reflection::TypeMeta::cloneByName(type_name, prototype_component.getPtr()).m_instance));
+            }
+        }
+        cloned_component_count = object_components.size();
+        deleteComponents(object_components);
+    });
+
+    std::filesystem::remove_all(root_folder);
+
+    if (parsed_component_count != cloned_component_count || parsed_component_count == 0)
+    {
+        std::fprintf(stderr,
+                     "parsing made %zu components, the cache %zu\n",
+                     parsed_component_count,
+                     cloned_component_count);
+        return EXIT_FAILURE;
+    }
+
+    std::printf("%d objects of %d definitions: parse per object %.2f ms, cached definitions %.2f ms, %.2fx\n",
+                k_instance_count,
+                k_definition_count,
+                parse_milliseconds,
+                cache_milliseconds,
+                parse_milliseconds / cache_milliseconds);
+
+    Reflection::TypeMetaRegister::metaUnregister();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,142 @@
+#include "test_utilities.h"
+
+#include "runtime/core/log/log_system.h"
+#include "runtime/core/meta/reflection/reflection_register.h"
+
+#include "runtime/resource/asset_manager/asset_manager.h"
+#include "runtime/resource/config_manager/config_manager.h"
+#include "runtime/resource/res_type/common/object.h"
+
+#include "runtime/function/framework/component/component.h"
+#include "runtime/function/framework/level/level.h"
+#include "runtime/function/global/global_context.h"
+#include "runtime/function/job/job_system.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Piccolo;
+
+namespace
+{
+    constexpr int k_character_count = 2000;
+    constexpr int k_tick_count      = 50;
+
+    const char* const k_player_definition_url = "asset/objects/character/player/player.object.json";
+
+    /// a level that is ticked without loading a level file and without a physics scene
+    class BenchmarkLevel : public Level
+    {
+    public:
+        void markLoaded() { m_is_loaded = true; }
+    };
+
+    /// the transform and the animation of the player, without the components that need physics, scripts or a camera
+    std::shared_ptr<const ObjectDefinitionRes> makeCharacterDefinition()
+    {
+        ObjectDefinitionRes player_res;
+        if (!g_runtime_global_context.m_asset_manager->loadAsset(k_player_definition_url, player_res))
+            return nullptr;
+
+        std::shared_ptr<ObjectDefinitionRes> character_res = std::make_shared<ObjectDefinitionRes>();
+        for (auto& component : player_res.m_components)
+        {
+            const std::string type_name = component.getTypeName();
+            if (type_name == "TransformComponent" || type_name == "AnimationComponent")
+            {
+                character_res->m_components.push_back(component);
+            }
+            else
+            {
+                PICCOLO_REFLECTION_DELETE(component);
+            }
+        }
+        return character_res;
+    }
+
+    void deleteDefinitionComponents(const std::shared_ptr<const ObjectDefinitionRes>& definition_res)
+    {
+        for (auto component : definition_res->m_components)
+        {
+            PICCOLO_REFLECTION_DELETE(component);
+        }
+    }
+} // namespace
+
+// a level of 2000 animated characters ticked object by object, with BatchComponentTick off, on job systems of a
+// growing number of workers. the animation stage runs through parallelFor in both tick paths, so it scales with the
+// workers while the serial components tick on the main thread
+int main()
+{
+    Reflection::TypeMetaRegister::metaRegister();
+
+    const std::filesystem::path root_folder =
+        std::filesystem::temp_directory_path() / "piccolo_parallel_tick_scaling_benchmark";
+    std::filesystem::create_directories(root_folder);
+    std::ofstream(root_folder / "benchmark.ini") << "BinaryRootFolder=" << Test::getEngineRootFolder().generic_string()
+                                                 << "\nAssetFolder=asset\nBatchComponentTick=0\n";
+
+    g_runtime_global_context.m_logger_system  = std::make_shared<LogSystem>();
+    g_runtime_global_context.m_config_manager = std::make_shared<ConfigManager>();
+    g_runtime_global_context.m_config_manager->initialize(root_folder / "benchmark.ini");
+    g_runtime_global_context.m_asset_manager = std::make_shared<AssetManager>();
+
+    std::shared_ptr<const ObjectDefinitionRes> character_res = makeCharacterDefinition();
+    if (!character_res || character_res->m_components.size() != 2)
+    {
+        std::fprintf(stderr, "loading the animated character from %s failed\n", k_player_definition_url);
+        return EXIT_FAILURE;
+    }
+
+    std::unique_ptr<BenchmarkLevel> level = std::make_unique<BenchmarkLevel>();
+    for (int character_index = 0; character_index < k_character_count; ++character_index)
+    {
+        ObjectInstanceRes object_instance_res;
+        object_instance_res.m_name = "character_" + std::to_string(character_index);
+        level->createObject(object_instance_res, character_res);
+    }
+    level->markLoaded();
+
+    std::vector<uint32_t> worker_counts = {0};
+    const uint32_t        max_worker_count = std::max(1u, std::thread::hardware_concurrency()) - 1;
+    for (uint32_t worker_count = 1; worker_count < max_worker_count; worker_count *= 2)
+    {
+        worker_counts.push_back(worker_count);
+    }
+    if (max_worker_count > 0)
+    {
+        worker_counts.push_back(max_worker_count);
+    }
+
+    std::printf("%d animated characters ticked object by object\n", k_character_count);
+    std::printf("%8s %12s %8s\n", "workers", "ms/tick", "speedup");
+    double serial_milliseconds = 0.0;
+    for (uint32_t worker_count : worker_counts)
+    {
+        g_runtime_global_context.m_job_system = std::make_shared<JobSystem>();
+        g_runtime_global_context.m_job_system->initialize(worker_count);
+
+        const double milliseconds = Test::measureMilliseconds(k_tick_count, [&]() { level->tick(1.f / 60.f); });
+        if (worker_count == 0)
+        {
+            serial_milliseconds = milliseconds;
+        }
+        std::printf("%8u %12.3f %7.2fx\n", worker_count, milliseconds, serial_milliseconds / milliseconds);
+
+        g_runtime_global_context.m_job_system->clear();
+        g_runtime_global_context.m_job_system.reset();
+    }
+
+    level.reset();
+    deleteDefinitionComponents(character_res);
+    std::filesystem::remove_all(root_folder);
+
+    Reflection::TypeMetaRegister::metaUnregister();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,139 @@
+#include "test_utilities.h"
+
+#include "runtime/function/physics/physics_runtime.h"
+#include "runtime/function/physics/physics_scene.h"
+
+#include "runtime/resource/res_type/components/rigid_body.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <random>
+
+using namespace Piccolo;
+
+namespace
+{
+    constexpr int k_switch_count     = 20;
+    constexpr int k_scene_count      = 2;
+    constexpr int k_body_count       = 200;
+    constexpr int k_ticks_per_switch = 3;
+
+    /// threads of this process, -1 where it can not be read
+    int getThreadCount()
+    {
+#if defined(__linux__)
+        std::error_code error;
+        int             thread_count = 0;
+        for (std::filesystem::directory_iterator task_iter("/proc/self/task", error), end; !error && task_iter != end;
+             task_iter.increment(error))
+        {
+            ++thread_count;
+        }
+        return error ? -1 : thread_count;
+#else
+        return -1;
+#endif
+    }
+
+    /// a level of boxes, a floor and a few dynamic ones falling on it
+    void fillScene(PhysicsScene& physics_scene, std::mt19937& random)
+    {
+        std::uniform_real_distribution<float> position(-50.f, 50.f);
+
+        for (int body_index = 0; body_index < k_body_count; ++body_index)
+        {
+            Box* box            = new Box;
+            box->m_half_extents = body_index == 0 ? Vector3(100.f, 100.f, 0.5f) : Vector3(0.5f, 0.5f, 0.5f);
+
+            RigidBodyComponentRes rigid_body;
+            rigid_body.m_shapes.resize(1);
+            rigid_body.m_shapes[0].m_geometry = Reflection::ReflectionPtr<Geometry>("Box", box);
+            rigid_body.m_shapes[0].m_local_transform =
+                Transform(Vector3::ZERO, Quaternion::IDENTITY, Vector3::UNIT_SCALE);
+            // every fourth box falls, the inverse mass 0 takes its mass from the volume
+            const RigidBodyActorType actor_type =
+                body_index % 4 == 1 ? RigidBodyActorType::dynamic_body : RigidBodyActorType::static_body;
+            rigid_body.m_actor_type = static_cast<int>(actor_type);
+
+            const Vector3 center =
+                body_index == 0 ? Vector3(0.f, 0.f, -0.5f) : Vector3(position(random), position(random), 2.f);
+            physics_scene.createRigidBody(Transform(center, Quaternion::IDENTITY, Vector3::UNIT_SCALE), rigid_body);
+        }
+    }
+
+    /// milliseconds of one level switch, unloading the scenes of the last level and loading and stepping new ones.
+    /// with is_runtime_shared false every scene brings its own runtime, the way scenes were set up before
+    double measureLevelSwitch(bool is_runtime_shared, int& out_peak_thread_count)
+    {
+        PhysicsConfig config;
+        std::mt19937  random(20221017u);
+
+        std::unique_ptr<PhysicsRuntime> shared_runtime;
+        if (is_runtime_shared)
+        {
+            shared_runtime = std::make_unique<PhysicsRuntime>(config);
+        }
+
+        std::unique_ptr<PhysicsRuntime> scene_runtimes[k_scene_count];
+        std::unique_ptr<PhysicsScene>   scenes[k_scene_count];
+
+        out_peak_thread_count = getThreadCount();
+        double milliseconds   = Test::measureMilliseconds(k_switch_count, [&]() {
+            for (int scene_index = 0; scene_index < k_scene_count; ++scene_index)
+            {
+                scenes[scene_index].reset();
+                scene_runtimes[scene_index].reset();
+            }
+
+            for (int scene_index = 0; scene_index < k_scene_count; ++scene_index)
+            {
+                if (!is_runtime_shared)
+                {
+                    scene_runtimes[scene_index] = std::make_unique<PhysicsRuntime>(config);
+                }
+                PhysicsRuntime& runtime = is_runtime_shared ? *shared_runtime : *scene_runtimes[scene_index];
+
+                scenes[scene_index] = std::make_unique<PhysicsScene>(runtime, config.m_gravity, config);
+                fillScene(*scenes[scene_index], random);
+            }
+            out_peak_thread_count = std::max(out_peak_thread_count, getThreadCount());
+
+            for (int tick_index = 0; tick_index < k_ticks_per_switch; ++tick_index)
+            {
+                for (std::unique_ptr<PhysicsScene>& physics_scene : scenes)
+                {
+                    physics_scene->tick(1.f / 60.f);
+                }
+            }
+        });
+
+        for (int scene_index = 0; scene_index < k_scene_count; ++scene_index)
+        {
+            scenes[scene_index].reset();
+            scene_runtimes[scene_index].reset();
+        }
+        return milliseconds;
+    }
+} // namespace
+
+// level switches with two physics scenes alive per level, each switch destroys the scenes of the last level, creates
+// and fills new ones and steps them a few times. once with a runtime per scene and once with one shared runtime
+int main()
+{
+    int          per_scene_peak_thread_count = 0;
+    const double per_scene_milliseconds      = measureLevelSwitch(false, per_scene_peak_thread_count);
+
+    int          shared_peak_thread_count = 0;
+    const double shared_milliseconds      = measureLevelSwitch(true, shared_peak_thread_count);
+
+    std::printf("%d scenes of %d bodies per level\n", k_scene_count, k_body_count);
+    std::printf("runtime per scene: %.3f ms per switch, peak %d threads\n",
+                per_scene_milliseconds,
+                per_scene_peak_thread_count);
+    std::printf("shared runtime:    %.3f ms per switch, peak %d threads\n",
+                shared_milliseconds,
+                shared_peak_thread_count);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,337 @@
+#include "test_utilities.h"
+
+#include "runtime/core/log/log_system.h"
+#include "runtime/core/meta/reflection/reflection.h"
+#include "runtime/core/meta/reflection/reflection_register.h"
+#include "runtime/core/meta/serializer/json_writer.h"
+#include "runtime/core/meta/serializer/serializer.h"
+
+#include "runtime/resource/asset_manager/asset_manager.h"
+#include "runtime/resource/config_manager/config_manager.h"
+#include "runtime/resource/res_type/common/level.h"
+#include "runtime/resource/res_type/common/object.h"
+
+#include "runtime/function/framework/component/component.h"
+#include "runtime/function/global/global_context.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace Piccolo;
+
+namespace
+{
+    constexpr int k_object_count = 10000;
+    constexpr int k_write_count  = 5;
+    constexpr int k_walk_count   = 20;
+
+    const char* const k_level_url = "asset/level/1-1.level.json";
+
+    struct WalkType;
+
+    /// a reflected field, reached through its accessor table and through std::function objects wrapping the same
+    /// accessors, the way every accessor was called before the tables. a wrapper adds the std::function call the old
+    /// tuples made on top of the call into the table
+    struct WalkField
+    {
+        Reflection::FieldAccessor        m_accessor;
+        std::function<void*(void*)>      m_get_function;
+        Reflection::ArrayAccessor        m_array_accessor;
+        std::function<int(void*)>        m_get_size_function;
+        std::function<void*(int, void*)> m_get_element_function;
+        const WalkType*                  m_type {nullptr};
+        bool                             m_is_array {false};
+    };
+
+    struct WalkType
+    {
+        std::vector<WalkField> m_fields;
+    };
+
+    /// the fields of every reflected type met in the level, looked up before the walks are timed
+    class WalkTypeCache
+    {
+    public:
+        const WalkType* getType(const std::string& type_name)
+        {
+            auto found = m_types.find(type_name);
+            if (found != m_types.end())
+            {
+                return found->second.get();
+            }
+
+            Reflection::TypeMeta meta = Reflection::TypeMeta::newMetaFromName(type_name);
+            if (!meta.isValid())
+            {
+                m_types.emplace(type_name, nullptr);
+                return nullptr;
+            }
+
+            // the entry is made first, so a type that holds itself through an array is not looked up again
+            WalkType* type = m_types.emplace(type_name, std::make_unique<WalkType>()).first->second.get();
+            for (const Reflection::FieldAccessor& accessor : meta.getFields())
+            {
+                WalkField field;
+                field.m_accessor     = accessor;
+                field.m_get_function = [accessor](void* instance) { return accessor.get(instance); };
+                field.m_is_array     = accessor.isArrayType();
+                if (field.m_is_array)
+                {
+                    const std::string array_type_name = accessor.getFieldTypeName();
+                    if (!Reflection::TypeMeta::newArrayAccessorFromName(array_type_name, field.m_array_accessor))
+                        continue;
+                    const Reflection::ArrayAccessor array_accessor = field.m_array_accessor;
+                    field.m_get_size_function = [array_accessor](void* instance) {
+                        return array_accessor.getSize(instance);
+                    };
+                    field.m_get_element_function = [array_accessor](int index, void* instance) {
+                        return array_accessor.get(index, instance);
+                    };
+                    field.m_type = getType(array_accessor.getElementTypeName());
+                }
+                else
+                {
+                    field.m_type = getType(accessor.getFieldTypeName());
+                }
+                type->m_fields.push_back(std::move(field));
+            }
+            return type;
+        }
+
+    private:
+        using Types = std::unordered_map<std::string, std::unique_ptr<WalkType>>;
+        Types m_types;
+    };
+
+    /// visits every reflected field below instance and sums the addresses the accessors hand out
+    uintptr_t walkByTable(const WalkType& type, void* instance)
+    {
+        uintptr_t checksum = 0;
+        for (const WalkField& field : type.m_fields)
+        {
+            void* field_instance = field.m_accessor.get(instance);
+            checksum += reinterpret_cast<uintptr_t>(field_instance);
+            if (field.m_is_array)
+            {
+                const int element_count = field.m_array_accessor.getSize(field_instance);
+                for (int element_index = 0; element_index < element_count; ++element_index)
+                {
+                    void* element_instance = field.m_array_accessor.get(element_index, field_instance);
+                    checksum += reinterpret_cast<uintptr_t>(element_instance);
+                    if (field.m_type != nullptr)
+                    {
+                        checksum += walkByTable(*field.m_type, element_instance);
+                    }
+                }
+            }
+            else if (field.m_type != nullptr)
+            {
+                checksum += walkByTable(*field.m_type, field_instance);
+            }
+        }
+        return checksum;
+    }
+
+    uintptr_t walkByFunction(const WalkType& type, void* instance)
+    {
+        uintptr_t checksum = 0;
+        for (const WalkField& field : type.m_fields)
+        {
+            void* field_instance = field.m_get_function(instance);
+            checksum += reinterpret_cast<uintptr_t>(field_instance);
+            if (field.m_is_array)
+            {
+                const int element_count = field.m_get_size_function(field_instance);
+                for (int element_index = 0; element_index < element_count; ++element_index)
+                {
+                    void* element_instance = field.m_get_element_function(element_index, field_instance);
+                    checksum += reinterpret_cast<uintptr_t>(element_instance);
+                    if (field.m_type != nullptr)
+                    {
+                        checksum += walkByFunction(*field.m_type, element_instance);
+                    }
+                }
+            }
+            else if (field.m_type != nullptr)
+            {
+                checksum += walkByFunction(*field.m_type, field_instance);
+            }
+        }
+        return checksum;
+    }
+
+    /// a copy of every component of the object, the instanced ones followed by the ones of its definition
+    void appendComponents(const ObjectInstanceRes&                           object_res,
+                          const ObjectDefinitionRes&                         definition_res,
+                          std::vector<Reflection::ReflectionPtr<Component>>& out_components)
+    {
+        auto append_component = [&](const Reflection::ReflectionPtr<Component>& component) {
+            Reflection::ReflectionInstance copy =
+                Reflection::TypeMeta::cloneByName(component.getTypeName(), component.getPtr());
+            if (copy.m_instance != nullptr)
+            {
+                out_components.emplace_back(component.getTypeName(), static_cast<Component*>(copy.m_instance));
+            }
+        };
+        for (const auto& component : object_res.m_instanced_components)
+        {
+            append_component(component);
+        }
+        for (const auto& component : definition_res.m_components)
+        {
+            append_component(component);
+        }
+    }
+
+    /// the objects of the level repeated up to k_object_count, each carrying every component of its definition as
+    /// an instanced component, so all of them go through the accessor tables when the level is written
+    bool makeLargeLevel(LevelRes& out_level_res)
+    {
+        LevelRes level_res;
+        if (!g_runtime_global_context.m_asset_manager->loadAsset(k_level_url, level_res) || level_res.m_objects.empty())
+            return false;
+
+        std::vector<ObjectDefinitionRes> definitions(level_res.m_objects.size());
+        for (size_t object_index = 0; object_index < level_res.m_objects.size(); ++object_index)
+        {
+            const std::string& definition_url = level_res.m_objects[object_index].m_definition;
+            if (!definition_url.empty())
+            {
+                g_runtime_global_context.m_asset_manager->loadAsset(definition_url, definitions[object_index]);
+            }
+        }
+
+        out_level_res.m_gravity        = level_res.m_gravity;
+        out_level_res.m_character_name = level_res.m_character_name;
+        for (int object_index = 0; object_index < k_object_count; ++object_index)
+        {
+            const size_t             source_index = object_index % level_res.m_objects.size();
+            const ObjectInstanceRes& source_res   = level_res.m_objects[source_index];
+            ObjectInstanceRes&       object_res   = out_level_res.m_objects.emplace_back();
+            object_res.m_name                     = source_res.m_name + "_" + std::to_string(object_index);
+            appendComponents(source_res, definitions[source_index], object_res.m_instanced_components);
+        }
+
+        for (auto& object_res : level_res.m_objects)
+        {
+            for (auto& component : object_res.m_instanced_components)
+            {
+                PICCOLO_REFLECTION_DELETE(component);
+            }
+        }
+        for (auto& definition_res : definitions)
+        {
+            for (auto& component : definition_res.m_components)
+            {
+                PICCOLO_REFLECTION_DELETE(component);
+            }
+        }
+        return true;
+    }
+} // namespace
+
+// the objects of level 1-1 repeated into a level of 10k objects, every one holding all components of its definition.
+// prints the time of writing the level to json, and compares a walk over every reflected field of the components
+// through the accessor tables with the same walk through std::function objects, the way the accessors were called
+// before the tables
+int main()
+{
+    Reflection::TypeMetaRegister::metaRegister();
+
+    const std::filesystem::path root_folder =
+        std::filesystem::temp_directory_path() / "piccolo_reflection_serialization_benchmark";
+    std::filesystem::create_directories(root_folder);
+    std::ofstream(root_folder / "benchmark.ini") << "BinaryRootFolder=" << Test::getEngineRootFolder().generic_string()
+                                                 << "\nAssetFolder=asset\n";
+
+    g_runtime_global_context.m_logger_system  = std::make_shared<LogSystem>();
+    g_runtime_global_context.m_config_manager = std::make_shared<ConfigManager>();
+    g_runtime_global_context.m_config_manager->initialize(root_folder / "benchmark.ini");
+    g_runtime_global_context.m_asset_manager = std::make_shared<AssetManager>();
+
+    LevelRes level_res;
+    if (!makeLargeLevel(level_res))
+    {
+        std::fprintf(stderr, "loading %s failed\n", k_level_url);
+        return EXIT_FAILURE;
+    }
+
+    size_t json_size          = 0;
+    double write_milliseconds = Test::measureMilliseconds(k_write_count, [&]() {
+        std::ostringstream stream;
+        {
+            JsonWriter writer(stream, false);
+            Serializer::write(writer, level_res);
+        }
+        json_size = stream.str().size();
+    });
+
+    size_t                                         component_count = 0;
+    WalkTypeCache                                  type_cache;
+    std::vector<std::pair<const WalkType*, void*>> component_walks;
+    for (auto& object_res : level_res.m_objects)
+    {
+        for (auto& component : object_res.m_instanced_components)
+        {
+            ++component_count;
+            if (const WalkType* type = type_cache.getType(component.getTypeName()))
+            {
+                component_walks.emplace_back(type, component.getPtr());
+            }
+        }
+    }
+
+    uintptr_t table_checksum     = 0;
+    double    table_milliseconds = Test::measureMilliseconds(k_walk_count, [&]() {
+        table_checksum = 0;
+        for (const auto& [type, instance] : component_walks)
+        {
+            table_checksum += walkByTable(*type, instance);
+        }
+    });
+
+    uintptr_t function_checksum     = 0;
+    double    function_milliseconds = Test::measureMilliseconds(k_walk_count, [&]() {
+        function_checksum = 0;
+        for (const auto& [type, instance] : component_walks)
+        {
+            function_checksum += walkByFunction(*type, instance);
+        }
+    });
+
+    if (table_checksum != function_checksum || table_checksum == 0)
+    {
+        std::fprintf(stderr, "the accessor tables reach other fields than the std::function accessors\n");
+        return EXIT_FAILURE;
+    }
+
+    std::printf("%d objects, %zu components: json write %.3f ms for %.2f MB\n",
+                k_object_count,
+                component_count,
+                write_milliseconds,
+                static_cast<double>(json_size) / (1024.0 * 1024.0));
+    std::printf("field walk: std::function %.3f ms, tables %.3f ms, %.2fx\n",
+                function_milliseconds,
+                table_milliseconds,
+                function_milliseconds / table_milliseconds);
+
+    for (auto& object_res : level_res.m_objects)
+    {
+        for (auto& component : object_res.m_instanced_components)
+        {
+            PICCOLO_REFLECTION_DELETE(component);
+        }
+    }
+    std::filesystem::remove_all(root_folder);
+
+    Reflection::TypeMetaRegister::metaUnregister();
+    return EXIT_SUCCESS;
+}
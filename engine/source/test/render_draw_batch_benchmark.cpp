@@ -0,0 +1,152 @@
+#include "test_utilities.h"
+
+#include "runtime/function/render/render_draw_batch.h"
+
+#include <cstdio>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace Piccolo;
+
+namespace
+{
+    constexpr int k_node_count     = 5000;
+    constexpr int k_material_count = 16;
+    constexpr int k_mesh_count     = 64;
+
+    struct MeshNode
+    {
+        const Matrix4x4* model_matrix {nullptr};
+        const Matrix4x4* joint_matrices {nullptr};
+        uint32_t         joint_count {0};
+    };
+
+    using MeshDrawcallBatch = std::map<VulkanPBRMaterial*, std::map<VulkanMesh*, std::vector<MeshNode>>>;
+
+    /// the grouping the passes built every frame before the batch table
+    void buildMapBatches(const std::vector<RenderMeshNode>& nodes, MeshDrawcallBatch& out_batches)
+    {
+        out_batches.clear();
+        for (const RenderMeshNode& node : nodes)
+        {
+            auto& mesh_instanced = out_batches[node.ref_material];
+            auto& mesh_nodes     = mesh_instanced[node.ref_mesh];
+
+            MeshNode temp;
+            temp.model_matrix = node.model_matrix;
+            if (node.enable_vertex_blending)
+            {
+                temp.joint_matrices = node.joint_matrices;
+                temp.joint_count    = node.joint_count;
+            }
+
+            mesh_nodes.push_back(temp);
+        }
+    }
+
+    /// the table has to end up with the same batches as the map, in any order
+    bool isSameBatching(const RenderDrawBatchTable& table, const MeshDrawcallBatch& map_batches)
+    {
+        size_t map_batch_count = 0;
+        for (const auto& material_pair : map_batches)
+        {
+            map_batch_count += material_pair.second.size();
+        }
+        if (map_batch_count != table.getBatches().size())
+        {
+            return false;
+        }
+
+        for (const RenderDrawBatch& batch : table.getBatches())
+        {
+            auto material_iter = map_batches.find(batch.material);
+            if (material_iter == map_batches.end())
+            {
+                return false;
+            }
+            auto mesh_iter = material_iter->second.find(batch.mesh);
+            if (mesh_iter == material_iter->second.end() || mesh_iter->second.size() != batch.instance_count)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+} // namespace
+
+// the batching of 5000 visible mesh nodes: the map the passes rebuilt every frame, the table with the same visible
+// nodes as the last frame, and the table with a different visible set every frame, which sorts it again
+int main()
+{
+    std::mt19937                       random(20221017u);
+    std::uniform_int_distribution<int> material_index(0, k_material_count - 1);
+    std::uniform_int_distribution<int> mesh_index(0, k_mesh_count - 1);
+
+    std::vector<VulkanPBRMaterial> materials(k_material_count);
+    std::vector<VulkanMesh>        meshes(k_mesh_count);
+    std::vector<Matrix4x4>         model_matrices(k_node_count, Matrix4x4::IDENTITY);
+
+    // two frames of the same scene seen from slightly different places, the second drops every tenth node
+    std::vector<RenderMeshNode> nodes;
+    for (int node_index = 0; node_index < k_node_count; ++node_index)
+    {
+        const int material = material_index(random);
+        const int mesh     = mesh_index(random);
+
+        RenderMeshNode node;
+        node.model_matrix      = &model_matrices[node_index];
+        node.ref_material      = &materials[material];
+        node.ref_mesh          = &meshes[mesh];
+        node.material_asset_id = static_cast<size_t>(material);
+        node.mesh_asset_id     = static_cast<size_t>(mesh);
+        node.node_id           = static_cast<uint32_t>(node_index);
+        nodes.push_back(node);
+    }
+    std::vector<RenderMeshNode> other_nodes;
+    for (int node_index = 0; node_index < k_node_count; ++node_index)
+    {
+        if (node_index % 10 != 0)
+        {
+            other_nodes.push_back(nodes[node_index]);
+        }
+    }
+
+    const int iteration_count = 1000;
+
+    MeshDrawcallBatch map_batches;
+    double            map_milliseconds =
+        Test::measureMilliseconds(iteration_count, [&]() { buildMapBatches(nodes, map_batches); });
+
+    RenderDrawBatchTable table;
+    double               unchanged_milliseconds =
+        Test::measureMilliseconds(iteration_count, [&]() { table.update(nodes); });
+    if (!isSameBatching(table, map_batches))
+    {
+        std::fprintf(stderr, "the batch table groups the nodes differently from the map\n");
+        return EXIT_FAILURE;
+    }
+
+    int    frame_index          = 0;
+    double changed_milliseconds = Test::measureMilliseconds(iteration_count, [&]() {
+        table.update(frame_index % 2 == 0 ? other_nodes : nodes);
+        ++frame_index;
+    });
+
+    buildMapBatches(frame_index % 2 == 0 ? nodes : other_nodes, map_batches);
+    if (!isSameBatching(table, map_batches))
+    {
+        std::fprintf(stderr, "the batch table groups the changed nodes differently from the map\n");
+        return EXIT_FAILURE;
+    }
+
+    std::printf("%d nodes, %zu batches: map %.1f us, table unchanged %.1f us (%.1fx), table changed %.1f us (%.1fx)\n",
+                k_node_count,
+                table.getBatches().size(),
+                map_milliseconds * 1000.0,
+                unchanged_milliseconds * 1000.0,
+                map_milliseconds / unchanged_milliseconds,
+                changed_milliseconds * 1000.0,
+                map_milliseconds / changed_milliseconds);
+    return EXIT_SUCCESS;
+}
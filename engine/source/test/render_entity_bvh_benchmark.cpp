@@ -0,0 +1,179 @@
+#include "test_utilities.h"
+
+#include "runtime/core/math/math.h"
+#include "runtime/core/math/matrix4.h"
+
+#include "runtime/function/render/render_entity_bvh.h"
+#include "runtime/function/render/render_helper.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace Piccolo;
+
+namespace
+{
+    constexpr uint32_t k_entity_count = 100000;
+
+    struct Entity
+    {
+        BoundingBox asset_bounds;
+        Matrix4x4   model_matrix;
+        BoundingBox world_bounds;
+        uint32_t    proxy {RenderEntityBVH::k_null_node};
+    };
+
+    /// culling of every entity the way the scene did before the hierarchy: the asset box is transformed by the
+    /// model matrix in every pass
+    void cullBruteForce(const std::vector<Entity>&                      entities,
+                        const std::function<bool(const BoundingBox&)>& is_visible,
+                        std::vector<uint32_t>&                          out_visible_entities)
+    {
+        out_visible_entities.clear();
+        for (uint32_t entity_index = 0; entity_index < entities.size(); ++entity_index)
+        {
+            const Entity& entity = entities[entity_index];
+            if (is_visible(BoundingBoxTransform(entity.asset_bounds, entity.model_matrix)))
+            {
+                out_visible_entities.push_back(entity_index);
+            }
+        }
+    }
+
+    /// culling through the hierarchy against the shared world bounds, the way RenderScene culls
+    void cullHierarchy(const RenderEntityBVH&                          bvh,
+                       const std::vector<Entity>&                      entities,
+                       const std::function<bool(const BoundingBox&)>& is_visible,
+                       std::vector<uint32_t>&                          out_visible_entities)
+    {
+        out_visible_entities.clear();
+        bvh.query(is_visible, [&](uint32_t entity_index) {
+            if (is_visible(entities[entity_index].world_bounds))
+            {
+                out_visible_entities.push_back(entity_index);
+            }
+        });
+    }
+
+    bool isSameSet(std::vector<uint32_t> lhs, std::vector<uint32_t> rhs)
+    {
+        std::sort(lhs.begin(), lhs.end());
+        std::sort(rhs.begin(), rhs.end());
+        return lhs == rhs;
+    }
+} // namespace
+
+// 100k entities scattered over a large level, culled against the main camera frustum, the directional light frustum
+// and a point light, once brute force and once through RenderEntityBVH. also the cost of moving a percent of them
+int main()
+{
+    std::mt19937                          random(20221017u);
+    std::uniform_real_distribution<float> position(-1000.f, 1000.f);
+    std::uniform_real_distribution<float> height(0.f, 20.f);
+    std::uniform_real_distribution<float> size(0.5f, 3.f);
+    std::uniform_real_distribution<float> angle(0.f, 360.f);
+
+    std::vector<Entity> entities(k_entity_count);
+    RenderEntityBVH     bvh;
+    for (uint32_t entity_index = 0; entity_index < k_entity_count; ++entity_index)
+    {
+        Entity&       entity = entities[entity_index];
+        const Vector3 half_extents(size(random), size(random), size(random));
+        entity.asset_bounds = BoundingBox(-half_extents, half_extents);
+
+        Quaternion orientation;
+        orientation.fromAngleAxis(Radian(Degree(angle(random))), Vector3::UNIT_Z);
+        entity.model_matrix.makeTransform(
+            Vector3(position(random), position(random), height(random)), Vector3::UNIT_SCALE, orientation);
+
+        entity.world_bounds = BoundingBoxTransform(entity.asset_bounds, entity.model_matrix);
+        entity.proxy        = bvh.createProxy(entity.world_bounds, entity_index);
+    }
+
+    const Matrix4x4 camera_proj_view =
+        Math::makePerspectiveMatrix(Radian(Math_PI / 3.f), 16.f / 9.f, 0.1f, 300.f) *
+        Math::makeLookAtMatrix(Vector3(0.f, -50.f, 20.f), Vector3(0.f, 100.f, 0.f), Vector3::UNIT_Z);
+    const ClusterFrustum camera_frustum =
+        CreateClusterFrustumFromMatrix(camera_proj_view, -1.0, 1.0, -1.0, 1.0, 0.0, 1.0);
+
+    const Matrix4x4 light_proj_view =
+        Math::makeOrthographicProjectionMatrix01(-150.f, 150.f, -150.f, 150.f, 0.f, 200.f) *
+        Math::makeLookAtMatrix(Vector3(20.f, 20.f, 100.f), Vector3(0.f, 0.f, 0.f), Vector3::UNIT_Y);
+    const ClusterFrustum light_frustum =
+        CreateClusterFrustumFromMatrix(light_proj_view, -1.0, 1.0, -1.0, 1.0, 0.0, 1.0);
+
+    BoundingSphere point_light;
+    point_light.m_center = Vector3(10.f, 30.f, 5.f);
+    point_light.m_radius = 40.f;
+
+    struct CullingPass
+    {
+        const char*                             name;
+        std::function<bool(const BoundingBox&)> is_visible;
+    };
+    const CullingPass culling_passes[] = {
+        {"main camera", [&](const BoundingBox& bounds) { return TiledFrustumIntersectBox(camera_frustum, bounds); }},
+        {"directional light",
+         [&](const BoundingBox& bounds) { return TiledFrustumIntersectBox(light_frustum, bounds); }},
+        {"point light", [&](const BoundingBox& bounds) { return BoxIntersectsWithSphere(bounds, point_light); }},
+    };
+
+    std::printf("%18s %10s %18s %18s %8s\n", "pass", "visible", "brute ns/entity", "bvh ns/entity", "speedup");
+    std::vector<uint32_t> brute_force_visible;
+    std::vector<uint32_t> hierarchy_visible;
+    for (const CullingPass& culling_pass : culling_passes)
+    {
+        const double brute_force_milliseconds = Test::measureMilliseconds(
+            20, [&]() { cullBruteForce(entities, culling_pass.is_visible, brute_force_visible); });
+        const double hierarchy_milliseconds = Test::measureMilliseconds(
+            20, [&]() { cullHierarchy(bvh, entities, culling_pass.is_visible, hierarchy_visible); });
+
+        if (!isSameSet(brute_force_visible, hierarchy_visible))
+        {
+            std::fprintf(stderr, "the %s pass sees different entities through the hierarchy\n", culling_pass.name);
+            return EXIT_FAILURE;
+        }
+
+        std::printf("%18s %10zu %18.2f %18.2f %7.1fx\n",
+                    culling_pass.name,
+                    hierarchy_visible.size(),
+                    brute_force_milliseconds * 1e6 / k_entity_count,
+                    hierarchy_milliseconds * 1e6 / k_entity_count,
+                    brute_force_milliseconds / hierarchy_milliseconds);
+    }
+
+    // a percent of the entities drift a little every frame, most of them stay inside their enlarged leaf box
+    std::uniform_int_distribution<uint32_t> moving_entity(0, k_entity_count - 1);
+    std::vector<uint32_t>                   moving_entities;
+    for (uint32_t move_index = 0; move_index < k_entity_count / 100; ++move_index)
+    {
+        moving_entities.push_back(moving_entity(random));
+    }
+
+    int          frame_index       = 0;
+    const double move_milliseconds = Test::measureMilliseconds(100, [&]() {
+        const Vector3 offset(0.05f * ((frame_index / 20) % 2 == 0 ? 1.f : -1.f), 0.f, 0.f);
+        for (uint32_t entity_index : moving_entities)
+        {
+            Entity& entity = entities[entity_index];
+            entity.model_matrix.setTrans(entity.model_matrix.getTrans() + offset);
+            entity.world_bounds = BoundingBoxTransform(entity.asset_bounds, entity.model_matrix);
+            bvh.moveProxy(entity.proxy, entity.world_bounds);
+        }
+        ++frame_index;
+    });
+
+    cullBruteForce(entities, culling_passes[0].is_visible, brute_force_visible);
+    cullHierarchy(bvh, entities, culling_passes[0].is_visible, hierarchy_visible);
+    if (!isSameSet(brute_force_visible, hierarchy_visible))
+    {
+        std::fprintf(stderr, "the hierarchy sees different entities after the moves\n");
+        return EXIT_FAILURE;
+    }
+
+    std::printf("moving %zu entities: %.3f ms per frame\n", moving_entities.size(), move_milliseconds);
+    return EXIT_SUCCESS;
+}
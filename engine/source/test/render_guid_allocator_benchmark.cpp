@@ -0,0 +1,118 @@
+#include "test_utilities.h"
+
+#include "runtime/function/render/render_entity.h"
+#include "runtime/function/render/render_object.h"
+#include "runtime/function/render/render_scene.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace Piccolo;
+
+namespace
+{
+    constexpr size_t k_parts_per_object = 4;
+    constexpr int    k_pass_count       = 3;
+
+    /// nanoseconds per part of adding a level of part_count mesh parts to a scene and deleting its objects again,
+    /// newest first or in random order
+    bool measureScene(size_t  part_count,
+                      bool    is_delete_order_random,
+                      double& out_add_nanoseconds,
+                      double& out_delete_nanoseconds)
+    {
+        const size_t object_count = part_count / k_parts_per_object;
+
+        std::vector<GObjectID> delete_order(object_count);
+        std::iota(delete_order.rbegin(), delete_order.rend(), GObjectID(0));
+        if (is_delete_order_random)
+        {
+            std::shuffle(delete_order.begin(), delete_order.end(), std::mt19937(20221017u));
+        }
+
+        // the parts are added the way RenderSystem processes a dirty object
+        auto fill_scene = [&](RenderScene& render_scene) {
+            for (GObjectID object_id = 0; object_id < object_count; ++object_id)
+            {
+                for (size_t part_index = 0; part_index < k_parts_per_object; ++part_index)
+                {
+                    RenderEntity render_entity;
+                    render_entity.m_instance_id = static_cast<uint32_t>(
+                        render_scene.getInstanceIdAllocator().allocGuid(GameObjectPartId {object_id, part_index}));
+                    render_entity.m_model_matrix.setTrans(Vector3(static_cast<float>(object_id % 1000),
+                                                                  static_cast<float>(object_id / 1000),
+                                                                  static_cast<float>(part_index)));
+                    render_entity.m_bounding_box.merge(Vector3(-0.5f, -0.5f, -0.5f));
+                    render_entity.m_bounding_box.merge(Vector3(0.5f, 0.5f, 0.5f));
+
+                    render_scene.addInstanceIdToMap(render_entity.m_instance_id, object_id);
+                    render_scene.addOrUpdateRenderEntity(render_entity);
+                }
+            }
+        };
+
+        // every pass starts from an empty scene, adds all parts and deletes all objects again
+        using Clock = std::chrono::steady_clock;
+        Clock::duration add_duration {0};
+        Clock::duration delete_duration {0};
+        for (int pass = 0; pass < k_pass_count; ++pass)
+        {
+            RenderScene render_scene;
+
+            const Clock::time_point add_begin = Clock::now();
+            fill_scene(render_scene);
+            const Clock::time_point delete_begin = Clock::now();
+            for (GObjectID object_id : delete_order)
+            {
+                render_scene.deleteEntityByGObjectID(object_id);
+            }
+            const Clock::time_point delete_end = Clock::now();
+
+            add_duration += delete_begin - add_begin;
+            delete_duration += delete_end - delete_begin;
+
+            if (!render_scene.getRenderEntityWorldBounds().empty())
+            {
+                std::fprintf(stderr, "render entities left after deleting every object\n");
+                return false;
+            }
+        }
+
+        const double pass_part_count = static_cast<double>(k_pass_count) * part_count;
+        out_add_nanoseconds    = std::chrono::duration<double, std::nano>(add_duration).count() / pass_part_count;
+        out_delete_nanoseconds = std::chrono::duration<double, std::nano>(delete_duration).count() / pass_part_count;
+        return true;
+    }
+} // namespace
+
+// levels of 1k to 100k mesh parts added to a RenderScene and deleted object by object, newest first and in random
+// order. every step of a delete is O(1) or O(log n), so the cost per part of the deletes newest first stays flat as
+// the level grows. in random order the growth comes from cache misses once the scene outgrows the caches
+int main()
+{
+    const size_t part_counts[] = {1000, 10000, 50000, 100000};
+
+    std::printf("%8s %14s %24s %24s\n", "parts", "add ns/part", "delete newest ns/part", "delete random ns/part");
+    for (size_t part_count : part_counts)
+    {
+        double add_nanoseconds           = 0.0;
+        double newest_delete_nanoseconds = 0.0;
+        double random_delete_nanoseconds = 0.0;
+        double random_add_nanoseconds    = 0.0;
+        if (!measureScene(part_count, false, add_nanoseconds, newest_delete_nanoseconds) ||
+            !measureScene(part_count, true, random_add_nanoseconds, random_delete_nanoseconds))
+        {
+            return EXIT_FAILURE;
+        }
+        std::printf("%8zu %14.1f %24.1f %24.1f\n",
+                    part_count,
+                    add_nanoseconds,
+                    newest_delete_nanoseconds,
+                    random_delete_nanoseconds);
+    }
+    return EXIT_SUCCESS;
+}
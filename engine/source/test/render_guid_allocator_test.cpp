@@ -0,0 +1,63 @@
+#include "test_utilities.h"
+
+#include "runtime/function/render/render_guid_allocator.h"
+
+#include <unordered_set>
+
+using namespace Piccolo;
+
+int main()
+{
+    // one slot reused over and over, every guid it hands out must be new and die with its element
+    {
+        GuidAllocator<int>         allocator;
+        std::unordered_set<size_t> handed_out_guids;
+        size_t                     previous_guid = s_invalid_guid;
+        for (int element = 0; element < 1000; ++element)
+        {
+            size_t guid = allocator.allocGuid(element);
+            if (!GuidAllocator<int>::isValidGuid(guid))
+            {
+                PICCOLO_CHECK(false);
+                break;
+            }
+            PICCOLO_CHECK(handed_out_guids.insert(guid).second);
+
+            int found_element = -1;
+            PICCOLO_CHECK(!allocator.getGuidRelatedElement(previous_guid, found_element));
+            PICCOLO_CHECK(allocator.getGuidRelatedElement(guid, found_element) && found_element == element);
+
+            allocator.freeGuid(guid);
+            PICCOLO_CHECK(!allocator.getGuidRelatedElement(guid, found_element));
+            previous_guid = guid;
+        }
+
+        // the very first guid stays stale after the slot ran through all its generations
+        int found_element = -1;
+        allocator.allocGuid(-1);
+        for (size_t guid : handed_out_guids)
+        {
+            PICCOLO_CHECK(!allocator.getGuidRelatedElement(guid, found_element));
+        }
+    }
+
+    // allocating an element twice returns its guid, freeing by element frees the guid
+    {
+        GuidAllocator<int> allocator;
+        size_t             guid = allocator.allocGuid(7);
+        PICCOLO_CHECK(allocator.allocGuid(7) == guid);
+        PICCOLO_CHECK(allocator.hasElement(7));
+
+        size_t other_guid = allocator.allocGuid(8);
+        PICCOLO_CHECK(other_guid != guid);
+        PICCOLO_CHECK(allocator.getAllocatedGuids().size() == 2);
+
+        allocator.freeElement(7);
+        PICCOLO_CHECK(!allocator.hasElement(7));
+        size_t found_guid = s_invalid_guid;
+        PICCOLO_CHECK(allocator.getElementGuid(8, found_guid) && found_guid == other_guid);
+        PICCOLO_CHECK(allocator.getAllocatedGuids().size() == 1);
+    }
+
+    return Test::finish();
+}
@@ -0,0 +1,236 @@
+#include "test_utilities.h"
+
+#include "runtime/core/math/math.h"
+#include "runtime/core/math/transform.h"
+
+#include "runtime/function/animation/animation_system.h"
+#include "runtime/function/animation/node.h"
+#include "runtime/function/animation/skeleton.h"
+
+#include "runtime/resource/res_type/data/animation_clip.h"
+#include "runtime/resource/res_type/data/animation_skeleton_node_map.h"
+#include "runtime/resource/res_type/data/skeleton_data.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Piccolo;
+
+namespace
+{
+    constexpr int   k_bone_count  = 67;
+    constexpr int   k_frame_count = 24;
+    constexpr float k_tolerance   = 1e-4f;
+
+    std::mt19937 g_random(20221017u);
+
+    float randomFloat(float min_value, float max_value)
+    {
+        return std::uniform_real_distribution<float>(min_value, max_value)(g_random);
+    }
+
+    Vector3 randomVector(float min_value, float max_value)
+    {
+        return Vector3(randomFloat(min_value, max_value),
+                       randomFloat(min_value, max_value),
+                       randomFloat(min_value, max_value));
+    }
+
+    Quaternion randomRotation()
+    {
+        Quaternion rotation(
+            randomFloat(-1.f, 1.f), randomFloat(-1.f, 1.f), randomFloat(-1.f, 1.f), randomFloat(-1.f, 1.f));
+        rotation.normalise();
+        return rotation;
+    }
+
+    SkeletonData makeSkeleton()
+    {
+        SkeletonData skeleton;
+        skeleton.is_flat              = true;
+        skeleton.in_topological_order = true;
+        skeleton.root_index           = 0;
+        for (int bone_index = 0; bone_index < k_bone_count; ++bone_index)
+        {
+            RawBone bone;
+            bone.name         = "bone_" + std::to_string(bone_index);
+            bone.index        = bone_index;
+            bone.parent_index = bone_index == 0 ? -1 : static_cast<int>(g_random() % bone_index);
+            bone.binding_pose = Transform(randomVector(-1.f, 1.f), randomRotation(), randomVector(0.8f, 1.2f));
+
+            Matrix4x4 inverse_tpose;
+            inverse_tpose.makeInverseTransform(randomVector(-2.f, 2.f), randomVector(0.5f, 1.5f), randomRotation());
+            bone.tpose_matrix = inverse_tpose.toMatrix4x4_();
+
+            skeleton.bones_map.push_back(bone);
+        }
+        return skeleton;
+    }
+
+    /// a channel for every bone but the last few, with the node order shuffled against the bone order
+    void makeClip(AnimationClip& clip, AnimSkelMap& anim_skel_map)
+    {
+        const int node_count = k_bone_count - 3;
+
+        std::vector<int> bone_indices(k_bone_count);
+        for (int bone_index = 0; bone_index < k_bone_count; ++bone_index)
+        {
+            bone_indices[bone_index] = bone_index;
+        }
+        std::shuffle(bone_indices.begin(), bone_indices.end(), g_random);
+
+        clip.total_frame = k_frame_count;
+        clip.node_count  = node_count;
+        clip.node_channels.resize(node_count);
+        anim_skel_map.convert.resize(node_count);
+        for (int node_index = 0; node_index < node_count; ++node_index)
+        {
+            AnimationChannel& channel = clip.node_channels[node_index];
+            channel.name              = "node_" + std::to_string(node_index);
+            for (int frame = 0; frame < k_frame_count; ++frame)
+            {
+                channel.position_keys.push_back(randomVector(-0.5f, 0.5f));
+                channel.rotation_keys.push_back(randomRotation());
+                channel.scaling_keys.push_back(randomVector(0.9f, 1.1f));
+            }
+            anim_skel_map.convert[node_index] = bone_indices[node_index];
+        }
+        // a node without a bone is skipped
+        anim_skel_map.convert[node_count / 2] = -1;
+    }
+
+    /// the single clip path of Skeleton before the pose buffers, every bone is a Node moved from its initial pose
+    std::vector<Matrix4x4> applyScalarReference(const SkeletonData&  skeleton,
+                                                const AnimationClip& animation_clip,
+                                                const AnimSkelMap&   anim_skel_map,
+                                                float                phase)
+    {
+        std::vector<Bone> bones(skeleton.bones_map.size());
+        for (size_t i = 0; i < bones.size(); i++)
+        {
+            const RawBone& bone_definition = skeleton.bones_map[i];
+            Bone* parent_bone = bone_definition.parent_index < 0 ? nullptr : &bones[bone_definition.parent_index];
+            bones[i].initialize(std::make_shared<RawBone>(bone_definition), parent_bone);
+        }
+
+        float exact_frame        = phase * (animation_clip.total_frame - 1);
+        int   current_frame_low  = floor(exact_frame);
+        int   current_frame_high = ceil(exact_frame);
+        float lerp_ratio         = exact_frame - current_frame_low;
+        for (size_t node_index = 0;
+             node_index < static_cast<size_t>(animation_clip.node_count) && node_index < anim_skel_map.convert.size();
+             node_index++)
+        {
+            const AnimationChannel& channel    = animation_clip.node_channels[node_index];
+            size_t                  bone_index = anim_skel_map.convert[node_index];
+            if (bone_index == std::numeric_limits<size_t>().max())
+            {
+                continue;
+            }
+            Bone* bone = &bones[bone_index];
+            if (static_cast<int>(channel.position_keys.size()) <= current_frame_high)
+            {
+                current_frame_high = channel.position_keys.size() - 1;
+            }
+            if (static_cast<int>(channel.scaling_keys.size()) <= current_frame_high)
+            {
+                current_frame_high = channel.scaling_keys.size() - 1;
+            }
+            if (static_cast<int>(channel.rotation_keys.size()) <= current_frame_high)
+            {
+                current_frame_high = channel.rotation_keys.size() - 1;
+            }
+            current_frame_low = (current_frame_low < current_frame_high) ? current_frame_low : current_frame_high;
+            Vector3 position  = Vector3::lerp(
+                channel.position_keys[current_frame_low], channel.position_keys[current_frame_high], lerp_ratio);
+            Vector3 scaling = Vector3::lerp(
+                channel.scaling_keys[current_frame_low], channel.scaling_keys[current_frame_high], lerp_ratio);
+            Quaternion rotation = Quaternion::nLerp(
+                lerp_ratio, channel.rotation_keys[current_frame_low], channel.rotation_keys[current_frame_high], true);
+
+            bone->rotate(rotation);
+            bone->scale(scaling);
+            bone->translate(position);
+        }
+
+        std::vector<Matrix4x4> joint_matrices;
+        for (Bone& bone : bones)
+        {
+            bone.update();
+            joint_matrices.push_back(
+                Transform(bone._getDerivedPosition(), bone._getDerivedOrientation(), bone._getDerivedScale())
+                    .getMatrix() *
+                bone._getInverseTpose());
+        }
+        return joint_matrices;
+    }
+
+    void checkSameJoints(const AnimationResult& animation_result, const std::vector<Matrix4x4>& expected)
+    {
+        PICCOLO_CHECK(animation_result.node.size() == expected.size());
+        for (size_t bone_index = 0; bone_index < animation_result.node.size() && bone_index < expected.size();
+             ++bone_index)
+        {
+            Matrix4x4 joint_matrix(animation_result.node[bone_index].transform);
+            for (int row = 0; row < 4; ++row)
+            {
+                for (int column = 0; column < 4; ++column)
+                {
+                    PICCOLO_CHECK_NEAR(
+                        joint_matrix.m_mat[row][column], expected[bone_index].m_mat[row][column], k_tolerance);
+                }
+            }
+        }
+    }
+} // namespace
+
+int main()
+{
+    const SkeletonData skeleton_definition = makeSkeleton();
+
+    auto clip          = std::make_shared<AnimationClip>();
+    auto anim_skel_map = std::make_shared<AnimSkelMap>();
+    makeClip(*clip, *anim_skel_map);
+
+    auto other_clip          = std::make_shared<AnimationClip>();
+    auto other_anim_skel_map = std::make_shared<AnimSkelMap>();
+    makeClip(*other_clip, *other_anim_skel_map);
+
+    BlendStateWithClipHandles single_clip;
+    single_clip.clip_count = 1;
+    single_clip.blend_clip.push_back(clip);
+    single_clip.blend_anim_skel_map.push_back(anim_skel_map);
+    single_clip.clip_weight.push_back(1.f);
+
+    // a second clip without weight must not change the pose
+    BlendStateWithClipHandles unweighted_second_clip = single_clip;
+    unweighted_second_clip.clip_count                = 2;
+    unweighted_second_clip.blend_clip.push_back(other_clip);
+    unweighted_second_clip.blend_anim_skel_map.push_back(other_anim_skel_map);
+    unweighted_second_clip.clip_weight.push_back(0.f);
+
+    Skeleton skeleton;
+    skeleton.buildSkeleton(skeleton_definition);
+    PICCOLO_CHECK(skeleton.getBonesCount() == k_bone_count);
+
+    AnimationResult animation_result;
+    for (float phase : {0.f, 0.13f, 0.5f, 0.77f, 0.999f, 1.f})
+    {
+        const std::vector<Matrix4x4> expected =
+            applyScalarReference(skeleton_definition, *clip, *anim_skel_map, phase);
+
+        skeleton.applyAnimation(single_clip, {phase});
+        skeleton.outputAnimationResult(animation_result);
+        checkSameJoints(animation_result, expected);
+
+        skeleton.applyAnimation(unweighted_second_clip, {phase, 1.f - phase});
+        skeleton.outputAnimationResult(animation_result);
+        checkSameJoints(animation_result, expected);
+    }
+
+    return Test::finish();
+}
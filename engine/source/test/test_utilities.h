@@ -0,0 +1,63 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+
+// https://gcc.gnu.org/onlinedocs/cpp/Stringizing.html
+#define PICCOLO_XSTR(s) PICCOLO_STR(s)
+#define PICCOLO_STR(s) #s
+
+namespace Piccolo
+{
+    namespace Test
+    {
+        inline int g_failed_check_count = 0;
+
+        /// the engine folder holding asset/, set by the CMakeLists of the tests
+        inline std::filesystem::path getEngineRootFolder() { return PICCOLO_XSTR(PICCOLO_ENGINE_ROOT_DIR); }
+
+        /// the exit code of a test, non-zero when any check failed
+        inline int finish()
+        {
+            if (g_failed_check_count != 0)
+            {
+                std::fprintf(stderr, "%d checks failed\n", g_failed_check_count);
+                return EXIT_FAILURE;
+            }
+            return EXIT_SUCCESS;
+        }
+
+        /// average milliseconds of one call of function over iteration_count calls, after one call to warm up
+        template<typename TFunction>
+        double measureMilliseconds(int iteration_count, TFunction&& function)
+        {
+            function();
+
+            auto begin = std::chrono::steady_clock::now();
+            for (int iteration = 0; iteration < iteration_count; ++iteration)
+            {
+                function();
+            }
+            auto end = std::chrono::steady_clock::now();
+
+            return std::chrono::duration<double, std::milli>(end - begin).count() / iteration_count;
+        }
+    } // namespace Test
+} // namespace Piccolo
+
+/// reports a failed condition and lets the test go on, Test::finish() turns the failures into the exit code
+#define PICCOLO_CHECK(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            ++Piccolo::Test::g_failed_check_count; \
+        } \
+    } while (false)
+
+#define PICCOLO_CHECK_NEAR(value, expected, tolerance) \
+    PICCOLO_CHECK(std::fabs(static_cast<double>(value) - static_cast<double>(expected)) <= (tolerance))